@@ -0,0 +1,59 @@
+/**
+ *  \file benchmark/benchmark.h
+ */
+
+#ifndef KIRKE__BENCHMARK__H
+#define KIRKE__BENCHMARK__H
+
+// System Includes
+#include <stdio.h>  // printf
+#include <time.h>   // clock_gettime
+
+/**
+ *  \defgroup benchmark Benchmark
+ *  @{
+ */
+
+/**
+ *  \brief This method returns the current value of a monotonic clock.
+ *  \returns The current time, in seconds, measured from an unspecified starting point.
+ */
+static inline double benchmark__now( void ){
+    struct timespec now;
+    clock_gettime( CLOCK_MONOTONIC, &now );
+
+    return (double) now.tv_sec + (double) now.tv_nsec * 1e-9;
+}
+
+/**
+ *  \brief This method prints a single line describing the result of a benchmark to stdout.
+ *  \param name A null-terminated C-style string naming the benchmark.
+ *  \param operation_count The number of operations which were timed.
+ *  \param seconds The total time, in seconds, taken by all operations.
+ */
+static inline void benchmark__report( const char *name, unsigned long long operation_count, double seconds ){
+    printf(
+        "%-64s %12llu ops %12.3f ms %12.2f ns/op\n",
+        name,
+        operation_count,
+        seconds * 1e3,
+        operation_count > 0 ? seconds * 1e9 / (double) operation_count : 0.0
+    );
+}
+
+/**
+ *  \def BENCHMARK__DO_NOT_OPTIMIZE
+ *  \brief Prevents the compiler from discarding a computed value whose result is otherwise unused.
+ */
+#define BENCHMARK__DO_NOT_OPTIMIZE( value )         \
+    do{                                             \
+        volatile unsigned long long sink;           \
+        sink = (unsigned long long)( value );       \
+        (void)( sink );                             \
+    } while( 0 )
+
+/**
+ *  @} group benchmark
+ */
+
+#endif // KIRKE__BENCHMARK__H
@@ -0,0 +1,99 @@
+// Internal Includes
+#include "benchmark.h"
+#include "kirke/arena_allocator.h"
+#include "kirke/split_iterator.h"
+#include "kirke/string.h"
+#include "kirke/system_allocator.h"
+
+/**
+ *  The number of strings built or tokens split per simulated request. Arena-backed runs reset the arena once
+ *  per request, system-backed runs free every allocation individually.
+ */
+#define REQUEST_SIZE 1000
+#define REQUEST_COUNT 2000
+
+static void format_request( Allocator *allocator, String *strings ){
+    for( unsigned long long string_index = 0; string_index < REQUEST_SIZE; string_index++ ){
+        string__initialize__format( &strings[ string_index ], allocator, "token-%llu:%s", string_index, "value" );
+    }
+}
+
+static void split_request( Allocator *allocator, String const *input, String const *delimiter, AutoArray__String *tokens ){
+    auto_array__string__initialize( tokens, allocator, 0 );
+
+    SplitIterator iterator;
+    split_iterator__initialize( &iterator, input, delimiter );
+
+    String token;
+    while( split_iterator__next( &iterator, &token ) ){
+        String copy;
+        string__initialize__full( &copy, allocator, token.data, token.length, token.length );
+        auto_array__string__append_element( tokens, copy );
+    }
+}
+
+static void benchmark__format( SystemAllocator *system_allocator, ArenaAllocator *arena_allocator ){
+    static String strings[ REQUEST_SIZE ];
+
+    double start = benchmark__now();
+    for( int request = 0; request < REQUEST_COUNT; request++ ){
+        format_request( system_allocator->allocator, strings );
+        for( unsigned long long string_index = 0; string_index < REQUEST_SIZE; string_index++ ){
+            string__clear( &strings[ string_index ], system_allocator->allocator );
+        }
+    }
+    benchmark__report( "string__initialize__format / SystemAllocator", REQUEST_COUNT * REQUEST_SIZE, benchmark__now() - start );
+
+    start = benchmark__now();
+    for( int request = 0; request < REQUEST_COUNT; request++ ){
+        format_request( arena_allocator->allocator, strings );
+        arena_allocator__reset( arena_allocator );
+    }
+    benchmark__report( "string__initialize__format / ArenaAllocator", REQUEST_COUNT * REQUEST_SIZE, benchmark__now() - start );
+}
+
+static void benchmark__split( SystemAllocator *system_allocator, ArenaAllocator *arena_allocator ){
+    String input;
+    string__initialize( &input, system_allocator->allocator, 0 );
+    for( unsigned long long token_index = 0; token_index < REQUEST_SIZE; token_index++ ){
+        string__append__format( &input, system_allocator->allocator, "token-%llu, ", token_index );
+    }
+
+    String delimiter = string__literal( ", " );
+    AutoArray__String tokens;
+
+    double start = benchmark__now();
+    for( int request = 0; request < REQUEST_COUNT; request++ ){
+        split_request( system_allocator->allocator, &input, &delimiter, &tokens );
+        for( unsigned long long token_index = 0; token_index < tokens.array__string->length; token_index++ ){
+            string__clear( &tokens.array__string->data[ token_index ], system_allocator->allocator );
+        }
+        auto_array__string__clear( &tokens );
+    }
+    benchmark__report( "split_iterator -> AutoArray__String / SystemAllocator", REQUEST_COUNT * REQUEST_SIZE, benchmark__now() - start );
+
+    start = benchmark__now();
+    for( int request = 0; request < REQUEST_COUNT; request++ ){
+        split_request( arena_allocator->allocator, &input, &delimiter, &tokens );
+        arena_allocator__reset( arena_allocator );
+    }
+    benchmark__report( "split_iterator -> AutoArray__String / ArenaAllocator", REQUEST_COUNT * REQUEST_SIZE, benchmark__now() - start );
+
+    string__clear( &input, system_allocator->allocator );
+}
+
+int main( void ){
+    SystemAllocator system_allocator;
+    system_allocator__initialize( &system_allocator, NULL );
+
+    ArenaAllocator arena_allocator;
+    arena_allocator__initialize( &arena_allocator, system_allocator.allocator, 1024 * 1024 );
+
+    benchmark__format( &system_allocator, &arena_allocator );
+    benchmark__split( &system_allocator, &arena_allocator );
+
+    arena_allocator__deinitialize( &arena_allocator );
+    system_allocator__deinitialize( &system_allocator );
+
+    return 0;
+}
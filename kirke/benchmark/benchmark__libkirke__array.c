@@ -0,0 +1,182 @@
+// Internal Includes
+#include "benchmark.h"
+#include "kirke/array.h"
+#include "kirke/string.h"
+#include "kirke/system_allocator.h"
+
+#define STRING_COUNT 256
+#define CHUNK_SIZE 100ULL
+#define MINIMUM_STRING_LENGTH ( 4ULL * 1024ULL )
+#define TOKEN_COUNT ( 10ULL * 1000ULL * 1000ULL )
+#define SEARCH_TEXT_LENGTH ( 1024ULL * 1024ULL )
+#define SEARCH_COUNT 100ULL
+
+static bool chars_are_equal( char first, char second ){
+    return first == second;
+}
+
+/* The same element type as String, compared through an equality function rather than bitwise. */
+ARRAY__DECLARE( Array__Char, array__char, char )
+ARRAY__DEFINE( Array__Char, array__char, char, chars_are_equal )
+
+/**
+ *  Builds large strings of log-uniformly distributed lengths, as a service builds response bodies, by appending
+ *  small chunks, and reports the share of the strings' capacity which was left unused.
+ */
+static void benchmark__append( const char *name, Allocator *allocator, Array__GrowthPolicy const *growth_policy, bool reserve ){
+    static AutoString auto_strings[ STRING_COUNT ];
+    static char chunk[ CHUNK_SIZE ];
+    char label[ 128 ];
+
+    unsigned long long state = 88172645463325252ULL;
+    unsigned long long append_count = 0;
+
+    double start = benchmark__now();
+    for( int string_index = 0; string_index < STRING_COUNT; string_index++ ){
+        /* xorshift64 */
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+
+        /* A random power of 2 times a random factor between 1 and 2. */
+        unsigned long long magnitude = MINIMUM_STRING_LENGTH << ( state % 10 );
+        unsigned long long length = magnitude + ( state >> 8 ) % magnitude;
+
+        AutoString *auto_string = &auto_strings[ string_index ];
+        auto_string__initialize( auto_string, allocator, 16 );
+        auto_string->growth_policy = growth_policy;
+        if( reserve ){
+            auto_string__reserve( auto_string, length );
+        }
+
+        while( auto_string->string->length + CHUNK_SIZE <= length ){
+            auto_string__append_elements( auto_string, CHUNK_SIZE, chunk );
+            append_count++;
+        }
+    }
+    double seconds = benchmark__now() - start;
+
+    unsigned long long total_length = 0;
+    unsigned long long total_capacity = 0;
+    for( int string_index = 0; string_index < STRING_COUNT; string_index++ ){
+        total_length += auto_strings[ string_index ].string->length;
+        total_capacity += auto_strings[ string_index ].string->capacity;
+        auto_string__clear( &auto_strings[ string_index ] );
+    }
+
+    snprintf(
+        label,
+        sizeof( label ),
+        "append 100 B / %s (%.1f%% slack)",
+        name,
+        100.0 * (double)( total_capacity - total_length ) / (double) total_capacity
+    );
+    benchmark__report( label, append_count, seconds );
+}
+
+/**
+ *  Copies short tokens, of between 1 and 24 characters, into a String each, as a parser does.
+ */
+static void benchmark__tokens( Allocator *allocator ){
+    static const char text[] = "identifier_with_a_long_name";
+    unsigned long long state = 88172645463325252ULL;
+    unsigned long long total_length = 0;
+
+    double start = benchmark__now();
+    for( unsigned long long token = 0; token < TOKEN_COUNT; token++ ){
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+
+        AutoString auto_string;
+        auto_string__initialize( &auto_string, allocator, 0 );
+        auto_string__append_elements( &auto_string, 1 + state % 24, text );
+        total_length += auto_string.string->length;
+        auto_string__clear( &auto_string );
+    }
+    benchmark__report( "token / AutoString", TOKEN_COUNT, benchmark__now() - start );
+
+    start = benchmark__now();
+    for( unsigned long long token = 0; token < TOKEN_COUNT; token++ ){
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+
+        SmallString small_string;
+        small_string__initialize( &small_string, allocator );
+        small_string__append_elements( &small_string, 1 + state % 24, text );
+        total_length += small_string.length;
+        small_string__clear( &small_string );
+    }
+    benchmark__report( "token / SmallString", TOKEN_COUNT, benchmark__now() - start );
+
+    BENCHMARK__DO_NOT_OPTIMIZE( total_length );
+}
+
+/**
+ *  Searches 1 MB of text for a sequence at its end, through an equality function and bitwise.
+ */
+static void benchmark__index_of( Allocator *allocator ){
+    String text;
+    string__initialize( &text, allocator, SEARCH_TEXT_LENGTH );
+    for( unsigned long long index = 0; index < SEARCH_TEXT_LENGTH; index++ ){
+        text.data[ index ] = 'a' + index % 23;
+    }
+    text.length = SEARCH_TEXT_LENGTH;
+    memcpy( text.data + SEARCH_TEXT_LENGTH - 6, "needle", 6 );
+
+    String sequence = string__literal( "needle" );
+    Array__Char generic_text = { .data = text.data, .length = text.length, .capacity = text.capacity, .element_size = 1 };
+    Array__Char generic_sequence = { .data = sequence.data, .length = sequence.length, .capacity = sequence.capacity, .element_size = 1 };
+
+    unsigned long long found_index = 0;
+    double start = benchmark__now();
+    for( unsigned long long search = 0; search < SEARCH_COUNT; search++ ){
+        array__char__index_of( &generic_text, &generic_sequence, &found_index );
+        BENCHMARK__DO_NOT_OPTIMIZE( found_index );
+    }
+    benchmark__report( "index_of 1 MB / ARRAY__DEFINE", SEARCH_COUNT, benchmark__now() - start );
+
+    start = benchmark__now();
+    for( unsigned long long search = 0; search < SEARCH_COUNT; search++ ){
+        string__index_of( &text, &sequence, &found_index );
+        BENCHMARK__DO_NOT_OPTIMIZE( found_index );
+    }
+    benchmark__report( "index_of 1 MB / string__index_of", SEARCH_COUNT, benchmark__now() - start );
+
+    string__clear( &text, allocator );
+}
+
+int main( void ){
+    SystemAllocator system_allocator;
+    system_allocator__initialize( &system_allocator, NULL );
+
+    static const Array__GrowthPolicy growth_factor__1_5 = {
+        .growth_factor = 1.5,
+        .minimum_capacity = 0,
+        .maximum_growth_bytes = 0
+    };
+    static const Array__GrowthPolicy growth_factor__2__linear_1_mb = {
+        .growth_factor = 2.0,
+        .minimum_capacity = 0,
+        .maximum_growth_bytes = 1024ULL * 1024ULL
+    };
+    static const Array__GrowthPolicy growth_factor__1_5__linear_256_kb = {
+        .growth_factor = 1.5,
+        .minimum_capacity = 0,
+        .maximum_growth_bytes = 256ULL * 1024ULL
+    };
+
+    benchmark__append( "growth factor 2 (default)", system_allocator.allocator, NULL, false );
+    benchmark__append( "growth factor 1.5", system_allocator.allocator, &growth_factor__1_5, false );
+    benchmark__append( "growth factor 2, linear above 1 MB", system_allocator.allocator, &growth_factor__2__linear_1_mb, false );
+    benchmark__append( "growth factor 1.5, linear above 256 KB", system_allocator.allocator, &growth_factor__1_5__linear_256_kb, false );
+    benchmark__append( "reserve", system_allocator.allocator, NULL, true );
+
+    benchmark__tokens( system_allocator.allocator );
+    benchmark__index_of( system_allocator.allocator );
+
+    system_allocator__deinitialize( &system_allocator );
+
+    return 0;
+}
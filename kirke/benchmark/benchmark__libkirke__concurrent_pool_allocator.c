@@ -0,0 +1,177 @@
+// System Includes
+#include <pthread.h>
+#include <sched.h> // sched_yield
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <unistd.h> // sysconf
+
+// Internal Includes
+#include "benchmark.h"
+#include "kirke/concurrent_pool_allocator.h"
+#include "kirke/system_allocator.h"
+#include "kirke/thread_cache_allocator.h"
+
+#define OPERATION_COUNT_PER_THREAD 4000000ULL
+#define LIVE_OBJECT_COUNT 256
+#define OBJECT_SIZE 48
+#define RING_SIZE 1024
+
+/**
+ *  A single-producer, single-consumer ring through which one thread passes objects to another.
+ */
+typedef struct Ring {
+    _Alignas( 64 ) atomic_ullong head;
+    _Alignas( 64 ) atomic_ullong tail;
+    void *objects[ RING_SIZE ];
+} Ring;
+
+typedef struct Worker {
+    Allocator *allocator;
+    unsigned long long seed;
+    Ring *ring;
+} Worker;
+
+/**
+ *  Each worker keeps a window of live objects, replacing one object per operation.
+ */
+static void *worker__run__local( void *worker_pointer ){
+    Worker *worker = (Worker*) worker_pointer;
+    void *objects[ LIVE_OBJECT_COUNT ] = { 0 };
+
+    unsigned long long state = worker->seed;
+    for( unsigned long long operation = 0; operation < OPERATION_COUNT_PER_THREAD; operation++ ){
+        /* xorshift64 */
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+
+        unsigned long long object_index = state % LIVE_OBJECT_COUNT;
+        allocator__free( worker->allocator, objects[ object_index ] );
+        objects[ object_index ] = allocator__alloc( worker->allocator, OBJECT_SIZE );
+        *(char*) objects[ object_index ] = 1;
+    }
+
+    for( unsigned long long object_index = 0; object_index < LIVE_OBJECT_COUNT; object_index++ ){
+        allocator__free( worker->allocator, objects[ object_index ] );
+    }
+
+    return NULL;
+}
+
+/**
+ *  Allocates objects and passes them to the consumer through the worker's ring.
+ */
+static void *worker__run__producer( void *worker_pointer ){
+    Worker *worker = (Worker*) worker_pointer;
+    Ring *ring = worker->ring;
+
+    for( unsigned long long operation = 0; operation < OPERATION_COUNT_PER_THREAD; operation++ ){
+        void *object = allocator__alloc( worker->allocator, OBJECT_SIZE );
+        *(char*) object = 1;
+
+        unsigned long long tail = atomic_load_explicit( &ring->tail, memory_order_relaxed );
+        while( tail - atomic_load_explicit( &ring->head, memory_order_acquire ) == RING_SIZE ){
+            /* The ring is full. */
+            sched_yield();
+        }
+
+        ring->objects[ tail % RING_SIZE ] = object;
+        atomic_store_explicit( &ring->tail, tail + 1, memory_order_release );
+    }
+
+    return NULL;
+}
+
+/**
+ *  Frees the objects passed through the worker's ring.
+ */
+static void *worker__run__consumer( void *worker_pointer ){
+    Worker *worker = (Worker*) worker_pointer;
+    Ring *ring = worker->ring;
+
+    for( unsigned long long operation = 0; operation < OPERATION_COUNT_PER_THREAD; operation++ ){
+        unsigned long long head = atomic_load_explicit( &ring->head, memory_order_relaxed );
+        while( atomic_load_explicit( &ring->tail, memory_order_acquire ) == head ){
+            /* The ring is empty. */
+            sched_yield();
+        }
+
+        allocator__free( worker->allocator, ring->objects[ head % RING_SIZE ] );
+        atomic_store_explicit( &ring->head, head + 1, memory_order_release );
+    }
+
+    return NULL;
+}
+
+/**
+ *  Runs \p thread_count local workers, or \p thread_count / 2 producer and consumer pairs.
+ */
+static void benchmark__threads( const char *name, Allocator *allocator, long thread_count, bool pairs ){
+    static pthread_t threads[ 256 ];
+    static Worker workers[ 256 ];
+    static Ring rings[ 128 ];
+
+    double start = benchmark__now();
+    for( long thread_index = 0; thread_index < thread_count; thread_index++ ){
+        Ring *ring = &rings[ thread_index / 2 ];
+        workers[ thread_index ] = (Worker){ .allocator = allocator, .seed = 0x9E3779B97F4A7C15ULL * ( thread_index + 1 ), .ring = ring };
+
+        void *( *run )( void* ) = worker__run__local;
+        if( pairs ){
+            if( thread_index % 2 == 0 ){
+                atomic_init( &ring->head, 0 );
+                atomic_init( &ring->tail, 0 );
+                run = worker__run__producer;
+            }
+            else{
+                run = worker__run__consumer;
+            }
+        }
+
+        pthread_create( &threads[ thread_index ], NULL, run, &workers[ thread_index ] );
+    }
+
+    for( long thread_index = 0; thread_index < thread_count; thread_index++ ){
+        pthread_join( threads[ thread_index ], NULL );
+    }
+    double seconds = benchmark__now() - start;
+
+    char label[ 128 ];
+    snprintf( label, sizeof( label ), "%s, %2ld threads / %s", pairs ? "producer -> consumer" : "alloc + free", thread_count, name );
+    benchmark__report( label, OPERATION_COUNT_PER_THREAD * thread_count, seconds );
+}
+
+int main( void ){
+    long core_count = sysconf( _SC_NPROCESSORS_ONLN );
+    if( core_count > 256 ){
+        core_count = 256;
+    }
+
+    SystemAllocator system_allocator;
+    system_allocator__initialize( &system_allocator, NULL );
+
+    ThreadCacheAllocator thread_cache_allocator;
+    thread_cache_allocator__initialize( &thread_cache_allocator, system_allocator.allocator );
+
+    ConcurrentPoolAllocator concurrent_pool_allocator;
+    concurrent_pool_allocator__initialize( &concurrent_pool_allocator, system_allocator.allocator, OBJECT_SIZE, 0 );
+
+    for( long thread_count = 1; thread_count <= core_count; thread_count *= 2 ){
+        benchmark__threads( "SystemAllocator", system_allocator.allocator, thread_count, false );
+        benchmark__threads( "ThreadCacheAllocator", thread_cache_allocator.allocator, thread_count, false );
+        benchmark__threads( "ConcurrentPoolAllocator", concurrent_pool_allocator.allocator, thread_count, false );
+    }
+
+    /* At least one pair is always run, even on a single core. */
+    for( long thread_count = 2; thread_count <= core_count || thread_count == 2; thread_count *= 2 ){
+        benchmark__threads( "SystemAllocator", system_allocator.allocator, thread_count, true );
+        benchmark__threads( "ThreadCacheAllocator", thread_cache_allocator.allocator, thread_count, true );
+        benchmark__threads( "ConcurrentPoolAllocator", concurrent_pool_allocator.allocator, thread_count, true );
+    }
+
+    concurrent_pool_allocator__deinitialize( &concurrent_pool_allocator );
+    thread_cache_allocator__deinitialize( &thread_cache_allocator );
+    system_allocator__deinitialize( &system_allocator );
+
+    return 0;
+}
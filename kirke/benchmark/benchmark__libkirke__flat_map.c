@@ -0,0 +1,143 @@
+// Internal Includes
+#include "benchmark.h"
+#include "kirke/flat_map.h"
+#include "kirke/hash_map.h"
+#include "kirke/statistics_allocator.h"
+#include "kirke/system_allocator.h"
+
+#define LOOKUP_COUNT 10000000ULL
+#define ITERATION_PAIR_COUNT 100000000ULL
+
+static bool ints_are_equal( int first, int second ){
+    return first == second;
+}
+
+static bool ints_are_less( int first, int second ){
+    return first < second;
+}
+
+static unsigned long long hash_int( int key ){
+    return (unsigned long long) key * 0x9E3779B97F4A7C15ULL;
+}
+
+HASH_MAP__DECLARE( Benchmark__HashMap, benchmark__hash_map, int, int )
+HASH_MAP__DEFINE( Benchmark__HashMap, benchmark__hash_map, int, int, hash_int, ints_are_equal )
+
+FLAT_MAP__DECLARE( Benchmark__FlatMap, benchmark__flat_map, int, int )
+FLAT_MAP__DEFINE( Benchmark__FlatMap, benchmark__flat_map, int, int, ints_are_less )
+
+static void benchmark__sum( int key, int value, void *user_data ){
+    *(unsigned long long*) user_data += (unsigned long long)( key + value );
+}
+
+/**
+ *  Builds a map of pair_count random keys, with as many buckets for the Hash Map, and measures the memory each map
+ *  holds, random lookups of keys which are present half of the time, and iteration over every pair.
+ */
+static void benchmark__maps( Allocator *allocator, unsigned long long pair_count ){
+    char label[ 128 ];
+
+    Benchmark__FlatMap__KeyValuePair *pairs = (Benchmark__FlatMap__KeyValuePair*) allocator__alloc(
+        allocator,
+        pair_count * sizeof( Benchmark__FlatMap__KeyValuePair )
+    );
+    unsigned long long state = 88172645463325252ULL;
+    for( unsigned long long index = 0; index < pair_count; index++ ){
+        /* xorshift64 */
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        pairs[ index ] = (Benchmark__FlatMap__KeyValuePair){ .key = (int)( state & 0x7FFFFFFE ), .value = (int) index };
+    }
+
+    StatisticsAllocator hash_map_statistics;
+    statistics_allocator__initialize( &hash_map_statistics, allocator );
+    Benchmark__HashMap hash_map;
+    double start = benchmark__now();
+    benchmark__hash_map__initialize( &hash_map, hash_map_statistics.allocator, pair_count );
+    for( unsigned long long index = 0; index < pair_count; index++ ){
+        benchmark__hash_map__insert( &hash_map, pairs[ index ].key, pairs[ index ].value );
+    }
+    snprintf( label, sizeof( label ), "build %llu pairs / HashMap insert", pair_count );
+    benchmark__report( label, pair_count, benchmark__now() - start );
+
+    StatisticsAllocator flat_map_statistics;
+    statistics_allocator__initialize( &flat_map_statistics, allocator );
+    Benchmark__FlatMap flat_map;
+    start = benchmark__now();
+    benchmark__flat_map__initialize__pairs( &flat_map, flat_map_statistics.allocator, pair_count, pairs );
+    snprintf( label, sizeof( label ), "build %llu pairs / FlatMap initialize__pairs", pair_count );
+    benchmark__report( label, pair_count, benchmark__now() - start );
+
+    StatisticsAllocator__Snapshot hash_map_snapshot;
+    StatisticsAllocator__Snapshot flat_map_snapshot;
+    statistics_allocator__snapshot( &hash_map_statistics, &hash_map_snapshot );
+    statistics_allocator__snapshot( &flat_map_statistics, &flat_map_snapshot );
+    printf(
+        "%-64s %12.1f bytes/pair HashMap %8.1f bytes/pair FlatMap\n",
+        "",
+        (double) hash_map_snapshot.live_bytes / (double) pair_count,
+        (double) flat_map_snapshot.live_bytes / (double) pair_count
+    );
+
+    /* Odd keys are never present, since every inserted key is even. */
+    unsigned long long found_count = 0;
+    start = benchmark__now();
+    for( unsigned long long lookup = 0; lookup < LOOKUP_COUNT; lookup++ ){
+        int value;
+        int key = pairs[ ( lookup * 7919 ) % pair_count ].key + (int)( lookup & 1 );
+        found_count += benchmark__hash_map__retrieve( &hash_map, key, &value ) ? 1 : 0;
+    }
+    snprintf( label, sizeof( label ), "retrieve from %llu pairs / HashMap", pair_count );
+    benchmark__report( label, LOOKUP_COUNT, benchmark__now() - start );
+    BENCHMARK__DO_NOT_OPTIMIZE( found_count );
+
+    found_count = 0;
+    start = benchmark__now();
+    for( unsigned long long lookup = 0; lookup < LOOKUP_COUNT; lookup++ ){
+        int value;
+        int key = pairs[ ( lookup * 7919 ) % pair_count ].key + (int)( lookup & 1 );
+        found_count += benchmark__flat_map__retrieve( &flat_map, key, &value ) ? 1 : 0;
+    }
+    snprintf( label, sizeof( label ), "retrieve from %llu pairs / FlatMap", pair_count );
+    benchmark__report( label, LOOKUP_COUNT, benchmark__now() - start );
+    BENCHMARK__DO_NOT_OPTIMIZE( found_count );
+
+    unsigned long long pass_count = ITERATION_PAIR_COUNT / pair_count;
+    unsigned long long sum = 0;
+    start = benchmark__now();
+    for( unsigned long long pass = 0; pass < pass_count; pass++ ){
+        benchmark__hash_map__for_each( &hash_map, benchmark__sum, &sum );
+    }
+    snprintf( label, sizeof( label ), "for_each over %llu pairs / HashMap", pair_count );
+    benchmark__report( label, pass_count * pair_count, benchmark__now() - start );
+    BENCHMARK__DO_NOT_OPTIMIZE( sum );
+
+    sum = 0;
+    start = benchmark__now();
+    for( unsigned long long pass = 0; pass < pass_count; pass++ ){
+        benchmark__flat_map__for_each( &flat_map, benchmark__sum, &sum );
+    }
+    snprintf( label, sizeof( label ), "for_each over %llu pairs / FlatMap", pair_count );
+    benchmark__report( label, pass_count * pair_count, benchmark__now() - start );
+    BENCHMARK__DO_NOT_OPTIMIZE( sum );
+
+    benchmark__hash_map__clear( &hash_map );
+    benchmark__flat_map__clear( &flat_map );
+    statistics_allocator__deinitialize( &hash_map_statistics );
+    statistics_allocator__deinitialize( &flat_map_statistics );
+    allocator__free( allocator, pairs );
+}
+
+int main( void ){
+    SystemAllocator system_allocator;
+    system_allocator__initialize( &system_allocator, NULL );
+
+    benchmark__maps( system_allocator.allocator, 100 );
+    benchmark__maps( system_allocator.allocator, 10000 );
+    benchmark__maps( system_allocator.allocator, 1000000 );
+
+    system_allocator__deinitialize( &system_allocator );
+
+    return 0;
+}
@@ -0,0 +1,109 @@
+// Internal Includes
+#include "benchmark.h"
+#include "kirke/array.h"
+#include "kirke/hash_map.h"
+#include "kirke/malloc_allocator.h"
+#include "kirke/system_allocator.h"
+
+#define SMALL_ARRAY_COUNT 1000000
+#define SMALL_ARRAY_LENGTH 16
+#define SMALL_ARRAY_ELEMENT_COUNT ( (unsigned long long) SMALL_ARRAY_COUNT * SMALL_ARRAY_LENGTH )
+#define HASH_MAP_KEY_COUNT 1000000
+
+typedef unsigned long long Key;
+
+static bool keys_are_equal( Key first, Key second ){
+    return first == second;
+}
+
+static unsigned long long hash_key( Key key ){
+    return key * 0x9E3779B97F4A7C15ULL;
+}
+
+/* Each container is instantiated twice: once through the Allocator vtable, and once bound to malloc at compile time. */
+ARRAY__DECLARE( Array__Key, array__key, Key )
+ARRAY__DEFINE( Array__Key, array__key, Key, keys_are_equal )
+
+ARRAY__DECLARE( StaticArray__Key, static_array__key, Key )
+ARRAY__DEFINE__ALLOCATOR( StaticArray__Key, static_array__key, Key, keys_are_equal, malloc_allocator )
+
+HASH_MAP__DECLARE( HashMap__KeyToKey, hash_map__key_to_key, Key, Key )
+HASH_MAP__DEFINE( HashMap__KeyToKey, hash_map__key_to_key, Key, Key, hash_key, keys_are_equal )
+
+HASH_MAP__DECLARE( StaticHashMap__KeyToKey, static_hash_map__key_to_key, Key, Key )
+HASH_MAP__DEFINE__ALLOCATOR( StaticHashMap__KeyToKey, static_hash_map__key_to_key, Key, Key, hash_key, keys_are_equal, malloc_allocator )
+
+/**
+ *  Builds many short-lived arrays of a few elements each, so that allocation dominates the cost of each append.
+ */
+#define BENCHMARK__SMALL_ARRAYS( NAME, TYPENAME, TYPENAME_LOWERCASE, ALLOCATOR )                                    \
+    do{                                                                                                             \
+        char label[ 128 ];                                                                                          \
+        Key checksum = 0;                                                                                           \
+                                                                                                                    \
+        double start = benchmark__now();                                                                            \
+        for( unsigned long long array_index = 0; array_index < SMALL_ARRAY_COUNT; array_index++ ){                  \
+            Auto ## TYPENAME auto_array;                                                                            \
+            auto_ ## TYPENAME_LOWERCASE ## __initialize( &auto_array, ALLOCATOR, 1 );                               \
+            for( Key element = 0; element < SMALL_ARRAY_LENGTH; element++ ){                                        \
+                auto_ ## TYPENAME_LOWERCASE ## __append_element( &auto_array, element );                            \
+            }                                                                                                       \
+            checksum += auto_array.TYPENAME_LOWERCASE->data[ array_index % SMALL_ARRAY_LENGTH ];                    \
+            auto_ ## TYPENAME_LOWERCASE ## __clear( &auto_array );                                                  \
+        }                                                                                                           \
+        snprintf( label, sizeof( label ), "auto_array__append_element / %s", NAME );                                \
+        benchmark__report( label, SMALL_ARRAY_ELEMENT_COUNT, benchmark__now() - start );                            \
+                                                                                                                    \
+        start = benchmark__now();                                                                                   \
+        for( unsigned long long array_index = 0; array_index < SMALL_ARRAY_COUNT; array_index++ ){                  \
+            Auto ## TYPENAME auto_array;                                                                            \
+            auto_ ## TYPENAME_LOWERCASE ## __initialize( &auto_array, ALLOCATOR, 1 );                               \
+            for( Key element = 0; element < SMALL_ARRAY_LENGTH; element++ ){                                        \
+                auto_ ## TYPENAME_LOWERCASE ## __insert_element( &auto_array, element / 2, element );               \
+            }                                                                                                       \
+            checksum += auto_array.TYPENAME_LOWERCASE->data[ array_index % SMALL_ARRAY_LENGTH ];                    \
+            auto_ ## TYPENAME_LOWERCASE ## __clear( &auto_array );                                                  \
+        }                                                                                                           \
+        snprintf( label, sizeof( label ), "auto_array__insert_element / %s", NAME );                                \
+        benchmark__report( label, SMALL_ARRAY_ELEMENT_COUNT, benchmark__now() - start );                            \
+                                                                                                                    \
+        BENCHMARK__DO_NOT_OPTIMIZE( checksum );                                                                     \
+    } while( 0 )
+
+/**
+ *  Inserts distinct keys into a hash map, each of which allocates a list link.
+ */
+#define BENCHMARK__HASH_MAP( NAME, TYPENAME, METHOD_PREFIX, ALLOCATOR )                                             \
+    do{                                                                                                             \
+        char label[ 128 ];                                                                                          \
+        TYPENAME hash_map;                                                                                          \
+        METHOD_PREFIX ## __initialize( &hash_map, ALLOCATOR, HASH_MAP_KEY_COUNT );                                  \
+                                                                                                                    \
+        double start = benchmark__now();                                                                            \
+        for( Key key = 0; key < HASH_MAP_KEY_COUNT; key++ ){                                                        \
+            METHOD_PREFIX ## __insert( &hash_map, key, key );                                                       \
+        }                                                                                                           \
+        snprintf( label, sizeof( label ), "hash_map__insert / %s", NAME );                                          \
+        benchmark__report( label, HASH_MAP_KEY_COUNT, benchmark__now() - start );                                   \
+                                                                                                                    \
+        Key value = 0;                                                                                              \
+        METHOD_PREFIX ## __retrieve( &hash_map, HASH_MAP_KEY_COUNT / 2, &value );                                   \
+        BENCHMARK__DO_NOT_OPTIMIZE( value );                                                                        \
+        METHOD_PREFIX ## __clear( &hash_map );                                                                      \
+    } while( 0 )
+
+int main( void ){
+    /* Both variants end up in malloc, so the difference is the cost of calling through the Allocator. */
+    SystemAllocator system_allocator;
+    system_allocator__initialize__options( &system_allocator, NULL, NULL );
+
+    BENCHMARK__SMALL_ARRAYS( "runtime allocator", Array__Key, array__key, system_allocator.allocator );
+    BENCHMARK__SMALL_ARRAYS( "malloc_allocator", StaticArray__Key, static_array__key, NULL );
+
+    BENCHMARK__HASH_MAP( "runtime allocator", HashMap__KeyToKey, hash_map__key_to_key, system_allocator.allocator );
+    BENCHMARK__HASH_MAP( "malloc_allocator", StaticHashMap__KeyToKey, static_hash_map__key_to_key, NULL );
+
+    system_allocator__deinitialize( &system_allocator );
+
+    return 0;
+}
@@ -0,0 +1,342 @@
+// System Includes
+#include <stdlib.h> // atol, qsort
+#include <string.h> // memcpy
+#include <unistd.h> // sysconf
+
+// Internal Includes
+#include "benchmark.h"
+#include "kirke/array.h"
+#include "kirke/ordered_array.h"
+#include "kirke/system_allocator.h"
+
+#define SORT_LENGTH 10000000ULL
+#define PARALLEL_SORT_LENGTH 100000000ULL
+#define SEARCH_COUNT 10000000ULL
+#define LINEAR_SEARCH_COUNT 10ULL
+
+typedef struct Benchmark__Record{
+    int key;
+    unsigned int payload[ 3 ];
+} Benchmark__Record;
+
+static bool ints_are_less( int first, int second ){
+    return first < second;
+}
+
+static unsigned long long int__key( int value ){
+    return ( (unsigned long long) value ) ^ ( 1ULL << 63 );
+}
+
+static int ints__compare( void const *first, void const *second ){
+    int first_int = *(int const*) first;
+    int second_int = *(int const*) second;
+    return ( first_int > second_int ) - ( first_int < second_int );
+}
+
+static bool records_are_less( Benchmark__Record first, Benchmark__Record second ){
+    return first.key < second.key;
+}
+
+static unsigned long long record__key( Benchmark__Record record ){
+    return int__key( record.key );
+}
+
+static int records__compare( void const *first, void const *second ){
+    return ints__compare( &( (Benchmark__Record const*) first )->key, &( (Benchmark__Record const*) second )->key );
+}
+
+ARRAY__DECLARE( Benchmark__Array, benchmark__array, int )
+ARRAY__DEFINE_POD( Benchmark__Array, benchmark__array, int )
+ORDERED_ARRAY__DECLARE( Benchmark__Array, benchmark__array, int )
+ORDERED_ARRAY__DEFINE( Benchmark__Array, benchmark__array, int, ints_are_less )
+ORDERED_ARRAY__DECLARE_RADIX_SORT( Benchmark__Array, benchmark__array, int )
+ORDERED_ARRAY__DEFINE_RADIX_SORT( Benchmark__Array, benchmark__array, int, int__key )
+ORDERED_ARRAY__DECLARE_PARALLEL_SORT( Benchmark__Array, benchmark__array, int )
+ORDERED_ARRAY__DEFINE_PARALLEL_SORT( Benchmark__Array, benchmark__array, int, ints_are_less )
+ORDERED_ARRAY__DECLARE_EYTZINGER( Benchmark__Array, benchmark__array, int )
+ORDERED_ARRAY__DEFINE_EYTZINGER( Benchmark__Array, benchmark__array, int, ints_are_less )
+
+ARRAY__DECLARE( Benchmark__RecordArray, benchmark__record_array, Benchmark__Record )
+ARRAY__DEFINE_POD( Benchmark__RecordArray, benchmark__record_array, Benchmark__Record )
+ORDERED_ARRAY__DECLARE( Benchmark__RecordArray, benchmark__record_array, Benchmark__Record )
+ORDERED_ARRAY__DEFINE( Benchmark__RecordArray, benchmark__record_array, Benchmark__Record, records_are_less )
+ORDERED_ARRAY__DECLARE_RADIX_SORT( Benchmark__RecordArray, benchmark__record_array, Benchmark__Record )
+ORDERED_ARRAY__DEFINE_RADIX_SORT( Benchmark__RecordArray, benchmark__record_array, Benchmark__Record, record__key )
+
+/**
+ *  Sorts 10M random ints, and then 10M ints which are already sorted but for a few swaps, with qsort and with each
+ *  sort of an Ordered Array, whose comparisons are inlined rather than called through a function pointer.
+ */
+static void benchmark__sort__ints( Allocator *allocator, bool nearly_sorted ){
+    char label[ 128 ];
+    char const *input = nearly_sorted ? "nearly sorted" : "random";
+
+    Benchmark__Array original;
+    Benchmark__Array array;
+    benchmark__array__initialize( &original, allocator, SORT_LENGTH );
+    benchmark__array__initialize( &array, allocator, SORT_LENGTH );
+    original.length = SORT_LENGTH;
+    array.length = SORT_LENGTH;
+
+    unsigned long long state = 88172645463325252ULL;
+    for( unsigned long long index = 0; index < SORT_LENGTH; index++ ){
+        /* xorshift64 */
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        original.data[ index ] = nearly_sorted ? (int) index : (int) state;
+    }
+    for( unsigned long long swap = 0; nearly_sorted && swap < 100; swap++ ){
+        int *first = &original.data[ ( swap * 7919ULL * 7919ULL ) % SORT_LENGTH ];
+        int *second = &original.data[ ( swap * 104729ULL * 104729ULL ) % SORT_LENGTH ];
+        int element = *first;
+        *first = *second;
+        *second = element;
+    }
+
+    memcpy( array.data, original.data, SORT_LENGTH * sizeof( int ) );
+    double start = benchmark__now();
+    qsort( array.data, SORT_LENGTH, sizeof( int ), ints__compare );
+    snprintf( label, sizeof( label ), "sort 10M %s ints / qsort", input );
+    benchmark__report( label, SORT_LENGTH, benchmark__now() - start );
+    BENCHMARK__DO_NOT_OPTIMIZE( array.data[ 0 ] );
+
+    memcpy( array.data, original.data, SORT_LENGTH * sizeof( int ) );
+    start = benchmark__now();
+    benchmark__array__sort( &array );
+    snprintf( label, sizeof( label ), "sort 10M %s ints / array__sort", input );
+    benchmark__report( label, SORT_LENGTH, benchmark__now() - start );
+    BENCHMARK__DO_NOT_OPTIMIZE( array.data[ 0 ] );
+
+    memcpy( array.data, original.data, SORT_LENGTH * sizeof( int ) );
+    start = benchmark__now();
+    benchmark__array__sort__stable( &array, allocator );
+    snprintf( label, sizeof( label ), "sort 10M %s ints / array__sort__stable", input );
+    benchmark__report( label, SORT_LENGTH, benchmark__now() - start );
+    BENCHMARK__DO_NOT_OPTIMIZE( array.data[ 0 ] );
+
+    memcpy( array.data, original.data, SORT_LENGTH * sizeof( int ) );
+    start = benchmark__now();
+    benchmark__array__sort__radix( &array, allocator );
+    snprintf( label, sizeof( label ), "sort 10M %s ints / array__sort__radix", input );
+    benchmark__report( label, SORT_LENGTH, benchmark__now() - start );
+    BENCHMARK__DO_NOT_OPTIMIZE( array.data[ 0 ] );
+
+    benchmark__array__clear( &original, allocator );
+    benchmark__array__clear( &array, allocator );
+}
+
+/**
+ *  Sorts 10M random 16 byte records by an int key.
+ */
+static void benchmark__sort__records( Allocator *allocator ){
+    Benchmark__RecordArray original;
+    Benchmark__RecordArray array;
+    benchmark__record_array__initialize( &original, allocator, SORT_LENGTH );
+    benchmark__record_array__initialize( &array, allocator, SORT_LENGTH );
+    original.length = SORT_LENGTH;
+    array.length = SORT_LENGTH;
+
+    unsigned long long state = 88172645463325252ULL;
+    for( unsigned long long index = 0; index < SORT_LENGTH; index++ ){
+        /* xorshift64 */
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        original.data[ index ] = (Benchmark__Record){ .key = (int) state, .payload = { (unsigned int) index, 0, 0 } };
+    }
+
+    unsigned long long const size = SORT_LENGTH * sizeof( Benchmark__Record );
+
+    memcpy( array.data, original.data, size );
+    double start = benchmark__now();
+    qsort( array.data, SORT_LENGTH, sizeof( Benchmark__Record ), records__compare );
+    benchmark__report( "sort 10M random records / qsort", SORT_LENGTH, benchmark__now() - start );
+    BENCHMARK__DO_NOT_OPTIMIZE( array.data[ 0 ].key );
+
+    memcpy( array.data, original.data, size );
+    start = benchmark__now();
+    benchmark__record_array__sort( &array );
+    benchmark__report( "sort 10M random records / array__sort", SORT_LENGTH, benchmark__now() - start );
+    BENCHMARK__DO_NOT_OPTIMIZE( array.data[ 0 ].key );
+
+    memcpy( array.data, original.data, size );
+    start = benchmark__now();
+    benchmark__record_array__sort__stable( &array, allocator );
+    benchmark__report( "sort 10M random records / array__sort__stable", SORT_LENGTH, benchmark__now() - start );
+    BENCHMARK__DO_NOT_OPTIMIZE( array.data[ 0 ].key );
+
+    memcpy( array.data, original.data, size );
+    start = benchmark__now();
+    benchmark__record_array__sort__radix( &array, allocator );
+    benchmark__report( "sort 10M random records / array__sort__radix", SORT_LENGTH, benchmark__now() - start );
+    BENCHMARK__DO_NOT_OPTIMIZE( array.data[ 0 ].key );
+
+    benchmark__record_array__clear( &original, allocator );
+    benchmark__record_array__clear( &array, allocator );
+}
+
+/**
+ *  Sorts 100M random ints with array__sort__parallel, doubling the number of threads from 1 up to maximum_thread_count,
+ *  and then with maximum_thread_count threads.
+ */
+static void benchmark__sort__parallel( Allocator *allocator, long maximum_thread_count ){
+    char label[ 128 ];
+
+    Benchmark__Array original;
+    Benchmark__Array array;
+    benchmark__array__initialize( &original, allocator, PARALLEL_SORT_LENGTH );
+    benchmark__array__initialize( &array, allocator, PARALLEL_SORT_LENGTH );
+    original.length = PARALLEL_SORT_LENGTH;
+    array.length = PARALLEL_SORT_LENGTH;
+
+    unsigned long long state = 88172645463325252ULL;
+    for( unsigned long long index = 0; index < PARALLEL_SORT_LENGTH; index++ ){
+        /* xorshift64 */
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        original.data[ index ] = (int) state;
+    }
+
+    double single_thread_seconds = 0.0;
+    long thread_count = 1;
+    while( true ){
+        memcpy( array.data, original.data, PARALLEL_SORT_LENGTH * sizeof( int ) );
+        double start = benchmark__now();
+        benchmark__array__sort__parallel( &array, allocator, (unsigned int) thread_count );
+        double seconds = benchmark__now() - start;
+        BENCHMARK__DO_NOT_OPTIMIZE( array.data[ 0 ] );
+
+        if( thread_count == 1 ){
+            single_thread_seconds = seconds;
+        }
+        snprintf( label, sizeof( label ), "sort 100M random ints / array__sort__parallel, %ld threads", thread_count );
+        benchmark__report( label, PARALLEL_SORT_LENGTH, seconds );
+        printf( "%-64s %12.2fx speedup\n", "", single_thread_seconds / seconds );
+
+        if( thread_count >= maximum_thread_count ){
+            break;
+        }
+        thread_count = thread_count * 2 < maximum_thread_count ? thread_count * 2 : maximum_thread_count;
+    }
+
+    benchmark__array__clear( &original, allocator );
+    benchmark__array__clear( &array, allocator );
+}
+
+/**
+ *  Searches a sorted array of length distinct ints for random elements, which are present half of the time, with
+ *  array__index_of, with the binary search of array__lower_bound, and with an Eytzinger table. The linear search of
+ *  array__index_of is only run LINEAR_SEARCH_COUNT times.
+ */
+static void benchmark__search( Allocator *allocator, unsigned long long length ){
+    char label[ 128 ];
+
+    /* Even elements, so that adding 1 gives an element which is not present. */
+    Benchmark__Array array;
+    benchmark__array__initialize( &array, allocator, length );
+    array.length = length;
+    for( unsigned long long index = 0; index < length; index++ ){
+        array.data[ index ] = (int)( 2 * index );
+    }
+
+    Benchmark__Array__Eytzinger eytzinger;
+    double start = benchmark__now();
+    benchmark__array__eytzinger__initialize( &eytzinger, &array, allocator );
+    snprintf( label, sizeof( label ), "build %lluM element Eytzinger table", length / 1000000 );
+    benchmark__report( label, length, benchmark__now() - start );
+
+    unsigned long long state = 88172645463325252ULL;
+    unsigned long long found_count = 0;
+    start = benchmark__now();
+    for( unsigned long long search = 0; search < LINEAR_SEARCH_COUNT; search++ ){
+        /* xorshift64 */
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        int element = (int)( 2 * ( state % length ) + ( state >> 63 ) );
+        Benchmark__Array sequence = { .data = &element, .length = 1, .capacity = 1, .element_size = sizeof( int ) };
+        unsigned long long index;
+        found_count += benchmark__array__index_of( &array, &sequence, &index ) ? 1 : 0;
+    }
+    snprintf( label, sizeof( label ), "search %lluM ints / array__index_of", length / 1000000 );
+    benchmark__report( label, LINEAR_SEARCH_COUNT, benchmark__now() - start );
+    BENCHMARK__DO_NOT_OPTIMIZE( found_count );
+
+    state = 88172645463325252ULL;
+    unsigned long long rank_sum = 0;
+    start = benchmark__now();
+    for( unsigned long long search = 0; search < SEARCH_COUNT; search++ ){
+        /* xorshift64 */
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        int element = (int)( 2 * ( state % length ) + ( state >> 63 ) );
+        rank_sum += benchmark__array__lower_bound( &array, element );
+    }
+    snprintf( label, sizeof( label ), "search %lluM ints / array__lower_bound", length / 1000000 );
+    benchmark__report( label, SEARCH_COUNT, benchmark__now() - start );
+    BENCHMARK__DO_NOT_OPTIMIZE( rank_sum );
+
+    state = 88172645463325252ULL;
+    unsigned long long eytzinger_rank_sum = 0;
+    start = benchmark__now();
+    for( unsigned long long search = 0; search < SEARCH_COUNT; search++ ){
+        /* xorshift64 */
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        int element = (int)( 2 * ( state % length ) + ( state >> 63 ) );
+        eytzinger_rank_sum += benchmark__array__eytzinger__rank( &eytzinger, element );
+    }
+    snprintf( label, sizeof( label ), "search %lluM ints / array__eytzinger__rank", length / 1000000 );
+    benchmark__report( label, SEARCH_COUNT, benchmark__now() - start );
+    BENCHMARK__DO_NOT_OPTIMIZE( eytzinger_rank_sum );
+
+    state = 88172645463325252ULL;
+    unsigned long long index_sum = 0;
+    start = benchmark__now();
+    for( unsigned long long search = 0; search < SEARCH_COUNT; search++ ){
+        /* xorshift64 */
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        int element = (int)( 2 * ( state % length ) + ( state >> 63 ) );
+        unsigned long long index;
+        benchmark__array__eytzinger__lower_bound( &eytzinger, element, &index );
+        index_sum += index;
+    }
+    snprintf( label, sizeof( label ), "search %lluM ints / array__eytzinger__lower_bound", length / 1000000 );
+    benchmark__report( label, SEARCH_COUNT, benchmark__now() - start );
+    BENCHMARK__DO_NOT_OPTIMIZE( index_sum );
+
+    if( rank_sum != eytzinger_rank_sum ){
+        printf( "array__eytzinger__rank disagrees with array__lower_bound\n" );
+    }
+
+    benchmark__array__eytzinger__clear( &eytzinger, allocator );
+    benchmark__array__clear( &array, allocator );
+}
+
+/**
+ *  Usage: benchmark__libkirke__ordered_array [maximum thread count]
+ *  The parallel sort is measured with up to the given number of threads, or else with up to one thread per core.
+ */
+int main( int argument_count, char **arguments ){
+    SystemAllocator system_allocator;
+    system_allocator__initialize( &system_allocator, NULL );
+
+    benchmark__sort__ints( system_allocator.allocator, false );
+    benchmark__sort__ints( system_allocator.allocator, true );
+    benchmark__sort__records( system_allocator.allocator );
+    benchmark__search( system_allocator.allocator, 1000000 );
+    benchmark__search( system_allocator.allocator, 10000000 );
+    benchmark__search( system_allocator.allocator, 100000000 );
+    long maximum_thread_count = argument_count > 1 ? atol( arguments[ 1 ] ) : sysconf( _SC_NPROCESSORS_ONLN );
+    benchmark__sort__parallel( system_allocator.allocator, maximum_thread_count );
+
+    system_allocator__deinitialize( &system_allocator );
+
+    return 0;
+}
@@ -0,0 +1,137 @@
+// System Includes
+#include <stdlib.h> // rand, srand
+
+// Internal Includes
+#include "benchmark.h"
+#include "kirke/hash_map.h"
+#include "kirke/list.h"
+#include "kirke/pool_allocator.h"
+#include "kirke/system_allocator.h"
+
+#define LIST_LENGTH 1000000
+#define TRAVERSAL_COUNT 20
+#define HASH_MAP_KEY_COUNT 100000
+#define HASH_MAP_ROUND_COUNT 20
+
+typedef unsigned long long Key;
+
+static bool keys_are_equal( Key first, Key second ){
+    return first == second;
+}
+
+LIST__DECLARE( List__Key, list__key, Key )
+LIST__DEFINE( List__Key, list__key, Key, keys_are_equal )
+
+HASH_MAP__DECLARE( HashMap__KeyToKey, hash_map__key_to_key, Key, Key )
+HASH_MAP__DEFINE_DEFAULT_HASH_FUNCTION( hash_map__key_to_key, Key )
+HASH_MAP__DEFINE(
+    HashMap__KeyToKey,
+    hash_map__key_to_key,
+    Key,
+    Key,
+    HASH_MAP__DEFAULT_HASH_FUNCTION( hash_map__key_to_key, Key ),
+    keys_are_equal
+)
+
+static void sum_values( Key *value, void *user_data ){
+    *(Key*) user_data += *value;
+}
+
+/**
+ *  Builds a long list, interleaving each link allocation with short-lived allocations of other sizes, as a
+ *  long-running program would. With the system allocator this scatters links across the heap.
+ */
+static List__Key *build_list( Allocator *list_allocator, Allocator *other_allocator ){
+    void *scratch[ 8 ] = { 0 };
+
+    List__Key *list;
+    list__key__initialize( &list, list_allocator, 0 );
+
+    for( Key value = 1; value < LIST_LENGTH; value++ ){
+        unsigned long long scratch_index = value % ELEMENT_COUNT( scratch );
+        allocator__free( other_allocator, scratch[ scratch_index ] );
+        scratch[ scratch_index ] = allocator__alloc( other_allocator, 16 + rand() % 256 );
+
+        list = list__key__prepend( list, list_allocator, value );
+    }
+
+    for( unsigned long long scratch_index = 0; scratch_index < ELEMENT_COUNT( scratch ); scratch_index++ ){
+        allocator__free( other_allocator, scratch[ scratch_index ] );
+    }
+
+    return list;
+}
+
+static void benchmark__list( const char *name, Allocator *list_allocator, Allocator *other_allocator ){
+    char label[ 128 ];
+
+    srand( 42 );
+    double start = benchmark__now();
+    List__Key *list = build_list( list_allocator, other_allocator );
+    snprintf( label, sizeof( label ), "list__prepend / %s", name );
+    benchmark__report( label, LIST_LENGTH, benchmark__now() - start );
+
+    Key sum = 0;
+    start = benchmark__now();
+    for( int traversal = 0; traversal < TRAVERSAL_COUNT; traversal++ ){
+        list__key__for_each( list, sum_values, &sum );
+    }
+    snprintf( label, sizeof( label ), "list__for_each / %s", name );
+    benchmark__report( label, (unsigned long long) TRAVERSAL_COUNT * LIST_LENGTH, benchmark__now() - start );
+    BENCHMARK__DO_NOT_OPTIMIZE( sum );
+
+    List__Key *link = NULL;
+    start = benchmark__now();
+    for( int traversal = 0; traversal < TRAVERSAL_COUNT; traversal++ ){
+        list__key__where( list, LIST_LENGTH, &link );
+    }
+    snprintf( label, sizeof( label ), "list__where (absent value) / %s", name );
+    benchmark__report( label, (unsigned long long) TRAVERSAL_COUNT * LIST_LENGTH, benchmark__now() - start );
+    BENCHMARK__DO_NOT_OPTIMIZE( link );
+
+    list__key__clear( list, list_allocator );
+}
+
+static void benchmark__hash_map( const char *name, Allocator *allocator ){
+    char label[ 128 ];
+
+    HashMap__KeyToKey hash_map;
+    hash_map__key_to_key__initialize( &hash_map, allocator, HASH_MAP_KEY_COUNT / 4 );
+
+    double start = benchmark__now();
+    for( int round = 0; round < HASH_MAP_ROUND_COUNT; round++ ){
+        for( Key key = 0; key < HASH_MAP_KEY_COUNT; key++ ){
+            hash_map__key_to_key__insert( &hash_map, key * 7919, key );
+        }
+
+        for( Key key = 0; key < HASH_MAP_KEY_COUNT; key++ ){
+            hash_map__key_to_key__delete( &hash_map, key * 7919 );
+        }
+    }
+    snprintf( label, sizeof( label ), "hash_map__insert + hash_map__delete / %s", name );
+    benchmark__report( label, 2ULL * HASH_MAP_ROUND_COUNT * HASH_MAP_KEY_COUNT, benchmark__now() - start );
+
+    hash_map__key_to_key__clear( &hash_map );
+}
+
+int main( void ){
+    SystemAllocator system_allocator;
+    system_allocator__initialize( &system_allocator, NULL );
+
+    benchmark__list( "SystemAllocator", system_allocator.allocator, system_allocator.allocator );
+
+    PoolAllocator pool_allocator;
+    pool_allocator__initialize( &pool_allocator, system_allocator.allocator, sizeof( List__Key ), 0 );
+    benchmark__list( "PoolAllocator", pool_allocator.allocator, system_allocator.allocator );
+    pool_allocator__deinitialize( &pool_allocator );
+
+    benchmark__hash_map( "SystemAllocator", system_allocator.allocator );
+
+    pool_allocator__initialize( &pool_allocator, system_allocator.allocator, sizeof( HashMap__KeyToKey__List__KeyValuePair ), 0 );
+    benchmark__hash_map( "PoolAllocator", pool_allocator.allocator );
+    pool_allocator__deinitialize( &pool_allocator );
+
+    system_allocator__deinitialize( &system_allocator );
+
+    return 0;
+}
@@ -0,0 +1,57 @@
+// Internal Includes
+#include "benchmark.h"
+#include "kirke/sampling_allocator.h"
+#include "kirke/system_allocator.h"
+
+#define OPERATION_COUNT 10000000ULL
+#define LIVE_OBJECT_COUNT 256
+
+/**
+ *  Keeps a window of live objects of random small sizes, replacing one object per operation.
+ */
+static void benchmark__churn( const char *name, Allocator *allocator ){
+    char label[ 128 ];
+    void *objects[ LIVE_OBJECT_COUNT ] = { 0 };
+
+    unsigned long long state = 88172645463325252ULL;
+    double start = benchmark__now();
+    for( unsigned long long operation = 0; operation < OPERATION_COUNT; operation++ ){
+        /* xorshift64 */
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+
+        unsigned long long object_index = state % LIVE_OBJECT_COUNT;
+        allocator__free( allocator, objects[ object_index ] );
+        objects[ object_index ] = allocator__alloc( allocator, 8 + ( state >> 32 ) % 504 );
+        *(char*) objects[ object_index ] = 1;
+    }
+    snprintf( label, sizeof( label ), "alloc + free / %s", name );
+    benchmark__report( label, OPERATION_COUNT, benchmark__now() - start );
+
+    for( unsigned long long object_index = 0; object_index < LIVE_OBJECT_COUNT; object_index++ ){
+        allocator__free( allocator, objects[ object_index ] );
+    }
+}
+
+int main( void ){
+    SystemAllocator system_allocator;
+    system_allocator__initialize( &system_allocator, NULL );
+
+    benchmark__churn( "SystemAllocator", system_allocator.allocator );
+
+    unsigned long long sample_intervals[] = { SAMPLING_ALLOCATOR__DEFAULT_SAMPLE_INTERVAL, 64 * 1024, 4 * 1024 };
+    for( unsigned long long interval_index = 0; interval_index < ELEMENT_COUNT( sample_intervals ); interval_index++ ){
+        char name[ 128 ];
+        snprintf( name, sizeof( name ), "SamplingAllocator, 1 sample per %llu bytes", sample_intervals[ interval_index ] );
+
+        SamplingAllocator sampling_allocator;
+        sampling_allocator__initialize( &sampling_allocator, system_allocator.allocator, sample_intervals[ interval_index ] );
+        benchmark__churn( name, sampling_allocator.allocator );
+        sampling_allocator__deinitialize( &sampling_allocator );
+    }
+
+    system_allocator__deinitialize( &system_allocator );
+
+    return 0;
+}
@@ -0,0 +1,72 @@
+// Internal Includes
+#include "benchmark.h"
+#include "kirke/statistics_allocator.h"
+#include "kirke/string.h"
+#include "kirke/system_allocator.h"
+#include "kirke/thread_cache_allocator.h"
+
+#define OPERATION_COUNT 10000000ULL
+#define LIVE_OBJECT_COUNT 256
+
+/**
+ *  Keeps a window of live objects of random small sizes, replacing one object per operation.
+ */
+static void benchmark__churn( const char *name, Allocator *allocator ){
+    char label[ 128 ];
+    void *objects[ LIVE_OBJECT_COUNT ] = { 0 };
+
+    unsigned long long state = 88172645463325252ULL;
+    double start = benchmark__now();
+    for( unsigned long long operation = 0; operation < OPERATION_COUNT; operation++ ){
+        /* xorshift64 */
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+
+        unsigned long long object_index = state % LIVE_OBJECT_COUNT;
+        allocator__free( allocator, objects[ object_index ] );
+        objects[ object_index ] = allocator__alloc( allocator, 8 + ( state >> 32 ) % 504 );
+        *(char*) objects[ object_index ] = 1;
+    }
+    snprintf( label, sizeof( label ), "alloc + free / %s", name );
+    benchmark__report( label, OPERATION_COUNT, benchmark__now() - start );
+
+    for( unsigned long long object_index = 0; object_index < LIVE_OBJECT_COUNT; object_index++ ){
+        allocator__free( allocator, objects[ object_index ] );
+    }
+}
+
+int main( void ){
+    SystemAllocator system_allocator;
+    system_allocator__initialize( &system_allocator, NULL );
+
+    ThreadCacheAllocator thread_cache_allocator;
+    thread_cache_allocator__initialize( &thread_cache_allocator, system_allocator.allocator );
+
+    StatisticsAllocator statistics_allocator;
+
+    benchmark__churn( "SystemAllocator", system_allocator.allocator );
+
+    statistics_allocator__initialize( &statistics_allocator, system_allocator.allocator );
+    benchmark__churn( "StatisticsAllocator over SystemAllocator", statistics_allocator.allocator );
+    statistics_allocator__deinitialize( &statistics_allocator );
+
+    benchmark__churn( "ThreadCacheAllocator", thread_cache_allocator.allocator );
+
+    statistics_allocator__initialize( &statistics_allocator, thread_cache_allocator.allocator );
+    benchmark__churn( "StatisticsAllocator over ThreadCacheAllocator", statistics_allocator.allocator );
+
+    StatisticsAllocator__Snapshot snapshot;
+    statistics_allocator__snapshot( &statistics_allocator, &snapshot );
+
+    String report = { 0 };
+    statistics_allocator__snapshot__append_text( &snapshot, &report, system_allocator.allocator );
+    printf( "\n%s", report.data );
+    string__clear( &report, system_allocator.allocator );
+
+    statistics_allocator__deinitialize( &statistics_allocator );
+    thread_cache_allocator__deinitialize( &thread_cache_allocator );
+    system_allocator__deinitialize( &system_allocator );
+
+    return 0;
+}
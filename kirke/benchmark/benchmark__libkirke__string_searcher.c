@@ -0,0 +1,68 @@
+// Internal Includes
+#include "benchmark.h"
+#include "kirke/split_iterator.h"
+#include "kirke/string.h"
+#include "kirke/string_searcher.h"
+#include "kirke/system_allocator.h"
+
+#define TEXT_LENGTH ( 16ULL * 1024ULL * 1024ULL )
+#define RECORD_LENGTH 4096ULL
+
+/**
+ *  Splits 16 MB of records, separated by the delimiter, first by calling string__index_of on the rest of the text,
+ *  as split_iterator__next used to, and then with a SplitIterator, whose StringSearcher analyzes the delimiter once.
+ */
+static void benchmark__split( Allocator *allocator, const char *delimiter_text ){
+    char label[ 128 ];
+    unsigned long long delimiter_length = strlen( delimiter_text );
+    String delimiter = { .data = (char*) delimiter_text, .length = delimiter_length, .capacity = delimiter_length, .element_size = 1 };
+
+    /* Records of text which often contains the delimiter's first characters, but never the whole delimiter. */
+    String text;
+    string__initialize( &text, allocator, TEXT_LENGTH );
+    for( unsigned long long index = 0; index < TEXT_LENGTH; index++ ){
+        text.data[ index ] = index % 7 == 0 ? delimiter_text[ 0 ] : (char)( 'a' + index % 19 );
+    }
+    for( unsigned long long index = RECORD_LENGTH; index + delimiter.length < TEXT_LENGTH; index += RECORD_LENGTH ){
+        memcpy( text.data + index, delimiter.data, delimiter.length );
+    }
+    text.length = TEXT_LENGTH;
+
+    double start = benchmark__now();
+    unsigned long long token_count = 0;
+    String rest = text;
+    unsigned long long index;
+    while( string__index_of( &rest, &delimiter, &index ) ){
+        rest.data += index + delimiter.length;
+        rest.length -= index + delimiter.length;
+        token_count++;
+    }
+    snprintf( label, sizeof( label ), "split 16 MB, %llu byte delimiter / string__index_of", delimiter.length );
+    benchmark__report( label, token_count, benchmark__now() - start );
+
+    start = benchmark__now();
+    SplitIterator split_iterator;
+    split_iterator__initialize( &split_iterator, &text, &delimiter );
+    String token;
+    token_count = 0;
+    while( split_iterator__next( &split_iterator, &token ) ){
+        token_count++;
+    }
+    snprintf( label, sizeof( label ), "split 16 MB, %llu byte delimiter / SplitIterator", delimiter.length );
+    benchmark__report( label, token_count, benchmark__now() - start );
+
+    string__clear( &text, allocator );
+}
+
+int main( void ){
+    SystemAllocator system_allocator;
+    system_allocator__initialize( &system_allocator, NULL );
+
+    benchmark__split( system_allocator.allocator, "\r\n" );
+    benchmark__split( system_allocator.allocator, "--boundary--" );
+    benchmark__split( system_allocator.allocator, "--------------------------------boundary--------------------------------" );
+
+    system_allocator__deinitialize( &system_allocator );
+
+    return 0;
+}
@@ -0,0 +1,127 @@
+// Internal Includes
+#include "benchmark.h"
+#include "kirke/array.h"
+#include "kirke/string.h"
+#include "kirke/system_allocator.h"
+
+#define CHUNK_SIZE ( 64ULL * 1024ULL )
+/* One chunk short of 1 GB, so that the string's capacity stops at about 1 GB. */
+#define APPEND_COUNT ( 1024ULL * 1024ULL * 1024ULL / CHUNK_SIZE - 1 )
+
+/* 512 MB of elements, far more than the TLB can cover with 4 KB pages. */
+#define LOOKUP_ELEMENT_COUNT ( 64ULL * 1024ULL * 1024ULL )
+#define LOOKUP_COUNT ( 5ULL * 1000ULL * 1000ULL )
+
+static bool elements_are_equal( unsigned long long first, unsigned long long second ){
+    return first == second;
+}
+
+ARRAY__DECLARE( Array__ULLong, array__ullong, unsigned long long )
+ARRAY__DEFINE( Array__ULLong, array__ullong, unsigned long long, elements_are_equal )
+
+/**
+ *  Appends almost 1 GB to an AutoString in fixed size chunks, counting how often its data moves.
+ */
+static void benchmark__append( const char *name, Allocator *allocator, bool uninitialized_growth ){
+    static char chunk[ CHUNK_SIZE ];
+    char label[ 128 ];
+
+    AutoString auto_string = { 0 };
+    auto_string__initialize( &auto_string, allocator, 1 );
+    auto_string.uninitialized_growth = uninitialized_growth;
+
+    unsigned long long move_count = 0;
+    char *data = auto_string.string->data;
+
+    double start = benchmark__now();
+    for( unsigned long long append = 0; append < APPEND_COUNT; append++ ){
+        auto_string__append_elements( &auto_string, CHUNK_SIZE, chunk );
+
+        if( auto_string.string->data != data ){
+            data = auto_string.string->data;
+            move_count++;
+        }
+    }
+    snprintf( label, sizeof( label ), "append 64 KB / %s (%llu moves)", name, move_count );
+    benchmark__report( label, APPEND_COUNT, benchmark__now() - start );
+
+    BENCHMARK__DO_NOT_OPTIMIZE( auto_string.string->data[ auto_string.string->length - 1 ] );
+    auto_string__clear( &auto_string );
+}
+
+/**
+ *  Looks up random elements of a large Array. Each index depends on the previous lookup, so that the latency of
+ *  every TLB miss is exposed rather than overlapped.
+ */
+static void benchmark__random_lookup( const char *name, SystemAllocator__Options const *options ){
+    char label[ 128 ];
+
+    SystemAllocator system_allocator;
+    system_allocator__initialize__options( &system_allocator, NULL, options );
+
+    /* Prefaulting moves the cost of the page faults from the first writes into the allocation. */
+    Array__ULLong array;
+    double start = benchmark__now();
+    array__ullong__initialize( &array, system_allocator.allocator, LOOKUP_ELEMENT_COUNT );
+    snprintf( label, sizeof( label ), "allocate 512 MB / %s", name );
+    benchmark__report( label, 1, benchmark__now() - start );
+
+    start = benchmark__now();
+    for( unsigned long long index = 0; index < LOOKUP_ELEMENT_COUNT; index++ ){
+        array.data[ index ] = index * 0x9E3779B97F4A7C15ULL;
+    }
+    array.length = LOOKUP_ELEMENT_COUNT;
+    snprintf( label, sizeof( label ), "first write 512 MB / %s", name );
+    benchmark__report( label, LOOKUP_ELEMENT_COUNT, benchmark__now() - start );
+
+    SystemAllocator__HugePageStatistics statistics;
+    system_allocator__huge_page_statistics( &system_allocator, &statistics );
+
+    unsigned long long random = 88172645463325252ULL;
+    unsigned long long sum = 0;
+
+    start = benchmark__now();
+    for( unsigned long long lookup = 0; lookup < LOOKUP_COUNT; lookup++ ){
+        /* xorshift64 */
+        random ^= random << 13;
+        random ^= random >> 7;
+        random ^= random << 17;
+
+        sum += array.data[ ( random ^ sum ) & ( LOOKUP_ELEMENT_COUNT - 1 ) ];
+    }
+    snprintf( label, sizeof( label ), "random lookup 512 MB / %s (%llu MB huge)", name, statistics.backed_bytes >> 20 );
+    benchmark__report( label, LOOKUP_COUNT, benchmark__now() - start );
+
+    BENCHMARK__DO_NOT_OPTIMIZE( sum );
+    array__ullong__clear( &array, system_allocator.allocator );
+    system_allocator__deinitialize( &system_allocator );
+}
+
+int main( void ){
+    SystemAllocator system_allocator;
+
+    system_allocator__initialize__options( &system_allocator, NULL, NULL );
+    benchmark__append( "malloc only", system_allocator.allocator, false );
+    system_allocator__deinitialize( &system_allocator );
+
+    SystemAllocator__Options options = {
+        .large_block_threshold = SYSTEM_ALLOCATOR__DEFAULT_LARGE_BLOCK_THRESHOLD,
+        .huge_page_threshold = 0,
+        .prefault = false
+    };
+
+    system_allocator__initialize__options( &system_allocator, NULL, &options );
+    benchmark__append( "large blocks", system_allocator.allocator, false );
+    benchmark__append( "large blocks, uninitialized growth", system_allocator.allocator, true );
+    system_allocator__deinitialize( &system_allocator );
+
+    benchmark__random_lookup( "small pages", &options );
+
+    options.huge_page_threshold = SYSTEM_ALLOCATOR__HUGE_PAGE_SIZE;
+    benchmark__random_lookup( "huge pages", &options );
+
+    options.prefault = true;
+    benchmark__random_lookup( "huge pages, prefaulted", &options );
+
+    return 0;
+}
@@ -0,0 +1,86 @@
+// System Includes
+#include <pthread.h>
+#include <unistd.h> // sysconf
+
+// Internal Includes
+#include "benchmark.h"
+#include "kirke/system_allocator.h"
+#include "kirke/thread_cache_allocator.h"
+
+#define OPERATION_COUNT_PER_THREAD 4000000ULL
+#define LIVE_OBJECT_COUNT 256
+
+typedef struct Worker {
+    Allocator *allocator;
+    unsigned long long seed;
+} Worker;
+
+/**
+ *  Each worker keeps a window of live objects of random small sizes, replacing one object per operation.
+ */
+static void *worker__run( void *worker_pointer ){
+    Worker *worker = (Worker*) worker_pointer;
+    void *objects[ LIVE_OBJECT_COUNT ] = { 0 };
+
+    unsigned long long state = worker->seed;
+    for( unsigned long long operation = 0; operation < OPERATION_COUNT_PER_THREAD; operation++ ){
+        /* xorshift64 */
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+
+        unsigned long long object_index = state % LIVE_OBJECT_COUNT;
+        allocator__free( worker->allocator, objects[ object_index ] );
+        objects[ object_index ] = allocator__alloc( worker->allocator, 8 + ( state >> 32 ) % 504 );
+        *(char*) objects[ object_index ] = 1;
+    }
+
+    for( unsigned long long object_index = 0; object_index < LIVE_OBJECT_COUNT; object_index++ ){
+        allocator__free( worker->allocator, objects[ object_index ] );
+    }
+
+    return NULL;
+}
+
+static void benchmark__threads( const char *name, Allocator *allocator, long thread_count ){
+    pthread_t threads[ 256 ];
+    Worker workers[ 256 ];
+
+    double start = benchmark__now();
+    for( long thread_index = 0; thread_index < thread_count; thread_index++ ){
+        workers[ thread_index ] = (Worker){ .allocator = allocator, .seed = 0x9E3779B97F4A7C15ULL * ( thread_index + 1 ) };
+        pthread_create( &threads[ thread_index ], NULL, worker__run, &workers[ thread_index ] );
+    }
+
+    for( long thread_index = 0; thread_index < thread_count; thread_index++ ){
+        pthread_join( threads[ thread_index ], NULL );
+    }
+    double seconds = benchmark__now() - start;
+
+    char label[ 128 ];
+    snprintf( label, sizeof( label ), "alloc + free, %2ld threads / %s", thread_count, name );
+    benchmark__report( label, OPERATION_COUNT_PER_THREAD * thread_count, seconds );
+}
+
+int main( void ){
+    long core_count = sysconf( _SC_NPROCESSORS_ONLN );
+    if( core_count > 256 ){
+        core_count = 256;
+    }
+
+    SystemAllocator system_allocator;
+    system_allocator__initialize( &system_allocator, NULL );
+
+    ThreadCacheAllocator thread_cache_allocator;
+    thread_cache_allocator__initialize( &thread_cache_allocator, system_allocator.allocator );
+
+    for( long thread_count = 1; thread_count <= core_count; thread_count *= 2 ){
+        benchmark__threads( "SystemAllocator", system_allocator.allocator, thread_count );
+        benchmark__threads( "ThreadCacheAllocator", thread_cache_allocator.allocator, thread_count );
+    }
+
+    thread_cache_allocator__deinitialize( &thread_cache_allocator );
+    system_allocator__deinitialize( &system_allocator );
+
+    return 0;
+}
@@ -0,0 +1,198 @@
+// System Includes
+#include <stdbool.h>
+#include <string.h> // strlen
+#include <sys/wait.h> // waitpid
+#include <unistd.h> // fork
+
+// Internal Includes
+#include "benchmark.h"
+#include "kirke/arena_allocator.h"
+#include "kirke/buddy_allocator.h"
+#include "kirke/error.h"
+#include "kirke/hash_map.h"
+#include "kirke/list.h"
+#include "kirke/string.h"
+#include "kirke/system_allocator.h"
+#include "kirke/thread_cache_allocator.h"
+#include "kirke/trace_allocator.h"
+
+#define REQUEST_COUNT 200000ULL
+#define CACHED_STRING_COUNT 1024
+#define SESSION_WINDOW 8192
+#define BUDDY_REGION_SIZE ( 1024ULL * 1024ULL * 1024ULL )
+
+static bool ints_are_equal( int first, int second ){
+    return first == second;
+}
+
+static unsigned long long hash_int( int key ){
+    return (unsigned long long) key * 0x9E3779B97F4A7C15ULL;
+}
+
+LIST__DECLARE( Benchmark__List, benchmark__list, int )
+LIST__DEFINE( Benchmark__List, benchmark__list, int, ints_are_equal )
+
+HASH_MAP__DECLARE( Benchmark__HashMap, benchmark__hash_map, int, int )
+HASH_MAP__DEFINE( Benchmark__HashMap, benchmark__hash_map, int, int, hash_int, ints_are_equal )
+
+/**
+ *  Simulates a service handling requests: each request builds a response string and a list of items, some responses
+ *  are kept in a cache, and a map of sessions is updated, so that allocations of many sizes and lifetimes mix.
+ */
+static void benchmark__workload( Allocator *allocator ){
+    AutoString cache[ CACHED_STRING_COUNT ] = { { 0 } };
+
+    Benchmark__HashMap sessions;
+    benchmark__hash_map__initialize( &sessions, allocator, 64 );
+
+    unsigned long long state = 88172645463325252ULL;
+    for( unsigned long long request = 0; request < REQUEST_COUNT; request++ ){
+        /* xorshift64 */
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+
+        AutoString response;
+        auto_string__initialize( &response, allocator, 16 );
+        for( unsigned long long part = 0; part < 1 + state % 32; part++ ){
+            auto_string__append_elements( &response, 23, "{\"key\": \"value\"}, ... " );
+        }
+
+        Benchmark__List *items = NULL;
+        benchmark__list__initialize( &items, allocator, 0 );
+        for( int item = 0; item < (int)( ( state >> 8 ) % 16 ); item++ ){
+            items = benchmark__list__prepend( items, allocator, item );
+        }
+        benchmark__list__clear( items, allocator );
+
+        benchmark__hash_map__insert( &sessions, (int) request, (int) state );
+        if( request >= SESSION_WINDOW ){
+            benchmark__hash_map__delete( &sessions, (int)( request - SESSION_WINDOW ) );
+        }
+
+        /* One response in four replaces a cached one, and the rest are dropped. */
+        if( ( state >> 16 ) % 4 == 0 ){
+            AutoString *cached = &cache[ ( state >> 24 ) % CACHED_STRING_COUNT ];
+            if( cached->string != NULL ){
+                auto_string__clear( cached );
+            }
+            *cached = response;
+        }
+        else{
+            auto_string__clear( &response );
+        }
+    }
+
+    for( int index = 0; index < CACHED_STRING_COUNT; index++ ){
+        if( cache[ index ].string != NULL ){
+            auto_string__clear( &cache[ index ] );
+        }
+    }
+    benchmark__hash_map__clear( &sessions );
+}
+
+/**
+ *  Replays the trace in a child process, so that every allocator starts from the same resident set.
+ */
+static void benchmark__replay( const char *name, TraceAllocator__Trace const *trace, Allocator *( *create )( void ) ){
+    fflush( stdout );
+
+    pid_t child = fork();
+    if( child == 0 ){
+        /* Memory freed by the parent before forking would otherwise be reused without growing the resident set. */
+        Allocator *allocator = create();
+        allocator__trim( allocator );
+
+        TraceAllocator__Replay replay;
+        bool replayed = trace_allocator__replay( trace, allocator, &replay );
+
+        char label[ 128 ];
+        snprintf( label, sizeof( label ), "replay / %s%s", name, replayed ? "" : " (failed)" );
+        benchmark__report( label, replay.operation_count, replay.seconds );
+        printf(
+            "%-64s %12.2f MB peak live %8.2f MB peak resident %6.1f%% fragmentation\n",
+            "",
+            (double) replay.peak_live_bytes / ( 1024.0 * 1024.0 ),
+            (double) replay.peak_resident_bytes / ( 1024.0 * 1024.0 ),
+            replay.fragmentation * 100.0
+        );
+        fflush( stdout );
+        _exit( 0 );
+    }
+
+    waitpid( child, NULL, 0 );
+}
+
+/* The allocators below are only created in the child processes, which exit without de-initializing them. */
+
+static Allocator *benchmark__create__system_allocator( void ){
+    static SystemAllocator system_allocator;
+    system_allocator__initialize( &system_allocator, NULL );
+    return system_allocator.allocator;
+}
+
+static Allocator *benchmark__create__thread_cache_allocator( void ){
+    static ThreadCacheAllocator thread_cache_allocator;
+    thread_cache_allocator__initialize( &thread_cache_allocator, benchmark__create__system_allocator() );
+    return thread_cache_allocator.allocator;
+}
+
+static Allocator *benchmark__create__buddy_allocator( void ){
+    static BuddyAllocator buddy_allocator;
+    buddy_allocator__initialize__mapped( &buddy_allocator, BUDDY_REGION_SIZE );
+    return buddy_allocator.allocator;
+}
+
+static Allocator *benchmark__create__arena_allocator( void ){
+    static ArenaAllocator arena_allocator;
+    arena_allocator__initialize( &arena_allocator, benchmark__create__system_allocator(), 0 );
+    return arena_allocator.allocator;
+}
+
+/**
+ *  Usage: benchmark__libkirke__trace_allocator [trace file]
+ *  Replays the given trace, as written by trace_allocator__write, or else records and replays a synthetic workload.
+ */
+int main( int argument_count, char **arguments ){
+    SystemAllocator system_allocator;
+    system_allocator__initialize( &system_allocator, NULL );
+
+    TraceAllocator__Trace trace;
+
+    if( argument_count > 1 ){
+        Error error = { 0 };
+        unsigned long long length = strlen( arguments[ 1 ] );
+        String file_path = { .data = arguments[ 1 ], .length = length, .capacity = length, .element_size = sizeof( char ) };
+        if( !trace_allocator__read( file_path, &trace, system_allocator.allocator, &error ) ){
+            printf( "%s\n", error.message );
+            return 1;
+        }
+    }
+    else{
+        double start = benchmark__now();
+        benchmark__workload( system_allocator.allocator );
+        benchmark__report( "workload / SystemAllocator", REQUEST_COUNT, benchmark__now() - start );
+
+        TraceAllocator trace_allocator;
+        trace_allocator__initialize( &trace_allocator, system_allocator.allocator );
+
+        start = benchmark__now();
+        benchmark__workload( trace_allocator.allocator );
+        benchmark__report( "workload / TraceAllocator over SystemAllocator", REQUEST_COUNT, benchmark__now() - start );
+
+        trace_allocator__trace( &trace_allocator, &trace, system_allocator.allocator );
+        trace_allocator__deinitialize( &trace_allocator );
+    }
+
+    printf( "\n%llu events, %llu allocations, %llu threads\n\n", trace.event_count, trace.pointer_count, trace.thread_count );
+
+    benchmark__replay( "SystemAllocator", &trace, benchmark__create__system_allocator );
+    benchmark__replay( "ThreadCacheAllocator", &trace, benchmark__create__thread_cache_allocator );
+    benchmark__replay( "BuddyAllocator", &trace, benchmark__create__buddy_allocator );
+    benchmark__replay( "ArenaAllocator", &trace, benchmark__create__arena_allocator );
+
+    trace_allocator__trace__clear( &trace, system_allocator.allocator );
+    system_allocator__deinitialize( &system_allocator );
+
+    return 0;
+}
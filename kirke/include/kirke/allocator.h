@@ -5,6 +5,9 @@
 #ifndef KIRKE__ALLOCATOR__H
 #define KIRKE__ALLOCATOR__H
 
+// System Includes
+#include <stdbool.h>
+
 // Internal Includes
 #include "kirke/macros.h"
 
@@ -15,6 +18,13 @@
 
 BEGIN_DECLARATIONS
 
+/**
+ *  \def ALLOCATOR__CACHE_LINE_SIZE
+ *  \brief The size in bytes of a cache line, which is a suitable alignment for data accessed by vector instructions,
+ *  or shared between threads.
+ */
+#define ALLOCATOR__CACHE_LINE_SIZE 64ULL
+
 /**
  *	\brief Allocator is a structure which handles dynamic memory allocation and release.
  *	Allocator itself is opaque, and defined in kirke/src/allocator.c. Allocator is just a virtual
@@ -59,7 +69,9 @@ void *allocator__alloc( Allocator* allocator, unsigned long long size );
 
 /**
  *  \brief This method allocates a region of memory large enough to hold the given number of items of 
- *  the given size, and zeros the newly-allocated region.
+ *  the given size, and zeros the newly-allocated region. If the allocator has a calloc function, then it is
+ *  used, so that memory which is known to be zeroed already is not written again. Otherwise, the region is
+ *  allocated with alloc and then zeroed.
  *  \param allocator The allocator to be used for allocation.
  *  \param count The number of items to allocate.
  *  \param size The size in bytes of each item to allocate.
@@ -83,6 +95,137 @@ void *allocator__realloc( Allocator* allocator, void* pointer, unsigned long lon
  */
 void allocator__free( Allocator* allocator, void* pointer );
 
+/**
+ *  \brief Supplies an Allocator with functions for aligned allocation, which are used by allocator__alloc_aligned,
+ *  allocator__realloc_aligned and allocator__free_aligned. Without them, these methods fall back to over-allocating
+ *  with the allocator's alloc and realloc functions.
+ *  \param allocator The allocator to which the functions will be supplied.
+ *  \param alloc_aligned_function The function which will be called to allocate a block of memory whose address is a
+ *  multiple of the given alignment.
+ *  \param realloc_aligned_function Optional. The function which will be called to reallocate an aligned block of
+ *  memory, preserving the given number of bytes. If this is NULL, then aligned blocks are reallocated by allocating a
+ *  new block, copying and freeing the old block.
+ *  \param free_aligned_function Optional. The function which will be called to free an aligned block of memory. If
+ *  this is NULL, then aligned blocks are freed with the allocator's free function.
+ */
+void allocator__set_aligned_functions(
+    Allocator* allocator,
+    void* ( *alloc_aligned_function )( unsigned long long size, unsigned long long alignment, void* allocator_data ),
+    void* ( *realloc_aligned_function )( void* pointer, unsigned long long old_size, unsigned long long size, unsigned long long alignment, void* allocator_data ),
+    void ( *free_aligned_function )( void* pointer, void* allocator_data )
+);
+
+/**
+ *  \brief Supplies an Allocator with a function which frees a block of memory given its size, which is used by
+ *  allocator__free_sized. Knowing the size lets an allocator find the size class of a block without looking it up.
+ *  Without this function, allocator__free_sized falls back to the allocator's free function.
+ *  \param allocator The allocator to which the function will be supplied.
+ *  \param free_sized_function The function which will be called to free a block of memory of a given size.
+ */
+void allocator__set_free_sized_function(
+    Allocator* allocator,
+    void ( *free_sized_function )( void* pointer, unsigned long long size, void* allocator_data )
+);
+
+/**
+ *  \brief Supplies an Allocator with a function which resizes a block of memory without moving it, which is used by
+ *  allocator__try_expand. Without this function, allocator__try_expand always fails.
+ *  \param allocator The allocator to which the function will be supplied.
+ *  \param try_expand_function The function which will be called to resize a block of memory in place. It returns
+ *  true if the block now holds at least the requested number of bytes at the same address, and false otherwise, in
+ *  which case the block is left unchanged.
+ */
+void allocator__set_try_expand_function(
+    Allocator* allocator,
+    bool ( *try_expand_function )( void* pointer, unsigned long long size, void* allocator_data )
+);
+
+/**
+ *  \brief Supplies an Allocator with a function which allocates zeroed memory, which is used by allocator__calloc.
+ *  \param allocator The allocator to which the function will be supplied.
+ *  \param calloc_function The function which will be called to allocate \p count items of \p size bytes each, all
+ *  zeroed. It must return NULL if count * size overflows.
+ */
+void allocator__set_calloc_function(
+    Allocator* allocator,
+    void* ( *calloc_function )( unsigned long long count, unsigned long long size, void* allocator_data )
+);
+
+/**
+ *  \brief Supplies an Allocator with a function which returns memory it holds, but which is not in use, to its backing
+ *  allocator or to the operating system, which is used by allocator__trim.
+ *  \param allocator The allocator to which the function will be supplied.
+ *  \param trim_function The function which will be called to trim the allocator. It returns true if any memory was
+ *  released, and false otherwise.
+ */
+void allocator__set_trim_function(
+    Allocator* allocator,
+    bool ( *trim_function )( void* allocator_data )
+);
+
+/**
+ *  \brief This method attempts to resize a block of memory without moving it. Unlike allocator__realloc, this never
+ *  copies the block's contents, and never invalidates pointers into the block.
+ *  \param allocator The allocator which allocated \p pointer.
+ *  \param pointer A pointer to the start of a region of memory allocated with allocator__alloc, allocator__calloc,
+ *  or allocator__realloc.
+ *  \param size The new size in bytes of the memory region.
+ *  \returns Returns true if the region was resized in place, and false if it was left unchanged. The out_of_memory
+ *  callback is not called on failure.
+ */
+bool allocator__try_expand( Allocator* allocator, void* pointer, unsigned long long size );
+
+/**
+ *  \brief This method returns memory which an allocator holds, but which is not in use, for example chunks retained
+ *  after a rewind, or free pages at the top of the heap, to its backing allocator or to the operating system. This
+ *  lowers the memory used by a long-running process after a peak, without invalidating any allocation.
+ *  \param allocator The allocator to be trimmed.
+ *  \returns Returns true if any memory was released, and false otherwise, including when the allocator does not
+ *  supply a trim function.
+ */
+bool allocator__trim( Allocator* allocator );
+
+/**
+ *  \brief This method allocates a new block of memory whose address is a multiple of \p alignment.
+ *  \param allocator The allocator to be used for allocation.
+ *  \param size The size in bytes of the memory region to be allocated.
+ *  \param alignment The required alignment in bytes. This must be a power of 2.
+ *  \returns A pointer to the start of the newly-allocated block of memory, or NULL if it could not be allocated.
+ *  \note Memory allocated with this method must be reallocated with allocator__realloc_aligned, and freed with
+ *  allocator__free_aligned.
+ */
+void* allocator__alloc_aligned( Allocator* allocator, unsigned long long size, unsigned long long alignment );
+
+/**
+ *  \brief This method reallocates a block of memory allocated with allocator__alloc_aligned, keeping its alignment.
+ *  \param allocator The allocator which allocated \p pointer.
+ *  \param pointer A pointer to the start of the region of memory to be reallocated. If this is NULL, then a new
+ *  block is allocated.
+ *  \param old_size The number of bytes at the start of the existing block which must be preserved. This must not
+ *  exceed the size with which the block was allocated.
+ *  \param size The new size in bytes of the memory region.
+ *  \param alignment The required alignment in bytes, which must be the alignment with which \p pointer was allocated.
+ *  \returns A pointer to the start of the reallocated block of memory, or NULL if it could not be reallocated, in
+ *  which case \p pointer remains valid.
+ */
+void* allocator__realloc_aligned( Allocator* allocator, void* pointer, unsigned long long old_size, unsigned long long size, unsigned long long alignment );
+
+/**
+ *  \brief This method frees a block of memory allocated with allocator__alloc_aligned or allocator__realloc_aligned.
+ *  \param allocator The allocator which will be used to free memory.
+ *  \param pointer A pointer to the start of the region of memory to be freed.
+ */
+void allocator__free_aligned( Allocator* allocator, void* pointer );
+
+/**
+ *  \brief This method frees a region of memory allocated with allocator__alloc, allocator__calloc, or
+ *  allocator__realloc, whose size is known to the caller.
+ *  \param allocator The allocator which will be used to free memory.
+ *  \param pointer A pointer to the start of the region of memory to be freed.
+ *  \param size The size in bytes with which the region was last allocated or reallocated.
+ */
+void allocator__free_sized( Allocator* allocator, void* pointer, unsigned long long size );
+
 /**
  *  @} group allocator
  */
@@ -0,0 +1,134 @@
+/**
+ *  \file kirke/arena_allocator.h
+ */
+
+#ifndef KIRKE__ARENA_ALLOCATOR__H
+#define KIRKE__ARENA_ALLOCATOR__H
+
+// Internal Includes
+#include "kirke/macros.h"
+#include "kirke/allocator.h"
+
+BEGIN_DECLARATIONS
+
+/**
+ *  \defgroup arena_allocator ArenaAllocator
+ *  @{
+ */
+
+/**
+ *  \brief Opaque type representing a single large block of memory, from which an ArenaAllocator carves
+ *  smaller allocations. Defined in kirke/src/arena_allocator.c.
+ */
+typedef struct ArenaAllocator__Chunk ArenaAllocator__Chunk;
+
+/**
+ *  \brief A position within an ArenaAllocator, as returned by arena_allocator__mark. Passing a mark to
+ *  arena_allocator__rewind releases every allocation made after the mark was taken.
+ */
+typedef struct ArenaAllocator__Mark {
+    /**
+     *  The chunk which was current when the mark was taken.
+     */
+    ArenaAllocator__Chunk *chunk;
+    /**
+     *  The number of bytes which were in use within \ref chunk when the mark was taken.
+     */
+    unsigned long long position;
+} ArenaAllocator__Mark;
+
+/**
+ *  \brief An allocator which serves allocations by bumping a pointer through large chunks of memory, which
+ *  are themselves allocated from a backing allocator.
+ *  Freeing individual allocations is a no-op. Instead, memory is released in bulk, either with
+ *  arena_allocator__rewind, which releases everything allocated after a given mark, or with
+ *  arena_allocator__reset, which releases everything. Reallocating the most recent allocation grows
+ *  or shrinks it in place whenever the current chunk has room.
+ *  Chunks are retained after rewinding or resetting, and reused by subsequent allocations. They are only
+ *  returned to the backing allocator by arena_allocator__trim and arena_allocator__deinitialize.
+ */
+typedef struct ArenaAllocator{
+    /**
+     *  The initialized allocator, which can be passed to any method requiring an allocator parameter.
+     */
+    Allocator *allocator;
+    /**
+     *  The allocator from which chunks are allocated. This is borrowed rather than owned.
+     */
+    Allocator *backing_allocator;
+    /**
+     *  The default size, in bytes, of each chunk. Allocations larger than this receive a chunk of their own.
+     */
+    unsigned long long chunk_size;
+    /**
+     *  The first chunk in the arena's list of chunks.
+     */
+    ArenaAllocator__Chunk *first_chunk;
+    /**
+     *  The chunk from which allocations are currently being served.
+     */
+    ArenaAllocator__Chunk *current_chunk;
+    /**
+     *  The most recent allocation, which may be resized in place. NULL if there is no such allocation.
+     */
+    void *last_allocation;
+    /**
+     *  The position of the arena directly after \ref allocator was allocated. arena_allocator__reset
+     *  rewinds to this mark.
+     */
+    ArenaAllocator__Mark base_mark;
+} ArenaAllocator;
+
+/**
+ *  \brief Initializes an ArenaAllocator structure.
+ *  \param arena_allocator A pointer to the ArenaAllocator to be initialized.
+ *  \param backing_allocator The allocator which will be used to allocate chunks.
+ *  \param chunk_size The default size, in bytes, of each chunk.
+ */
+void arena_allocator__initialize( ArenaAllocator *arena_allocator, Allocator *backing_allocator, unsigned long long chunk_size );
+
+/**
+ *  \brief De-initializes an ArenaAllocator structure, returning all of its chunks to the backing allocator.
+ *  \param arena_allocator A pointer to the ArenaAllocator to be de-initialized.
+ *  \note Any memory allocated from \p arena_allocator is invalid after this call.
+ */
+void arena_allocator__deinitialize( ArenaAllocator *arena_allocator );
+
+/**
+ *  \brief Retrieves the current position of an ArenaAllocator.
+ *  \param arena_allocator A pointer to the ArenaAllocator.
+ *  \returns A mark which can later be passed to arena_allocator__rewind.
+ */
+ArenaAllocator__Mark arena_allocator__mark( ArenaAllocator const *arena_allocator );
+
+/**
+ *  \brief Releases every allocation made from an ArenaAllocator since \p mark was taken. This is a constant
+ *  time operation.
+ *  \param arena_allocator A pointer to the ArenaAllocator.
+ *  \param mark A mark previously returned by arena_allocator__mark for the same ArenaAllocator, which has not
+ *  been invalidated by rewinding to an earlier mark.
+ */
+void arena_allocator__rewind( ArenaAllocator *arena_allocator, ArenaAllocator__Mark mark );
+
+/**
+ *  \brief Releases every allocation made from an ArenaAllocator. This is a constant time operation.
+ *  \param arena_allocator A pointer to the ArenaAllocator.
+ */
+void arena_allocator__reset( ArenaAllocator *arena_allocator );
+
+/**
+ *  \brief Returns the chunks which were left unused by rewinding or resetting an ArenaAllocator to its backing
+ *  allocator. This is also called by allocator__trim on \ref ArenaAllocator::allocator.
+ *  \param arena_allocator A pointer to the ArenaAllocator.
+ *  \returns Returns true if any chunk was released, and false otherwise.
+ *  \note Allocations made before the most recent rewind or reset, and marks taken before them, remain valid.
+ */
+bool arena_allocator__trim( ArenaAllocator *arena_allocator );
+
+/**
+ *  @} group arena_allocator
+ */
+
+END_DECLARATIONS
+
+#endif // KIRKE__ARENA_ALLOCATOR__H
@@ -6,7 +6,7 @@
 #define KIRKE__ARRAY__H
 
 // System Includes
-#include <string.h> // memcmp, memcpy, memset
+#include <string.h> // memchr, memcmp, memcpy, memset
 #include <stdbool.h>
 
 // Internal Includes
@@ -26,6 +26,62 @@
  *  will not compile, because many of the methods defined here modify the underlying elements.
  */
 
+/**
+ *  \def ARRAY__DEFAULT_GROWTH_FACTOR
+ *  \brief The factor by which an AutoArray without a growth policy multiplies its capacity when it grows.
+ */
+#define ARRAY__DEFAULT_GROWTH_FACTOR 2.0
+
+/**
+ *  \brief Describes how an AutoArray grows when an insertion exceeds its capacity. Growth never yields less than the
+ *  capacity required by the insertion, and the new capacity is allocated exactly, rather than rounded up.
+ */
+typedef struct Array__GrowthPolicy {
+    /**
+     *  The factor by which the capacity is multiplied, for example 1.5 or 2. Smaller factors leave less slack
+     *  capacity, at the cost of growing, and so copying, more often. A factor of 1 or less grows to exactly the
+     *  capacity required.
+     */
+    double growth_factor;
+    /**
+     *  The smallest capacity, in elements, which growth allocates.
+     */
+    unsigned long long minimum_capacity;
+    /**
+     *  If this is not 0, then the largest number of bytes which a single growth adds, so that huge arrays grow
+     *  linearly rather than geometrically.
+     */
+    unsigned long long maximum_growth_bytes;
+} Array__GrowthPolicy;
+
+/**
+ *  \brief Computes the capacity to which an AutoArray grows.
+ *  \param growth_policy The AutoArray's growth policy, or NULL to multiply the capacity by
+ *  \ref ARRAY__DEFAULT_GROWTH_FACTOR.
+ *  \param capacity The current capacity, in elements.
+ *  \param required_capacity The capacity required by the insertion, in elements.
+ *  \param element_size The size of a single element, in bytes.
+ *  \returns Returns the new capacity, in elements, which is at least \p required_capacity.
+ */
+static inline unsigned long long array__growth_policy__capacity(
+    Array__GrowthPolicy const *growth_policy,
+    unsigned long long capacity,
+    unsigned long long required_capacity,
+    unsigned long long element_size
+){
+    double growth_factor = growth_policy != NULL ? growth_policy->growth_factor : ARRAY__DEFAULT_GROWTH_FACTOR;
+    unsigned long long grown_capacity = growth_factor > 1.0 ? (unsigned long long)( capacity * growth_factor ) : capacity;
+
+    if( growth_policy != NULL ){
+        if( growth_policy->maximum_growth_bytes != 0 ){
+            grown_capacity = math__min__ullong( grown_capacity, capacity + growth_policy->maximum_growth_bytes / element_size );
+        }
+        grown_capacity = math__max__ullong( grown_capacity, growth_policy->minimum_capacity );
+    }
+
+    return math__max__ullong( grown_capacity, required_capacity );
+}
+
 /**
  *  \def ARRAY__DECLARE( TYPENAME, TYPENAME_LOWERCASE, ELEMENT_TYPE )
  *  \brief Declares a structure and interface methods for a Array type. This macro should be paired
@@ -172,6 +228,23 @@
          *  The allocator used for memory management.                                                                                                               \
          */                                                                                                                                                         \
         Allocator *allocator;                                                                                                                                       \
+        /**                                                                                                                                                         \
+         *  The alignment in bytes of the underlying array's data, or 0 for the allocator's default alignment.                                                      \
+         */                                                                                                                                                         \
+        unsigned long long alignment;                                                                                                                               \
+        /**                                                                                                                                                         \
+         *  If this is false, which is the default, then growing the underlying array zeroes its new capacity. If this                                              \
+         *  is true, then the new capacity is left uninitialized, which saves writing, and faulting in, every page of a                                             \
+         *  buffer which is about to be overwritten anyway. Either way, elements skipped over by inserting beyond the                                               \
+         *  end are zeroed, and the element after the last is zeroed whenever there is room for it, so that an                                                      \
+         *  AutoString stays null-terminated.                                                                                                                       \
+         */                                                                                                                                                         \
+        bool uninitialized_growth;                                                                                                                                  \
+        /**                                                                                                                                                         \
+         *  The policy by which the underlying array grows, or NULL, which is the default, to double its capacity.                                                  \
+         *  This is borrowed rather than owned, and must outlive the AutoArray.                                                                                     \
+         */                                                                                                                                                         \
+        Array__GrowthPolicy const *growth_policy;                                                                                                                   \
     } Auto ## TYPENAME;                                                                                                                                             \
                                                                                                                                                                     \
     /**                                                                                                                                                             \
@@ -187,6 +260,24 @@
         unsigned long long capacity                                                                                                                                 \
     );                                                                                                                                                              \
                                                                                                                                                                     \
+    /**                                                                                                                                                             \
+     *  \brief This method intializes an AutoArray structure whose data is aligned to a given boundary, for example                                                 \
+     *  \ref ALLOCATOR__CACHE_LINE_SIZE. The alignment is kept as the AutoArray grows.                                                                              \
+     *  \param auto_array A pointer to the AutoArray to be initialized.                                                                                             \
+     *  \param allocator A pointer to the allocator which will be used to manage memory controlled by the                                                           \
+     *  AutoArray.                                                                                                                                                  \
+     *  \param capacity The desired initial capacity of the AutoArray, in elements.                                                                                 \
+     *  \param alignment The required alignment of the underlying array's data, in bytes. This must be a power of 2.                                                \
+     *  \note The data of an aligned AutoArray is allocated with allocator__alloc_aligned, so the AutoArray must be                                                 \
+     *  cleared with auto_array__clear, rather than by clearing the underlying array.                                                                               \
+     */                                                                                                                                                             \
+    void auto_ ## TYPENAME_LOWERCASE ## __initialize__aligned(                                                                                                      \
+        Auto ## TYPENAME *auto_ ## TYPENAME_LOWERCASE,                                                                                                              \
+        Allocator *allocator,                                                                                                                                       \
+        unsigned long long capacity,                                                                                                                                \
+        unsigned long long alignment                                                                                                                                \
+    );                                                                                                                                                              \
+                                                                                                                                                                    \
     /**                                                                                                                                                             \
      *  \brief This method will clear an AutoArray structure, and the underlying memory contained in                                                                \
      *  auto_array->array be freed. However, if the elements contained by this field are themselves                                                                 \
@@ -200,6 +291,70 @@
         Auto ## TYPENAME *auto_ ## TYPENAME_LOWERCASE                                                                                                               \
     );                                                                                                                                                              \
                                                                                                                                                                     \
+    /**                                                                                                                                                             \
+     *  \brief Ensures that an AutoArray has room for at least \p capacity elements, and the element after the last,                                                \
+     *  allocating exactly that much if it must grow, regardless of its growth policy. This avoids both repeated                                                    \
+     *  growth and slack capacity when the final length is known in advance.                                                                                        \
+     *  \param auto_array A pointer to the AutoArray.                                                                                                               \
+     *  \param capacity The required capacity, in elements.                                                                                                         \
+     *  \returns Returns true if the AutoArray has room for \p capacity elements.                                                                                   \
+     *  \returns Returns false if its allocator is out of memory, in which case the AutoArray is left unchanged.                                                    \
+     */                                                                                                                                                             \
+    bool auto_ ## TYPENAME_LOWERCASE ## __reserve(                                                                                                                  \
+        Auto ## TYPENAME *auto_ ## TYPENAME_LOWERCASE,                                                                                                              \
+        unsigned long long capacity                                                                                                                                 \
+    );                                                                                                                                                              \
+                                                                                                                                                                    \
+    /**                                                                                                                                                             \
+     *  \brief Sets the length of an AutoArray, growing it as necessary. Elements added by lengthening the AutoArray                                                \
+     *  are zeroed, and elements removed by shortening it are discarded, without releasing any capacity.                                                            \
+     *  \param auto_array A pointer to the AutoArray to be resized.                                                                                                 \
+     *  \param length The new length, in elements.                                                                                                                  \
+     */                                                                                                                                                             \
+    void auto_ ## TYPENAME_LOWERCASE ## __resize(                                                                                                                   \
+        Auto ## TYPENAME *auto_ ## TYPENAME_LOWERCASE,                                                                                                              \
+        unsigned long long length                                                                                                                                   \
+    );                                                                                                                                                               \
+                                                                                                                                                                    \
+    /**                                                                                                                                                             \
+     *  \brief Same as auto_array__resize, except that elements added by lengthening the AutoArray are left                                                         \
+     *  uninitialized, for a caller which is about to overwrite them, for example by reading into them.                                                             \
+     *  \param auto_array A pointer to the AutoArray to be resized.                                                                                                 \
+     *  \param length The new length, in elements.                                                                                                                  \
+     */                                                                                                                                                             \
+    void auto_ ## TYPENAME_LOWERCASE ## __resize__uninitialized(                                                                                                    \
+        Auto ## TYPENAME *auto_ ## TYPENAME_LOWERCASE,                                                                                                              \
+        unsigned long long length                                                                                                                                   \
+    );                                                                                                                                                              \
+                                                                                                                                                                    \
+    /**                                                                                                                                                             \
+     *  \brief Removes every element from an AutoArray, keeping its capacity, so that a buffer reused across                                                        \
+     *  iterations stops reallocating once it has grown to its largest size.                                                                                        \
+     *  \param auto_array A pointer to the AutoArray to be emptied.                                                                                                 \
+     */                                                                                                                                                             \
+    void auto_ ## TYPENAME_LOWERCASE ## __clear__keep_capacity(                                                                                                     \
+        Auto ## TYPENAME *auto_ ## TYPENAME_LOWERCASE                                                                                                               \
+    );                                                                                                                                                              \
+                                                                                                                                                                    \
+    /**                                                                                                                                                             \
+     *  \brief Reallocates the data of an AutoArray to hold exactly its elements, and the zeroed element after the                                                  \
+     *  last, releasing the slack capacity left over from growth to its allocator. Nothing is changed if the                                                        \
+     *  reallocation fails.                                                                                                                                         \
+     *  \param auto_array A pointer to the AutoArray whose capacity will be reduced to its length.                                                                  \
+     */                                                                                                                                                             \
+    void auto_ ## TYPENAME_LOWERCASE ## __shrink_to_fit(                                                                                                            \
+        Auto ## TYPENAME *auto_ ## TYPENAME_LOWERCASE                                                                                                               \
+    );                                                                                                                                                               \
+                                                                                                                                                                    \
+    /**                                                                                                                                                             \
+     *  \brief Calls auto_array__shrink_to_fit on the AutoArray pointed to by \p auto_array. This has the signature                                                 \
+     *  of a memory_pressure__register callback, from \ref kirke/memory_pressure.h.                                                                                 \
+     *  \param auto_array A pointer to the AutoArray, passed as the callback's data.                                                                                \
+     */                                                                                                                                                             \
+    void auto_ ## TYPENAME_LOWERCASE ## __shrink_to_fit__callback(                                                                                                  \
+        void *auto_ ## TYPENAME_LOWERCASE                                                                                                                           \
+    );                                                                                                                                                              \
+                                                                                                                                                                    \
     /**                                                                                                                                                             \
      *  \brief This method appends elements to the end of an AutoArray, allocating additional memory as necessary.                                                  \
      *  \param auto_array A pointer to the AutoArray to which the elements will be appended.                                                                        \
@@ -210,7 +365,7 @@
         Auto ## TYPENAME *auto_ ## TYPENAME_LOWERCASE,                                                                                                              \
         unsigned long long element_count,                                                                                                                           \
         ELEMENT_TYPE const *data                                                                                                                                    \
-    );                                                                                                                                                              \
+    );                                                                                                                                                               \
                                                                                                                                                                     \
     /**                                                                                                                                                             \
      *  \brief This method appends a single element to the end of an AutoArray, allocating additional memory as necessary.                                          \
@@ -220,7 +375,7 @@
     void auto_ ## TYPENAME_LOWERCASE ## __append_element(                                                                                                    \
         Auto ## TYPENAME *auto_ ## TYPENAME_LOWERCASE,                                                                                                              \
         ELEMENT_TYPE element                                                                                                                                        \
-    );                                                                                                                                                               \
+    );                                                                                                                                                              \
                                                                                                                                                                     \
     /**                                                                                                                                                             \
      *  \brief This method prepends elements to the beginning of an AutoArray, allocating additional memory as necessary.                                           \
@@ -232,7 +387,7 @@
         Auto ## TYPENAME *auto_ ## TYPENAME_LOWERCASE,                                                                                                              \
         unsigned long long element_count,                                                                                                                           \
         ELEMENT_TYPE const *data                                                                                                                                    \
-    );                                                                                                                                                              \
+    );                                                                                                                                                               \
                                                                                                                                                                     \
     /**                                                                                                                                                             \
      *  \brief This method prepends an element to the beginning of an AutoArray, allocating additional memory as necessary.                                         \
@@ -242,7 +397,7 @@
     void auto_ ## TYPENAME_LOWERCASE ## __prepend_element(                                                                                                   \
         Auto ## TYPENAME *auto_ ## TYPENAME_LOWERCASE,                                                                                                              \
         ELEMENT_TYPE element                                                                                                                                        \
-    );                                                                                                                                                               \
+    );                                                                                                                                                              \
                                                                                                                                                                     \
     /**                                                                                                                                                             \
      *  \brief This method inserts elements to the specified location of an AutoArray, allocating additional memory as necessary.                                   \
@@ -256,7 +411,7 @@
         unsigned long long start_index,                                                                                                                             \
         unsigned long long element_count,                                                                                                                           \
         ELEMENT_TYPE const *data                                                                                                                                    \
-    );                                                                                                                                                              \
+    );                                                                                                                                                               \
                                                                                                                                                                     \
     /**                                                                                                                                                             \
      *  \brief This method inserts an element into the specified location of an AutoArray, allocating additional memory as necessary.                               \
@@ -268,7 +423,7 @@
         Auto ## TYPENAME *auto_ ## TYPENAME_LOWERCASE,                                                                                                              \
         unsigned long long index,                                                                                                                                   \
         ELEMENT_TYPE element                                                                                                                                        \
-    );                                                                                                                                                               \
+    );                                                                                                                                                              \
                                                                                                                                                                     \
     /**                                                                                                                                                             \
      *  \brief Removes the element at the given index.                                                                                                              \
@@ -324,6 +479,88 @@
  *  comparison function yields the most utility and flexibility.
  */
 #define ARRAY__DEFINE( TYPENAME, TYPENAME_LOWERCASE, ELEMENT_TYPE, ELEMENT_TYPE__EQUALS_FUNCTION )                                                                  \
+    ARRAY__DEFINE__ALLOCATOR( TYPENAME, TYPENAME_LOWERCASE, ELEMENT_TYPE, ELEMENT_TYPE__EQUALS_FUNCTION, allocator )
+
+/**
+ *  \def ARRAY__DEFINE__ALLOCATOR( TYPENAME, TYPENAME_LOWERCASE, ELEMENT_TYPE, ELEMENT_TYPE__EQUALS_FUNCTION, ALLOCATOR )
+ *  \brief Defines interface methods for a Array type, as ARRAY__DEFINE does, except that memory is managed by a set of
+ *  functions fixed at compile time. ARRAY__DEFINE always manages memory through the Allocator passed to each method,
+ *  which costs an indirect call that the compiler cannot inline. Binding the functions statically lets the compiler
+ *  inline them, and see through allocations which it can elide.
+ *  \param ALLOCATOR The prefix of the functions which manage memory. The methods call ALLOCATOR__alloc,
+ *  ALLOCATOR__calloc, ALLOCATOR__realloc, ALLOCATOR__free, ALLOCATOR__try_expand, ALLOCATOR__alloc_aligned,
+ *  ALLOCATOR__realloc_aligned and ALLOCATOR__free_aligned, each of which takes the same parameters as the allocator__
+ *  function of the same name, and is passed the Allocator which was passed to the method. Passing allocator yields
+ *  ARRAY__DEFINE. Passing malloc_allocator, from \ref kirke/malloc_allocator.h, calls the C library directly.
+ */
+#define ARRAY__DEFINE__ALLOCATOR( TYPENAME, TYPENAME_LOWERCASE, ELEMENT_TYPE, ELEMENT_TYPE__EQUALS_FUNCTION, ALLOCATOR )                                            \
+    ARRAY__DEFINE__IMPLEMENTATION(                                                                                                                                  \
+        TYPENAME,                                                                                                                                                   \
+        TYPENAME_LOWERCASE,                                                                                                                                         \
+        ELEMENT_TYPE,                                                                                                                                               \
+        ELEMENT_TYPE__EQUALS_FUNCTION,                                                                                                                              \
+        ALLOCATOR,                                                                                                                                                  \
+        false,                                                                                                                                                      \
+        TYPENAME_LOWERCASE ## __index_of__scan                                                                                                                      \
+    )
+
+/**
+ *  \def ARRAY__DEFINE_POD( TYPENAME, TYPENAME_LOWERCASE, ELEMENT_TYPE )
+ *  \brief Defines interface methods for a Array type, as ARRAY__DEFINE does, for an ELEMENT_TYPE whose values are
+ *  equal exactly when their bytes are equal, such as char or an integer type. Rather than calling an equality
+ *  function per element, array__equals compares whole arrays with memcmp, and array__index_of scans for the first
+ *  element of the sequence with memchr, where elements are single bytes, and only then compares the rest.
+ *  \note Floating point types, for which 0.0 and -0.0 are equal, and structures with padding bytes, are not suitable.
+ */
+#define ARRAY__DEFINE_POD( TYPENAME, TYPENAME_LOWERCASE, ELEMENT_TYPE )                                                                                             \
+    ARRAY__DEFINE_POD__ALLOCATOR( TYPENAME, TYPENAME_LOWERCASE, ELEMENT_TYPE, allocator )
+
+/**
+ *  \def ARRAY__DEFINE_POD__ALLOCATOR( TYPENAME, TYPENAME_LOWERCASE, ELEMENT_TYPE, ALLOCATOR )
+ *  \brief Combines ARRAY__DEFINE_POD and ARRAY__DEFINE__ALLOCATOR.
+ */
+#define ARRAY__DEFINE_POD__ALLOCATOR( TYPENAME, TYPENAME_LOWERCASE, ELEMENT_TYPE, ALLOCATOR )                                                                       \
+    ARRAY__DEFINE_POD__IMPLEMENTATION( TYPENAME, TYPENAME_LOWERCASE, ELEMENT_TYPE, ALLOCATOR, TYPENAME_LOWERCASE ## __index_of__scan )
+
+/**
+ *  \def ARRAY__DEFINE_POD__INDEX_OF( TYPENAME, TYPENAME_LOWERCASE, ELEMENT_TYPE, INDEX_OF_FUNCTION )
+ *  \brief Defines interface methods for a Array type, as ARRAY__DEFINE_POD does, except that array__index_of calls
+ *  INDEX_OF_FUNCTION, which takes the same parameters. This lets a type with a better search than a scan for the
+ *  first element use it, as String does with a StringSearcher.
+ */
+#define ARRAY__DEFINE_POD__INDEX_OF( TYPENAME, TYPENAME_LOWERCASE, ELEMENT_TYPE, INDEX_OF_FUNCTION )                                                                \
+    ARRAY__DEFINE_POD__IMPLEMENTATION( TYPENAME, TYPENAME_LOWERCASE, ELEMENT_TYPE, allocator, INDEX_OF_FUNCTION )
+
+/**
+ *  \def ARRAY__DEFINE_POD__IMPLEMENTATION( TYPENAME, TYPENAME_LOWERCASE, ELEMENT_TYPE, ALLOCATOR, INDEX_OF_FUNCTION )
+ *  \brief Defines interface methods for a Array type whose elements may be compared bytewise. This is used by the
+ *  other ARRAY__DEFINE_POD macros, which should be used instead.
+ */
+#define ARRAY__DEFINE_POD__IMPLEMENTATION( TYPENAME, TYPENAME_LOWERCASE, ELEMENT_TYPE, ALLOCATOR, INDEX_OF_FUNCTION )                                               \
+    static inline bool TYPENAME_LOWERCASE ## __elements_are_equal( ELEMENT_TYPE first, ELEMENT_TYPE second ){                                                       \
+        return memcmp( &first, &second, sizeof( ELEMENT_TYPE ) ) == 0;                                                                                              \
+    }                                                                                                                                                               \
+                                                                                                                                                                    \
+    ARRAY__DEFINE__IMPLEMENTATION(                                                                                                                                  \
+        TYPENAME,                                                                                                                                                   \
+        TYPENAME_LOWERCASE,                                                                                                                                         \
+        ELEMENT_TYPE,                                                                                                                                               \
+        TYPENAME_LOWERCASE ## __elements_are_equal,                                                                                                                 \
+        ALLOCATOR,                                                                                                                                                  \
+        true,                                                                                                                                                       \
+        INDEX_OF_FUNCTION                                                                                                                                           \
+    )
+
+/**
+ *  \def ARRAY__DEFINE__IMPLEMENTATION( TYPENAME, TYPENAME_LOWERCASE, ELEMENT_TYPE, ELEMENT_TYPE__EQUALS_FUNCTION, ALLOCATOR, BITWISE, INDEX_OF_FUNCTION )
+ *  \brief Defines interface methods for a Array type. This is used by the other ARRAY__DEFINE macros, which should be
+ *  used instead.
+ *  \param BITWISE true if elements may be compared with memcmp, and false if they must be compared with
+ *  ELEMENT_TYPE__EQUALS_FUNCTION. This is a constant, so the compiler removes whichever comparison is not used.
+ *  \param INDEX_OF_FUNCTION The function which implements array__index_of. Passing array__index_of__scan uses the
+ *  scan defined here.
+ */
+#define ARRAY__DEFINE__IMPLEMENTATION( TYPENAME, TYPENAME_LOWERCASE, ELEMENT_TYPE, ELEMENT_TYPE__EQUALS_FUNCTION, ALLOCATOR, BITWISE, INDEX_OF_FUNCTION )           \
                                                                                                                                                                     \
     void TYPENAME_LOWERCASE ## __initialize(                                                                                                                        \
         TYPENAME *TYPENAME_LOWERCASE,                                                                                                                               \
@@ -332,7 +569,7 @@
     ){                                                                                                                                                              \
         *TYPENAME_LOWERCASE = (TYPENAME){                                                                                                                           \
             /* Cast for C++ compatibility */                                                                                                                        \
-            .data = (ELEMENT_TYPE*) allocator__alloc( allocator, capacity * sizeof( ELEMENT_TYPE ) ),                                                               \
+            .data = (ELEMENT_TYPE*) ALLOCATOR ## __alloc( allocator, capacity * sizeof( ELEMENT_TYPE ) ),                                                           \
             .length = 0,                                                                                                                                            \
             .capacity = capacity,                                                                                                                                   \
             .element_size = sizeof( ELEMENT_TYPE )                                                                                                                  \
@@ -348,7 +585,7 @@
     ){                                                                                                                                                              \
         *TYPENAME_LOWERCASE = (TYPENAME) {                                                                                                                          \
             /* Cast for C++ compatibility */                                                                                                                        \
-            .data = (ELEMENT_TYPE*) allocator__alloc( allocator, length * sizeof( ELEMENT_TYPE ) ),                                                                 \
+            .data = (ELEMENT_TYPE*) ALLOCATOR ## __alloc( allocator, length * sizeof( ELEMENT_TYPE ) ),                                                             \
             .length = length,                                                                                                                                       \
             .capacity = capacity,                                                                                                                                   \
             .element_size = sizeof( ELEMENT_TYPE )                                                                                                                  \
@@ -362,7 +599,7 @@
         Allocator *allocator                                                                                                                                        \
     ){                                                                                                                                                              \
         if( TYPENAME_LOWERCASE != NULL ){                                                                                                                           \
-            allocator__free( allocator, TYPENAME_LOWERCASE->data );                                                                                                 \
+            ALLOCATOR ## __free( allocator, TYPENAME_LOWERCASE->data );                                                                                             \
             TYPENAME_LOWERCASE->data = NULL;                                                                                                                        \
             TYPENAME_LOWERCASE->length = 0;                                                                                                                         \
             TYPENAME_LOWERCASE->capacity = 0;                                                                                                                       \
@@ -394,10 +631,10 @@
         TYPENAME const *TYPENAME_LOWERCASE,                                                                                                                         \
         Allocator *allocator                                                                                                                                        \
     ){                                                                                                                                                              \
-        TYPENAME *new_ ## TYPENAME_LOWERCASE = (TYPENAME*) allocator__alloc( allocator, sizeof( TYPENAME ) );                                                       \
+        TYPENAME *new_ ## TYPENAME_LOWERCASE = (TYPENAME*) ALLOCATOR ## __alloc( allocator, sizeof( TYPENAME ) );                                                   \
         *new_ ## TYPENAME_LOWERCASE = (TYPENAME) {                                                                                                                  \
             /* Cast for C++ compatibility */                                                                                                                        \
-            .data = (ELEMENT_TYPE*) allocator__alloc( allocator, TYPENAME_LOWERCASE->length * sizeof( ELEMENT_TYPE ) ),                                             \
+            .data = (ELEMENT_TYPE*) ALLOCATOR ## __alloc( allocator, TYPENAME_LOWERCASE->length * sizeof( ELEMENT_TYPE ) ),                                         \
             .length = TYPENAME_LOWERCASE->length,                                                                                                                   \
             .capacity = TYPENAME_LOWERCASE->capacity,                                                                                                               \
             .element_size = sizeof( ELEMENT_TYPE )                                                                                                                  \
@@ -416,6 +653,10 @@
             return false;                                                                                                                                           \
         }                                                                                                                                                           \
                                                                                                                                                                     \
+        if( BITWISE ){                                                                                                                                              \
+            return first.length == 0 || memcmp( first.data, second.data, first.length * sizeof( ELEMENT_TYPE ) ) == 0;                                              \
+        }                                                                                                                                                           \
+                                                                                                                                                                    \
         for( unsigned long long element_index = 0; element_index < first.length; element_index++ ){                                                                 \
             if( ELEMENT_TYPE__EQUALS_FUNCTION( first.data[ element_index ], second.data[ element_index ] ) == 0 ){                                                  \
                 return false;                                                                                                                                       \
@@ -425,12 +666,48 @@
         return true;                                                                                                                                                \
     }                                                                                                                                                               \
                                                                                                                                                                     \
-    bool TYPENAME_LOWERCASE ## __index_of(                                                                                                                          \
+    static inline bool TYPENAME_LOWERCASE ## __index_of__scan(                                                                                                      \
         const TYPENAME* TYPENAME_LOWERCASE,                                                                                                                         \
         const TYPENAME* sequence,                                                                                                                                   \
         unsigned long long *out_index                                                                                                                               \
     ){                                                                                                                                                              \
-        for( unsigned long long element_index = 0; element_index < TYPENAME_LOWERCASE->length; element_index++ ){                                                   \
+        *out_index = TYPENAME_LOWERCASE->length;                                                                                                                    \
+        if( sequence->length > TYPENAME_LOWERCASE->length ){                                                                                                        \
+            return false;                                                                                                                                           \
+        }                                                                                                                                                           \
+                                                                                                                                                                    \
+        /* The sequence cannot start after this index without running past the end of the array. */                                                                 \
+        unsigned long long last_index = TYPENAME_LOWERCASE->length - sequence->length;                                                                              \
+                                                                                                                                                                    \
+        if( BITWISE && sequence->length > 0 ){                                                                                                                      \
+            ELEMENT_TYPE const *data = TYPENAME_LOWERCASE->data;                                                                                                    \
+            for( unsigned long long element_index = 0; element_index <= last_index; element_index++ ){                                                              \
+                if( sizeof( ELEMENT_TYPE ) == 1 ){                                                                                                                  \
+                    /* Cast for C++ compatibility */                                                                                                                \
+                    ELEMENT_TYPE const *candidate = (ELEMENT_TYPE const*) memchr(                                                                                   \
+                        data + element_index,                                                                                                                       \
+                        *(unsigned char const*) sequence->data,                                                                                                     \
+                        last_index - element_index + 1                                                                                                              \
+                    );                                                                                                                                              \
+                    if( candidate == NULL ){                                                                                                                        \
+                        return false;                                                                                                                               \
+                    }                                                                                                                                               \
+                    element_index = candidate - data;                                                                                                               \
+                }                                                                                                                                                   \
+                else if( memcmp( data + element_index, sequence->data, sizeof( ELEMENT_TYPE ) ) != 0 ){                                                             \
+                    continue;                                                                                                                                       \
+                }                                                                                                                                                   \
+                                                                                                                                                                    \
+                if( memcmp( data + element_index + 1, sequence->data + 1, ( sequence->length - 1 ) * sizeof( ELEMENT_TYPE ) ) == 0 ){                               \
+                    *out_index = element_index;                                                                                                                     \
+                    return true;                                                                                                                                    \
+                }                                                                                                                                                   \
+            }                                                                                                                                                       \
+                                                                                                                                                                    \
+            return false;                                                                                                                                           \
+        }                                                                                                                                                           \
+                                                                                                                                                                    \
+        for( unsigned long long element_index = 0; element_index <= last_index && element_index < TYPENAME_LOWERCASE->length; element_index++ ){                    \
             TYPENAME subsequence = {                                                                                                                                \
                 .data = TYPENAME_LOWERCASE->data + element_index,                                                                                                   \
                 .length = sequence->length,                                                                                                                         \
@@ -447,34 +724,185 @@
         return false;                                                                                                                                               \
     }                                                                                                                                                               \
                                                                                                                                                                     \
+    bool TYPENAME_LOWERCASE ## __index_of(                                                                                                                          \
+        const TYPENAME* TYPENAME_LOWERCASE,                                                                                                                         \
+        const TYPENAME* sequence,                                                                                                                                   \
+        unsigned long long *out_index                                                                                                                               \
+    ){                                                                                                                                                              \
+        return INDEX_OF_FUNCTION( TYPENAME_LOWERCASE, sequence, out_index );                                                                                        \
+    }                                                                                                                                                               \
+                                                                                                                                                                    \
     void auto_ ## TYPENAME_LOWERCASE ## __initialize(                                                                                                               \
         Auto ## TYPENAME *auto_ ## TYPENAME_LOWERCASE,                                                                                                              \
         Allocator *allocator,                                                                                                                                       \
         unsigned long long capacity                                                                                                                                 \
     ){                                                                                                                                                              \
         /* Cast for C++ compatibility */                                                                                                                            \
-        auto_ ## TYPENAME_LOWERCASE->TYPENAME_LOWERCASE = (TYPENAME*) allocator__alloc( allocator, sizeof( TYPENAME ) );                                            \
+        auto_ ## TYPENAME_LOWERCASE->TYPENAME_LOWERCASE = (TYPENAME*) ALLOCATOR ## __alloc( allocator, sizeof( TYPENAME ) );                                        \
         TYPENAME_LOWERCASE ## __initialize( auto_ ## TYPENAME_LOWERCASE->TYPENAME_LOWERCASE, allocator, capacity );                                                 \
         auto_ ## TYPENAME_LOWERCASE->allocator = allocator;                                                                                                         \
+        auto_ ## TYPENAME_LOWERCASE->alignment = 0;                                                                                                                 \
+        auto_ ## TYPENAME_LOWERCASE->uninitialized_growth = false;                                                                                                  \
+        auto_ ## TYPENAME_LOWERCASE->growth_policy = NULL;                                                                                                          \
+    }                                                                                                                                                               \
+                                                                                                                                                                    \
+    void auto_ ## TYPENAME_LOWERCASE ## __initialize__aligned(                                                                                                      \
+        Auto ## TYPENAME *auto_ ## TYPENAME_LOWERCASE,                                                                                                              \
+        Allocator *allocator,                                                                                                                                       \
+        unsigned long long capacity,                                                                                                                                \
+        unsigned long long alignment                                                                                                                                \
+    ){                                                                                                                                                              \
+        /* Cast for C++ compatibility */                                                                                                                            \
+        auto_ ## TYPENAME_LOWERCASE->TYPENAME_LOWERCASE = (TYPENAME*) ALLOCATOR ## __alloc( allocator, sizeof( TYPENAME ) );                                        \
+        *auto_ ## TYPENAME_LOWERCASE->TYPENAME_LOWERCASE = (TYPENAME){                                                                                              \
+            /* Cast for C++ compatibility */                                                                                                                        \
+            .data = (ELEMENT_TYPE*) ALLOCATOR ## __alloc_aligned( allocator, capacity * sizeof( ELEMENT_TYPE ), alignment ),                                        \
+            .length = 0,                                                                                                                                            \
+            .capacity = capacity,                                                                                                                                   \
+            .element_size = sizeof( ELEMENT_TYPE )                                                                                                                  \
+        };                                                                                                                                                          \
+        auto_ ## TYPENAME_LOWERCASE->allocator = allocator;                                                                                                         \
+        auto_ ## TYPENAME_LOWERCASE->alignment = alignment;                                                                                                         \
+        auto_ ## TYPENAME_LOWERCASE->uninitialized_growth = false;                                                                                                  \
+        auto_ ## TYPENAME_LOWERCASE->growth_policy = NULL;                                                                                                          \
     }                                                                                                                                                               \
                                                                                                                                                                     \
     void auto_ ## TYPENAME_LOWERCASE ## __clear( Auto ## TYPENAME *auto_ ## TYPENAME_LOWERCASE ){                                                                   \
         if( auto_ ## TYPENAME_LOWERCASE != NULL ){                                                                                                                  \
+            if( auto_ ## TYPENAME_LOWERCASE->alignment != 0 && auto_ ## TYPENAME_LOWERCASE->TYPENAME_LOWERCASE != NULL ){                                           \
+                ALLOCATOR ## __free_aligned( auto_ ## TYPENAME_LOWERCASE->allocator, auto_ ## TYPENAME_LOWERCASE->TYPENAME_LOWERCASE->data );                       \
+                auto_ ## TYPENAME_LOWERCASE->TYPENAME_LOWERCASE->data = NULL;                                                                                       \
+            }                                                                                                                                                       \
             TYPENAME_LOWERCASE ## __clear( auto_ ## TYPENAME_LOWERCASE->TYPENAME_LOWERCASE, auto_ ## TYPENAME_LOWERCASE->allocator );                               \
-            allocator__free( auto_ ## TYPENAME_LOWERCASE->allocator, auto_ ## TYPENAME_LOWERCASE->TYPENAME_LOWERCASE );                                             \
+            ALLOCATOR ## __free( auto_ ## TYPENAME_LOWERCASE->allocator, auto_ ## TYPENAME_LOWERCASE->TYPENAME_LOWERCASE );                                         \
             auto_ ## TYPENAME_LOWERCASE->TYPENAME_LOWERCASE = NULL;                                                                                                 \
             auto_ ## TYPENAME_LOWERCASE->allocator = NULL;                                                                                                          \
+            auto_ ## TYPENAME_LOWERCASE->alignment = 0;                                                                                                             \
+        }                                                                                                                                                           \
+    }                                                                                                                                                               \
+                                                                                                                                                                    \
+    void auto_ ## TYPENAME_LOWERCASE ## __shrink_to_fit( Auto ## TYPENAME *auto_ ## TYPENAME_LOWERCASE ){                                                           \
+        RETURN_IF_FAIL( auto_ ## TYPENAME_LOWERCASE != NULL && auto_ ## TYPENAME_LOWERCASE->TYPENAME_LOWERCASE != NULL );                                           \
+                                                                                                                                                                    \
+        TYPENAME *TYPENAME_LOWERCASE = auto_ ## TYPENAME_LOWERCASE->TYPENAME_LOWERCASE;                                                                             \
+        if( TYPENAME_LOWERCASE->data == NULL || TYPENAME_LOWERCASE->capacity <= TYPENAME_LOWERCASE->length ){                                                       \
+            return;                                                                                                                                                 \
+        }                                                                                                                                                           \
+                                                                                                                                                                    \
+        /* One element beyond the last is kept, so that an AutoString stays null-terminated. */                                                                     \
+        unsigned long long bytes_required = ( TYPENAME_LOWERCASE->length + 1 ) * TYPENAME_LOWERCASE->element_size;                                                  \
+        ELEMENT_TYPE *data = NULL;                                                                                                                                  \
+        if( auto_ ## TYPENAME_LOWERCASE->alignment != 0 ){                                                                                                          \
+            /* Cast for C++ compatibility */                                                                                                                        \
+            data = (ELEMENT_TYPE*) ALLOCATOR ## __realloc_aligned(                                                                                                  \
+                auto_ ## TYPENAME_LOWERCASE->allocator,                                                                                                             \
+                TYPENAME_LOWERCASE->data,                                                                                                                           \
+                TYPENAME_LOWERCASE->length * TYPENAME_LOWERCASE->element_size,                                                                                      \
+                bytes_required,                                                                                                                                     \
+                auto_ ## TYPENAME_LOWERCASE->alignment                                                                                                              \
+            );                                                                                                                                                      \
+        }                                                                                                                                                           \
+        else{                                                                                                                                                       \
+            /* Cast for C++ compatibility */                                                                                                                        \
+            data = (ELEMENT_TYPE*) ALLOCATOR ## __realloc( auto_ ## TYPENAME_LOWERCASE->allocator, TYPENAME_LOWERCASE->data, bytes_required );                      \
+        }                                                                                                                                                           \
+                                                                                                                                                                    \
+        if( data != NULL ){                                                                                                                                         \
+            TYPENAME_LOWERCASE->data = data;                                                                                                                        \
+            TYPENAME_LOWERCASE->capacity = TYPENAME_LOWERCASE->length;                                                                                              \
+            memset( data + TYPENAME_LOWERCASE->length, 0, TYPENAME_LOWERCASE->element_size );                                                                       \
+        }                                                                                                                                                           \
+    }                                                                                                                                                               \
+                                                                                                                                                                    \
+    void auto_ ## TYPENAME_LOWERCASE ## __shrink_to_fit__callback( void *auto_ ## TYPENAME_LOWERCASE ){                                                             \
+        /* Cast for C++ compatibility */                                                                                                                            \
+        auto_ ## TYPENAME_LOWERCASE ## __shrink_to_fit( (Auto ## TYPENAME*) auto_ ## TYPENAME_LOWERCASE );                                                          \
+    }                                                                                                                                                               \
+                                                                                                                                                                    \
+    /**                                                                                                                                                             \
+     *  \brief Reallocates auto_array->array->data to hold exactly new_capacity elements, and the element after                                                     \
+     *  the last.                                                                                                                                                   \
+     *  \param auto_ ## TYPENAME_LOWERCASE A pointer to the AutoArray whose memory will be expanded.                                                                \
+     *  \param new_capacity The new capacity, in elements.                                                                                                          \
+     *  \returns Returns true if the memory was expanded.                                                                                                           \
+     *  \returns Returns false if the allocator is out of memory, in which case the AutoArray keeps its old memory.                                                 \
+     */                                                                                                                                                             \
+    static bool auto_ ## TYPENAME_LOWERCASE ## __expand(                                                                                                            \
+        Auto ## TYPENAME *auto_ ## TYPENAME_LOWERCASE,                                                                                                              \
+        unsigned long long new_capacity                                                                                                                             \
+    ){                                                                                                                                                              \
+        unsigned long long bytes_required = ( new_capacity + 1 ) * auto_ ## TYPENAME_LOWERCASE->TYPENAME_LOWERCASE->element_size;                                   \
+        ELEMENT_TYPE *data = auto_ ## TYPENAME_LOWERCASE->TYPENAME_LOWERCASE->data;                                                                                 \
+        bool zeroed = false;                                                                                                                                        \
+                                                                                                                                                                    \
+        if( auto_ ## TYPENAME_LOWERCASE->alignment != 0 ){                                                                                                          \
+            /* Cast for C++ compatibility */                                                                                                                        \
+            data = (ELEMENT_TYPE*) ALLOCATOR ## __realloc_aligned(                                                                                                  \
+                auto_ ## TYPENAME_LOWERCASE->allocator,                                                                                                             \
+                auto_ ## TYPENAME_LOWERCASE->TYPENAME_LOWERCASE->data,                                                                                              \
+                auto_ ## TYPENAME_LOWERCASE->TYPENAME_LOWERCASE->length * auto_ ## TYPENAME_LOWERCASE->TYPENAME_LOWERCASE->element_size,                            \
+                bytes_required,                                                                                                                                     \
+                auto_ ## TYPENAME_LOWERCASE->alignment                                                                                                              \
+            );                                                                                                                                                      \
+        }                                                                                                                                                           \
+        /* Growing the data in place, where the allocator is able to, avoids copying the existing elements. */                                                      \
+        else if(                                                                                                                                                    \
+            auto_ ## TYPENAME_LOWERCASE->TYPENAME_LOWERCASE->data == NULL ||                                                                                        \
+            !ALLOCATOR ## __try_expand( auto_ ## TYPENAME_LOWERCASE->allocator, auto_ ## TYPENAME_LOWERCASE->TYPENAME_LOWERCASE->data, bytes_required )             \
+        ){                                                                                                                                                          \
+            /* An empty array has nothing to copy, so its new data may as well come zeroed from the allocator. */                                                   \
+            if( !auto_ ## TYPENAME_LOWERCASE->uninitialized_growth && auto_ ## TYPENAME_LOWERCASE->TYPENAME_LOWERCASE->length == 0 ){                               \
+                /* Cast for C++ compatibility */                                                                                                                    \
+                data = (ELEMENT_TYPE*) ALLOCATOR ## __calloc( auto_ ## TYPENAME_LOWERCASE->allocator, 1, bytes_required );                                          \
+                if( data != NULL ){                                                                                                                                 \
+                    ALLOCATOR ## __free( auto_ ## TYPENAME_LOWERCASE->allocator, auto_ ## TYPENAME_LOWERCASE->TYPENAME_LOWERCASE->data );                           \
+                }                                                                                                                                                   \
+                zeroed = true;                                                                                                                                      \
+            }                                                                                                                                                       \
+            else{                                                                                                                                                   \
+                /* Cast for C++ compatibility */                                                                                                                    \
+                data = (ELEMENT_TYPE*) ALLOCATOR ## __realloc(                                                                                                      \
+                    auto_ ## TYPENAME_LOWERCASE->allocator,                                                                                                         \
+                    auto_ ## TYPENAME_LOWERCASE->TYPENAME_LOWERCASE->data,                                                                                          \
+                    bytes_required                                                                                                                                  \
+                );                                                                                                                                                  \
+            }                                                                                                                                                       \
+        }                                                                                                                                                           \
+                                                                                                                                                                    \
+        /* A failed reallocation leaves the old memory allocated, so the AutoArray must keep hold of it. */                                                         \
+        if( data == NULL ){                                                                                                                                         \
+            return false;                                                                                                                                           \
+        }                                                                                                                                                           \
+                                                                                                                                                                    \
+        auto_ ## TYPENAME_LOWERCASE->TYPENAME_LOWERCASE->data = data;                                                                                               \
+        auto_ ## TYPENAME_LOWERCASE->TYPENAME_LOWERCASE->capacity = new_capacity;                                                                                   \
+                                                                                                                                                                    \
+        if( !zeroed ){                                                                                                                                              \
+            /* The element after the last is always zeroed, so that an AutoString filled to capacity stays null-terminated. */                                      \
+            memset( auto_ ## TYPENAME_LOWERCASE->TYPENAME_LOWERCASE->data + new_capacity, 0, auto_ ## TYPENAME_LOWERCASE->TYPENAME_LOWERCASE->element_size );       \
+                                                                                                                                                                    \
+            if( !auto_ ## TYPENAME_LOWERCASE->uninitialized_growth ){                                                                                               \
+                TYPENAME_LOWERCASE ## __clear_elements(                                                                                                             \
+                    auto_ ## TYPENAME_LOWERCASE->TYPENAME_LOWERCASE,                                                                                                \
+                    auto_ ## TYPENAME_LOWERCASE->TYPENAME_LOWERCASE->length,                                                                                        \
+                    auto_ ## TYPENAME_LOWERCASE->TYPENAME_LOWERCASE->capacity - auto_ ## TYPENAME_LOWERCASE->TYPENAME_LOWERCASE->length                             \
+                );                                                                                                                                                  \
+            }                                                                                                                                                       \
         }                                                                                                                                                           \
+                                                                                                                                                                    \
+        return true;                                                                                                                                                \
     }                                                                                                                                                               \
                                                                                                                                                                     \
     /**                                                                                                                                                             \
      *  \brief Possibly expands the memory allocated for auto_array->array->data.                                                                                   \
      *  If auto_array->capacity < new_capacity, then the memory allocated for auto_array->array->data                                                               \
-     *  will be expanded to new_capacity. Otherwise, no action is taken.                                                                                            \
-     *  \param auto_ ## TYPENAME_LOWERCASE A pointer to the AutoSlice whose memory may be expanded.                                                                 \
+     *  will be expanded to at least new_capacity, as given by the AutoArray's growth policy. Otherwise, no action                                                  \
+     *  is taken.                                                                                                                                                   \
+     *  \param auto_ ## TYPENAME_LOWERCASE A pointer to the AutoArray whose memory may be expanded.                                                                 \
      *  \param new_capacity The desired capacity, in elements.                                                                                                      \
+     *  \returns Returns false if the memory had to be expanded, but the allocator is out of memory.                                                                \
      */                                                                                                                                                             \
-    static void auto_ ## TYPENAME_LOWERCASE ## __maybe_expand(                                                                                                      \
+    static bool auto_ ## TYPENAME_LOWERCASE ## __maybe_expand(                                                                                                      \
         Auto ## TYPENAME *auto_ ## TYPENAME_LOWERCASE,                                                                                                              \
         unsigned long long new_capacity                                                                                                                             \
     ){                                                                                                                                                              \
@@ -482,21 +910,47 @@
             auto_ ## TYPENAME_LOWERCASE->TYPENAME_LOWERCASE->data == NULL ||                                                                                        \
             new_capacity > auto_ ## TYPENAME_LOWERCASE->TYPENAME_LOWERCASE->capacity                                                                                \
         ){                                                                                                                                                          \
-            unsigned long bytes_required = math__nearest_greater_power_of_2__ulong( auto_ ## TYPENAME_LOWERCASE->TYPENAME_LOWERCASE->element_size * new_capacity ); \
-                                                                                                                                                                    \
-            /* Cast for C++ compatibility */                                                                                                                        \
-            auto_ ## TYPENAME_LOWERCASE->TYPENAME_LOWERCASE->data = (ELEMENT_TYPE*) allocator__realloc(                                                             \
-                auto_ ## TYPENAME_LOWERCASE->allocator,                                                                                                             \
-                auto_ ## TYPENAME_LOWERCASE->TYPENAME_LOWERCASE->data,                                                                                              \
-                bytes_required                                                                                                                                      \
+            return auto_ ## TYPENAME_LOWERCASE ## __expand(                                                                                                         \
+                auto_ ## TYPENAME_LOWERCASE,                                                                                                                        \
+                array__growth_policy__capacity(                                                                                                                     \
+                    auto_ ## TYPENAME_LOWERCASE->growth_policy,                                                                                                     \
+                    auto_ ## TYPENAME_LOWERCASE->TYPENAME_LOWERCASE->data == NULL ? 0 : auto_ ## TYPENAME_LOWERCASE->TYPENAME_LOWERCASE->capacity,                  \
+                    new_capacity,                                                                                                                                   \
+                    auto_ ## TYPENAME_LOWERCASE->TYPENAME_LOWERCASE->element_size                                                                                   \
+                )                                                                                                                                                   \
             );                                                                                                                                                      \
+        }                                                                                                                                                           \
+                                                                                                                                                                    \
+        return true;                                                                                                                                                \
+    }                                                                                                                                                               \
+                                                                                                                                                                    \
+    bool auto_ ## TYPENAME_LOWERCASE ## __reserve(                                                                                                                  \
+        Auto ## TYPENAME *auto_ ## TYPENAME_LOWERCASE,                                                                                                              \
+        unsigned long long capacity                                                                                                                                 \
+    ){                                                                                                                                                              \
+        RETURN_VALUE_IF_FAIL( auto_ ## TYPENAME_LOWERCASE != NULL && auto_ ## TYPENAME_LOWERCASE->TYPENAME_LOWERCASE != NULL, false );                              \
                                                                                                                                                                     \
-            auto_ ## TYPENAME_LOWERCASE->TYPENAME_LOWERCASE->capacity = ( bytes_required / auto_ ## TYPENAME_LOWERCASE->TYPENAME_LOWERCASE->element_size ) - 1;     \
+        if( auto_ ## TYPENAME_LOWERCASE->TYPENAME_LOWERCASE->data == NULL || capacity > auto_ ## TYPENAME_LOWERCASE->TYPENAME_LOWERCASE->capacity ){                \
+            return auto_ ## TYPENAME_LOWERCASE ## __expand( auto_ ## TYPENAME_LOWERCASE, capacity );                                                                \
+        }                                                                                                                                                           \
                                                                                                                                                                     \
+        return true;                                                                                                                                                \
+    }                                                                                                                                                               \
+                                                                                                                                                                    \
+    /**                                                                                                                                                             \
+     *  \brief Zeroes the element after the last element of an AutoArray whose growth leaves memory uninitialized,                                                  \
+     *  if there is room for it. Otherwise, growth has zeroed it already.                                                                                           \
+     *  \param auto_ ## TYPENAME_LOWERCASE A pointer to the AutoArray.                                                                                              \
+     */                                                                                                                                                             \
+    static void auto_ ## TYPENAME_LOWERCASE ## __terminate( Auto ## TYPENAME *auto_ ## TYPENAME_LOWERCASE ){                                                        \
+        if(                                                                                                                                                         \
+            auto_ ## TYPENAME_LOWERCASE->uninitialized_growth &&                                                                                                    \
+            auto_ ## TYPENAME_LOWERCASE->TYPENAME_LOWERCASE->length < auto_ ## TYPENAME_LOWERCASE->TYPENAME_LOWERCASE->capacity                                     \
+        ){                                                                                                                                                          \
             TYPENAME_LOWERCASE ## __clear_elements(                                                                                                                 \
                 auto_ ## TYPENAME_LOWERCASE->TYPENAME_LOWERCASE,                                                                                                    \
                 auto_ ## TYPENAME_LOWERCASE->TYPENAME_LOWERCASE->length,                                                                                            \
-                auto_ ## TYPENAME_LOWERCASE->TYPENAME_LOWERCASE->capacity - auto_ ## TYPENAME_LOWERCASE->TYPENAME_LOWERCASE->length                                 \
+                1                                                                                                                                                   \
             );                                                                                                                                                      \
         }                                                                                                                                                           \
     }                                                                                                                                                               \
@@ -516,7 +970,8 @@
         RETURN_IF_FAIL( auto_ ## TYPENAME_LOWERCASE != NULL );                                                                                                      \
         RETURN_IF_FAIL( element_count > 0 );                                                                                                                        \
                                                                                                                                                                     \
-        auto_ ## TYPENAME_LOWERCASE ## __maybe_expand( auto_ ## TYPENAME_LOWERCASE, auto_ ## TYPENAME_LOWERCASE->TYPENAME_LOWERCASE->length + element_count );      \
+        unsigned long long length_after_insertion = auto_ ## TYPENAME_LOWERCASE->TYPENAME_LOWERCASE->length + element_count;                                        \
+        RETURN_IF_FAIL( auto_ ## TYPENAME_LOWERCASE ## __maybe_expand( auto_ ## TYPENAME_LOWERCASE, length_after_insertion ) );                                     \
                                                                                                                                                                     \
         memcpy(                                                                                                                                                     \
             auto_ ## TYPENAME_LOWERCASE->TYPENAME_LOWERCASE->data + auto_ ## TYPENAME_LOWERCASE->TYPENAME_LOWERCASE->length,                                        \
@@ -525,6 +980,7 @@
         );                                                                                                                                                          \
                                                                                                                                                                     \
         auto_ ## TYPENAME_LOWERCASE->TYPENAME_LOWERCASE->length += element_count;                                                                                   \
+        auto_ ## TYPENAME_LOWERCASE ## __terminate( auto_ ## TYPENAME_LOWERCASE );                                                                                  \
     }                                                                                                                                                               \
                                                                                                                                                                     \
     void auto_ ## TYPENAME_LOWERCASE ## __prepend_element(                                                                                                   \
@@ -542,7 +998,8 @@
         RETURN_IF_FAIL( auto_ ## TYPENAME_LOWERCASE != NULL );                                                                                                      \
         RETURN_IF_FAIL( element_count > 0 );                                                                                                                        \
                                                                                                                                                                     \
-        auto_ ## TYPENAME_LOWERCASE ## __maybe_expand( auto_ ## TYPENAME_LOWERCASE, auto_ ## TYPENAME_LOWERCASE->TYPENAME_LOWERCASE->length + element_count );      \
+        unsigned long long length_after_insertion = auto_ ## TYPENAME_LOWERCASE->TYPENAME_LOWERCASE->length + element_count;                                        \
+        RETURN_IF_FAIL( auto_ ## TYPENAME_LOWERCASE ## __maybe_expand( auto_ ## TYPENAME_LOWERCASE, length_after_insertion ) );                                     \
                                                                                                                                                                     \
         /* We use mem__move here because whenever element_count < length, the memory regions will overlap. */                                                       \
         memmove(                                                                                                                                                    \
@@ -558,6 +1015,7 @@
         );                                                                                                                                                          \
                                                                                                                                                                     \
         auto_ ## TYPENAME_LOWERCASE->TYPENAME_LOWERCASE->length += element_count;                                                                                   \
+        auto_ ## TYPENAME_LOWERCASE ## __terminate( auto_ ## TYPENAME_LOWERCASE );                                                                                  \
     }                                                                                                                                                               \
                                                                                                                                                                     \
     void auto_ ## TYPENAME_LOWERCASE ## __insert_element(                                                                                                    \
@@ -580,7 +1038,16 @@
         /* This calculation allows for inserting elements at an index greater than the auto_ ## TYPENAME_LOWERCASE's length. */                                     \
         unsigned long long length_after_insertion = math__max__ullong( auto_ ## TYPENAME_LOWERCASE->TYPENAME_LOWERCASE->length, start_index ) + element_count;      \
                                                                                                                                                                     \
-        auto_ ## TYPENAME_LOWERCASE ## __maybe_expand( auto_ ## TYPENAME_LOWERCASE, length_after_insertion );                                                       \
+        RETURN_IF_FAIL( auto_ ## TYPENAME_LOWERCASE ## __maybe_expand( auto_ ## TYPENAME_LOWERCASE, length_after_insertion ) );                                     \
+                                                                                                                                                                    \
+        /* Elements skipped over by inserting beyond the end are zeroed, whatever was left there before. */                                                         \
+        if( start_index > auto_ ## TYPENAME_LOWERCASE->TYPENAME_LOWERCASE->length ){                                                                                \
+            TYPENAME_LOWERCASE ## __clear_elements(                                                                                                                 \
+                auto_ ## TYPENAME_LOWERCASE->TYPENAME_LOWERCASE,                                                                                                    \
+                auto_ ## TYPENAME_LOWERCASE->TYPENAME_LOWERCASE->length,                                                                                            \
+                start_index - auto_ ## TYPENAME_LOWERCASE->TYPENAME_LOWERCASE->length                                                                               \
+            );                                                                                                                                                      \
+        }                                                                                                                                                           \
                                                                                                                                                                     \
         /* We only have to make room for the inserted elements if they are inserted between existing elements.  */                                                  \
         if( start_index < auto_ ## TYPENAME_LOWERCASE->TYPENAME_LOWERCASE->length ){                                                                                \
@@ -598,6 +1065,7 @@
         );                                                                                                                                                          \
                                                                                                                                                                     \
         auto_ ## TYPENAME_LOWERCASE->TYPENAME_LOWERCASE->length = length_after_insertion;                                                                           \
+        auto_ ## TYPENAME_LOWERCASE ## __terminate( auto_ ## TYPENAME_LOWERCASE );                                                                                  \
     }                                                                                                                                                               \
                                                                                                                                                                     \
     void auto_ ## TYPENAME_LOWERCASE ## __remove_element(                                                                                                           \
@@ -651,6 +1119,469 @@
         );                                                                                                                                                          \
                                                                                                                                                                     \
         auto_ ## TYPENAME_LOWERCASE->TYPENAME_LOWERCASE->length -= element_count;                                                                                   \
+    }                                                                                                                                                               \
+                                                                                                                                                                    \
+    /**                                                                                                                                                             \
+     *  \brief Sets the length of an AutoArray, growing it as necessary, and zeroes the element after the last.                                                     \
+     *  \param auto_ ## TYPENAME_LOWERCASE A pointer to the AutoArray.                                                                                              \
+     *  \param length The new length, in elements.                                                                                                                  \
+     *  \param zero_new_elements Whether elements added by lengthening the AutoArray are zeroed.                                                                    \
+     */                                                                                                                                                             \
+    static void auto_ ## TYPENAME_LOWERCASE ## __set_length(                                                                                                        \
+        Auto ## TYPENAME *auto_ ## TYPENAME_LOWERCASE,                                                                                                              \
+        unsigned long long length,                                                                                                                                  \
+        bool zero_new_elements                                                                                                                                      \
+    ){                                                                                                                                                              \
+        RETURN_IF_FAIL( auto_ ## TYPENAME_LOWERCASE != NULL && auto_ ## TYPENAME_LOWERCASE->TYPENAME_LOWERCASE != NULL );                                           \
+                                                                                                                                                                    \
+        TYPENAME *TYPENAME_LOWERCASE = auto_ ## TYPENAME_LOWERCASE->TYPENAME_LOWERCASE;                                                                             \
+        if( length > TYPENAME_LOWERCASE->length ){                                                                                                                  \
+            /* Growth zeroes everything after the last element already, unless it leaves memory uninitialized. */                                                   \
+            bool zeroed_by_growth = (                                                                                                                               \
+                ( TYPENAME_LOWERCASE->data == NULL || length > TYPENAME_LOWERCASE->capacity ) &&                                                                    \
+                !auto_ ## TYPENAME_LOWERCASE->uninitialized_growth                                                                                                  \
+            );                                                                                                                                                      \
+            RETURN_IF_FAIL( auto_ ## TYPENAME_LOWERCASE ## __maybe_expand( auto_ ## TYPENAME_LOWERCASE, length ) );                                                 \
+                                                                                                                                                                    \
+            if( zero_new_elements && !zeroed_by_growth ){                                                                                                           \
+                TYPENAME_LOWERCASE ## __clear_elements( TYPENAME_LOWERCASE, TYPENAME_LOWERCASE->length, length - TYPENAME_LOWERCASE->length );                      \
+            }                                                                                                                                                       \
+        }                                                                                                                                                           \
+                                                                                                                                                                    \
+        TYPENAME_LOWERCASE->length = length;                                                                                                                        \
+        if( length < TYPENAME_LOWERCASE->capacity ){                                                                                                                \
+            TYPENAME_LOWERCASE ## __clear_elements( TYPENAME_LOWERCASE, length, 1 );                                                                                \
+        }                                                                                                                                                           \
+    }                                                                                                                                                               \
+                                                                                                                                                                    \
+    void auto_ ## TYPENAME_LOWERCASE ## __resize(                                                                                                                   \
+        Auto ## TYPENAME *auto_ ## TYPENAME_LOWERCASE,                                                                                                              \
+        unsigned long long length                                                                                                                                   \
+    ){                                                                                                                                                              \
+        auto_ ## TYPENAME_LOWERCASE ## __set_length( auto_ ## TYPENAME_LOWERCASE, length, true );                                                                   \
+    }                                                                                                                                                               \
+                                                                                                                                                                    \
+    void auto_ ## TYPENAME_LOWERCASE ## __resize__uninitialized(                                                                                                    \
+        Auto ## TYPENAME *auto_ ## TYPENAME_LOWERCASE,                                                                                                              \
+        unsigned long long length                                                                                                                                   \
+    ){                                                                                                                                                              \
+        auto_ ## TYPENAME_LOWERCASE ## __set_length( auto_ ## TYPENAME_LOWERCASE, length, false );                                                                  \
+    }                                                                                                                                                               \
+                                                                                                                                                                    \
+    void auto_ ## TYPENAME_LOWERCASE ## __clear__keep_capacity(                                                                                                     \
+        Auto ## TYPENAME *auto_ ## TYPENAME_LOWERCASE                                                                                                               \
+    ){                                                                                                                                                              \
+        auto_ ## TYPENAME_LOWERCASE ## __set_length( auto_ ## TYPENAME_LOWERCASE, 0, false );                                                                       \
+    }
+
+/**
+ *  \def ARRAY__DECLARE_SMALL( TYPENAME, TYPENAME_LOWERCASE, ARRAY_TYPENAME, ELEMENT_TYPE, INLINE_CAPACITY )
+ *  \brief Declares a structure and interface methods for a small array type, which stores up to INLINE_CAPACITY
+ *  elements within the structure itself, and only allocates memory once it holds more. This macro should be paired
+ *  with a call to the macro
+ *      ARRAY__DEFINE_SMALL( TYPENAME, TYPENAME_LOWERCASE, ARRAY_TYPENAME, ELEMENT_TYPE, INLINE_CAPACITY ).
+ *  Small arrays grow in the same way as an AutoArray without a growth policy, and are always followed by a zeroed
+ *  element, so that a small array of char holds a null-terminated string.
+ *  \param TYPENAME The name which will be assigned to the structure type.
+ *  \param TYPENAME_LOWERCASE Same as TYPENAME, only lowercase. This will be used to prefix interface methods,
+ *  as well as to name local variables and parameters for the interface methods.
+ *  \param ARRAY_TYPENAME The name of an array type of the same ELEMENT_TYPE, declared with ARRAY__DECLARE, which
+ *  is used to view the elements of the small array.
+ *  \param ELEMENT_TYPE The type which will be stored in the small array.
+ *  \param INLINE_CAPACITY The number of elements stored within the structure.
+ */
+#define ARRAY__DECLARE_SMALL( TYPENAME, TYPENAME_LOWERCASE, ARRAY_TYPENAME, ELEMENT_TYPE, INLINE_CAPACITY )                                                         \
+    /*                                                                                                                                                              \
+     *  An array which stores its first elements inline, rather than in memory allocated for them.                                                                  \
+     */                                                                                                                                                             \
+    typedef struct TYPENAME {                                                                                                                                       \
+        /**                                                                                                                                                         \
+         *  The memory allocated for the elements once they no longer fit inline, or NULL while they are inline.                                                    \
+         */                                                                                                                                                         \
+        ELEMENT_TYPE *spilled_data;                                                                                                                                 \
+        /**                                                                                                                                                         \
+         *  The length of the array, in elements.                                                                                                                   \
+         */                                                                                                                                                         \
+        unsigned long long length;                                                                                                                                  \
+        /**                                                                                                                                                         \
+         *  The capacity of the array, in elements, which is INLINE_CAPACITY while the elements are inline.                                                         \
+         */                                                                                                                                                         \
+        unsigned long long capacity;                                                                                                                                \
+        /**                                                                                                                                                         \
+         *  The allocator used once the elements no longer fit inline. This is borrowed rather than owned.                                                          \
+         */                                                                                                                                                         \
+        Allocator *allocator;                                                                                                                                       \
+        /**                                                                                                                                                         \
+         *  The inline elements, and the zeroed element after the last.                                                                                             \
+         */                                                                                                                                                         \
+        ELEMENT_TYPE inline_data[ INLINE_CAPACITY + 1 ];                                                                                                            \
+    } TYPENAME;                                                                                                                                                     \
+                                                                                                                                                                    \
+    /**                                                                                                                                                             \
+     *  \brief Returns a pointer to the elements of a small array, wherever they are stored.                                                                        \
+     *  \param small_array A pointer to the small array.                                                                                                            \
+     *  \returns Returns a pointer to the first element, which is invalidated by any insertion.                                                                     \
+     */                                                                                                                                                             \
+    static inline ELEMENT_TYPE *TYPENAME_LOWERCASE ## __data( TYPENAME *TYPENAME_LOWERCASE ){                                                                       \
+        return TYPENAME_LOWERCASE->spilled_data != NULL ? TYPENAME_LOWERCASE->spilled_data : TYPENAME_LOWERCASE->inline_data;                                       \
+    }                                                                                                                                                               \
+                                                                                                                                                                    \
+    /**                                                                                                                                                             \
+     *  \brief Initializes an empty small array, without allocating memory.                                                                                         \
+     *  \param small_array A pointer to the small array to be initialized.                                                                                          \
+     *  \param allocator A pointer to the allocator which will be used once the elements no longer fit inline.                                                      \
+     *  \note A small array whose elements are inline can be copied, but one whose elements have spilled must not be                                                \
+     *  cleared through more than one copy.                                                                                                                         \
+     */                                                                                                                                                             \
+    void TYPENAME_LOWERCASE ## __initialize(                                                                                                                        \
+        TYPENAME *TYPENAME_LOWERCASE,                                                                                                                               \
+        Allocator *allocator                                                                                                                                        \
+    );                                                                                                                                                              \
+                                                                                                                                                                    \
+    /**                                                                                                                                                             \
+     *  \brief Frees the memory allocated for the elements of a small array, if any, and empties it. The small array                                                \
+     *  stays initialized, and can be used again.                                                                                                                   \
+     *  \param small_array A pointer to the small array to be cleared.                                                                                              \
+     */                                                                                                                                                             \
+    void TYPENAME_LOWERCASE ## __clear(                                                                                                                             \
+        TYPENAME *TYPENAME_LOWERCASE                                                                                                                                \
+    );                                                                                                                                                              \
+                                                                                                                                                                    \
+    /**                                                                                                                                                             \
+     *  \brief Removes every element from a small array, keeping its capacity.                                                                                      \
+     *  \param small_array A pointer to the small array to be emptied.                                                                                              \
+     */                                                                                                                                                             \
+    void TYPENAME_LOWERCASE ## __clear__keep_capacity(                                                                                                              \
+        TYPENAME *TYPENAME_LOWERCASE                                                                                                                                \
+    );                                                                                                                                                              \
+                                                                                                                                                                    \
+    /**                                                                                                                                                             \
+     *  \brief Returns an array which views the elements of a small array, so that it can be passed to array                                                        \
+     *  methods, such as array__index_of. The view is invalidated by any insertion.                                                                                 \
+     *  \param small_array A pointer to the small array.                                                                                                            \
+     *  \returns Returns an array sharing the elements of \p small_array.                                                                                           \
+     */                                                                                                                                                             \
+    ARRAY_TYPENAME TYPENAME_LOWERCASE ## __array(                                                                                                                   \
+        TYPENAME *TYPENAME_LOWERCASE                                                                                                                                \
+    );                                                                                                                                                              \
+                                                                                                                                                                    \
+    /**                                                                                                                                                             \
+     *  \brief Ensures that a small array has room for at least \p capacity elements, allocating exactly that much                                                  \
+     *  if it must grow.                                                                                                                                            \
+     *  \param small_array A pointer to the small array.                                                                                                            \
+     *  \param capacity The required capacity, in elements.                                                                                                         \
+     *  \returns Returns true if the small array has room for \p capacity elements.                                                                                 \
+     *  \returns Returns false if its allocator is out of memory, in which case the small array is left unchanged.                                                  \
+     */                                                                                                                                                             \
+    bool TYPENAME_LOWERCASE ## __reserve(                                                                                                                           \
+        TYPENAME *TYPENAME_LOWERCASE,                                                                                                                               \
+        unsigned long long capacity                                                                                                                                 \
+    );                                                                                                                                                              \
+                                                                                                                                                                    \
+    /**                                                                                                                                                             \
+     *  \brief Appends elements to the end of a small array, allocating memory as necessary.                                                                        \
+     *  \param small_array A pointer to the small array to which the elements will be appended.                                                                     \
+     *  \param element_count The number of elements to be appended.                                                                                                 \
+     *  \param data A pointer to the elements to be appended.                                                                                                       \
+     */                                                                                                                                                             \
+    void TYPENAME_LOWERCASE ## __append_elements(                                                                                                                   \
+        TYPENAME *TYPENAME_LOWERCASE,                                                                                                                               \
+        unsigned long long element_count,                                                                                                                           \
+        ELEMENT_TYPE const *data                                                                                                                                    \
+    );                                                                                                                                                              \
+                                                                                                                                                                    \
+    /**                                                                                                                                                             \
+     *  \brief Appends a single element to the end of a small array, allocating memory as necessary.                                                                \
+     *  \param small_array A pointer to the small array to which the element will be appended.                                                                      \
+     *  \param element The element to be appended.                                                                                                                  \
+     */                                                                                                                                                             \
+    void TYPENAME_LOWERCASE ## __append_element(                                                                                                                    \
+        TYPENAME *TYPENAME_LOWERCASE,                                                                                                                               \
+        ELEMENT_TYPE element                                                                                                                                        \
+    );                                                                                                                                                              \
+                                                                                                                                                                    \
+    /**                                                                                                                                                             \
+     *  \brief Prepends elements to the beginning of a small array, allocating memory as necessary.                                                                 \
+     *  \param small_array A pointer to the small array to which the elements will be prepended.                                                                    \
+     *  \param element_count The number of elements to be prepended.                                                                                                \
+     *  \param data A pointer to the elements to be prepended.                                                                                                      \
+     */                                                                                                                                                             \
+    void TYPENAME_LOWERCASE ## __prepend_elements(                                                                                                                  \
+        TYPENAME *TYPENAME_LOWERCASE,                                                                                                                               \
+        unsigned long long element_count,                                                                                                                           \
+        ELEMENT_TYPE const *data                                                                                                                                    \
+    );                                                                                                                                                              \
+                                                                                                                                                                    \
+    /**                                                                                                                                                             \
+     *  \brief Prepends a single element to the beginning of a small array, allocating memory as necessary.                                                         \
+     *  \param small_array A pointer to the small array to which the element will be prepended.                                                                     \
+     *  \param element The element to be prepended.                                                                                                                 \
+     */                                                                                                                                                             \
+    void TYPENAME_LOWERCASE ## __prepend_element(                                                                                                                   \
+        TYPENAME *TYPENAME_LOWERCASE,                                                                                                                               \
+        ELEMENT_TYPE element                                                                                                                                        \
+    );                                                                                                                                                              \
+                                                                                                                                                                    \
+    /**                                                                                                                                                             \
+     *  \brief Inserts elements at the specified location of a small array, allocating memory as necessary. Inserting                                               \
+     *  beyond the end zeroes the elements skipped over.                                                                                                            \
+     *  \param small_array A pointer to the small array into which elements will be inserted.                                                                       \
+     *  \param start_index The index at which the first element will be inserted.                                                                                   \
+     *  \param element_count The number of elements to be inserted.                                                                                                 \
+     *  \param data A pointer to the elements to be inserted.                                                                                                       \
+     */                                                                                                                                                             \
+    void TYPENAME_LOWERCASE ## __insert_elements(                                                                                                                   \
+        TYPENAME *TYPENAME_LOWERCASE,                                                                                                                               \
+        unsigned long long start_index,                                                                                                                             \
+        unsigned long long element_count,                                                                                                                           \
+        ELEMENT_TYPE const *data                                                                                                                                    \
+    );                                                                                                                                                              \
+                                                                                                                                                                    \
+    /**                                                                                                                                                             \
+     *  \brief Inserts a single element at the specified location of a small array, allocating memory as necessary.                                                 \
+     *  \param small_array A pointer to the small array into which the element will be inserted.                                                                    \
+     *  \param index The index at which the element will be inserted.                                                                                               \
+     *  \param element The element to be inserted.                                                                                                                  \
+     */                                                                                                                                                             \
+    void TYPENAME_LOWERCASE ## __insert_element(                                                                                                                    \
+        TYPENAME *TYPENAME_LOWERCASE,                                                                                                                               \
+        unsigned long long index,                                                                                                                                   \
+        ELEMENT_TYPE element                                                                                                                                        \
+    );                                                                                                                                                              \
+                                                                                                                                                                    \
+    /**                                                                                                                                                             \
+     *  \brief Removes the element at the given index, preserving the order of the remaining elements.                                                              \
+     *  \param small_array A pointer to the small array from which the element will be removed.                                                                     \
+     *  \param element_index The index of the element to be removed.                                                                                                \
+     */                                                                                                                                                             \
+    void TYPENAME_LOWERCASE ## __remove_element(                                                                                                                    \
+        TYPENAME *TYPENAME_LOWERCASE,                                                                                                                               \
+        unsigned long long element_index                                                                                                                            \
+    );                                                                                                                                                              \
+                                                                                                                                                                    \
+    /**                                                                                                                                                             \
+     *  \brief Removes the element at the given index, by copying the last element to it.                                                                           \
+     *  \param small_array A pointer to the small array from which the element will be removed.                                                                     \
+     *  \param element_index The index of the element to be removed.                                                                                                \
+     */                                                                                                                                                             \
+    void TYPENAME_LOWERCASE ## __remove_element__fast(                                                                                                              \
+        TYPENAME *TYPENAME_LOWERCASE,                                                                                                                               \
+        unsigned long long element_index                                                                                                                            \
+    );                                                                                                                                                              \
+                                                                                                                                                                    \
+    /**                                                                                                                                                             \
+     *  \brief Removes a sequence of elements from a small array.                                                                                                   \
+     *  \param small_array A pointer to the small array from which elements will be removed.                                                                        \
+     *  \param start_index The index of the first element to be removed.                                                                                            \
+     *  \param element_count The number of elements to be removed.                                                                                                  \
+     */                                                                                                                                                             \
+    void TYPENAME_LOWERCASE ## __remove_range(                                                                                                                      \
+        TYPENAME *TYPENAME_LOWERCASE,                                                                                                                               \
+        unsigned long long start_index,                                                                                                                             \
+        unsigned long long element_count                                                                                                                            \
+    );
+
+/**
+ *  \def ARRAY__DEFINE_SMALL( TYPENAME, TYPENAME_LOWERCASE, ARRAY_TYPENAME, ELEMENT_TYPE, INLINE_CAPACITY )
+ *  \brief Defines interface methods for a small array type. This macro must be paired with a call to the macro
+ *  ARRAY__DECLARE_SMALL( TYPENAME, TYPENAME_LOWERCASE, ARRAY_TYPENAME, ELEMENT_TYPE, INLINE_CAPACITY ), with the same
+ *  parameters.
+ */
+#define ARRAY__DEFINE_SMALL( TYPENAME, TYPENAME_LOWERCASE, ARRAY_TYPENAME, ELEMENT_TYPE, INLINE_CAPACITY )                                                          \
+    void TYPENAME_LOWERCASE ## __initialize(                                                                                                                        \
+        TYPENAME *TYPENAME_LOWERCASE,                                                                                                                               \
+        Allocator *allocator                                                                                                                                        \
+    ){                                                                                                                                                              \
+        TYPENAME_LOWERCASE->spilled_data = NULL;                                                                                                                    \
+        TYPENAME_LOWERCASE->length = 0;                                                                                                                             \
+        TYPENAME_LOWERCASE->capacity = INLINE_CAPACITY;                                                                                                             \
+        TYPENAME_LOWERCASE->allocator = allocator;                                                                                                                  \
+        memset( &TYPENAME_LOWERCASE->inline_data[ 0 ], 0, sizeof( ELEMENT_TYPE ) );                                                                                 \
+    }                                                                                                                                                               \
+                                                                                                                                                                    \
+    void TYPENAME_LOWERCASE ## __clear( TYPENAME *TYPENAME_LOWERCASE ){                                                                                             \
+        RETURN_IF_FAIL( TYPENAME_LOWERCASE != NULL );                                                                                                               \
+                                                                                                                                                                    \
+        if( TYPENAME_LOWERCASE->spilled_data != NULL ){                                                                                                             \
+            allocator__free( TYPENAME_LOWERCASE->allocator, TYPENAME_LOWERCASE->spilled_data );                                                                     \
+        }                                                                                                                                                           \
+        TYPENAME_LOWERCASE ## __initialize( TYPENAME_LOWERCASE, TYPENAME_LOWERCASE->allocator );                                                                    \
+    }                                                                                                                                                               \
+                                                                                                                                                                    \
+    void TYPENAME_LOWERCASE ## __clear__keep_capacity( TYPENAME *TYPENAME_LOWERCASE ){                                                                              \
+        RETURN_IF_FAIL( TYPENAME_LOWERCASE != NULL );                                                                                                               \
+                                                                                                                                                                    \
+        TYPENAME_LOWERCASE->length = 0;                                                                                                                             \
+        memset( TYPENAME_LOWERCASE ## __data( TYPENAME_LOWERCASE ), 0, sizeof( ELEMENT_TYPE ) );                                                                    \
+    }                                                                                                                                                               \
+                                                                                                                                                                    \
+    ARRAY_TYPENAME TYPENAME_LOWERCASE ## __array( TYPENAME *TYPENAME_LOWERCASE ){                                                                                   \
+        return (ARRAY_TYPENAME){                                                                                                                                    \
+            .data = TYPENAME_LOWERCASE ## __data( TYPENAME_LOWERCASE ),                                                                                             \
+            .length = TYPENAME_LOWERCASE->length,                                                                                                                   \
+            .capacity = TYPENAME_LOWERCASE->capacity,                                                                                                               \
+            .element_size = sizeof( ELEMENT_TYPE )                                                                                                                  \
+        };                                                                                                                                                          \
+    }                                                                                                                                                               \
+                                                                                                                                                                    \
+    /**                                                                                                                                                             \
+     *  \brief Moves the elements of a small array to memory allocated for exactly new_capacity elements, and the                                                   \
+     *  element after the last.                                                                                                                                     \
+     *  \param TYPENAME_LOWERCASE A pointer to the small array whose memory will be expanded.                                                                       \
+     *  \param new_capacity The new capacity, in elements.                                                                                                          \
+     *  \returns Returns false if the allocator is out of memory, in which case the small array keeps its old memory.                                               \
+     */                                                                                                                                                             \
+    static bool TYPENAME_LOWERCASE ## __expand(                                                                                                                     \
+        TYPENAME *TYPENAME_LOWERCASE,                                                                                                                               \
+        unsigned long long new_capacity                                                                                                                             \
+    ){                                                                                                                                                              \
+        unsigned long long bytes_required = ( new_capacity + 1 ) * sizeof( ELEMENT_TYPE );                                                                          \
+        ELEMENT_TYPE *spilled_data = NULL;                                                                                                                          \
+                                                                                                                                                                    \
+        if( TYPENAME_LOWERCASE->spilled_data == NULL ){                                                                                                             \
+            /* Cast for C++ compatibility */                                                                                                                        \
+            spilled_data = (ELEMENT_TYPE*) allocator__alloc( TYPENAME_LOWERCASE->allocator, bytes_required );                                                       \
+            RETURN_VALUE_IF_FAIL( spilled_data != NULL, false );                                                                                                    \
+            memcpy( spilled_data, TYPENAME_LOWERCASE->inline_data, ( TYPENAME_LOWERCASE->length + 1 ) * sizeof( ELEMENT_TYPE ) );                                   \
+        }                                                                                                                                                           \
+        else{                                                                                                                                                       \
+            /* Cast for C++ compatibility */                                                                                                                        \
+            spilled_data = (ELEMENT_TYPE*) allocator__realloc( TYPENAME_LOWERCASE->allocator, TYPENAME_LOWERCASE->spilled_data, bytes_required );                   \
+            RETURN_VALUE_IF_FAIL( spilled_data != NULL, false );                                                                                                    \
+        }                                                                                                                                                           \
+        TYPENAME_LOWERCASE->spilled_data = spilled_data;                                                                                                            \
+        TYPENAME_LOWERCASE->capacity = new_capacity;                                                                                                                \
+                                                                                                                                                                    \
+        return true;                                                                                                                                                \
+    }                                                                                                                                                               \
+                                                                                                                                                                    \
+    bool TYPENAME_LOWERCASE ## __reserve(                                                                                                                           \
+        TYPENAME *TYPENAME_LOWERCASE,                                                                                                                               \
+        unsigned long long capacity                                                                                                                                 \
+    ){                                                                                                                                                              \
+        RETURN_VALUE_IF_FAIL( TYPENAME_LOWERCASE != NULL, false );                                                                                                  \
+                                                                                                                                                                    \
+        if( capacity > TYPENAME_LOWERCASE->capacity ){                                                                                                              \
+            return TYPENAME_LOWERCASE ## __expand( TYPENAME_LOWERCASE, capacity );                                                                                  \
+        }                                                                                                                                                           \
+                                                                                                                                                                    \
+        return true;                                                                                                                                                \
+    }                                                                                                                                                               \
+                                                                                                                                                                    \
+    void TYPENAME_LOWERCASE ## __append_elements(                                                                                                                   \
+        TYPENAME *TYPENAME_LOWERCASE,                                                                                                                               \
+        unsigned long long element_count,                                                                                                                           \
+        ELEMENT_TYPE const *data                                                                                                                                    \
+    ){                                                                                                                                                              \
+        RETURN_IF_FAIL( TYPENAME_LOWERCASE != NULL );                                                                                                               \
+                                                                                                                                                                    \
+        TYPENAME_LOWERCASE ## __insert_elements( TYPENAME_LOWERCASE, TYPENAME_LOWERCASE->length, element_count, data );                                             \
+    }                                                                                                                                                               \
+                                                                                                                                                                    \
+    void TYPENAME_LOWERCASE ## __append_element(                                                                                                                    \
+        TYPENAME *TYPENAME_LOWERCASE,                                                                                                                               \
+        ELEMENT_TYPE element                                                                                                                                        \
+    ){                                                                                                                                                              \
+        RETURN_IF_FAIL( TYPENAME_LOWERCASE != NULL );                                                                                                               \
+                                                                                                                                                                    \
+        TYPENAME_LOWERCASE ## __insert_elements( TYPENAME_LOWERCASE, TYPENAME_LOWERCASE->length, 1, &element );                                                     \
+    }                                                                                                                                                               \
+                                                                                                                                                                    \
+    void TYPENAME_LOWERCASE ## __prepend_elements(                                                                                                                  \
+        TYPENAME *TYPENAME_LOWERCASE,                                                                                                                               \
+        unsigned long long element_count,                                                                                                                           \
+        ELEMENT_TYPE const *data                                                                                                                                    \
+    ){                                                                                                                                                              \
+        TYPENAME_LOWERCASE ## __insert_elements( TYPENAME_LOWERCASE, 0, element_count, data );                                                                      \
+    }                                                                                                                                                               \
+                                                                                                                                                                    \
+    void TYPENAME_LOWERCASE ## __prepend_element(                                                                                                                   \
+        TYPENAME *TYPENAME_LOWERCASE,                                                                                                                               \
+        ELEMENT_TYPE element                                                                                                                                        \
+    ){                                                                                                                                                              \
+        TYPENAME_LOWERCASE ## __insert_elements( TYPENAME_LOWERCASE, 0, 1, &element );                                                                              \
+    }                                                                                                                                                               \
+                                                                                                                                                                    \
+    void TYPENAME_LOWERCASE ## __insert_elements(                                                                                                                   \
+        TYPENAME *TYPENAME_LOWERCASE,                                                                                                                               \
+        unsigned long long start_index,                                                                                                                             \
+        unsigned long long element_count,                                                                                                                           \
+        ELEMENT_TYPE const *data                                                                                                                                    \
+    ){                                                                                                                                                              \
+        RETURN_IF_FAIL( TYPENAME_LOWERCASE != NULL );                                                                                                               \
+        RETURN_IF_FAIL( element_count > 0 );                                                                                                                        \
+                                                                                                                                                                    \
+        unsigned long long length_after_insertion = math__max__ullong( TYPENAME_LOWERCASE->length, start_index ) + element_count;                                   \
+        if( length_after_insertion > TYPENAME_LOWERCASE->capacity ){                                                                                                \
+            bool expanded = TYPENAME_LOWERCASE ## __expand(                                                                                                         \
+                TYPENAME_LOWERCASE,                                                                                                                                 \
+                array__growth_policy__capacity( NULL, TYPENAME_LOWERCASE->capacity, length_after_insertion, sizeof( ELEMENT_TYPE ) )                                \
+            );                                                                                                                                                      \
+            RETURN_IF_FAIL( expanded );                                                                                                                             \
+        }                                                                                                                                                           \
+                                                                                                                                                                    \
+        ELEMENT_TYPE *elements = TYPENAME_LOWERCASE ## __data( TYPENAME_LOWERCASE );                                                                                \
+        if( start_index > TYPENAME_LOWERCASE->length ){                                                                                                             \
+            memset( elements + TYPENAME_LOWERCASE->length, 0, ( start_index - TYPENAME_LOWERCASE->length ) * sizeof( ELEMENT_TYPE ) );                              \
+        }                                                                                                                                                           \
+        else{                                                                                                                                                       \
+            memmove(                                                                                                                                                \
+                elements + start_index + element_count,                                                                                                             \
+                elements + start_index,                                                                                                                             \
+                ( TYPENAME_LOWERCASE->length - start_index ) * sizeof( ELEMENT_TYPE )                                                                               \
+            );                                                                                                                                                      \
+        }                                                                                                                                                           \
+        memcpy( elements + start_index, data, element_count * sizeof( ELEMENT_TYPE ) );                                                                             \
+                                                                                                                                                                    \
+        TYPENAME_LOWERCASE->length = length_after_insertion;                                                                                                        \
+        memset( elements + TYPENAME_LOWERCASE->length, 0, sizeof( ELEMENT_TYPE ) );                                                                                 \
+    }                                                                                                                                                               \
+                                                                                                                                                                    \
+    void TYPENAME_LOWERCASE ## __insert_element(                                                                                                                    \
+        TYPENAME *TYPENAME_LOWERCASE,                                                                                                                               \
+        unsigned long long index,                                                                                                                                   \
+        ELEMENT_TYPE element                                                                                                                                        \
+    ){                                                                                                                                                              \
+        TYPENAME_LOWERCASE ## __insert_elements( TYPENAME_LOWERCASE, index, 1, &element );                                                                          \
+    }                                                                                                                                                               \
+                                                                                                                                                                    \
+    void TYPENAME_LOWERCASE ## __remove_element(                                                                                                                    \
+        TYPENAME *TYPENAME_LOWERCASE,                                                                                                                               \
+        unsigned long long element_index                                                                                                                            \
+    ){                                                                                                                                                              \
+        TYPENAME_LOWERCASE ## __remove_range( TYPENAME_LOWERCASE, element_index, 1 );                                                                               \
+    }                                                                                                                                                               \
+                                                                                                                                                                    \
+    void TYPENAME_LOWERCASE ## __remove_element__fast(                                                                                                              \
+        TYPENAME *TYPENAME_LOWERCASE,                                                                                                                               \
+        unsigned long long element_index                                                                                                                            \
+    ){                                                                                                                                                              \
+        RETURN_IF_FAIL( TYPENAME_LOWERCASE != NULL );                                                                                                               \
+        RETURN_IF_FAIL( element_index < TYPENAME_LOWERCASE->length );                                                                                               \
+                                                                                                                                                                    \
+        ELEMENT_TYPE *elements = TYPENAME_LOWERCASE ## __data( TYPENAME_LOWERCASE );                                                                                \
+        TYPENAME_LOWERCASE->length--;                                                                                                                               \
+        elements[ element_index ] = elements[ TYPENAME_LOWERCASE->length ];                                                                                         \
+        memset( elements + TYPENAME_LOWERCASE->length, 0, sizeof( ELEMENT_TYPE ) );                                                                                 \
+    }                                                                                                                                                               \
+                                                                                                                                                                    \
+    void TYPENAME_LOWERCASE ## __remove_range(                                                                                                                      \
+        TYPENAME *TYPENAME_LOWERCASE,                                                                                                                               \
+        unsigned long long start_index,                                                                                                                             \
+        unsigned long long element_count                                                                                                                            \
+    ){                                                                                                                                                              \
+        RETURN_IF_FAIL( TYPENAME_LOWERCASE != NULL );                                                                                                               \
+        RETURN_IF_FAIL( start_index + element_count <= TYPENAME_LOWERCASE->length );                                                                                \
+                                                                                                                                                                    \
+        ELEMENT_TYPE *elements = TYPENAME_LOWERCASE ## __data( TYPENAME_LOWERCASE );                                                                                \
+        memmove(                                                                                                                                                    \
+            elements + start_index,                                                                                                                                 \
+            elements + start_index + element_count,                                                                                                                 \
+            ( TYPENAME_LOWERCASE->length - ( start_index + element_count ) ) * sizeof( ELEMENT_TYPE )                                                               \
+        );                                                                                                                                                          \
+                                                                                                                                                                    \
+        TYPENAME_LOWERCASE->length -= element_count;                                                                                                                \
+        memset( elements + TYPENAME_LOWERCASE->length, 0, sizeof( ELEMENT_TYPE ) );                                                                                 \
     }
 
 /**
@@ -0,0 +1,171 @@
+/**
+ *  \file kirke/buddy_allocator.h
+ */
+
+#ifndef KIRKE__BUDDY_ALLOCATOR__H
+#define KIRKE__BUDDY_ALLOCATOR__H
+
+// System Includes
+#include <stdbool.h>
+
+// Internal Includes
+#include "kirke/macros.h"
+#include "kirke/allocator.h"
+
+BEGIN_DECLARATIONS
+
+/**
+ *  \defgroup buddy_allocator BuddyAllocator
+ *  @{
+ */
+
+/**
+ *  \def BUDDY_ALLOCATOR__MINIMUM_BLOCK_SIZE
+ *  \brief The size in bytes of the smallest block, of order 0. Every block is this size times a power of 2.
+ */
+#define BUDDY_ALLOCATOR__MINIMUM_BLOCK_SIZE 64ULL
+
+/**
+ *  \def BUDDY_ALLOCATOR__ORDER_COUNT
+ *  \brief The number of block orders, which bounds the size of the largest block.
+ */
+#define BUDDY_ALLOCATOR__ORDER_COUNT 48
+
+/**
+ *  \brief Opaque type representing a free block, linked into the free list for its order. Defined in
+ *  kirke/src/buddy_allocator.c.
+ */
+typedef struct BuddyAllocator__FreeBlock BuddyAllocator__FreeBlock;
+
+/**
+ *  \brief Statistics describing the memory managed by a BuddyAllocator, as returned by buddy_allocator__statistics.
+ */
+typedef struct BuddyAllocator__Statistics{
+    /**
+     *  The number of bytes managed by the allocator.
+     */
+    unsigned long long total_bytes;
+    /**
+     *  The number of bytes in allocated blocks, including block headers and the rounding of each request up to
+     *  a power of 2.
+     */
+    unsigned long long allocated_bytes;
+    /**
+     *  The number of bytes requested by the allocations which are live. The difference from
+     *  \ref allocated_bytes is lost to internal fragmentation.
+     */
+    unsigned long long requested_bytes;
+    /**
+     *  The number of bytes in free blocks.
+     */
+    unsigned long long free_bytes;
+    /**
+     *  The number of free blocks.
+     */
+    unsigned long long free_block_count;
+    /**
+     *  The size in bytes of the largest free block, which bounds the largest allocation that can succeed.
+     */
+    unsigned long long largest_free_block;
+    /**
+     *  The fraction of free bytes which lie outside the largest free block, from 0, when all free memory is one
+     *  block, towards 1, when it is scattered across many small blocks.
+     */
+    double external_fragmentation;
+} BuddyAllocator__Statistics;
+
+/**
+ *  \brief An allocator which manages a fixed region of memory with the binary buddy system, for code which
+ *  needs a fixed memory budget and a bound on the time taken by every allocation.
+ *  Each request is rounded up, together with a small header, to a block of \ref BUDDY_ALLOCATOR__MINIMUM_BLOCK_SIZE
+ *  times a power of 2. Larger free blocks are split in halves to obtain it, and freed blocks are merged with their
+ *  free halves, or buddies, again. Both take O( log n ) time in the size of the region, and never call the system.
+ *  The region is either supplied by the caller, or mapped once by buddy_allocator__initialize__mapped. Allocations
+ *  fail, rather than grow the region, once it is exhausted.
+ *  A BuddyAllocator must only be used by one thread at a time.
+ *  \note Allocations are aligned to 16 bytes.
+ */
+typedef struct BuddyAllocator{
+    /**
+     *  The initialized allocator, which can be passed to any method requiring an allocator parameter. This is NULL
+     *  if the region was too small to manage, or could not be mapped.
+     */
+    Allocator *allocator;
+    /**
+     *  The start of the managed region, aligned to 16 bytes.
+     */
+    char *base;
+    /**
+     *  The number of bytes managed, which is a multiple of \ref BUDDY_ALLOCATOR__MINIMUM_BLOCK_SIZE.
+     */
+    unsigned long long size;
+    /**
+     *  The mapping which was made by buddy_allocator__initialize__mapped, or NULL if the region was supplied by the
+     *  caller.
+     */
+    void *mapping;
+    /**
+     *  The size in bytes of \ref mapping.
+     */
+    unsigned long long mapping_size;
+    /**
+     *  The free blocks of each order, in doubly-linked lists.
+     */
+    BuddyAllocator__FreeBlock *free_lists[ BUDDY_ALLOCATOR__ORDER_COUNT ];
+    /**
+     *  The number of free blocks of each order.
+     */
+    unsigned long long free_block_counts[ BUDDY_ALLOCATOR__ORDER_COUNT ];
+    /**
+     *  The number of bytes in allocated blocks.
+     */
+    unsigned long long allocated_bytes;
+    /**
+     *  The number of bytes requested by the live allocations.
+     */
+    unsigned long long requested_bytes;
+} BuddyAllocator;
+
+/**
+ *  \brief Initializes a BuddyAllocator structure, which manages a region of memory supplied by the caller.
+ *  \param buddy_allocator A pointer to the BuddyAllocator to be initialized.
+ *  \param region The start of the region. It must stay valid, and must not be used otherwise, until
+ *  \p buddy_allocator is de-initialized.
+ *  \param size The size in bytes of the region. It need not be a power of 2. Any bytes beyond the last multiple
+ *  of \ref BUDDY_ALLOCATOR__MINIMUM_BLOCK_SIZE are left unused.
+ *  \note The Allocator structure itself is allocated from the region. If the region is too small for it, then
+ *  \ref BuddyAllocator::allocator is set to NULL.
+ */
+void buddy_allocator__initialize( BuddyAllocator *buddy_allocator, void *region, unsigned long long size );
+
+/**
+ *  \brief Initializes a BuddyAllocator structure, which manages a region of \p size bytes mapped from the
+ *  operating system. The region is mapped once, here, and unmapped by buddy_allocator__deinitialize.
+ *  \param buddy_allocator A pointer to the BuddyAllocator to be initialized.
+ *  \param size The size in bytes of the region.
+ *  \note If the region cannot be mapped, then \ref BuddyAllocator::allocator is set to NULL.
+ */
+void buddy_allocator__initialize__mapped( BuddyAllocator *buddy_allocator, unsigned long long size );
+
+/**
+ *  \brief De-initializes a BuddyAllocator structure, unmapping its region if it was mapped by
+ *  buddy_allocator__initialize__mapped. A region supplied by the caller may be reused once this returns.
+ *  \param buddy_allocator A pointer to the BuddyAllocator to be de-initialized.
+ *  \note Any memory allocated from \p buddy_allocator is invalid after this call.
+ */
+void buddy_allocator__deinitialize( BuddyAllocator *buddy_allocator );
+
+/**
+ *  \brief Retrieves statistics describing the memory managed by a BuddyAllocator. This takes O( log n ) time.
+ *  \param buddy_allocator A pointer to the BuddyAllocator.
+ *  \param out_statistics A pointer to the structure which receives the statistics.
+ */
+void buddy_allocator__statistics( BuddyAllocator const *buddy_allocator, BuddyAllocator__Statistics *out_statistics );
+
+/**
+ *  @} group buddy_allocator
+ */
+
+END_DECLARATIONS
+
+#endif // KIRKE__BUDDY_ALLOCATOR__H
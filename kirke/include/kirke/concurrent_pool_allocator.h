@@ -0,0 +1,136 @@
+/**
+ *  \file kirke/concurrent_pool_allocator.h
+ */
+
+#ifndef KIRKE__CONCURRENT_POOL_ALLOCATOR__H
+#define KIRKE__CONCURRENT_POOL_ALLOCATOR__H
+
+// System Includes
+#include <stdbool.h>
+
+// Internal Includes
+#include "kirke/macros.h"
+#include "kirke/allocator.h"
+
+BEGIN_DECLARATIONS
+
+/**
+ *  \defgroup concurrent_pool_allocator ConcurrentPoolAllocator
+ *  @{
+ */
+
+/**
+ *  \def CONCURRENT_POOL_ALLOCATOR__DEFAULT_SLAB_SIZE
+ *  \brief The slab size used when zero is passed to concurrent_pool_allocator__initialize.
+ */
+#define CONCURRENT_POOL_ALLOCATOR__DEFAULT_SLAB_SIZE ( 2ULL * 1024ULL * 1024ULL )
+
+/**
+ *  \def CONCURRENT_POOL_ALLOCATOR__MAXIMUM_SLAB_COUNT
+ *  \brief The largest number of slabs a ConcurrentPoolAllocator can allocate. Allocations fail once every slab is
+ *  in use.
+ */
+#define CONCURRENT_POOL_ALLOCATOR__MAXIMUM_SLAB_COUNT 4096ULL
+
+/**
+ *  \def CONCURRENT_POOL_ALLOCATOR__MAGAZINE_SIZE
+ *  \brief The number of objects in a full magazine, which is the unit in which objects move between a thread and
+ *  the shared depot.
+ */
+#define CONCURRENT_POOL_ALLOCATOR__MAGAZINE_SIZE 64ULL
+
+/**
+ *  \brief Opaque type holding the state shared by all threads using a ConcurrentPoolAllocator: the lock-free stack
+ *  of full magazines, the slabs, and the list of per-thread magazines. Defined in
+ *  kirke/src/concurrent_pool_allocator.c.
+ */
+typedef struct ConcurrentPoolAllocator__Depot ConcurrentPoolAllocator__Depot;
+
+/**
+ *  \brief A thread-safe allocator which serves objects of a single, fixed size from large slabs, for objects which
+ *  are allocated by one thread and freed by another, such as list links passed from a producer to a consumer.
+ *  Each thread allocates from, and frees to, a pair of magazines of its own - linked lists of up to
+ *  \ref CONCURRENT_POOL_ALLOCATOR__MAGAZINE_SIZE free objects - without any synchronization. When both run empty,
+ *  the thread pops a full magazine from the depot shared by all threads. When both are full, it pushes one. The
+ *  depot is a lock-free stack whose head carries a tag, which changes with every push and pop, so that a head which
+ *  was popped and pushed again by other threads in the meantime is never mistaken for an unchanged one (the ABA
+ *  problem). A mutex is only taken to carve fresh objects from a slab, once the depot is empty.
+ *  Requests larger than the object size are forwarded to the backing allocator. Slabs are only returned to the
+ *  backing allocator by concurrent_pool_allocator__deinitialize.
+ *  A single ConcurrentPoolAllocator can be shared by any number of threads through its \ref allocator field.
+ *  \note Objects are aligned to the largest power of 2 which divides the object size, up to the slab size.
+ */
+typedef struct ConcurrentPoolAllocator{
+    /**
+     *  The initialized allocator, which can be passed to any method requiring an allocator parameter. This is NULL
+     *  if the depot could not be allocated.
+     */
+    Allocator *allocator;
+    /**
+     *  The allocator from which slabs, and requests larger than \ref object_size, are allocated. This must be
+     *  thread-safe, for example the allocator of a \ref SystemAllocator. It is borrowed rather than owned.
+     */
+    Allocator *backing_allocator;
+    /**
+     *  The size in bytes of each object served from a slab. This is the size passed to
+     *  concurrent_pool_allocator__initialize, rounded up to a multiple of 8 bytes, and to at least 16 bytes.
+     */
+    unsigned long long object_size;
+    /**
+     *  The size in bytes of each slab, which is a power of 2. Slabs are aligned to their size.
+     */
+    unsigned long long slab_size;
+    /**
+     *  The state shared by all threads using this allocator.
+     */
+    ConcurrentPoolAllocator__Depot *depot;
+} ConcurrentPoolAllocator;
+
+/**
+ *  \brief Initializes a ConcurrentPoolAllocator structure.
+ *  \param concurrent_pool_allocator A pointer to the ConcurrentPoolAllocator to be initialized.
+ *  \param backing_allocator The thread-safe allocator which will be used to allocate slabs and large requests.
+ *  \param object_size The size in bytes of the objects which will be served by the pool.
+ *  \param slab_size The size in bytes of each slab, which is rounded up to a power of 2. If 0, then
+ *  \ref CONCURRENT_POOL_ALLOCATOR__DEFAULT_SLAB_SIZE is used.
+ */
+void concurrent_pool_allocator__initialize(
+    ConcurrentPoolAllocator *concurrent_pool_allocator,
+    Allocator *backing_allocator,
+    unsigned long long object_size,
+    unsigned long long slab_size
+);
+
+/**
+ *  \brief De-initializes a ConcurrentPoolAllocator structure, returning all of its slabs to the backing allocator.
+ *  \param concurrent_pool_allocator A pointer to the ConcurrentPoolAllocator to be de-initialized.
+ *  \note No other thread may be using \p concurrent_pool_allocator during this call. Any objects allocated from
+ *  \p concurrent_pool_allocator are invalid after this call. Requests which were forwarded to the backing allocator
+ *  are not freed.
+ */
+void concurrent_pool_allocator__deinitialize( ConcurrentPoolAllocator *concurrent_pool_allocator );
+
+/**
+ *  \brief Returns the objects in the calling thread's magazines to the depot, where other threads can reuse them.
+ *  This happens automatically when a thread exits.
+ *  \param concurrent_pool_allocator A pointer to the ConcurrentPoolAllocator.
+ */
+void concurrent_pool_allocator__flush( ConcurrentPoolAllocator *concurrent_pool_allocator );
+
+/**
+ *  \brief Determines whether a pointer refers to an object served from one of a ConcurrentPoolAllocator's slabs.
+ *  This takes constant time, and may be called by any thread.
+ *  \param concurrent_pool_allocator A pointer to the ConcurrentPoolAllocator.
+ *  \param pointer The pointer to be tested.
+ *  \returns Returns true if \p pointer lies within one of the pool's slabs.
+ *  \returns Returns false otherwise.
+ */
+bool concurrent_pool_allocator__owns( ConcurrentPoolAllocator const *concurrent_pool_allocator, void const *pointer );
+
+/**
+ *  @} group concurrent_pool_allocator
+ */
+
+END_DECLARATIONS
+
+#endif // KIRKE__CONCURRENT_POOL_ALLOCATOR__H
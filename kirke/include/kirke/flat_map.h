@@ -0,0 +1,203 @@
+/**
+ *  \file kirke/flat_map.h
+ */
+
+#ifndef KIRKE__FLAT_MAP__H
+#define KIRKE__FLAT_MAP__H
+
+// System Includes
+#include <stdbool.h>
+
+// Internal Includes
+#include "kirke/macros.h"
+#include "kirke/array.h"
+#include "kirke/ordered_array.h"
+
+/**
+ *  \defgroup flat_map Flat Map
+ *  @{
+ */
+
+/**
+ *  A Flat Map keeps its key:value pairs sorted by key, in a single contiguous AutoArray, and finds keys by binary
+ *  search. Compared to a Hash Map, which allocates a list node for every entry, it takes no memory per entry beyond
+ *  the pair itself, and iterates in key order, at the speed of reading an array. Insertion and deletion move the
+ *  pairs after the affected one, which makes a Flat Map best suited to small and medium maps, and to maps which are
+ *  built once, with METHOD_PREFIX__initialize__pairs, and then mostly read.
+ */
+
+/**
+ *  \def FLAT_MAP__DECLARE( TYPENAME, METHOD_PREFIX, KEY_TYPE, VALUE_TYPE )
+ *  \brief Declares a Flat Map type. This macro should be paired with a call to the macro
+ *      FLAT_MAP__DEFINE( TYPENAME, METHOD_PREFIX, KEY_TYPE, VALUE_TYPE, KEY_TYPE__LESS_FUNCTION ).
+ *  \param TYPENAME The name of the Flat Map type.
+ *  \param METHOD_PREFIX The prefix of the Flat Map type's methods.
+ *  \param KEY_TYPE The type of the keys.
+ *  \param VALUE_TYPE The type of the values.
+ */
+#define FLAT_MAP__DECLARE( TYPENAME, METHOD_PREFIX, KEY_TYPE, VALUE_TYPE )                                                                          \
+    typedef struct TYPENAME ## __KeyValuePair {                                                                                                     \
+        KEY_TYPE key;                                                                                                                               \
+        VALUE_TYPE value;                                                                                                                           \
+    } TYPENAME ## __KeyValuePair;                                                                                                                   \
+                                                                                                                                                    \
+    ARRAY__DECLARE( TYPENAME ## __Array__KeyValuePair, METHOD_PREFIX ## __array__key_value_pair, TYPENAME ## __KeyValuePair )                       \
+    ORDERED_ARRAY__DECLARE( TYPENAME ## __Array__KeyValuePair, METHOD_PREFIX ## __array__key_value_pair, TYPENAME ## __KeyValuePair )               \
+                                                                                                                                                    \
+    typedef struct TYPENAME {                                                                                                                       \
+        /**                                                                                                                                         \
+         *  The key:value pairs of the map, in ascending order of key, no two of which have equal keys.                                             \
+         */                                                                                                                                         \
+        Auto ## TYPENAME ## __Array__KeyValuePair pairs;                                                                                            \
+    } TYPENAME;                                                                                                                                     \
+                                                                                                                                                    \
+    /**                                                                                                                                             \
+     *  \brief Initializes an empty Flat Map.                                                                                                       \
+     *  \param flat_map A pointer to the Flat Map to be initialized.                                                                                \
+     *  \param allocator A pointer to the Allocator which will manage the memory of the Flat Map.                                                   \
+     *  \param capacity The number of key:value pairs for which to allocate memory.                                                                 \
+     */                                                                                                                                             \
+    void METHOD_PREFIX ## __initialize( TYPENAME *flat_map, Allocator *allocator, unsigned long long capacity );                                    \
+                                                                                                                                                    \
+    /**                                                                                                                                             \
+     *  \brief Initializes a Flat Map with the given key:value pairs, in any order, by sorting them and removing                                    \
+     *  duplicate keys in one pass. This is much faster than inserting them one at a time. Of pairs with equal keys,                                \
+     *  the last is kept, as if each were inserted in turn.                                                                                         \
+     *  \param flat_map A pointer to the Flat Map to be initialized.                                                                                \
+     *  \param allocator A pointer to the Allocator which will manage the memory of the Flat Map.                                                   \
+     *  \param pair_count The number of key:value pairs.                                                                                            \
+     *  \param pairs A pointer to the key:value pairs, which are copied.                                                                            \
+     */                                                                                                                                             \
+    void METHOD_PREFIX ## __initialize__pairs(                                                                                                      \
+        TYPENAME *flat_map,                                                                                                                         \
+        Allocator *allocator,                                                                                                                       \
+        unsigned long long pair_count,                                                                                                              \
+        TYPENAME ## __KeyValuePair const *pairs                                                                                                     \
+    );                                                                                                                                              \
+                                                                                                                                                    \
+    void METHOD_PREFIX ## __clear( TYPENAME *flat_map );                                                                                            \
+                                                                                                                                                    \
+    /**                                                                                                                                             \
+     *  \brief Inserts a key:value pair, replacing the value of an equal key.                                                                       \
+     */                                                                                                                                             \
+    void METHOD_PREFIX ## __insert( TYPENAME *flat_map, KEY_TYPE key, VALUE_TYPE value );                                                           \
+                                                                                                                                                    \
+    bool METHOD_PREFIX ## __retrieve( TYPENAME const *flat_map, KEY_TYPE key, VALUE_TYPE *out_value );                                              \
+                                                                                                                                                    \
+    void METHOD_PREFIX ## __delete( TYPENAME *flat_map, KEY_TYPE key );                                                                             \
+                                                                                                                                                    \
+    /**                                                                                                                                             \
+     *  \brief Calls a function with each key:value pair of a Flat Map, in ascending order of key.                                                  \
+     */                                                                                                                                             \
+    void METHOD_PREFIX ## __for_each( TYPENAME *flat_map, void (*function)( KEY_TYPE key, VALUE_TYPE value, void *user_data ), void *user_data );
+
+/**
+ *  \def FLAT_MAP__DEFINE( TYPENAME, METHOD_PREFIX, KEY_TYPE, VALUE_TYPE, KEY_TYPE__LESS_FUNCTION )
+ *  \brief Defines a Flat Map type. This macro must be paired with a call to the macro
+ *  FLAT_MAP__DECLARE( TYPENAME, METHOD_PREFIX, KEY_TYPE, VALUE_TYPE ).
+ *  \param KEY_TYPE__LESS_FUNCTION A function which returns true if its first key is ordered before its second, as
+ *  for ORDERED_ARRAY__DEFINE. Keys neither of which is less than the other are equal.
+ */
+#define FLAT_MAP__DEFINE( TYPENAME, METHOD_PREFIX, KEY_TYPE, VALUE_TYPE, KEY_TYPE__LESS_FUNCTION )                                                  \
+    static inline bool METHOD_PREFIX ## __key_value_pair__keys_are_less( TYPENAME ## __KeyValuePair first, TYPENAME ## __KeyValuePair second ){     \
+        return KEY_TYPE__LESS_FUNCTION( first.key, second.key );                                                                                    \
+    }                                                                                                                                               \
+                                                                                                                                                    \
+    static inline bool METHOD_PREFIX ## __key_value_pair__keys_are_equal( TYPENAME ## __KeyValuePair first, TYPENAME ## __KeyValuePair second ){    \
+        return !KEY_TYPE__LESS_FUNCTION( first.key, second.key ) && !KEY_TYPE__LESS_FUNCTION( second.key, first.key );                              \
+    }                                                                                                                                               \
+                                                                                                                                                    \
+    ARRAY__DEFINE(                                                                                                                                  \
+        TYPENAME ## __Array__KeyValuePair,                                                                                                          \
+        METHOD_PREFIX ## __array__key_value_pair,                                                                                                   \
+        TYPENAME ## __KeyValuePair,                                                                                                                 \
+        METHOD_PREFIX ## __key_value_pair__keys_are_equal                                                                                           \
+    )                                                                                                                                               \
+                                                                                                                                                    \
+    ORDERED_ARRAY__DEFINE(                                                                                                                          \
+        TYPENAME ## __Array__KeyValuePair,                                                                                                          \
+        METHOD_PREFIX ## __array__key_value_pair,                                                                                                   \
+        TYPENAME ## __KeyValuePair,                                                                                                                 \
+        METHOD_PREFIX ## __key_value_pair__keys_are_less                                                                                            \
+    )                                                                                                                                               \
+                                                                                                                                                    \
+    void METHOD_PREFIX ## __initialize( TYPENAME *flat_map, Allocator *allocator, unsigned long long capacity ){                                    \
+        auto_ ## METHOD_PREFIX ## __array__key_value_pair__initialize( &flat_map->pairs, allocator, capacity );                                     \
+    }                                                                                                                                               \
+                                                                                                                                                    \
+    void METHOD_PREFIX ## __initialize__pairs(                                                                                                      \
+        TYPENAME *flat_map,                                                                                                                         \
+        Allocator *allocator,                                                                                                                       \
+        unsigned long long pair_count,                                                                                                              \
+        TYPENAME ## __KeyValuePair const *pairs                                                                                                     \
+    ){                                                                                                                                              \
+        auto_ ## METHOD_PREFIX ## __array__key_value_pair__initialize( &flat_map->pairs, allocator, pair_count );                                   \
+        auto_ ## METHOD_PREFIX ## __array__key_value_pair__append_elements( &flat_map->pairs, pair_count, pairs );                                  \
+                                                                                                                                                    \
+        TYPENAME ## __Array__KeyValuePair *array = flat_map->pairs.METHOD_PREFIX ## __array__key_value_pair;                                        \
+        if( !METHOD_PREFIX ## __array__key_value_pair__sort__stable( array, allocator ) ){                                                          \
+            /* Without memory for a buffer, which of the pairs with equal keys is kept is unspecified. */                                           \
+            METHOD_PREFIX ## __array__key_value_pair__sort( array );                                                                                \
+        }                                                                                                                                           \
+                                                                                                                                                    \
+        /* Of each run of pairs with equal keys, only the last is kept. */                                                                          \
+        unsigned long long length = 0;                                                                                                              \
+        for( unsigned long long index = 0; index < array->length; index++ ){                                                                        \
+            if( index + 1 < array->length && !KEY_TYPE__LESS_FUNCTION( array->data[ index ].key, array->data[ index + 1 ].key ) ){                  \
+                continue;                                                                                                                           \
+            }                                                                                                                                       \
+            array->data[ length++ ] = array->data[ index ];                                                                                         \
+        }                                                                                                                                           \
+        auto_ ## METHOD_PREFIX ## __array__key_value_pair__resize( &flat_map->pairs, length );                                                      \
+    }                                                                                                                                               \
+                                                                                                                                                    \
+    void METHOD_PREFIX ## __clear( TYPENAME *flat_map ){                                                                                            \
+        auto_ ## METHOD_PREFIX ## __array__key_value_pair__clear( &flat_map->pairs );                                                               \
+    }                                                                                                                                               \
+                                                                                                                                                    \
+    void METHOD_PREFIX ## __insert( TYPENAME *flat_map, KEY_TYPE key, VALUE_TYPE value ){                                                           \
+        TYPENAME ## __KeyValuePair key_value_pair = { .key = key, .value = value };                                                                 \
+                                                                                                                                                    \
+        TYPENAME ## __Array__KeyValuePair *array = flat_map->pairs.METHOD_PREFIX ## __array__key_value_pair;                                        \
+        unsigned long long index = 0;                                                                                                               \
+        if( METHOD_PREFIX ## __array__key_value_pair__binary_search( array, key_value_pair, &index ) ){                                             \
+            array->data[ index ].value = value;                                                                                                     \
+            return;                                                                                                                                 \
+        }                                                                                                                                           \
+                                                                                                                                                    \
+        auto_ ## METHOD_PREFIX ## __array__key_value_pair__insert_element( &flat_map->pairs, index, key_value_pair );                               \
+    }                                                                                                                                               \
+                                                                                                                                                    \
+    bool METHOD_PREFIX ## __retrieve( TYPENAME const *flat_map, KEY_TYPE key, VALUE_TYPE *out_value ){                                              \
+        TYPENAME ## __Array__KeyValuePair const *array = flat_map->pairs.METHOD_PREFIX ## __array__key_value_pair;                                  \
+        unsigned long long index = 0;                                                                                                               \
+        if( METHOD_PREFIX ## __array__key_value_pair__binary_search( array, (TYPENAME ## __KeyValuePair){ .key = key }, &index ) ){                 \
+            *out_value = array->data[ index ].value;                                                                                                \
+            return true;                                                                                                                            \
+        }                                                                                                                                           \
+                                                                                                                                                    \
+        return false;                                                                                                                               \
+    }                                                                                                                                               \
+                                                                                                                                                    \
+    void METHOD_PREFIX ## __delete( TYPENAME *flat_map, KEY_TYPE key ){                                                                             \
+        TYPENAME ## __KeyValuePair key_value_pair = { .key = key };                                                                                 \
+                                                                                                                                                    \
+        TYPENAME ## __Array__KeyValuePair const *array = flat_map->pairs.METHOD_PREFIX ## __array__key_value_pair;                                  \
+        unsigned long long index = 0;                                                                                                               \
+        if( METHOD_PREFIX ## __array__key_value_pair__binary_search( array, key_value_pair, &index ) ){                                             \
+            auto_ ## METHOD_PREFIX ## __array__key_value_pair__remove_element( &flat_map->pairs, index );                                           \
+        }                                                                                                                                           \
+    }                                                                                                                                               \
+                                                                                                                                                    \
+    void METHOD_PREFIX ## __for_each( TYPENAME *flat_map, void (*function)( KEY_TYPE key, VALUE_TYPE value, void *user_data ), void *user_data ){   \
+        TYPENAME ## __Array__KeyValuePair *array = flat_map->pairs.METHOD_PREFIX ## __array__key_value_pair;                                        \
+        for( unsigned long long index = 0; index < array->length; index++ ){                                                                        \
+            function( array->data[ index ].key, array->data[ index ].value, user_data );                                                            \
+        }                                                                                                                                           \
+    }
+
+/**
+ *  @} group flat_map
+ */
+
+#endif // KIRKE__FLAT_MAP__H
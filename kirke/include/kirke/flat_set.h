@@ -0,0 +1,169 @@
+/**
+ *  \file kirke/flat_set.h
+ */
+
+#ifndef KIRKE__FLAT_SET__H
+#define KIRKE__FLAT_SET__H
+
+// System Includes
+#include <stdbool.h>
+
+// Internal Includes
+#include "kirke/macros.h"
+#include "kirke/array.h"
+#include "kirke/ordered_array.h"
+
+/**
+ *  \defgroup flat_set Flat Set
+ *  @{
+ */
+
+/**
+ *  A Flat Set keeps its elements sorted, in a single contiguous AutoArray, and finds them by binary search. It takes
+ *  no memory per element beyond the element itself, and iterates in order, at the speed of reading an array. Insertion
+ *  and deletion move the elements after the affected one, which makes a Flat Set best suited to sets which are built
+ *  once, with METHOD_PREFIX__initialize__elements, and then mostly read.
+ */
+
+/**
+ *  \def FLAT_SET__DECLARE( TYPENAME, METHOD_PREFIX, ELEMENT_TYPE )
+ *  \brief Declares a Flat Set type. This macro should be paired with a call to the macro
+ *      FLAT_SET__DEFINE( TYPENAME, METHOD_PREFIX, ELEMENT_TYPE, ELEMENT_TYPE__LESS_FUNCTION ).
+ *  \param TYPENAME The name of the Flat Set type.
+ *  \param METHOD_PREFIX The prefix of the Flat Set type's methods.
+ *  \param ELEMENT_TYPE The type stored in the Flat Set.
+ */
+#define FLAT_SET__DECLARE( TYPENAME, METHOD_PREFIX, ELEMENT_TYPE )                                                                                  \
+    ARRAY__DECLARE( TYPENAME ## __Array, METHOD_PREFIX ## __array, ELEMENT_TYPE )                                                                   \
+    ORDERED_ARRAY__DECLARE( TYPENAME ## __Array, METHOD_PREFIX ## __array, ELEMENT_TYPE )                                                           \
+                                                                                                                                                    \
+    typedef struct TYPENAME {                                                                                                                       \
+        /**                                                                                                                                         \
+         *  The elements of the set, in ascending order, no two of which are equal.                                                                 \
+         */                                                                                                                                         \
+        Auto ## TYPENAME ## __Array elements;                                                                                                       \
+    } TYPENAME;                                                                                                                                     \
+                                                                                                                                                    \
+    /**                                                                                                                                             \
+     *  \brief Initializes an empty Flat Set.                                                                                                       \
+     *  \param flat_set A pointer to the Flat Set to be initialized.                                                                                \
+     *  \param allocator A pointer to the Allocator which will manage the memory of the Flat Set.                                                   \
+     *  \param capacity The number of elements for which to allocate memory.                                                                        \
+     */                                                                                                                                             \
+    void METHOD_PREFIX ## __initialize( TYPENAME *flat_set, Allocator *allocator, unsigned long long capacity );                                    \
+                                                                                                                                                    \
+    /**                                                                                                                                             \
+     *  \brief Initializes a Flat Set with the given elements, in any order, by sorting them and removing duplicates                                \
+     *  in one pass. This is much faster than inserting them one at a time. Of equal elements, the last is kept, as if                              \
+     *  each were inserted in turn.                                                                                                                 \
+     *  \param flat_set A pointer to the Flat Set to be initialized.                                                                                \
+     *  \param allocator A pointer to the Allocator which will manage the memory of the Flat Set.                                                   \
+     *  \param element_count The number of elements.                                                                                                \
+     *  \param elements A pointer to the elements, which are copied.                                                                                \
+     */                                                                                                                                             \
+    void METHOD_PREFIX ## __initialize__elements(                                                                                                   \
+        TYPENAME *flat_set,                                                                                                                         \
+        Allocator *allocator,                                                                                                                       \
+        unsigned long long element_count,                                                                                                           \
+        ELEMENT_TYPE const *elements                                                                                                                \
+    );                                                                                                                                              \
+                                                                                                                                                    \
+    void METHOD_PREFIX ## __clear( TYPENAME *flat_set );                                                                                            \
+                                                                                                                                                    \
+    /**                                                                                                                                             \
+     *  \brief Inserts an element, replacing any equal element.                                                                                     \
+     */                                                                                                                                             \
+    void METHOD_PREFIX ## __insert( TYPENAME *flat_set, ELEMENT_TYPE element );                                                                     \
+                                                                                                                                                    \
+    bool METHOD_PREFIX ## __contains( TYPENAME const *flat_set, ELEMENT_TYPE element );                                                             \
+                                                                                                                                                    \
+    void METHOD_PREFIX ## __delete( TYPENAME *flat_set, ELEMENT_TYPE element );                                                                     \
+                                                                                                                                                    \
+    /**                                                                                                                                             \
+     *  \brief Calls a function with each element of a Flat Set, in ascending order.                                                                \
+     */                                                                                                                                             \
+    void METHOD_PREFIX ## __for_each( TYPENAME *flat_set, void (*function)( ELEMENT_TYPE element, void *user_data ), void *user_data );
+
+/**
+ *  \def FLAT_SET__DEFINE( TYPENAME, METHOD_PREFIX, ELEMENT_TYPE, ELEMENT_TYPE__LESS_FUNCTION )
+ *  \brief Defines a Flat Set type. This macro must be paired with a call to the macro
+ *  FLAT_SET__DECLARE( TYPENAME, METHOD_PREFIX, ELEMENT_TYPE ).
+ *  \param ELEMENT_TYPE__LESS_FUNCTION A function which returns true if its first parameter is ordered before its
+ *  second, as for ORDERED_ARRAY__DEFINE. Elements neither of which is less than the other are equal.
+ */
+#define FLAT_SET__DEFINE( TYPENAME, METHOD_PREFIX, ELEMENT_TYPE, ELEMENT_TYPE__LESS_FUNCTION )                                                      \
+    static inline bool METHOD_PREFIX ## __elements_are_equal( ELEMENT_TYPE first, ELEMENT_TYPE second ){                                            \
+        return !ELEMENT_TYPE__LESS_FUNCTION( first, second ) && !ELEMENT_TYPE__LESS_FUNCTION( second, first );                                      \
+    }                                                                                                                                               \
+                                                                                                                                                    \
+    ARRAY__DEFINE( TYPENAME ## __Array, METHOD_PREFIX ## __array, ELEMENT_TYPE, METHOD_PREFIX ## __elements_are_equal )                             \
+    ORDERED_ARRAY__DEFINE( TYPENAME ## __Array, METHOD_PREFIX ## __array, ELEMENT_TYPE, ELEMENT_TYPE__LESS_FUNCTION )                               \
+                                                                                                                                                    \
+    void METHOD_PREFIX ## __initialize( TYPENAME *flat_set, Allocator *allocator, unsigned long long capacity ){                                    \
+        auto_ ## METHOD_PREFIX ## __array__initialize( &flat_set->elements, allocator, capacity );                                                  \
+    }                                                                                                                                               \
+                                                                                                                                                    \
+    void METHOD_PREFIX ## __initialize__elements(                                                                                                   \
+        TYPENAME *flat_set,                                                                                                                         \
+        Allocator *allocator,                                                                                                                       \
+        unsigned long long element_count,                                                                                                           \
+        ELEMENT_TYPE const *elements                                                                                                                \
+    ){                                                                                                                                              \
+        auto_ ## METHOD_PREFIX ## __array__initialize( &flat_set->elements, allocator, element_count );                                             \
+        auto_ ## METHOD_PREFIX ## __array__append_elements( &flat_set->elements, element_count, elements );                                         \
+                                                                                                                                                    \
+        TYPENAME ## __Array *array = flat_set->elements.METHOD_PREFIX ## __array;                                                                   \
+        if( !METHOD_PREFIX ## __array__sort__stable( array, allocator ) ){                                                                          \
+            /* Without memory for a buffer, which of equal elements is kept is unspecified. */                                                      \
+            METHOD_PREFIX ## __array__sort( array );                                                                                                \
+        }                                                                                                                                           \
+                                                                                                                                                    \
+        /* Of each run of equal elements, only the last is kept. */                                                                                 \
+        unsigned long long length = 0;                                                                                                              \
+        for( unsigned long long index = 0; index < array->length; index++ ){                                                                        \
+            if( index + 1 < array->length && !ELEMENT_TYPE__LESS_FUNCTION( array->data[ index ], array->data[ index + 1 ] ) ){                      \
+                continue;                                                                                                                           \
+            }                                                                                                                                       \
+            array->data[ length++ ] = array->data[ index ];                                                                                         \
+        }                                                                                                                                           \
+        auto_ ## METHOD_PREFIX ## __array__resize( &flat_set->elements, length );                                                                   \
+    }                                                                                                                                               \
+                                                                                                                                                    \
+    void METHOD_PREFIX ## __clear( TYPENAME *flat_set ){                                                                                            \
+        auto_ ## METHOD_PREFIX ## __array__clear( &flat_set->elements );                                                                            \
+    }                                                                                                                                               \
+                                                                                                                                                    \
+    void METHOD_PREFIX ## __insert( TYPENAME *flat_set, ELEMENT_TYPE element ){                                                                     \
+        unsigned long long index = 0;                                                                                                               \
+        if( METHOD_PREFIX ## __array__binary_search( flat_set->elements.METHOD_PREFIX ## __array, element, &index ) ){                              \
+            flat_set->elements.METHOD_PREFIX ## __array->data[ index ] = element;                                                                   \
+            return;                                                                                                                                 \
+        }                                                                                                                                           \
+                                                                                                                                                    \
+        auto_ ## METHOD_PREFIX ## __array__insert_element( &flat_set->elements, index, element );                                                   \
+    }                                                                                                                                               \
+                                                                                                                                                    \
+    bool METHOD_PREFIX ## __contains( TYPENAME const *flat_set, ELEMENT_TYPE element ){                                                             \
+        unsigned long long index = 0;                                                                                                               \
+        return METHOD_PREFIX ## __array__binary_search( flat_set->elements.METHOD_PREFIX ## __array, element, &index );                             \
+    }                                                                                                                                               \
+                                                                                                                                                    \
+    void METHOD_PREFIX ## __delete( TYPENAME *flat_set, ELEMENT_TYPE element ){                                                                     \
+        unsigned long long index = 0;                                                                                                               \
+        if( METHOD_PREFIX ## __array__binary_search( flat_set->elements.METHOD_PREFIX ## __array, element, &index ) ){                              \
+            auto_ ## METHOD_PREFIX ## __array__remove_element( &flat_set->elements, index );                                                        \
+        }                                                                                                                                           \
+    }                                                                                                                                               \
+                                                                                                                                                    \
+    void METHOD_PREFIX ## __for_each( TYPENAME *flat_set, void (*function)( ELEMENT_TYPE element, void *user_data ), void *user_data ){             \
+        TYPENAME ## __Array *array = flat_set->elements.METHOD_PREFIX ## __array;                                                                   \
+        for( unsigned long long index = 0; index < array->length; index++ ){                                                                        \
+            function( array->data[ index ], user_data );                                                                                            \
+        }                                                                                                                                           \
+    }
+
+/**
+ *  @} group flat_set
+ */
+
+#endif // KIRKE__FLAT_SET__H
@@ -37,6 +37,13 @@
     void METHOD_PREFIX ## __for_each( TYPENAME *hash_map, void (*function)( KEY_TYPE key, VALUE_TYPE value, void *user_data ), void *user_data );
 
 #define HASH_MAP__DEFINE( TYPENAME, METHOD_PREFIX, KEY_TYPE, VALUE_TYPE, KEY_TYPE__HASH_FUNCTION, KEY_TYPE__EQUALS_FUNCTION )                       \
+    HASH_MAP__DEFINE__ALLOCATOR( TYPENAME, METHOD_PREFIX, KEY_TYPE, VALUE_TYPE, KEY_TYPE__HASH_FUNCTION, KEY_TYPE__EQUALS_FUNCTION, allocator )
+
+/**
+ *  Defines a hash map as HASH_MAP__DEFINE does, except that its buckets and entries are managed by the functions
+ *  prefixed with ALLOCATOR, rather than through the Allocator vtable. See ARRAY__DEFINE__ALLOCATOR.
+ */
+#define HASH_MAP__DEFINE__ALLOCATOR( TYPENAME, METHOD_PREFIX, KEY_TYPE, VALUE_TYPE, KEY_TYPE__HASH_FUNCTION, KEY_TYPE__EQUALS_FUNCTION, ALLOCATOR ) \
                                                                                                                                                     \
     bool METHOD_PREFIX ## __key_value_pair__keys_are_equal( TYPENAME ## __KeyValuePair first, TYPENAME ## __KeyValuePair second ){                  \
         if( KEY_TYPE__EQUALS_FUNCTION( first.key, second.key ) ){                                                                                   \
@@ -45,18 +52,20 @@
         return false;                                                                                                                               \
     }                                                                                                                                               \
                                                                                                                                                     \
-    LIST__DEFINE(                                                                                                                                   \
+    LIST__DEFINE__ALLOCATOR(                                                                                                                        \
         TYPENAME ## __List__KeyValuePair,                                                                                                           \
         METHOD_PREFIX ## __list__key_value_pair,                                                                                                    \
         TYPENAME ## __KeyValuePair,                                                                                                                 \
-        METHOD_PREFIX ## __key_value_pair__keys_are_equal                                                                                           \
+        METHOD_PREFIX ## __key_value_pair__keys_are_equal,                                                                                          \
+        ALLOCATOR                                                                                                                                   \
     )                                                                                                                                               \
                                                                                                                                                     \
-    ARRAY__DEFINE(                                                                                                                                  \
+    ARRAY__DEFINE__ALLOCATOR(                                                                                                                       \
         TYPENAME ## __Array__List__KeyValuePair,                                                                                                    \
         METHOD_PREFIX ## __array__list__key_value_pair,                                                                                             \
         TYPENAME ## __List__KeyValuePair *,                                                                                                         \
-        METHOD_PREFIX ## __list__key_value_pair__equals                                                                                             \
+        METHOD_PREFIX ## __list__key_value_pair__equals,                                                                                            \
+        ALLOCATOR                                                                                                                                   \
     )                                                                                                                                               \
                                                                                                                                                     \
     void METHOD_PREFIX ## __initialize( TYPENAME *hash_map, Allocator *allocator, unsigned long long bucket_count ){                                \
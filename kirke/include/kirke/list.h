@@ -58,10 +58,18 @@ BEGIN_DECLARATIONS
     TYPENAME *METHOD_PREFIX ## __delete_all( TYPENAME *link, ELEMENT_TYPE value, Allocator *allocator );                            \
 
 #define LIST__DEFINE( TYPENAME, METHOD_PREFIX, ELEMENT_TYPE, ELEMENT_TYPE__EQUALS_FUNCTION )                                        \
+    LIST__DEFINE__ALLOCATOR( TYPENAME, METHOD_PREFIX, ELEMENT_TYPE, ELEMENT_TYPE__EQUALS_FUNCTION, allocator )
+
+/**
+ *  Defines a list as LIST__DEFINE does, except that links are allocated and freed by ALLOCATOR__alloc and
+ *  ALLOCATOR__free_sized, which take the same parameters as allocator__alloc and allocator__free_sized, rather than
+ *  through the Allocator vtable. See ARRAY__DEFINE__ALLOCATOR.
+ */
+#define LIST__DEFINE__ALLOCATOR( TYPENAME, METHOD_PREFIX, ELEMENT_TYPE, ELEMENT_TYPE__EQUALS_FUNCTION, ALLOCATOR )                  \
                                                                                                                                     \
     void METHOD_PREFIX ## __initialize( TYPENAME **list, Allocator *allocator, ELEMENT_TYPE value ){                                \
         /* Cast for C++ compatibility */                                                                                            \
-        *list = (TYPENAME *) allocator__alloc( allocator, sizeof( TYPENAME ) );                                                     \
+        *list = (TYPENAME *) ALLOCATOR ## __alloc( allocator, sizeof( TYPENAME ) );                                                 \
         **list = (TYPENAME) {                                                                                                       \
             .value = value,                                                                                                         \
             .next = NULL,                                                                                                           \
@@ -74,7 +82,7 @@ BEGIN_DECLARATIONS
         while( current != NULL ){                                                                                                   \
             TYPENAME *head = current;                                                                                               \
             current = current->next;                                                                                                \
-            allocator__free( allocator, head );                                                                                     \
+            ALLOCATOR ## __free_sized( allocator, head, sizeof( TYPENAME ) );                                                       \
         }                                                                                                                           \
     }                                                                                                                               \
                                                                                                                                     \
@@ -201,7 +209,7 @@ BEGIN_DECLARATIONS
         TYPENAME *tail = METHOD_PREFIX ## __tail( list );                                                                           \
                                                                                                                                     \
         /* Cast for C++ compatibility */                                                                                            \
-        TYPENAME *new_list = (TYPENAME *) allocator__alloc( allocator, sizeof( TYPENAME ) );                                        \
+        TYPENAME *new_list = (TYPENAME *) ALLOCATOR ## __alloc( allocator, sizeof( TYPENAME ) );                                    \
         *new_list = (TYPENAME){                                                                                                     \
             .value = value,                                                                                                         \
             .next = NULL,                                                                                                           \
@@ -215,7 +223,7 @@ BEGIN_DECLARATIONS
         TYPENAME *head = METHOD_PREFIX ## __head( list );                                                                           \
                                                                                                                                     \
         /* Cast for C++ compatibility */                                                                                            \
-        TYPENAME *new_list = (TYPENAME *) allocator__alloc( allocator, sizeof( TYPENAME ) );                                        \
+        TYPENAME *new_list = (TYPENAME *) ALLOCATOR ## __alloc( allocator, sizeof( TYPENAME ) );                                    \
                                                                                                                                     \
         *new_list = (TYPENAME){                                                                                                     \
             .value = value,                                                                                                         \
@@ -235,7 +243,7 @@ BEGIN_DECLARATIONS
         }                                                                                                                           \
         else{                                                                                                                       \
             /* Cast for C++ compatibility */                                                                                        \
-            TYPENAME *new_link = (TYPENAME *) allocator__alloc( allocator, sizeof( TYPENAME ) );                                    \
+            TYPENAME *new_link = (TYPENAME *) ALLOCATOR ## __alloc( allocator, sizeof( TYPENAME ) );                                \
             *new_link = (TYPENAME){                                                                                                 \
                 .value = value,                                                                                                     \
                 .next = link,                                                                                                       \
@@ -251,7 +259,7 @@ BEGIN_DECLARATIONS
                                                                                                                                     \
     void METHOD_PREFIX ## __insert_after( TYPENAME *link, Allocator *allocator, ELEMENT_TYPE value ){                               \
         /* Cast for C++ compatibility */                                                                                            \
-        TYPENAME *new_link = (TYPENAME *) allocator__alloc( allocator, sizeof( TYPENAME ) );                                        \
+        TYPENAME *new_link = (TYPENAME *) ALLOCATOR ## __alloc( allocator, sizeof( TYPENAME ) );                                    \
         *new_link = (TYPENAME){                                                                                                     \
             .value = value,                                                                                                         \
             .next = link->next,                                                                                                     \
@@ -287,7 +295,7 @@ BEGIN_DECLARATIONS
             link->next->previous = link->previous;                                                                                  \
         }                                                                                                                           \
                                                                                                                                     \
-        allocator__free( allocator, link );                                                                                         \
+        ALLOCATOR ## __free_sized( allocator, link, sizeof( TYPENAME ) );                                                           \
                                                                                                                                     \
         return head;                                                                                                                \
     }                                                                                                                               \
@@ -0,0 +1,115 @@
+/**
+ *  \file kirke/malloc_allocator.h
+ */
+
+#ifndef KIRKE__MALLOC_ALLOCATOR__H
+#define KIRKE__MALLOC_ALLOCATOR__H
+
+// System Includes
+#include <stdbool.h>
+#include <stdlib.h> // malloc, calloc, realloc, free
+#include <string.h> // memcpy
+
+// Internal Includes
+#include "kirke/macros.h"
+#include "kirke/allocator.h"
+
+BEGIN_DECLARATIONS
+
+/**
+ *  \defgroup malloc_allocator MallocAllocator
+ *  \brief Functions which manage memory by calling the C library directly, for binding to a container at compile
+ *  time with ARRAY__DEFINE__ALLOCATOR, LIST__DEFINE__ALLOCATOR or HASH_MAP__DEFINE__ALLOCATOR. Apart from
+ *  malloc_allocator__alloc_aligned, they are defined in this header, so that the compiler can inline them into the
+ *  container methods.
+ *  Each function takes the same parameters as the allocator__ function of the same name, but ignores its Allocator
+ *  parameter, so NULL may be passed wherever a container method asks for an allocator. Failed allocations return
+ *  NULL, as there is no out_of_memory callback to call.
+ *  @{
+ */
+
+static inline void *malloc_allocator__alloc( Allocator *allocator, unsigned long long size ){
+    (void) allocator;
+    return malloc( size );
+}
+
+static inline void *malloc_allocator__calloc( Allocator *allocator, unsigned long long count, unsigned long long size ){
+    (void) allocator;
+    return calloc( count, size );
+}
+
+static inline void *malloc_allocator__realloc( Allocator *allocator, void *pointer, unsigned long long size ){
+    (void) allocator;
+    return realloc( pointer, size );
+}
+
+static inline void malloc_allocator__free( Allocator *allocator, void *pointer ){
+    (void) allocator;
+    free( pointer );
+}
+
+static inline void malloc_allocator__free_sized( Allocator *allocator, void *pointer, unsigned long long size ){
+    (void) allocator;
+    (void) size;
+    free( pointer );
+}
+
+/**
+ *  The C library offers no portable way to grow a block in place, so this always fails, and the compiler removes
+ *  the attempt entirely.
+ */
+static inline bool malloc_allocator__try_expand( Allocator *allocator, void *pointer, unsigned long long size ){
+    (void) allocator;
+    (void) pointer;
+    (void) size;
+    return false;
+}
+
+/**
+ *  This needs posix_memalign, which is not part of C11, so it is defined in kirke/src/malloc_allocator.c, where the
+ *  feature-test macro which declares it can come before every include. Aligned allocations are rare enough that the
+ *  call is not worth inlining.
+ */
+void *malloc_allocator__alloc_aligned( Allocator *allocator, unsigned long long size, unsigned long long alignment );
+
+/**
+ *  Blocks from posix_memalign may be passed to realloc, which keeps the data but not necessarily the alignment, so
+ *  the data is only copied again when the reallocated block turns out to be misaligned.
+ */
+static inline void *malloc_allocator__realloc_aligned(
+    Allocator *allocator,
+    void *pointer,
+    unsigned long long old_size,
+    unsigned long long size,
+    unsigned long long alignment
+){
+    if( pointer == NULL ){
+        return malloc_allocator__alloc_aligned( allocator, size, alignment );
+    }
+
+    void *new_pointer = realloc( pointer, size );
+    if( new_pointer == NULL || (unsigned long long) new_pointer % alignment == 0 ){
+        return new_pointer;
+    }
+
+    void *aligned_pointer = malloc_allocator__alloc_aligned( allocator, size, alignment );
+    if( aligned_pointer != NULL ){
+        memcpy( aligned_pointer, new_pointer, old_size < size ? old_size : size );
+    }
+
+    free( new_pointer );
+    return aligned_pointer;
+}
+
+static inline void malloc_allocator__free_aligned( Allocator *allocator, void *pointer ){
+    (void) allocator;
+    free( pointer );
+}
+
+/**
+ *  @} group malloc_allocator
+ */
+
+END_DECLARATIONS
+
+#endif // KIRKE__MALLOC_ALLOCATOR__H
@@ -0,0 +1,171 @@
+/**
+ *  \file kirke/memory_pressure.h
+ */
+
+#ifndef KIRKE__MEMORY_PRESSURE__H
+#define KIRKE__MEMORY_PRESSURE__H
+
+// System Includes
+#include <stdbool.h>
+
+// Internal Includes
+#include "kirke/macros.h"
+#include "kirke/allocator.h"
+#include "kirke/string.h"
+
+BEGIN_DECLARATIONS
+
+/**
+ *  \defgroup memory_pressure Memory Pressure
+ *  @{
+ */
+
+/**
+ *  \def MEMORY_PRESSURE__DEFAULT_FILE_PATH
+ *  \brief The file from which Linux reports pressure stall information for memory.
+ */
+#define MEMORY_PRESSURE__DEFAULT_FILE_PATH "/proc/pressure/memory"
+
+/**
+ *  \brief A registration of something which can give memory back when memory pressure is signalled: either a
+ *  callback, such as auto_array__shrink_to_fit__callback, or an Allocator to be trimmed with allocator__trim.
+ *  Handlers are linked into a list belonging to the thread which registered them, and are only ever called on that
+ *  thread, so they must stay at the same address until they are unregistered. They are typically embedded next to
+ *  the container they shrink.
+ */
+typedef struct MemoryPressure__Handler MemoryPressure__Handler;
+
+struct MemoryPressure__Handler{
+    /**
+     *  The function called when memory pressure is signalled, or NULL if \ref allocator is set instead.
+     */
+    void ( *callback )( void *data );
+    /**
+     *  The data passed to \ref callback.
+     */
+    void *data;
+    /**
+     *  The allocator trimmed when memory pressure is signalled, or NULL if \ref callback is set instead.
+     */
+    Allocator *allocator;
+    /**
+     *  The next handler in the list of the registering thread.
+     */
+    MemoryPressure__Handler *next;
+    /**
+     *  The previous handler in the list of the registering thread.
+     */
+    MemoryPressure__Handler *previous;
+};
+
+/**
+ *  \brief One line of pressure stall information: the percentage of time in which tasks were stalled waiting for
+ *  memory, averaged over three windows, and the total time stalled.
+ */
+typedef struct MemoryPressure__Averages{
+    /**
+     *  The percentage of the last 10 seconds.
+     */
+    double avg10;
+    /**
+     *  The percentage of the last 60 seconds.
+     */
+    double avg60;
+    /**
+     *  The percentage of the last 300 seconds.
+     */
+    double avg300;
+    /**
+     *  The total time stalled, in microseconds.
+     */
+    unsigned long long total;
+} MemoryPressure__Averages;
+
+/**
+ *  \brief The pressure stall information for memory.
+ */
+typedef struct MemoryPressure__Reading{
+    /**
+     *  The time in which at least one task was stalled waiting for memory.
+     */
+    MemoryPressure__Averages some;
+    /**
+     *  The time in which every non-idle task was stalled waiting for memory at once.
+     */
+    MemoryPressure__Averages full;
+} MemoryPressure__Reading;
+
+/**
+ *  \brief Registers a callback to be called on the current thread whenever memory pressure is signalled.
+ *  \param handler A pointer to the handler to be registered, which must not already be registered.
+ *  \param callback The function to be called, for example auto_array__shrink_to_fit__callback.
+ *  \param data The data to be passed to \p callback, for example a pointer to an AutoArray.
+ */
+void memory_pressure__register( MemoryPressure__Handler *handler, void ( *callback )( void *data ), void *data );
+
+/**
+ *  \brief Registers an allocator to be trimmed with allocator__trim on the current thread whenever memory pressure
+ *  is signalled.
+ *  Allocators are trimmed after every callback has been called, so that the memory released by the callbacks can be
+ *  returned to the system as well.
+ *  \param handler A pointer to the handler to be registered, which must not already be registered.
+ *  \param allocator The allocator to be trimmed.
+ */
+void memory_pressure__register__allocator( MemoryPressure__Handler *handler, Allocator *allocator );
+
+/**
+ *  \brief Removes a handler from the list of the current thread. This must be called by the thread which
+ *  registered the handler, before the handler, or whatever it refers to, is destroyed.
+ *  \param handler A pointer to the registered handler.
+ */
+void memory_pressure__unregister( MemoryPressure__Handler *handler );
+
+/**
+ *  \brief Signals memory pressure to every thread, and handles it at once on the calling thread with
+ *  memory_pressure__handle. Other threads handle it the next time they call memory_pressure__handle.
+ *  \note This may be called from any thread, since it never touches the handlers of other threads.
+ */
+void memory_pressure__signal( void );
+
+/**
+ *  \brief Calls every callback registered by the current thread, then trims every allocator registered by it, if
+ *  memory pressure has been signalled since the current thread last handled it. Containers are not thread-safe, so
+ *  each thread which registers handlers should call this periodically, for example from its event loop.
+ *  \note Callbacks must not register or unregister handlers.
+ *  \returns Returns true if memory pressure was pending and has been handled, and false otherwise.
+ */
+bool memory_pressure__handle( void );
+
+/**
+ *  \brief Reads the pressure stall information for memory from \ref MEMORY_PRESSURE__DEFAULT_FILE_PATH.
+ *  \param out_reading A pointer to the reading which will be filled in.
+ *  \returns Returns true if the information was read.
+ *  \returns Returns false if it is unavailable, for example on kernels older than Linux 4.20, or on other systems.
+ */
+bool memory_pressure__read( MemoryPressure__Reading *out_reading );
+
+/**
+ *  \brief Reads pressure stall information in the format of \ref MEMORY_PRESSURE__DEFAULT_FILE_PATH from a file,
+ *  for example the memory.pressure file of a cgroup.
+ *  \param file_path A String containing the path of the file to be read.
+ *  \param out_reading A pointer to the reading which will be filled in.
+ *  \returns Returns true if the information was read, and false otherwise.
+ */
+bool memory_pressure__read__file( String file_path, MemoryPressure__Reading *out_reading );
+
+/**
+ *  \brief Reads the pressure stall information for memory, and signals memory pressure if the share of the last
+ *  10 seconds in which some task was stalled exceeds a threshold. This is meant to be called periodically by a
+ *  long-running service.
+ *  \param some_avg10_threshold The threshold, as a percentage.
+ *  \returns Returns true if memory pressure was signalled, and false otherwise.
+ */
+bool memory_pressure__poll( double some_avg10_threshold );
+
+/**
+ *  @} group memory_pressure
+ */
+
+END_DECLARATIONS
+
+#endif // KIRKE__MEMORY_PRESSURE__H
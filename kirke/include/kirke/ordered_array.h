@@ -0,0 +1,1109 @@
+/**
+ *  \file kirke/ordered_array.h
+ */
+
+#ifndef KIRKE__ORDERED_ARRAY__H
+#define KIRKE__ORDERED_ARRAY__H
+
+// System Includes
+#include <pthread.h>
+#include <stdbool.h>
+#include <string.h> // memcpy, memset
+
+// Internal Includes
+#include "kirke/macros.h"
+#include "kirke/allocator.h"
+#include "kirke/array.h"
+
+/**
+ *  \defgroup ordered_array Ordered Array
+ *  @{
+ */
+
+/**
+ *  Ordered Array adds sorting, and searching of sorted elements, to an Array type, declared with ARRAY__DECLARE.
+ *  Like Array, it is only defined as a pair of macros, ORDERED_ARRAY__DECLARE and ORDERED_ARRAY__DEFINE. The ordering
+ *  of elements is given by a function passed to ORDERED_ARRAY__DEFINE, rather than by a function pointer, so that the
+ *  compiler can inline every comparison. A second pair of macros, ORDERED_ARRAY__DECLARE_RADIX_SORT and
+ *  ORDERED_ARRAY__DEFINE_RADIX_SORT, adds a radix sort for elements ordered by an integer key, and a third,
+ *  ORDERED_ARRAY__DECLARE_PARALLEL_SORT and ORDERED_ARRAY__DEFINE_PARALLEL_SORT, adds a stable sort which divides its
+ *  work among several threads. Finally, ORDERED_ARRAY__DECLARE_EYTZINGER and ORDERED_ARRAY__DEFINE_EYTZINGER add a
+ *  lookup table which copies a sorted array into a layout which is faster to search.
+ */
+
+/**
+ *  \def ORDERED_ARRAY__INSERTION_SORT_LENGTH
+ *  \brief The length below which the sorts of an Ordered Array sort by insertion.
+ */
+#define ORDERED_ARRAY__INSERTION_SORT_LENGTH 24
+
+/**
+ *  \def ORDERED_ARRAY__NINTHER_LENGTH
+ *  \brief The length above which the quicksort of an Ordered Array chooses its pivot as the median of three medians of three elements.
+ */
+#define ORDERED_ARRAY__NINTHER_LENGTH 128
+
+/**
+ *  \def ORDERED_ARRAY__PARALLEL_SORT_MAXIMUM_THREAD_COUNT
+ *  \brief The greatest number of threads among which a parallel sort divides its work.
+ */
+#define ORDERED_ARRAY__PARALLEL_SORT_MAXIMUM_THREAD_COUNT 64
+
+/**
+ *  \def ORDERED_ARRAY__PARALLEL_SORT_MINIMUM_LENGTH
+ *  \brief The fewest elements which a parallel sort gives to each thread. Smaller arrays are sorted by fewer
+ *  threads, so that starting a thread never costs more than the work it takes on.
+ */
+#define ORDERED_ARRAY__PARALLEL_SORT_MINIMUM_LENGTH 65536
+
+/**
+ *  \def ORDERED_ARRAY__CACHE_LINE_SIZE
+ *  \brief The size in bytes of a cache line, to which the elements of an Eytzinger table are aligned.
+ */
+#define ORDERED_ARRAY__CACHE_LINE_SIZE 64
+
+/**
+ *  \def ORDERED_ARRAY__DECLARE( TYPENAME, TYPENAME_LOWERCASE, ELEMENT_TYPE )
+ *  \brief Declares sorting and searching methods for an Array type. This macro should be paired with a call
+ *  to the macro
+ *      ORDERED_ARRAY__DEFINE( TYPENAME, TYPENAME_LOWERCASE, ELEMENT_TYPE, ELEMENT_TYPE__LESS_FUNCTION ).
+ *  \param TYPENAME The name of the Array type, as passed to ARRAY__DECLARE.
+ *  \param TYPENAME_LOWERCASE The prefix of the Array type's methods, as passed to ARRAY__DECLARE.
+ *  \param ELEMENT_TYPE The type stored in the Array.
+ */
+#define ORDERED_ARRAY__DECLARE( TYPENAME, TYPENAME_LOWERCASE, ELEMENT_TYPE )                                                                        \
+    /**                                                                                                                                             \
+     *  \brief Sorts an array in place, in ascending order, with pattern-defeating quicksort. This takes O(n log n)                                 \
+     *  time in the worst case, and linear time for many common patterns, such as sorted, reversed or mostly equal                                  \
+     *  elements. Equal elements may be reordered.                                                                                                  \
+     *  \param array A pointer to the array to be sorted.                                                                                           \
+     */                                                                                                                                             \
+    void TYPENAME_LOWERCASE ## __sort(                                                                                                              \
+        TYPENAME *TYPENAME_LOWERCASE                                                                                                                \
+    );                                                                                                                                              \
+                                                                                                                                                    \
+    /**                                                                                                                                             \
+     *  \brief Sorts an array in ascending order with merge sort, keeping equal elements in their original order.                                   \
+     *  \param array A pointer to the array to be sorted.                                                                                           \
+     *  \param allocator The allocator used to allocate a buffer of half the length of \p array.                                                    \
+     *  \returns Returns true if the array was sorted, and false if the buffer could not be allocated, in which case                                \
+     *  the array is unchanged.                                                                                                                     \
+     */                                                                                                                                             \
+    bool TYPENAME_LOWERCASE ## __sort__stable(                                                                                                      \
+        TYPENAME *TYPENAME_LOWERCASE,                                                                                                               \
+        Allocator *allocator                                                                                                                        \
+    );                                                                                                                                              \
+                                                                                                                                                    \
+    /**                                                                                                                                             \
+     *  \brief Finds the first element of a sorted array which is not ordered before the given element. The binary                                  \
+     *  search chooses each half with a conditional move rather than a branch, so that it is never mispredicted.                                    \
+     *  \param array A pointer to the sorted array to be searched.                                                                                  \
+     *  \param element The element to be searched for.                                                                                              \
+     *  \returns Returns the index of the first element not less than \p element, or the length of the array if                                     \
+     *  every element is less.                                                                                                                      \
+     */                                                                                                                                             \
+    unsigned long long TYPENAME_LOWERCASE ## __lower_bound(                                                                                         \
+        TYPENAME const *TYPENAME_LOWERCASE,                                                                                                         \
+        ELEMENT_TYPE element                                                                                                                        \
+    );                                                                                                                                              \
+                                                                                                                                                    \
+    /**                                                                                                                                             \
+     *  \brief Finds the first element of a sorted array which is ordered after the given element, as                                               \
+     *  array__lower_bound does.                                                                                                                    \
+     *  \param array A pointer to the sorted array to be searched.                                                                                  \
+     *  \param element The element to be searched for.                                                                                              \
+     *  \returns Returns the index of the first element greater than \p element, or the length of the array if                                      \
+     *  there is none.                                                                                                                              \
+     */                                                                                                                                             \
+    unsigned long long TYPENAME_LOWERCASE ## __upper_bound(                                                                                         \
+        TYPENAME const *TYPENAME_LOWERCASE,                                                                                                         \
+        ELEMENT_TYPE element                                                                                                                        \
+    );                                                                                                                                              \
+                                                                                                                                                    \
+    /**                                                                                                                                             \
+     *  \brief Searches a sorted array for an element equal to the given element, in O(log n) time.                                                 \
+     *  \param array A pointer to the sorted array to be searched.                                                                                  \
+     *  \param element The element to be searched for.                                                                                              \
+     *  \param out__index An out parameter. Upon return, this will store the index of the first equal element, or                                   \
+     *  if there is none, the index at which \p element would be inserted to keep the array sorted.                                                 \
+     *  \returns Returns true if an equal element was found, and false otherwise.                                                                   \
+     */                                                                                                                                             \
+    bool TYPENAME_LOWERCASE ## __binary_search(                                                                                                     \
+        TYPENAME const *TYPENAME_LOWERCASE,                                                                                                         \
+        ELEMENT_TYPE element,                                                                                                                       \
+        unsigned long long *out__index                                                                                                              \
+    );                                                                                                                                              \
+                                                                                                                                                    \
+    /**                                                                                                                                             \
+     *  \brief Inserts an element into a sorted AutoArray, after any equal elements, so that it stays sorted.                                       \
+     *  \param auto_array A pointer to the sorted AutoArray into which the element will be inserted.                                                \
+     *  \param element The element which will be inserted.                                                                                          \
+     *  \returns Returns the index at which the element was inserted.                                                                               \
+     */                                                                                                                                             \
+    unsigned long long auto_ ## TYPENAME_LOWERCASE ## __sorted_insert(                                                                              \
+        Auto ## TYPENAME *auto_ ## TYPENAME_LOWERCASE,                                                                                              \
+        ELEMENT_TYPE element                                                                                                                        \
+    );
+
+/**
+ *  \def ORDERED_ARRAY__DEFINE( TYPENAME, TYPENAME_LOWERCASE, ELEMENT_TYPE, ELEMENT_TYPE__LESS_FUNCTION )
+ *  \brief Defines sorting and searching methods for an Array type. This macro must be paired with a call to the
+ *  macro ORDERED_ARRAY__DECLARE( TYPENAME, TYPENAME_LOWERCASE, ELEMENT_TYPE ).
+ *  \param ELEMENT_TYPE__LESS_FUNCTION A function which returns true if its first parameter is ordered before its
+ *  second, and false otherwise. The signature should be:
+ *      bool (*less_function)( ELEMENT_TYPE, ELEMENT_TYPE ).
+ *  It must be a strict weak ordering, as for the comparison of C++'s std::sort. Defining it as static inline in the
+ *  same file lets the compiler inline it into every method.
+ */
+#define ORDERED_ARRAY__DEFINE( TYPENAME, TYPENAME_LOWERCASE, ELEMENT_TYPE, ELEMENT_TYPE__LESS_FUNCTION )                                            \
+    static inline void TYPENAME_LOWERCASE ## __sort__swap( ELEMENT_TYPE *first, ELEMENT_TYPE *second ){                                             \
+        ELEMENT_TYPE element = *first;                                                                                                              \
+        *first = *second;                                                                                                                           \
+        *second = element;                                                                                                                          \
+    }                                                                                                                                               \
+                                                                                                                                                    \
+    /**                                                                                                                                             \
+     *  \brief Orders two elements.                                                                                                                 \
+     */                                                                                                                                             \
+    static inline void TYPENAME_LOWERCASE ## __sort__sort_2( ELEMENT_TYPE *first, ELEMENT_TYPE *second ){                                           \
+        if( ELEMENT_TYPE__LESS_FUNCTION( *second, *first ) ){                                                                                       \
+            TYPENAME_LOWERCASE ## __sort__swap( first, second );                                                                                    \
+        }                                                                                                                                           \
+    }                                                                                                                                               \
+                                                                                                                                                    \
+    /**                                                                                                                                             \
+     *  \brief Orders three elements, so that the median is in the middle.                                                                          \
+     */                                                                                                                                             \
+    static inline void TYPENAME_LOWERCASE ## __sort__sort_3( ELEMENT_TYPE *first, ELEMENT_TYPE *second, ELEMENT_TYPE *third ){                      \
+        TYPENAME_LOWERCASE ## __sort__sort_2( first, second );                                                                                      \
+        TYPENAME_LOWERCASE ## __sort__sort_2( second, third );                                                                                      \
+        TYPENAME_LOWERCASE ## __sort__sort_2( first, second );                                                                                      \
+    }                                                                                                                                               \
+                                                                                                                                                    \
+    /**                                                                                                                                             \
+     *  \brief Sorts the elements in [begin, end) by insertion. This is stable, and fast for few or nearly sorted                                   \
+     *  elements.                                                                                                                                   \
+     */                                                                                                                                             \
+    static void TYPENAME_LOWERCASE ## __sort__insertion( ELEMENT_TYPE *begin, ELEMENT_TYPE *end ){                                                  \
+        if( begin == end ){                                                                                                                         \
+            return;                                                                                                                                 \
+        }                                                                                                                                           \
+                                                                                                                                                    \
+        for( ELEMENT_TYPE *current = begin + 1; current != end; current++ ){                                                                        \
+            if( ELEMENT_TYPE__LESS_FUNCTION( *current, *( current - 1 ) ) ){                                                                        \
+                ELEMENT_TYPE element = *current;                                                                                                    \
+                ELEMENT_TYPE *hole = current;                                                                                                       \
+                do{                                                                                                                                 \
+                    *hole = *( hole - 1 );                                                                                                          \
+                    hole--;                                                                                                                         \
+                } while( hole != begin && ELEMENT_TYPE__LESS_FUNCTION( element, *( hole - 1 ) ) );                                                  \
+                *hole = element;                                                                                                                    \
+            }                                                                                                                                       \
+        }                                                                                                                                           \
+    }                                                                                                                                               \
+                                                                                                                                                    \
+    /**                                                                                                                                             \
+     *  \brief Sorts the elements in [begin, end) by insertion, given that the element before begin is no greater                                   \
+     *  than any of them, so that it stops each element from moving further left without a bounds check.                                            \
+     */                                                                                                                                             \
+    static void TYPENAME_LOWERCASE ## __sort__insertion__unguarded( ELEMENT_TYPE *begin, ELEMENT_TYPE *end ){                                       \
+        if( begin == end ){                                                                                                                         \
+            return;                                                                                                                                 \
+        }                                                                                                                                           \
+                                                                                                                                                    \
+        for( ELEMENT_TYPE *current = begin + 1; current != end; current++ ){                                                                        \
+            if( ELEMENT_TYPE__LESS_FUNCTION( *current, *( current - 1 ) ) ){                                                                        \
+                ELEMENT_TYPE element = *current;                                                                                                    \
+                ELEMENT_TYPE *hole = current;                                                                                                       \
+                do{                                                                                                                                 \
+                    *hole = *( hole - 1 );                                                                                                          \
+                    hole--;                                                                                                                         \
+                } while( ELEMENT_TYPE__LESS_FUNCTION( element, *( hole - 1 ) ) );                                                                   \
+                *hole = element;                                                                                                                    \
+            }                                                                                                                                       \
+        }                                                                                                                                           \
+    }                                                                                                                                               \
+                                                                                                                                                    \
+    /**                                                                                                                                             \
+     *  \brief Attempts to sort the elements in [begin, end) by insertion, giving up once more than 8 elements have                                 \
+     *  been moved.                                                                                                                                 \
+     *  \returns Returns true if the elements were sorted, and false if the attempt was abandoned.                                                  \
+     */                                                                                                                                             \
+    static bool TYPENAME_LOWERCASE ## __sort__insertion__partial( ELEMENT_TYPE *begin, ELEMENT_TYPE *end ){                                         \
+        if( begin == end ){                                                                                                                         \
+            return true;                                                                                                                            \
+        }                                                                                                                                           \
+                                                                                                                                                    \
+        unsigned long long move_count = 0;                                                                                                          \
+        for( ELEMENT_TYPE *current = begin + 1; current != end; current++ ){                                                                        \
+            if( ELEMENT_TYPE__LESS_FUNCTION( *current, *( current - 1 ) ) ){                                                                        \
+                ELEMENT_TYPE element = *current;                                                                                                    \
+                ELEMENT_TYPE *hole = current;                                                                                                       \
+                do{                                                                                                                                 \
+                    *hole = *( hole - 1 );                                                                                                          \
+                    hole--;                                                                                                                         \
+                } while( hole != begin && ELEMENT_TYPE__LESS_FUNCTION( element, *( hole - 1 ) ) );                                                  \
+                *hole = element;                                                                                                                    \
+                                                                                                                                                    \
+                move_count += (unsigned long long)( current - hole );                                                                               \
+                if( move_count > 8 ){                                                                                                               \
+                    return false;                                                                                                                   \
+                }                                                                                                                                   \
+            }                                                                                                                                       \
+        }                                                                                                                                           \
+                                                                                                                                                    \
+        return true;                                                                                                                                \
+    }                                                                                                                                               \
+                                                                                                                                                    \
+    /**                                                                                                                                             \
+     *  \brief Restores the heap property of the subtree rooted at root, within a heap of length elements.                                          \
+     */                                                                                                                                             \
+    static void TYPENAME_LOWERCASE ## __sort__sift_down( ELEMENT_TYPE *heap, unsigned long long root, unsigned long long length ){                  \
+        ELEMENT_TYPE element = heap[ root ];                                                                                                        \
+        for( unsigned long long child = 2 * root + 1; child < length; child = 2 * root + 1 ){                                                       \
+            if( child + 1 < length && ELEMENT_TYPE__LESS_FUNCTION( heap[ child ], heap[ child + 1 ] ) ){                                            \
+                child++;                                                                                                                            \
+            }                                                                                                                                       \
+            if( !ELEMENT_TYPE__LESS_FUNCTION( element, heap[ child ] ) ){                                                                           \
+                break;                                                                                                                              \
+            }                                                                                                                                       \
+            heap[ root ] = heap[ child ];                                                                                                           \
+            root = child;                                                                                                                           \
+        }                                                                                                                                           \
+        heap[ root ] = element;                                                                                                                     \
+    }                                                                                                                                               \
+                                                                                                                                                    \
+    /**                                                                                                                                             \
+     *  \brief Sorts the elements in [begin, end) with heapsort, which bounds the time taken by inputs which defeat                                 \
+     *  the choice of pivot.                                                                                                                        \
+     */                                                                                                                                             \
+    static void TYPENAME_LOWERCASE ## __sort__heap( ELEMENT_TYPE *begin, ELEMENT_TYPE *end ){                                                       \
+        unsigned long long length = (unsigned long long)( end - begin );                                                                            \
+        for( unsigned long long root = length / 2; root > 0; root-- ){                                                                              \
+            TYPENAME_LOWERCASE ## __sort__sift_down( begin, root - 1, length );                                                                     \
+        }                                                                                                                                           \
+        for( unsigned long long last = length; last > 1; last-- ){                                                                                  \
+            TYPENAME_LOWERCASE ## __sort__swap( begin, begin + last - 1 );                                                                          \
+            TYPENAME_LOWERCASE ## __sort__sift_down( begin, 0, last - 1 );                                                                          \
+        }                                                                                                                                           \
+    }                                                                                                                                               \
+                                                                                                                                                    \
+    /**                                                                                                                                             \
+     *  \brief Partitions [begin, end) around the pivot at begin, placing elements equal to the pivot on its right.                                 \
+     *  \param out__already_partitioned An out parameter. Upon return, this will store whether no elements were                                     \
+     *  swapped, which suggests that the elements may already be sorted.                                                                            \
+     *  \returns Returns the final position of the pivot.                                                                                           \
+     */                                                                                                                                             \
+    static ELEMENT_TYPE *TYPENAME_LOWERCASE ## __sort__partition_right( ELEMENT_TYPE *begin, ELEMENT_TYPE *end, bool *out__already_partitioned ){   \
+        ELEMENT_TYPE pivot = *begin;                                                                                                                \
+        ELEMENT_TYPE *first = begin;                                                                                                                \
+        ELEMENT_TYPE *last = end;                                                                                                                   \
+                                                                                                                                                    \
+        /* The median of three guarantees that an element no less than the pivot stops the first scan. */                                           \
+        while( ELEMENT_TYPE__LESS_FUNCTION( *++first, pivot ) ){                                                                                    \
+        }                                                                                                                                           \
+                                                                                                                                                    \
+        /* Where no element was passed over, the second scan must be bounded. */                                                                    \
+        if( first - 1 == begin ){                                                                                                                   \
+            while( first < last && !ELEMENT_TYPE__LESS_FUNCTION( *--last, pivot ) ){                                                                \
+            }                                                                                                                                       \
+        }                                                                                                                                           \
+        else{                                                                                                                                       \
+            while( !ELEMENT_TYPE__LESS_FUNCTION( *--last, pivot ) ){                                                                                \
+            }                                                                                                                                       \
+        }                                                                                                                                           \
+                                                                                                                                                    \
+        *out__already_partitioned = first >= last;                                                                                                  \
+                                                                                                                                                    \
+        while( first < last ){                                                                                                                      \
+            TYPENAME_LOWERCASE ## __sort__swap( first, last );                                                                                      \
+            while( ELEMENT_TYPE__LESS_FUNCTION( *++first, pivot ) ){                                                                                \
+            }                                                                                                                                       \
+            while( !ELEMENT_TYPE__LESS_FUNCTION( *--last, pivot ) ){                                                                                \
+            }                                                                                                                                       \
+        }                                                                                                                                           \
+                                                                                                                                                    \
+        ELEMENT_TYPE *pivot_position = first - 1;                                                                                                   \
+        *begin = *pivot_position;                                                                                                                   \
+        *pivot_position = pivot;                                                                                                                    \
+                                                                                                                                                    \
+        return pivot_position;                                                                                                                      \
+    }                                                                                                                                               \
+                                                                                                                                                    \
+    /**                                                                                                                                             \
+     *  \brief Partitions [begin, end) around the pivot at begin, placing elements equal to the pivot on its left.                                  \
+     *  This is used when the pivot equals the element before begin, so that runs of equal elements are consumed in                                 \
+     *  linear time.                                                                                                                                \
+     *  \returns Returns the final position of the pivot.                                                                                           \
+     */                                                                                                                                             \
+    static ELEMENT_TYPE *TYPENAME_LOWERCASE ## __sort__partition_left( ELEMENT_TYPE *begin, ELEMENT_TYPE *end ){                                    \
+        ELEMENT_TYPE pivot = *begin;                                                                                                                \
+        ELEMENT_TYPE *first = begin;                                                                                                                \
+        ELEMENT_TYPE *last = end;                                                                                                                   \
+                                                                                                                                                    \
+        while( ELEMENT_TYPE__LESS_FUNCTION( pivot, *--last ) ){                                                                                     \
+        }                                                                                                                                           \
+                                                                                                                                                    \
+        if( last + 1 == end ){                                                                                                                      \
+            while( first < last && !ELEMENT_TYPE__LESS_FUNCTION( pivot, *++first ) ){                                                               \
+            }                                                                                                                                       \
+        }                                                                                                                                           \
+        else{                                                                                                                                       \
+            while( !ELEMENT_TYPE__LESS_FUNCTION( pivot, *++first ) ){                                                                               \
+            }                                                                                                                                       \
+        }                                                                                                                                           \
+                                                                                                                                                    \
+        while( first < last ){                                                                                                                      \
+            TYPENAME_LOWERCASE ## __sort__swap( first, last );                                                                                      \
+            while( ELEMENT_TYPE__LESS_FUNCTION( pivot, *--last ) ){                                                                                 \
+            }                                                                                                                                       \
+            while( !ELEMENT_TYPE__LESS_FUNCTION( pivot, *++first ) ){                                                                               \
+            }                                                                                                                                       \
+        }                                                                                                                                           \
+                                                                                                                                                    \
+        *begin = *last;                                                                                                                             \
+        *last = pivot;                                                                                                                              \
+                                                                                                                                                    \
+        return last;                                                                                                                                \
+    }                                                                                                                                               \
+                                                                                                                                                    \
+    /**                                                                                                                                             \
+     *  \brief Sorts [begin, end) with pattern-defeating quicksort.                                                                                 \
+     *  \param bad_partitions_allowed The number of highly unbalanced partitions after which heapsort is used.                                      \
+     *  \param leftmost Whether [begin, end) is the leftmost part of the array, with no element before begin.                                       \
+     */                                                                                                                                             \
+    static void TYPENAME_LOWERCASE ## __sort__pattern_defeating_quicksort(                                                                          \
+        ELEMENT_TYPE *begin,                                                                                                                        \
+        ELEMENT_TYPE *end,                                                                                                                          \
+        unsigned int bad_partitions_allowed,                                                                                                        \
+        bool leftmost                                                                                                                               \
+    ){                                                                                                                                              \
+        while( true ){                                                                                                                              \
+            unsigned long long length = (unsigned long long)( end - begin );                                                                        \
+            if( length < ORDERED_ARRAY__INSERTION_SORT_LENGTH ){                                                                                    \
+                if( leftmost ){                                                                                                                     \
+                    TYPENAME_LOWERCASE ## __sort__insertion( begin, end );                                                                          \
+                }                                                                                                                                   \
+                else{                                                                                                                               \
+                    TYPENAME_LOWERCASE ## __sort__insertion__unguarded( begin, end );                                                               \
+                }                                                                                                                                   \
+                return;                                                                                                                             \
+            }                                                                                                                                       \
+                                                                                                                                                    \
+            /* The pivot is moved to begin. */                                                                                                      \
+            unsigned long long half = length / 2;                                                                                                   \
+            if( length > ORDERED_ARRAY__NINTHER_LENGTH ){                                                                                           \
+                TYPENAME_LOWERCASE ## __sort__sort_3( begin, begin + half, end - 1 );                                                               \
+                TYPENAME_LOWERCASE ## __sort__sort_3( begin + 1, begin + half - 1, end - 2 );                                                       \
+                TYPENAME_LOWERCASE ## __sort__sort_3( begin + 2, begin + half + 1, end - 3 );                                                       \
+                TYPENAME_LOWERCASE ## __sort__sort_3( begin + half - 1, begin + half, begin + half + 1 );                                           \
+                TYPENAME_LOWERCASE ## __sort__swap( begin, begin + half );                                                                          \
+            }                                                                                                                                       \
+            else{                                                                                                                                   \
+                TYPENAME_LOWERCASE ## __sort__sort_3( begin + half, begin, end - 1 );                                                               \
+            }                                                                                                                                       \
+                                                                                                                                                    \
+            /* A pivot equal to the element before begin, which ended the previous partition, is the least element. */                              \
+            if( !leftmost && !ELEMENT_TYPE__LESS_FUNCTION( *( begin - 1 ), *begin ) ){                                                              \
+                begin = TYPENAME_LOWERCASE ## __sort__partition_left( begin, end ) + 1;                                                             \
+                continue;                                                                                                                           \
+            }                                                                                                                                       \
+                                                                                                                                                    \
+            bool already_partitioned;                                                                                                               \
+            ELEMENT_TYPE *pivot_position = TYPENAME_LOWERCASE ## __sort__partition_right( begin, end, &already_partitioned );                       \
+                                                                                                                                                    \
+            unsigned long long left_length = (unsigned long long)( pivot_position - begin );                                                        \
+            unsigned long long right_length = (unsigned long long)( end - ( pivot_position + 1 ) );                                                 \
+            if( left_length < length / 8 || right_length < length / 8 ){                                                                            \
+                if( --bad_partitions_allowed == 0 ){                                                                                                \
+                    TYPENAME_LOWERCASE ## __sort__heap( begin, end );                                                                               \
+                    return;                                                                                                                         \
+                }                                                                                                                                   \
+                                                                                                                                                    \
+                /* Swapping elements away from the ends breaks up patterns which defeated the choice of pivot. */                                   \
+                if( left_length >= ORDERED_ARRAY__INSERTION_SORT_LENGTH ){                                                                          \
+                    TYPENAME_LOWERCASE ## __sort__swap( begin, begin + left_length / 4 );                                                           \
+                    TYPENAME_LOWERCASE ## __sort__swap( pivot_position - 1, pivot_position - left_length / 4 );                                     \
+                    if( left_length > ORDERED_ARRAY__NINTHER_LENGTH ){                                                                              \
+                        TYPENAME_LOWERCASE ## __sort__swap( begin + 1, begin + ( left_length / 4 + 1 ) );                                           \
+                        TYPENAME_LOWERCASE ## __sort__swap( begin + 2, begin + ( left_length / 4 + 2 ) );                                           \
+                        TYPENAME_LOWERCASE ## __sort__swap( pivot_position - 2, pivot_position - ( left_length / 4 + 1 ) );                         \
+                        TYPENAME_LOWERCASE ## __sort__swap( pivot_position - 3, pivot_position - ( left_length / 4 + 2 ) );                         \
+                    }                                                                                                                               \
+                }                                                                                                                                   \
+                if( right_length >= ORDERED_ARRAY__INSERTION_SORT_LENGTH ){                                                                         \
+                    TYPENAME_LOWERCASE ## __sort__swap( pivot_position + 1, pivot_position + ( 1 + right_length / 4 ) );                            \
+                    TYPENAME_LOWERCASE ## __sort__swap( end - 1, end - right_length / 4 );                                                          \
+                    if( right_length > ORDERED_ARRAY__NINTHER_LENGTH ){                                                                             \
+                        TYPENAME_LOWERCASE ## __sort__swap( pivot_position + 2, pivot_position + ( 2 + right_length / 4 ) );                        \
+                        TYPENAME_LOWERCASE ## __sort__swap( pivot_position + 3, pivot_position + ( 3 + right_length / 4 ) );                        \
+                        TYPENAME_LOWERCASE ## __sort__swap( end - 2, end - ( 1 + right_length / 4 ) );                                              \
+                        TYPENAME_LOWERCASE ## __sort__swap( end - 3, end - ( 2 + right_length / 4 ) );                                              \
+                    }                                                                                                                               \
+                }                                                                                                                                   \
+            }                                                                                                                                       \
+            /* A partition which swapped nothing suggests sorted input, which insertion sort confirms cheaply. */                                   \
+            else if(                                                                                                                                \
+                already_partitioned &&                                                                                                              \
+                TYPENAME_LOWERCASE ## __sort__insertion__partial( begin, pivot_position ) &&                                                        \
+                TYPENAME_LOWERCASE ## __sort__insertion__partial( pivot_position + 1, end )                                                         \
+            ){                                                                                                                                      \
+                return;                                                                                                                             \
+            }                                                                                                                                       \
+                                                                                                                                                    \
+            /* Recursing into the left part, and looping over the right part, bounds the depth of the stack. */                                     \
+            TYPENAME_LOWERCASE ## __sort__pattern_defeating_quicksort( begin, pivot_position, bad_partitions_allowed, leftmost );                   \
+            begin = pivot_position + 1;                                                                                                             \
+            leftmost = false;                                                                                                                       \
+        }                                                                                                                                           \
+    }                                                                                                                                               \
+                                                                                                                                                    \
+    void TYPENAME_LOWERCASE ## __sort(                                                                                                              \
+        TYPENAME *TYPENAME_LOWERCASE                                                                                                                \
+    ){                                                                                                                                              \
+        RETURN_IF_FAIL( TYPENAME_LOWERCASE != NULL );                                                                                               \
+        RETURN_IF_FAIL( TYPENAME_LOWERCASE->length > 1 );                                                                                           \
+                                                                                                                                                    \
+        unsigned int bad_partitions_allowed = 0;                                                                                                    \
+        for( unsigned long long length = TYPENAME_LOWERCASE->length; length > 0; length >>= 1 ){                                                    \
+            bad_partitions_allowed++;                                                                                                               \
+        }                                                                                                                                           \
+                                                                                                                                                    \
+        ELEMENT_TYPE *data = TYPENAME_LOWERCASE->data;                                                                                              \
+        TYPENAME_LOWERCASE ## __sort__pattern_defeating_quicksort( data, data + TYPENAME_LOWERCASE->length, bad_partitions_allowed, true );         \
+    }                                                                                                                                               \
+                                                                                                                                                    \
+    /**                                                                                                                                             \
+     *  \brief Sorts length elements with a stable merge sort.                                                                                      \
+     *  \param buffer Room for at least half of the elements.                                                                                       \
+     */                                                                                                                                             \
+    static void TYPENAME_LOWERCASE ## __sort__merge( ELEMENT_TYPE *data, ELEMENT_TYPE *buffer, unsigned long long length ){                         \
+        if( length < ORDERED_ARRAY__INSERTION_SORT_LENGTH ){                                                                                        \
+            TYPENAME_LOWERCASE ## __sort__insertion( data, data + length );                                                                         \
+            return;                                                                                                                                 \
+        }                                                                                                                                           \
+                                                                                                                                                    \
+        unsigned long long half = length / 2;                                                                                                       \
+        TYPENAME_LOWERCASE ## __sort__merge( data, buffer, half );                                                                                  \
+        TYPENAME_LOWERCASE ## __sort__merge( data + half, buffer, length - half );                                                                  \
+                                                                                                                                                    \
+        /* Halves which are already in order need no merging. */                                                                                    \
+        if( !ELEMENT_TYPE__LESS_FUNCTION( data[ half ], data[ half - 1 ] ) ){                                                                       \
+            return;                                                                                                                                 \
+        }                                                                                                                                           \
+                                                                                                                                                    \
+        /* The left half is moved aside, so that merging into data never overwrites an element not yet merged. */                                   \
+        memcpy( buffer, data, half * sizeof( ELEMENT_TYPE ) );                                                                                      \
+                                                                                                                                                    \
+        unsigned long long left = 0;                                                                                                                \
+        unsigned long long right = half;                                                                                                            \
+        unsigned long long output = 0;                                                                                                              \
+        while( left < half && right < length ){                                                                                                     \
+            /* Ties take the left element, which keeps the sort stable. */                                                                          \
+            if( ELEMENT_TYPE__LESS_FUNCTION( data[ right ], buffer[ left ] ) ){                                                                     \
+                data[ output++ ] = data[ right++ ];                                                                                                 \
+            }                                                                                                                                       \
+            else{                                                                                                                                   \
+                data[ output++ ] = buffer[ left++ ];                                                                                                \
+            }                                                                                                                                       \
+        }                                                                                                                                           \
+        memcpy( data + output, buffer + left, ( half - left ) * sizeof( ELEMENT_TYPE ) );                                                           \
+    }                                                                                                                                               \
+                                                                                                                                                    \
+    bool TYPENAME_LOWERCASE ## __sort__stable(                                                                                                      \
+        TYPENAME *TYPENAME_LOWERCASE,                                                                                                               \
+        Allocator *allocator                                                                                                                        \
+    ){                                                                                                                                              \
+        RETURN_VALUE_IF_FAIL( TYPENAME_LOWERCASE != NULL, false );                                                                                  \
+        if( TYPENAME_LOWERCASE->length < 2 ){                                                                                                       \
+            return true;                                                                                                                            \
+        }                                                                                                                                           \
+                                                                                                                                                    \
+        /* Cast for C++ compatibility */                                                                                                            \
+        ELEMENT_TYPE *buffer = (ELEMENT_TYPE*) allocator__alloc( allocator, ( TYPENAME_LOWERCASE->length / 2 ) * sizeof( ELEMENT_TYPE ) );          \
+        RETURN_VALUE_IF_FAIL( buffer != NULL, false );                                                                                              \
+                                                                                                                                                    \
+        TYPENAME_LOWERCASE ## __sort__merge( TYPENAME_LOWERCASE->data, buffer, TYPENAME_LOWERCASE->length );                                        \
+                                                                                                                                                    \
+        allocator__free( allocator, buffer );                                                                                                       \
+        return true;                                                                                                                                \
+    }                                                                                                                                               \
+                                                                                                                                                    \
+    unsigned long long TYPENAME_LOWERCASE ## __lower_bound(                                                                                         \
+        TYPENAME const *TYPENAME_LOWERCASE,                                                                                                         \
+        ELEMENT_TYPE element                                                                                                                        \
+    ){                                                                                                                                              \
+        RETURN_VALUE_IF_FAIL( TYPENAME_LOWERCASE != NULL, 0 );                                                                                      \
+        unsigned long long length = TYPENAME_LOWERCASE->length;                                                                                     \
+        if( length == 0 ){                                                                                                                          \
+            return 0;                                                                                                                               \
+        }                                                                                                                                           \
+                                                                                                                                                    \
+        /* The first element not less than element is always within [base, base + length]. */                                                       \
+        ELEMENT_TYPE const *base = TYPENAME_LOWERCASE->data;                                                                                        \
+        while( length > 1 ){                                                                                                                        \
+            unsigned long long half = length / 2;                                                                                                   \
+            base = ELEMENT_TYPE__LESS_FUNCTION( base[ half ], element ) ? base + half : base;                                                       \
+            length -= half;                                                                                                                         \
+        }                                                                                                                                           \
+                                                                                                                                                    \
+        return (unsigned long long)( base - TYPENAME_LOWERCASE->data ) + ( ELEMENT_TYPE__LESS_FUNCTION( *base, element ) ? 1 : 0 );                 \
+    }                                                                                                                                               \
+                                                                                                                                                    \
+    unsigned long long TYPENAME_LOWERCASE ## __upper_bound(                                                                                         \
+        TYPENAME const *TYPENAME_LOWERCASE,                                                                                                         \
+        ELEMENT_TYPE element                                                                                                                        \
+    ){                                                                                                                                              \
+        RETURN_VALUE_IF_FAIL( TYPENAME_LOWERCASE != NULL, 0 );                                                                                      \
+        unsigned long long length = TYPENAME_LOWERCASE->length;                                                                                     \
+        if( length == 0 ){                                                                                                                          \
+            return 0;                                                                                                                               \
+        }                                                                                                                                           \
+                                                                                                                                                    \
+        /* The first element greater than element is always within [base, base + length]. */                                                        \
+        ELEMENT_TYPE const *base = TYPENAME_LOWERCASE->data;                                                                                        \
+        while( length > 1 ){                                                                                                                        \
+            unsigned long long half = length / 2;                                                                                                   \
+            base = !ELEMENT_TYPE__LESS_FUNCTION( element, base[ half ] ) ? base + half : base;                                                      \
+            length -= half;                                                                                                                         \
+        }                                                                                                                                           \
+                                                                                                                                                    \
+        return (unsigned long long)( base - TYPENAME_LOWERCASE->data ) + ( !ELEMENT_TYPE__LESS_FUNCTION( element, *base ) ? 1 : 0 );                \
+    }                                                                                                                                               \
+                                                                                                                                                    \
+    bool TYPENAME_LOWERCASE ## __binary_search(                                                                                                     \
+        TYPENAME const *TYPENAME_LOWERCASE,                                                                                                         \
+        ELEMENT_TYPE element,                                                                                                                       \
+        unsigned long long *out__index                                                                                                              \
+    ){                                                                                                                                              \
+        RETURN_VALUE_IF_FAIL( TYPENAME_LOWERCASE != NULL, false );                                                                                  \
+                                                                                                                                                    \
+        unsigned long long index = TYPENAME_LOWERCASE ## __lower_bound( TYPENAME_LOWERCASE, element );                                              \
+        *out__index = index;                                                                                                                        \
+                                                                                                                                                    \
+        return index < TYPENAME_LOWERCASE->length && !ELEMENT_TYPE__LESS_FUNCTION( element, TYPENAME_LOWERCASE->data[ index ] );                    \
+    }                                                                                                                                               \
+                                                                                                                                                    \
+    unsigned long long auto_ ## TYPENAME_LOWERCASE ## __sorted_insert(                                                                              \
+        Auto ## TYPENAME *auto_ ## TYPENAME_LOWERCASE,                                                                                              \
+        ELEMENT_TYPE element                                                                                                                        \
+    ){                                                                                                                                              \
+        RETURN_VALUE_IF_FAIL( auto_ ## TYPENAME_LOWERCASE != NULL && auto_ ## TYPENAME_LOWERCASE->TYPENAME_LOWERCASE != NULL, 0 );                  \
+                                                                                                                                                    \
+        unsigned long long index = TYPENAME_LOWERCASE ## __upper_bound( auto_ ## TYPENAME_LOWERCASE->TYPENAME_LOWERCASE, element );                 \
+        auto_ ## TYPENAME_LOWERCASE ## __insert_element( auto_ ## TYPENAME_LOWERCASE, index, element );                                             \
+                                                                                                                                                    \
+        return index;                                                                                                                               \
+    }
+
+/**
+ *  \def ORDERED_ARRAY__DECLARE_RADIX_SORT( TYPENAME, TYPENAME_LOWERCASE, ELEMENT_TYPE )
+ *  \brief Declares a radix sort for an Array type whose elements are ordered by an unsigned integer key. This macro
+ *  should be paired with a call to the macro
+ *      ORDERED_ARRAY__DEFINE_RADIX_SORT( TYPENAME, TYPENAME_LOWERCASE, ELEMENT_TYPE, ELEMENT_TYPE__KEY_FUNCTION ).
+ */
+#define ORDERED_ARRAY__DECLARE_RADIX_SORT( TYPENAME, TYPENAME_LOWERCASE, ELEMENT_TYPE )                                                             \
+    /**                                                                                                                                             \
+     *  \brief Sorts an array in ascending order of the keys of its elements, with a least significant digit radix                                  \
+     *  sort, one byte of the key at a time. Equal keys keep their original order. This takes linear time, and skips                                \
+     *  every byte which is the same in all keys, such as the high bytes of small keys.                                                             \
+     *  \param array A pointer to the array to be sorted.                                                                                           \
+     *  \param allocator The allocator used to allocate a buffer of the length of \p array.                                                         \
+     *  \returns Returns true if the array was sorted, and false if the buffer could not be allocated, in which case                                \
+     *  the array is unchanged.                                                                                                                     \
+     */                                                                                                                                             \
+    bool TYPENAME_LOWERCASE ## __sort__radix(                                                                                                       \
+        TYPENAME *TYPENAME_LOWERCASE,                                                                                                               \
+        Allocator *allocator                                                                                                                        \
+    );
+
+/**
+ *  \def ORDERED_ARRAY__DEFINE_RADIX_SORT( TYPENAME, TYPENAME_LOWERCASE, ELEMENT_TYPE, ELEMENT_TYPE__KEY_FUNCTION )
+ *  \brief Defines a radix sort for an Array type. This macro must be paired with a call to the macro
+ *  ORDERED_ARRAY__DECLARE_RADIX_SORT( TYPENAME, TYPENAME_LOWERCASE, ELEMENT_TYPE ).
+ *  \param ELEMENT_TYPE__KEY_FUNCTION A function which returns the key of an element. The signature should be:
+ *      unsigned long long (*key_function)( ELEMENT_TYPE ).
+ *  A signed integer is ordered correctly by flipping its sign bit, as in ( (unsigned long long) value ) ^ ( 1ULL << 63 ).
+ */
+#define ORDERED_ARRAY__DEFINE_RADIX_SORT( TYPENAME, TYPENAME_LOWERCASE, ELEMENT_TYPE, ELEMENT_TYPE__KEY_FUNCTION )                                  \
+    bool TYPENAME_LOWERCASE ## __sort__radix(                                                                                                       \
+        TYPENAME *TYPENAME_LOWERCASE,                                                                                                               \
+        Allocator *allocator                                                                                                                        \
+    ){                                                                                                                                              \
+        RETURN_VALUE_IF_FAIL( TYPENAME_LOWERCASE != NULL, false );                                                                                  \
+        unsigned long long length = TYPENAME_LOWERCASE->length;                                                                                     \
+        if( length < 2 ){                                                                                                                           \
+            return true;                                                                                                                            \
+        }                                                                                                                                           \
+                                                                                                                                                    \
+        /* Cast for C++ compatibility */                                                                                                            \
+        ELEMENT_TYPE *buffer = (ELEMENT_TYPE*) allocator__alloc( allocator, length * sizeof( ELEMENT_TYPE ) );                                      \
+        RETURN_VALUE_IF_FAIL( buffer != NULL, false );                                                                                              \
+                                                                                                                                                    \
+        /* The counts of every byte of the key are gathered in a single pass. */                                                                    \
+        unsigned long long counts[ sizeof( unsigned long long ) ][ 256 ];                                                                           \
+        memset( counts, 0, sizeof( counts ) );                                                                                                      \
+        for( unsigned long long index = 0; index < length; index++ ){                                                                               \
+            unsigned long long key = ELEMENT_TYPE__KEY_FUNCTION( TYPENAME_LOWERCASE->data[ index ] );                                               \
+            for( unsigned int digit = 0; digit < sizeof( unsigned long long ); digit++ ){                                                           \
+                counts[ digit ][ ( key >> ( 8 * digit ) ) & 0xFF ]++;                                                                               \
+            }                                                                                                                                       \
+        }                                                                                                                                           \
+                                                                                                                                                    \
+        ELEMENT_TYPE *source = TYPENAME_LOWERCASE->data;                                                                                            \
+        ELEMENT_TYPE *destination = buffer;                                                                                                         \
+        for( unsigned int digit = 0; digit < sizeof( unsigned long long ); digit++ ){                                                               \
+            unsigned int shift = 8 * digit;                                                                                                         \
+                                                                                                                                                    \
+            /* A byte which is the same in every key would not move any element. */                                                                 \
+            if( counts[ digit ][ ( ELEMENT_TYPE__KEY_FUNCTION( source[ 0 ] ) >> shift ) & 0xFF ] == length ){                                       \
+                continue;                                                                                                                           \
+            }                                                                                                                                       \
+                                                                                                                                                    \
+            unsigned long long offsets[ 256 ];                                                                                                      \
+            unsigned long long offset = 0;                                                                                                          \
+            for( unsigned int byte = 0; byte < 256; byte++ ){                                                                                       \
+                offsets[ byte ] = offset;                                                                                                           \
+                offset += counts[ digit ][ byte ];                                                                                                  \
+            }                                                                                                                                       \
+                                                                                                                                                    \
+            for( unsigned long long index = 0; index < length; index++ ){                                                                           \
+                destination[ offsets[ ( ELEMENT_TYPE__KEY_FUNCTION( source[ index ] ) >> shift ) & 0xFF ]++ ] = source[ index ];                    \
+            }                                                                                                                                       \
+                                                                                                                                                    \
+            ELEMENT_TYPE *sorted = destination;                                                                                                     \
+            destination = source;                                                                                                                   \
+            source = sorted;                                                                                                                        \
+        }                                                                                                                                           \
+                                                                                                                                                    \
+        if( source != TYPENAME_LOWERCASE->data ){                                                                                                   \
+            memcpy( TYPENAME_LOWERCASE->data, source, length * sizeof( ELEMENT_TYPE ) );                                                            \
+        }                                                                                                                                           \
+                                                                                                                                                    \
+        allocator__free( allocator, buffer );                                                                                                       \
+        return true;                                                                                                                                \
+    }
+
+/**
+ *  \def ORDERED_ARRAY__DECLARE_PARALLEL_SORT( TYPENAME, TYPENAME_LOWERCASE, ELEMENT_TYPE )
+ *  \brief Declares a parallel sort for an Array type. This macro should be paired with a call to the macro
+ *      ORDERED_ARRAY__DEFINE_PARALLEL_SORT( TYPENAME, TYPENAME_LOWERCASE, ELEMENT_TYPE, ELEMENT_TYPE__LESS_FUNCTION ).
+ */
+#define ORDERED_ARRAY__DECLARE_PARALLEL_SORT( TYPENAME, TYPENAME_LOWERCASE, ELEMENT_TYPE )                                                          \
+    /**                                                                                                                                             \
+     *  \brief Sorts an array in ascending order with several threads, keeping equal elements in their original                                     \
+     *  order. Each thread sorts a contiguous part of the array with merge sort, and then the sorted parts are merged                               \
+     *  in pairs, over log2( thread_count ) rounds. Every round divides the elements to be merged evenly among all of                               \
+     *  the threads, by finding where each thread's share of the output splits the two runs being merged. The result                                \
+     *  is identical to that of the sequential stable sort.                                                                                         \
+     *  \param array A pointer to the array to be sorted.                                                                                           \
+     *  \param allocator The allocator used to allocate a buffer of the length of \p array, which is all the memory                                 \
+     *  used beyond the stacks of the threads.                                                                                                      \
+     *  \param thread_count The number of threads to sort with, including the calling thread. This is limited to                                    \
+     *  ORDERED_ARRAY__PARALLEL_SORT_MAXIMUM_THREAD_COUNT, and to one thread for every                                                              \
+     *  ORDERED_ARRAY__PARALLEL_SORT_MINIMUM_LENGTH elements. Should a thread fail to start, its work is done by the                                \
+     *  calling thread instead.                                                                                                                     \
+     *  \returns Returns true if the array was sorted, and false if the buffer could not be allocated, in which case                                \
+     *  the array is unchanged.                                                                                                                     \
+     */                                                                                                                                             \
+    bool TYPENAME_LOWERCASE ## __sort__parallel(                                                                                                    \
+        TYPENAME *TYPENAME_LOWERCASE,                                                                                                               \
+        Allocator *allocator,                                                                                                                       \
+        unsigned int thread_count                                                                                                                   \
+    );
+
+/**
+ *  \def ORDERED_ARRAY__DEFINE_PARALLEL_SORT( TYPENAME, TYPENAME_LOWERCASE, ELEMENT_TYPE, ELEMENT_TYPE__LESS_FUNCTION )
+ *  \brief Defines a parallel sort for an Array type. This macro must be paired with a call to the macro
+ *  ORDERED_ARRAY__DECLARE_PARALLEL_SORT( TYPENAME, TYPENAME_LOWERCASE, ELEMENT_TYPE ), and follow the definition of
+ *  the Array type's sorts by ORDERED_ARRAY__DEFINE, with the same ELEMENT_TYPE__LESS_FUNCTION.
+ */
+#define ORDERED_ARRAY__DEFINE_PARALLEL_SORT( TYPENAME, TYPENAME_LOWERCASE, ELEMENT_TYPE, ELEMENT_TYPE__LESS_FUNCTION )                              \
+    /**                                                                                                                                             \
+     *  \brief The state shared by the threads of a parallel sort, during one of its steps.                                                         \
+     */                                                                                                                                             \
+    typedef struct TYPENAME ## __ParallelSort{                                                                                                      \
+        ELEMENT_TYPE *data;                                                                                                                         \
+        ELEMENT_TYPE *buffer;                                                                                                                       \
+        /* The elements read by the current step, and those written by it. */                                                                       \
+        ELEMENT_TYPE *source;                                                                                                                       \
+        ELEMENT_TYPE *destination;                                                                                                                  \
+        unsigned long long length;                                                                                                                  \
+        /* Part i of the array, as sorted by thread i, is [bounds[ i ], bounds[ i + 1 ]). */                                                        \
+        unsigned long long bounds[ ORDERED_ARRAY__PARALLEL_SORT_MAXIMUM_THREAD_COUNT + 1 ];                                                         \
+        unsigned int thread_count;                                                                                                                  \
+        /* The number of parts in each of the runs merged by the current step, or 0 while the parts are sorted. */                                  \
+        unsigned int run_part_count;                                                                                                                \
+    } TYPENAME ## __ParallelSort;                                                                                                                   \
+                                                                                                                                                    \
+    typedef struct TYPENAME ## __ParallelSortWorker{                                                                                                \
+        TYPENAME ## __ParallelSort const *sort;                                                                                                     \
+        unsigned int index;                                                                                                                         \
+    } TYPENAME ## __ParallelSortWorker;                                                                                                             \
+                                                                                                                                                    \
+    /**                                                                                                                                             \
+     *  \brief Merges two sorted runs into destination, taking from first on ties, so that the merge is stable.                                     \
+     */                                                                                                                                             \
+    static void TYPENAME_LOWERCASE ## __sort__merge_into(                                                                                           \
+        ELEMENT_TYPE const *first,                                                                                                                  \
+        unsigned long long first_length,                                                                                                            \
+        ELEMENT_TYPE const *second,                                                                                                                 \
+        unsigned long long second_length,                                                                                                           \
+        ELEMENT_TYPE *destination                                                                                                                   \
+    ){                                                                                                                                              \
+        unsigned long long first_index = 0;                                                                                                         \
+        unsigned long long second_index = 0;                                                                                                        \
+        while( first_index < first_length && second_index < second_length ){                                                                        \
+            if( ELEMENT_TYPE__LESS_FUNCTION( second[ second_index ], first[ first_index ] ) ){                                                      \
+                *destination++ = second[ second_index++ ];                                                                                          \
+            }                                                                                                                                       \
+            else{                                                                                                                                   \
+                *destination++ = first[ first_index++ ];                                                                                            \
+            }                                                                                                                                       \
+        }                                                                                                                                           \
+        memcpy( destination, first + first_index, ( first_length - first_index ) * sizeof( ELEMENT_TYPE ) );                                        \
+        destination += first_length - first_index;                                                                                                  \
+        memcpy( destination, second + second_index, ( second_length - second_index ) * sizeof( ELEMENT_TYPE ) );                                    \
+    }                                                                                                                                               \
+                                                                                                                                                    \
+    /**                                                                                                                                             \
+     *  \brief Finds how many of the first output_index elements of the stable merge of two sorted runs come from                                   \
+     *  the first run, by binary search.                                                                                                            \
+     */                                                                                                                                             \
+    static unsigned long long TYPENAME_LOWERCASE ## __sort__merge_split(                                                                            \
+        ELEMENT_TYPE const *first,                                                                                                                  \
+        unsigned long long first_length,                                                                                                            \
+        ELEMENT_TYPE const *second,                                                                                                                 \
+        unsigned long long second_length,                                                                                                           \
+        unsigned long long output_index                                                                                                             \
+    ){                                                                                                                                              \
+        unsigned long long low = output_index > second_length ? output_index - second_length : 0;                                                   \
+        unsigned long long high = output_index < first_length ? output_index : first_length;                                                        \
+        while( low < high ){                                                                                                                        \
+            unsigned long long middle = low + ( high - low ) / 2;                                                                                   \
+            /* An element of first which is no greater than an element of second is merged before it. */                                            \
+            if( !ELEMENT_TYPE__LESS_FUNCTION( second[ output_index - middle - 1 ], first[ middle ] ) ){                                             \
+                low = middle + 1;                                                                                                                   \
+            }                                                                                                                                       \
+            else{                                                                                                                                   \
+                high = middle;                                                                                                                      \
+            }                                                                                                                                       \
+        }                                                                                                                                           \
+                                                                                                                                                    \
+        return low;                                                                                                                                 \
+    }                                                                                                                                               \
+                                                                                                                                                    \
+    /**                                                                                                                                             \
+     *  \brief Performs one thread's share of the current step of a parallel sort.                                                                  \
+     */                                                                                                                                             \
+    static void *TYPENAME_LOWERCASE ## __sort__parallel__run( void *worker_pointer ){                                                               \
+        /* Cast for C++ compatibility */                                                                                                            \
+        TYPENAME ## __ParallelSortWorker const *worker = (TYPENAME ## __ParallelSortWorker const*) worker_pointer;                                  \
+        TYPENAME ## __ParallelSort const *sort = worker->sort;                                                                                      \
+        unsigned int index = worker->index;                                                                                                         \
+                                                                                                                                                    \
+        if( sort->run_part_count == 0 ){                                                                                                            \
+            unsigned long long begin = sort->bounds[ index ];                                                                                       \
+            TYPENAME_LOWERCASE ## __sort__merge( sort->data + begin, sort->buffer + begin, sort->bounds[ index + 1 ] - begin );                     \
+            return NULL;                                                                                                                            \
+        }                                                                                                                                           \
+                                                                                                                                                    \
+        /* Each thread writes an equal share of the output, whichever runs it falls in. */                                                          \
+        unsigned long long output_begin = sort->bounds[ index ];                                                                                    \
+        unsigned long long output_end = sort->bounds[ index + 1 ];                                                                                  \
+        unsigned int run_part_count = sort->run_part_count;                                                                                         \
+        for( unsigned int part = 0; part < sort->thread_count; part += 2 * run_part_count ){                                                        \
+            unsigned int middle_part = part + run_part_count < sort->thread_count ? part + run_part_count : sort->thread_count;                     \
+            unsigned int end_part = middle_part + run_part_count < sort->thread_count ? middle_part + run_part_count : sort->thread_count;          \
+            unsigned long long begin = sort->bounds[ part ];                                                                                        \
+            unsigned long long middle = sort->bounds[ middle_part ];                                                                                \
+            unsigned long long end = sort->bounds[ end_part ];                                                                                      \
+            if( end <= output_begin || begin >= output_end ){                                                                                       \
+                continue;                                                                                                                           \
+            }                                                                                                                                       \
+                                                                                                                                                    \
+            ELEMENT_TYPE const *first = sort->source + begin;                                                                                       \
+            ELEMENT_TYPE const *second = sort->source + middle;                                                                                     \
+            unsigned long long first_length = middle - begin;                                                                                       \
+            unsigned long long second_length = end - middle;                                                                                        \
+            unsigned long long share_begin = ( output_begin > begin ? output_begin : begin ) - begin;                                               \
+            unsigned long long share_end = ( output_end < end ? output_end : end ) - begin;                                                         \
+            unsigned long long first_begin = TYPENAME_LOWERCASE ## __sort__merge_split( first, first_length, second, second_length, share_begin );  \
+            unsigned long long first_end = TYPENAME_LOWERCASE ## __sort__merge_split( first, first_length, second, second_length, share_end );      \
+                                                                                                                                                    \
+            TYPENAME_LOWERCASE ## __sort__merge_into(                                                                                               \
+                first + first_begin,                                                                                                                \
+                first_end - first_begin,                                                                                                            \
+                second + ( share_begin - first_begin ),                                                                                             \
+                ( share_end - first_end ) - ( share_begin - first_begin ),                                                                          \
+                sort->destination + begin + share_begin                                                                                             \
+            );                                                                                                                                      \
+        }                                                                                                                                           \
+                                                                                                                                                    \
+        return NULL;                                                                                                                                \
+    }                                                                                                                                               \
+                                                                                                                                                    \
+    /**                                                                                                                                             \
+     *  \brief Runs the current step of a parallel sort on every thread, and waits for them all to finish it.                                       \
+     */                                                                                                                                             \
+    static void TYPENAME_LOWERCASE ## __sort__parallel__step( TYPENAME ## __ParallelSort const *sort ){                                             \
+        pthread_t threads[ ORDERED_ARRAY__PARALLEL_SORT_MAXIMUM_THREAD_COUNT ];                                                                     \
+        bool started[ ORDERED_ARRAY__PARALLEL_SORT_MAXIMUM_THREAD_COUNT ];                                                                          \
+        TYPENAME ## __ParallelSortWorker workers[ ORDERED_ARRAY__PARALLEL_SORT_MAXIMUM_THREAD_COUNT ];                                              \
+                                                                                                                                                    \
+        for( unsigned int index = 0; index < sort->thread_count; index++ ){                                                                         \
+            workers[ index ].sort = sort;                                                                                                           \
+            workers[ index ].index = index;                                                                                                         \
+            started[ index ] = false;                                                                                                               \
+            if( index > 0 ){                                                                                                                        \
+                started[ index ] = pthread_create( &threads[ index ], NULL, TYPENAME_LOWERCASE ## __sort__parallel__run, &workers[ index ] ) == 0;  \
+            }                                                                                                                                       \
+        }                                                                                                                                           \
+                                                                                                                                                    \
+        for( unsigned int index = 0; index < sort->thread_count; index++ ){                                                                         \
+            if( !started[ index ] ){                                                                                                                \
+                TYPENAME_LOWERCASE ## __sort__parallel__run( &workers[ index ] );                                                                   \
+            }                                                                                                                                       \
+        }                                                                                                                                           \
+                                                                                                                                                    \
+        for( unsigned int index = 0; index < sort->thread_count; index++ ){                                                                         \
+            if( started[ index ] ){                                                                                                                 \
+                pthread_join( threads[ index ], NULL );                                                                                             \
+            }                                                                                                                                       \
+        }                                                                                                                                           \
+    }                                                                                                                                               \
+                                                                                                                                                    \
+    bool TYPENAME_LOWERCASE ## __sort__parallel(                                                                                                    \
+        TYPENAME *TYPENAME_LOWERCASE,                                                                                                               \
+        Allocator *allocator,                                                                                                                       \
+        unsigned int thread_count                                                                                                                   \
+    ){                                                                                                                                              \
+        RETURN_VALUE_IF_FAIL( TYPENAME_LOWERCASE != NULL, false );                                                                                  \
+        unsigned long long length = TYPENAME_LOWERCASE->length;                                                                                     \
+                                                                                                                                                    \
+        if( thread_count > ORDERED_ARRAY__PARALLEL_SORT_MAXIMUM_THREAD_COUNT ){                                                                     \
+            thread_count = ORDERED_ARRAY__PARALLEL_SORT_MAXIMUM_THREAD_COUNT;                                                                       \
+        }                                                                                                                                           \
+        if( thread_count > length / ORDERED_ARRAY__PARALLEL_SORT_MINIMUM_LENGTH ){                                                                  \
+            thread_count = (unsigned int)( length / ORDERED_ARRAY__PARALLEL_SORT_MINIMUM_LENGTH );                                                  \
+        }                                                                                                                                           \
+        if( thread_count < 2 ){                                                                                                                     \
+            return TYPENAME_LOWERCASE ## __sort__stable( TYPENAME_LOWERCASE, allocator );                                                           \
+        }                                                                                                                                           \
+                                                                                                                                                    \
+        /* Cast for C++ compatibility */                                                                                                            \
+        ELEMENT_TYPE *buffer = (ELEMENT_TYPE*) allocator__alloc( allocator, length * sizeof( ELEMENT_TYPE ) );                                      \
+        RETURN_VALUE_IF_FAIL( buffer != NULL, false );                                                                                              \
+                                                                                                                                                    \
+        TYPENAME ## __ParallelSort sort;                                                                                                            \
+        sort.data = TYPENAME_LOWERCASE->data;                                                                                                       \
+        sort.buffer = buffer;                                                                                                                       \
+        sort.source = TYPENAME_LOWERCASE->data;                                                                                                     \
+        sort.destination = buffer;                                                                                                                  \
+        sort.length = length;                                                                                                                       \
+        sort.thread_count = thread_count;                                                                                                           \
+        sort.run_part_count = 0;                                                                                                                    \
+        for( unsigned int index = 0; index <= thread_count; index++ ){                                                                              \
+            sort.bounds[ index ] = length * index / thread_count;                                                                                   \
+        }                                                                                                                                           \
+                                                                                                                                                    \
+        /* Each part is sorted in place, using its own slice of the buffer. */                                                                      \
+        TYPENAME_LOWERCASE ## __sort__parallel__step( &sort );                                                                                      \
+                                                                                                                                                    \
+        /* Each round merges pairs of runs from one of the array and the buffer into the other. */                                                  \
+        for( sort.run_part_count = 1; sort.run_part_count < thread_count; sort.run_part_count *= 2 ){                                               \
+            TYPENAME_LOWERCASE ## __sort__parallel__step( &sort );                                                                                  \
+            ELEMENT_TYPE *merged = sort.destination;                                                                                                \
+            sort.destination = sort.source;                                                                                                         \
+            sort.source = merged;                                                                                                                   \
+        }                                                                                                                                           \
+                                                                                                                                                    \
+        /* Merging the single, sorted run copies it back from the buffer, evenly among the threads. */                                              \
+        if( sort.source != sort.data ){                                                                                                             \
+            TYPENAME_LOWERCASE ## __sort__parallel__step( &sort );                                                                                  \
+        }                                                                                                                                           \
+                                                                                                                                                    \
+        allocator__free( allocator, buffer );                                                                                                       \
+        return true;                                                                                                                                \
+    }
+
+/**
+ *  \def ORDERED_ARRAY__DECLARE_EYTZINGER( TYPENAME, TYPENAME_LOWERCASE, ELEMENT_TYPE )
+ *  \brief Declares a lookup table in Eytzinger layout for an Array type. This macro should be paired with a call to
+ *  the macro
+ *      ORDERED_ARRAY__DEFINE_EYTZINGER( TYPENAME, TYPENAME_LOWERCASE, ELEMENT_TYPE, ELEMENT_TYPE__LESS_FUNCTION ).
+ */
+#define ORDERED_ARRAY__DECLARE_EYTZINGER( TYPENAME, TYPENAME_LOWERCASE, ELEMENT_TYPE )                                                              \
+    /**                                                                                                                                             \
+     *  \brief A copy of a sorted array, laid out for searching. The elements are stored in the breadth first order                                 \
+     *  of a balanced binary search tree, from index 1, so that the children of the element at index k are at 2k and                                \
+     *  2k + 1. A search reads its first few steps from a handful of cache lines which stay cached, and each step                                   \
+     *  below can prefetch the cache line holding the elements several steps further down, which a binary search                                    \
+     *  over the sorted array cannot, since its next steps are scattered across the whole array.                                                    \
+     */                                                                                                                                             \
+    typedef struct TYPENAME ## __Eytzinger{                                                                                                         \
+        /**                                                                                                                                         \
+         *  The elements, from index 1, aligned to ORDERED_ARRAY__CACHE_LINE_SIZE. Index 0 is unused.                                               \
+         */                                                                                                                                         \
+        ELEMENT_TYPE *data;                                                                                                                         \
+        /**                                                                                                                                         \
+         *  The number of elements.                                                                                                                 \
+         */                                                                                                                                         \
+        unsigned long long length;                                                                                                                  \
+    } TYPENAME ## __Eytzinger;                                                                                                                      \
+                                                                                                                                                    \
+    /**                                                                                                                                             \
+     *  \brief Initializes an Eytzinger table with a copy of the elements of a sorted array.                                                        \
+     *  \param eytzinger A pointer to the table to be initialized.                                                                                  \
+     *  \param array A pointer to the array, which must be sorted in ascending order.                                                               \
+     *  \param allocator The allocator used to allocate the elements of the table.                                                                  \
+     *  \returns Returns true if the table was initialized, and false if its elements could not be allocated.                                       \
+     */                                                                                                                                             \
+    bool TYPENAME_LOWERCASE ## __eytzinger ## __initialize(                                                                                         \
+        TYPENAME ## __Eytzinger *eytzinger,                                                                                                         \
+        TYPENAME const *TYPENAME_LOWERCASE,                                                                                                         \
+        Allocator *allocator                                                                                                                        \
+    );                                                                                                                                              \
+                                                                                                                                                    \
+    void TYPENAME_LOWERCASE ## __eytzinger ## __clear(                                                                                              \
+        TYPENAME ## __Eytzinger *eytzinger,                                                                                                         \
+        Allocator *allocator                                                                                                                        \
+    );                                                                                                                                              \
+                                                                                                                                                    \
+    /**                                                                                                                                             \
+     *  \brief Finds the first element of an Eytzinger table which is not ordered before the given element, with a                                  \
+     *  search which has no unpredictable branches and prefetches the elements it will read.                                                        \
+     *  \param eytzinger A pointer to the table to be searched.                                                                                     \
+     *  \param element The element to be searched for.                                                                                              \
+     *  \param out__index An out parameter. Upon return, this will store the index within eytzinger->data of the                                    \
+     *  first element not less than \p element, or 0 if every element is less.                                                                      \
+     *  \returns Returns true if there is an element not less than \p element, and false otherwise.                                                 \
+     */                                                                                                                                             \
+    bool TYPENAME_LOWERCASE ## __eytzinger ## __lower_bound(                                                                                        \
+        TYPENAME ## __Eytzinger const *eytzinger,                                                                                                   \
+        ELEMENT_TYPE element,                                                                                                                       \
+        unsigned long long *out__index                                                                                                              \
+    );                                                                                                                                              \
+                                                                                                                                                    \
+    /**                                                                                                                                             \
+     *  \brief Counts the elements of an Eytzinger table which are ordered before the given element. This is the                                    \
+     *  index which array__lower_bound would return for the sorted array.                                                                           \
+     *  \param eytzinger A pointer to the table to be searched.                                                                                     \
+     *  \param element The element to be searched for.                                                                                              \
+     *  \returns Returns the number of elements less than \p element.                                                                               \
+     */                                                                                                                                             \
+    unsigned long long TYPENAME_LOWERCASE ## __eytzinger ## __rank(                                                                                 \
+        TYPENAME ## __Eytzinger const *eytzinger,                                                                                                   \
+        ELEMENT_TYPE element                                                                                                                        \
+    );
+
+/**
+ *  \def ORDERED_ARRAY__DEFINE_EYTZINGER( TYPENAME, TYPENAME_LOWERCASE, ELEMENT_TYPE, ELEMENT_TYPE__LESS_FUNCTION )
+ *  \brief Defines a lookup table in Eytzinger layout for an Array type. This macro must be paired with a call to the
+ *  macro ORDERED_ARRAY__DECLARE_EYTZINGER( TYPENAME, TYPENAME_LOWERCASE, ELEMENT_TYPE ).
+ *  \param ELEMENT_TYPE__LESS_FUNCTION A function which returns true if its first parameter is ordered before its
+ *  second, as for ORDERED_ARRAY__DEFINE. This must be the ordering by which the array is sorted.
+ */
+#define ORDERED_ARRAY__DEFINE_EYTZINGER( TYPENAME, TYPENAME_LOWERCASE, ELEMENT_TYPE, ELEMENT_TYPE__LESS_FUNCTION )                                  \
+    /**                                                                                                                                             \
+     *  \brief Computes the index within the sorted elements of the element at the given index of an Eytzinger table.                               \
+     *  The tree is treated as a perfect tree of the same height, in which the index in order of the node at position                               \
+     *  p of level d is ( 2p + 1 ) * 2^( height - 1 - d ) - 1, less the missing nodes of the last level which precede                               \
+     *  it. The nodes of the last level are at the even indices in order.                                                                           \
+     */                                                                                                                                             \
+    static inline unsigned long long TYPENAME_LOWERCASE ## __eytzinger__sorted_index( unsigned long long length, unsigned long long index ){        \
+        unsigned int height = 64 - (unsigned int) __builtin_clzll( length );                                                                        \
+        unsigned int depth = 63 - (unsigned int) __builtin_clzll( index );                                                                          \
+        unsigned long long last_level_length = length - ( ( 1ULL << ( height - 1 ) ) - 1 );                                                         \
+                                                                                                                                                    \
+        unsigned long long position = index - ( 1ULL << depth );                                                                                    \
+        unsigned long long perfect_index = ( ( 2 * position + 1 ) << ( height - 1 - depth ) ) - 1;                                                  \
+        unsigned long long preceding_last_level_length = ( perfect_index + 1 ) / 2;                                                                 \
+        if( preceding_last_level_length > last_level_length ){                                                                                      \
+            perfect_index -= preceding_last_level_length - last_level_length;                                                                       \
+        }                                                                                                                                           \
+                                                                                                                                                    \
+        return perfect_index;                                                                                                                       \
+    }                                                                                                                                               \
+                                                                                                                                                    \
+    bool TYPENAME_LOWERCASE ## __eytzinger ## __initialize(                                                                                         \
+        TYPENAME ## __Eytzinger *eytzinger,                                                                                                         \
+        TYPENAME const *TYPENAME_LOWERCASE,                                                                                                         \
+        Allocator *allocator                                                                                                                        \
+    ){                                                                                                                                              \
+        RETURN_VALUE_IF_FAIL( eytzinger != NULL && TYPENAME_LOWERCASE != NULL, false );                                                             \
+                                                                                                                                                    \
+        unsigned long long length = TYPENAME_LOWERCASE->length;                                                                                     \
+        /* Cast for C++ compatibility */                                                                                                            \
+        ELEMENT_TYPE *data = (ELEMENT_TYPE*) allocator__alloc_aligned(                                                                              \
+            allocator,                                                                                                                              \
+            ( length + 1 ) * sizeof( ELEMENT_TYPE ),                                                                                                \
+            ORDERED_ARRAY__CACHE_LINE_SIZE                                                                                                          \
+        );                                                                                                                                          \
+        RETURN_VALUE_IF_FAIL( data != NULL, false );                                                                                                \
+                                                                                                                                                    \
+        memset( data, 0, sizeof( ELEMENT_TYPE ) );                                                                                                  \
+        for( unsigned long long index = 1; index <= length; index++ ){                                                                              \
+            data[ index ] = TYPENAME_LOWERCASE->data[ TYPENAME_LOWERCASE ## __eytzinger__sorted_index( length, index ) ];                           \
+        }                                                                                                                                           \
+                                                                                                                                                    \
+        eytzinger->data = data;                                                                                                                     \
+        eytzinger->length = length;                                                                                                                 \
+        return true;                                                                                                                                \
+    }                                                                                                                                               \
+                                                                                                                                                    \
+    void TYPENAME_LOWERCASE ## __eytzinger ## __clear(                                                                                              \
+        TYPENAME ## __Eytzinger *eytzinger,                                                                                                         \
+        Allocator *allocator                                                                                                                        \
+    ){                                                                                                                                              \
+        RETURN_IF_FAIL( eytzinger != NULL );                                                                                                        \
+                                                                                                                                                    \
+        allocator__free_aligned( allocator, eytzinger->data );                                                                                      \
+        eytzinger->data = NULL;                                                                                                                     \
+        eytzinger->length = 0;                                                                                                                      \
+    }                                                                                                                                               \
+                                                                                                                                                    \
+    bool TYPENAME_LOWERCASE ## __eytzinger ## __lower_bound(                                                                                        \
+        TYPENAME ## __Eytzinger const *eytzinger,                                                                                                   \
+        ELEMENT_TYPE element,                                                                                                                       \
+        unsigned long long *out__index                                                                                                              \
+    ){                                                                                                                                              \
+        RETURN_VALUE_IF_FAIL( eytzinger != NULL, false );                                                                                           \
+                                                                                                                                                    \
+        /* The descendants of index k, a few levels down, fill the cache line starting at k * prefetch_stride. */                                   \
+        unsigned long long prefetch_stride = 1;                                                                                                     \
+        while( 2 * prefetch_stride * sizeof( ELEMENT_TYPE ) <= ORDERED_ARRAY__CACHE_LINE_SIZE ){                                                    \
+            prefetch_stride *= 2;                                                                                                                   \
+        }                                                                                                                                           \
+                                                                                                                                                    \
+        ELEMENT_TYPE const *data = eytzinger->data;                                                                                                 \
+        unsigned long long index = 1;                                                                                                               \
+        while( index <= eytzinger->length ){                                                                                                        \
+            __builtin_prefetch( data + index * prefetch_stride );                                                                                   \
+            index = 2 * index + ( ELEMENT_TYPE__LESS_FUNCTION( data[ index ], element ) ? 1 : 0 );                                                  \
+        }                                                                                                                                           \
+                                                                                                                                                    \
+        /* The lower bound is where the search last went left, before the right turns which followed it. */                                         \
+        index >>= __builtin_ffsll( (long long) ~index );                                                                                            \
+                                                                                                                                                    \
+        *out__index = index;                                                                                                                        \
+        return index != 0;                                                                                                                          \
+    }                                                                                                                                               \
+                                                                                                                                                    \
+    unsigned long long TYPENAME_LOWERCASE ## __eytzinger ## __rank(                                                                                 \
+        TYPENAME ## __Eytzinger const *eytzinger,                                                                                                   \
+        ELEMENT_TYPE element                                                                                                                        \
+    ){                                                                                                                                              \
+        unsigned long long index;                                                                                                                   \
+        if( !TYPENAME_LOWERCASE ## __eytzinger ## __lower_bound( eytzinger, element, &index ) ){                                                    \
+            return eytzinger != NULL ? eytzinger->length : 0;                                                                                       \
+        }                                                                                                                                           \
+                                                                                                                                                    \
+        return TYPENAME_LOWERCASE ## __eytzinger__sorted_index( eytzinger->length, index );                                                         \
+    }
+
+/**
+ *  @} group ordered_array
+ */
+
+#endif // KIRKE__ORDERED_ARRAY__H
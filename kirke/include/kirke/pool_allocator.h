@@ -0,0 +1,136 @@
+/**
+ *  \file kirke/pool_allocator.h
+ */
+
+#ifndef KIRKE__POOL_ALLOCATOR__H
+#define KIRKE__POOL_ALLOCATOR__H
+
+// System Includes
+#include <stdbool.h>
+
+// Internal Includes
+#include "kirke/macros.h"
+#include "kirke/allocator.h"
+
+BEGIN_DECLARATIONS
+
+/**
+ *  \defgroup pool_allocator PoolAllocator
+ *  @{
+ */
+
+/**
+ *  \def POOL_ALLOCATOR__DEFAULT_SLAB_SIZE
+ *  \brief The slab size used when zero is passed to pool_allocator__initialize. This matches the size of
+ *  a huge page on x86-64. Slabs are plain allocations from the backing allocator, so they are only backed by huge
+ *  pages if it provides them, as a SystemAllocator does when its \ref SystemAllocator__Options::huge_page_threshold
+ *  is at most this size.
+ */
+#define POOL_ALLOCATOR__DEFAULT_SLAB_SIZE ( 2ULL * 1024ULL * 1024ULL )
+
+/**
+ *  \brief An allocator which serves objects of a single, fixed size from large slabs.
+ *  Objects are packed contiguously within each slab, and freed objects are kept on a free list, to be
+ *  recycled by subsequent allocations. This makes PoolAllocator well suited as the allocator for list
+ *  links and hash map entries, which are all the same size.
+ *  Requests larger than the object size - such as the bucket array of a hash map - are forwarded to the
+ *  backing allocator, so a PoolAllocator can be used anywhere an Allocator* is accepted.
+ *  Slabs are only returned to the backing allocator by pool_allocator__trim, once every object in them has been
+ *  freed, and by pool_allocator__deinitialize.
+ *  Objects freed with allocator__free_sized are recycled without searching the slabs for their owner.
+ *  \note Objects are aligned to the largest power of 2 which divides the object size, up to the alignment
+ *  of the slabs returned by the backing allocator.
+ */
+typedef struct PoolAllocator{
+    /**
+     *  The initialized allocator, which can be passed to any method requiring an allocator parameter.
+     */
+    Allocator *allocator;
+    /**
+     *  The allocator from which slabs, and requests larger than \ref object_size, are allocated. This is
+     *  borrowed rather than owned.
+     */
+    Allocator *backing_allocator;
+    /**
+     *  The size in bytes of each object served from a slab. This is the size passed to
+     *  pool_allocator__initialize, rounded up to a multiple of the size of a pointer.
+     */
+    unsigned long long object_size;
+    /**
+     *  The size in bytes of each slab.
+     */
+    unsigned long long slab_size;
+    /**
+     *  A singly-linked list of freed objects, which will be reused before carving new objects from a slab.
+     */
+    void *free_list;
+    /**
+     *  The next object in the most recent slab which has never been allocated.
+     */
+    char *slab_cursor;
+    /**
+     *  The end of the most recent slab.
+     */
+    char *slab_end;
+    /**
+     *  The start addresses of every slab, sorted in ascending order, which are used to determine whether a
+     *  pointer was served from a slab or from the backing allocator.
+     */
+    char **slabs;
+    /**
+     *  The number of slabs stored in \ref slabs.
+     */
+    unsigned long long slab_count;
+    /**
+     *  The capacity of \ref slabs, in elements.
+     */
+    unsigned long long slab_capacity;
+} PoolAllocator;
+
+/**
+ *  \brief Initializes a PoolAllocator structure.
+ *  \param pool_allocator A pointer to the PoolAllocator to be initialized.
+ *  \param backing_allocator The allocator which will be used to allocate slabs.
+ *  \param object_size The size in bytes of the objects which will be served by the pool. This is typically
+ *  the size of a list link, for example sizeof( List__String ).
+ *  \param slab_size The size in bytes of each slab. If 0, then \ref POOL_ALLOCATOR__DEFAULT_SLAB_SIZE is used.
+ */
+void pool_allocator__initialize(
+    PoolAllocator *pool_allocator,
+    Allocator *backing_allocator,
+    unsigned long long object_size,
+    unsigned long long slab_size
+);
+
+/**
+ *  \brief De-initializes a PoolAllocator structure, returning all of its slabs to the backing allocator.
+ *  \param pool_allocator A pointer to the PoolAllocator to be de-initialized.
+ *  \note Any objects allocated from \p pool_allocator are invalid after this call. Requests which were forwarded
+ *  to the backing allocator are not freed.
+ */
+void pool_allocator__deinitialize( PoolAllocator *pool_allocator );
+
+/**
+ *  \brief Determines whether a pointer refers to an object served from one of a PoolAllocator's slabs.
+ *  \param pool_allocator A pointer to the PoolAllocator.
+ *  \param pointer The pointer to be tested.
+ *  \returns Returns true if \p pointer lies within one of the pool's slabs.
+ *  \returns Returns false otherwise.
+ */
+bool pool_allocator__owns( PoolAllocator const *pool_allocator, void const *pointer );
+
+/**
+ *  \brief Returns every slab in which no object is allocated to the backing allocator. This takes time linear in
+ *  the number of free objects, and is also called by allocator__trim on \ref PoolAllocator::allocator.
+ *  \param pool_allocator A pointer to the PoolAllocator.
+ *  \returns Returns true if any slab was released, and false otherwise.
+ */
+bool pool_allocator__trim( PoolAllocator *pool_allocator );
+
+/**
+ *  @} group pool_allocator
+ */
+
+END_DECLARATIONS
+
+#endif // KIRKE__POOL_ALLOCATOR__H
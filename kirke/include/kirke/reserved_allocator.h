@@ -0,0 +1,96 @@
+/**
+ *  \file kirke/reserved_allocator.h
+ */
+
+#ifndef KIRKE__RESERVED_ALLOCATOR__H
+#define KIRKE__RESERVED_ALLOCATOR__H
+
+// Internal Includes
+#include "kirke/macros.h"
+#include "kirke/allocator.h"
+
+BEGIN_DECLARATIONS
+
+/**
+ *  \defgroup reserved_allocator ReservedAllocator
+ *  @{
+ */
+
+/**
+ *  \def RESERVED_ALLOCATOR__COMMIT_GRANULARITY
+ *  \brief The number of bytes by which a ReservedAllocator commits memory at a time, so that steady growth does not
+ *  make a system call for every page.
+ */
+#define RESERVED_ALLOCATOR__COMMIT_GRANULARITY ( 64ULL * 1024ULL )
+
+/**
+ *  \brief An allocator which reserves a large range of virtual addresses up front, and serves allocations by
+ *  bumping a pointer through it. Pages are only committed, and so only consume memory, once allocations reach them.
+ *  The most recent allocation can always be grown in place, up to the end of the reservation. Since AutoArray
+ *  grows its data in place whenever its allocator allows, an AutoArray whose data is the most recent allocation of a
+ *  ReservedAllocator never moves or copies its elements, so pointers to them stay valid for its whole lifetime.
+ *  It is simplest to give each such AutoArray a ReservedAllocator of its own.
+ *  Freeing the most recent allocation releases its bytes for reuse. Freeing any other allocation is a no-op.
+ *  Memory is returned to the operating system by reserved_allocator__decommit and reserved_allocator__deinitialize.
+ */
+typedef struct ReservedAllocator{
+    /**
+     *  The initialized allocator, which can be passed to any method requiring an allocator parameter. This is NULL
+     *  if the address range could not be reserved.
+     */
+    Allocator *allocator;
+    /**
+     *  The start of the reserved address range.
+     */
+    char *base;
+    /**
+     *  The size in bytes of the reserved address range, which is a multiple of the page size.
+     */
+    unsigned long long reserved_size;
+    /**
+     *  The number of bytes at the start of the range which are committed, and may be read or written.
+     */
+    unsigned long long committed_size;
+    /**
+     *  The number of bytes at the start of the range which are in use.
+     */
+    unsigned long long position;
+    /**
+     *  The most recent allocation, which may be resized in place. NULL if there is no such allocation.
+     */
+    void *last_allocation;
+} ReservedAllocator;
+
+/**
+ *  \brief Initializes a ReservedAllocator structure, reserving an address range without committing memory to it.
+ *  \param reserved_allocator A pointer to the ReservedAllocator to be initialized.
+ *  \param reserved_size The size in bytes of the address range to reserve, which bounds the total size of all
+ *  allocations. Reserving address space is cheap, so this can be far larger than the memory actually used, for
+ *  example many gigabytes on a 64-bit system.
+ *  \note If the range cannot be reserved, then \ref ReservedAllocator::allocator is set to NULL.
+ */
+void reserved_allocator__initialize( ReservedAllocator *reserved_allocator, unsigned long long reserved_size );
+
+/**
+ *  \brief De-initializes a ReservedAllocator structure, returning its whole address range to the operating system.
+ *  \param reserved_allocator A pointer to the ReservedAllocator to be de-initialized.
+ *  \note Any memory allocated from \p reserved_allocator is invalid after this call.
+ */
+void reserved_allocator__deinitialize( ReservedAllocator *reserved_allocator );
+
+/**
+ *  \brief Returns the committed pages which lie beyond the memory in use to the operating system, for example after
+ *  an AutoArray allocated from \p reserved_allocator has been shrunk. The pages are committed again if allocations
+ *  reach them later. Memory which is in use is unaffected. This is also called by allocator__trim on
+ *  \ref ReservedAllocator::allocator.
+ *  \param reserved_allocator A pointer to the ReservedAllocator.
+ */
+void reserved_allocator__decommit( ReservedAllocator *reserved_allocator );
+
+/**
+ *  @} group reserved_allocator
+ */
+
+END_DECLARATIONS
+
+#endif // KIRKE__RESERVED_ALLOCATOR__H
@@ -0,0 +1,131 @@
+/**
+ *  \file kirke/sampling_allocator.h
+ */
+
+#ifndef KIRKE__SAMPLING_ALLOCATOR__H
+#define KIRKE__SAMPLING_ALLOCATOR__H
+
+// System Includes
+#include <stdbool.h>
+
+// Internal Includes
+#include "kirke/macros.h"
+#include "kirke/allocator.h"
+#include "kirke/string.h"
+
+BEGIN_DECLARATIONS
+
+/** Forward declaration of Error, defined in \ref kirke/error.h */
+typedef struct Error Error;
+
+/**
+ *  \defgroup sampling_allocator SamplingAllocator
+ *  @{
+ */
+
+/**
+ *  \def SAMPLING_ALLOCATOR__DEFAULT_SAMPLE_INTERVAL
+ *  \brief The default mean number of bytes allocated between two samples.
+ */
+#define SAMPLING_ALLOCATOR__DEFAULT_SAMPLE_INTERVAL ( 512ULL * 1024ULL )
+
+/**
+ *  \def SAMPLING_ALLOCATOR__MAXIMUM_DEPTH
+ *  \brief The maximum number of stack frames recorded for each sample.
+ */
+#define SAMPLING_ALLOCATOR__MAXIMUM_DEPTH 64
+
+/**
+ *  \brief This enumerator defines possible Error types for SamplingAllocator functions.
+ */
+typedef enum SamplingAllocator__Error {
+    /** \brief Denotes that an error occurred because the profile file could not be opened for writing. */
+    SamplingAllocator__Error__UnableToOpenFile = 1
+} SamplingAllocator__Error;
+
+/**
+ *  \brief Opaque type holding the live samples of a SamplingAllocator. Defined in kirke/src/sampling_allocator.c.
+ */
+typedef struct SamplingAllocator__State SamplingAllocator__State;
+
+/**
+ *  \brief A heap profiler, in the form of an allocator which wraps another allocator.
+ *  Allocations are sampled at random, on average once every \ref sample_interval bytes, so that the chance of
+ *  sampling an allocation is proportional to its size. The call stack of each sampled allocation is recorded,
+ *  and kept until the allocation is freed. A profile of the call sites which retain memory can then be written
+ *  at any time, with each sample weighted by the number of bytes it stands for.
+ *  Unsampled allocations cost little more than a call to the backing allocator, so a SamplingAllocator can be
+ *  left in place in production.
+ *  \note Every allocation is preceded by a small header, which refers to its sample, if any.
+ */
+typedef struct SamplingAllocator{
+    /**
+     *  The initialized allocator, which can be passed to any method requiring an allocator parameter.
+     */
+    Allocator *allocator;
+    /**
+     *  The allocator which serves all requests. This is borrowed rather than owned. If the SamplingAllocator
+     *  is used by multiple threads, then this must be thread-safe.
+     */
+    Allocator *backing_allocator;
+    /**
+     *  The mean number of bytes allocated between two samples.
+     */
+    unsigned long long sample_interval;
+    /**
+     *  The live samples of this allocator.
+     */
+    SamplingAllocator__State *state;
+} SamplingAllocator;
+
+/**
+ *  \brief Initializes a SamplingAllocator structure.
+ *  \param sampling_allocator A pointer to the SamplingAllocator to be initialized.
+ *  \param backing_allocator The allocator which will serve all requests.
+ *  \param sample_interval The mean number of bytes allocated between two samples. If this is 0, then
+ *  \ref SAMPLING_ALLOCATOR__DEFAULT_SAMPLE_INTERVAL is used. An interval of 1 samples every allocation.
+ */
+void sampling_allocator__initialize( SamplingAllocator *sampling_allocator, Allocator *backing_allocator, unsigned long long sample_interval );
+
+/**
+ *  \brief De-initializes a SamplingAllocator structure.
+ *  \param sampling_allocator A pointer to the SamplingAllocator to be de-initialized.
+ *  \note Memory allocated through \p sampling_allocator is not freed, and must not be freed after this call.
+ */
+void sampling_allocator__deinitialize( SamplingAllocator *sampling_allocator );
+
+/**
+ *  \brief Estimates the number of bytes currently allocated, from the live samples.
+ *  \param sampling_allocator A pointer to the SamplingAllocator.
+ *  \returns The sum of the weights of all live samples.
+ */
+unsigned long long sampling_allocator__live_bytes( SamplingAllocator const *sampling_allocator );
+
+/**
+ *  \brief Appends a profile of the live samples to a String, in the collapsed-stack format read by flame graph
+ *  tools. Each line holds the frames of one sample, outermost first and separated by semicolons, followed by a
+ *  space and the estimated number of bytes the sample stands for. Frames are named after their symbol where one
+ *  is available, and as module+offset otherwise.
+ *  \param sampling_allocator A pointer to the SamplingAllocator.
+ *  \param string A pointer to an initialized String, to which the profile will be appended.
+ *  \param allocator The allocator used to allocate memory for \p string.
+ */
+void sampling_allocator__append_profile( SamplingAllocator const *sampling_allocator, String *string, Allocator *allocator );
+
+/**
+ *  \brief Writes a profile of the live samples to a file, in the format described by
+ *  sampling_allocator__append_profile.
+ *  \param sampling_allocator A pointer to the SamplingAllocator.
+ *  \param file_path A String containing the path of the file to be written.
+ *  \param error Optional. A pointer to an Error structure, which will be set if the file cannot be written.
+ *  \returns Returns true if the profile was written, and false otherwise.
+ */
+bool sampling_allocator__write_profile( SamplingAllocator const *sampling_allocator, String file_path, Error *error );
+
+/**
+ *  @} group sampling_allocator
+ */
+
+END_DECLARATIONS
+
+#endif // KIRKE__SAMPLING_ALLOCATOR__H
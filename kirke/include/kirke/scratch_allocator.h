@@ -0,0 +1,186 @@
+/**
+ *  \file kirke/scratch_allocator.h
+ */
+
+#ifndef KIRKE__SCRATCH_ALLOCATOR__H
+#define KIRKE__SCRATCH_ALLOCATOR__H
+
+// System Includes
+#include <stdbool.h>
+
+// Internal Includes
+#include "kirke/macros.h"
+#include "kirke/allocator.h"
+
+BEGIN_DECLARATIONS
+
+/**
+ *  \defgroup scratch_allocator ScratchAllocator
+ *  @{
+ */
+
+/**
+ *  \def SCRATCH_ALLOCATOR__DEFAULT_CHUNK_SIZE
+ *  \brief The default size in bytes of the chunks from which a ScratchAllocator serves allocations.
+ */
+#define SCRATCH_ALLOCATOR__DEFAULT_CHUNK_SIZE ( 64ULL * 1024ULL )
+
+/**
+ *  \brief Opaque type representing a single block of memory, from which a ScratchAllocator carves allocations.
+ *  Defined in kirke/src/scratch_allocator.c.
+ */
+typedef struct ScratchAllocator__Chunk ScratchAllocator__Chunk;
+
+/**
+ *  \brief A position within a ScratchAllocator, as returned by scratch_allocator__push. Passing a marker to
+ *  scratch_allocator__pop releases every allocation made after the marker was pushed.
+ */
+typedef struct ScratchAllocator__Marker{
+    /**
+     *  The chunk which was current when the marker was pushed.
+     */
+    ScratchAllocator__Chunk *chunk;
+    /**
+     *  The number of bytes which were in use within \ref chunk when the marker was pushed.
+     */
+    unsigned long long position;
+    /**
+     *  The most recent live allocation when the marker was pushed.
+     */
+    void *top;
+} ScratchAllocator__Marker;
+
+/**
+ *  \brief Options which may be passed to scratch_allocator__initialize__options.
+ */
+typedef struct ScratchAllocator__Options{
+    /**
+     *  The default size in bytes of each chunk. Allocations larger than this receive a chunk of their own. If this
+     *  is 0, then \ref SCRATCH_ALLOCATOR__DEFAULT_CHUNK_SIZE is used.
+     */
+    unsigned long long chunk_size;
+    /**
+     *  If true, then freeing any allocation other than the most recent live one is logged as an error, and counted
+     *  in \ref ScratchAllocator::out_of_order_free_count.
+     */
+    bool debug;
+} ScratchAllocator__Options;
+
+/**
+ *  \brief An allocator for short-lived temporaries, such as formatted strings which only live for one function
+ *  call. Allocations are served by bumping a pointer through chunks of memory allocated from a backing allocator,
+ *  and are expected to be freed in the reverse order in which they were made.
+ *  Freeing the most recent allocation releases its bytes for reuse, and reallocating it grows or shrinks it in
+ *  place whenever its chunk has room, so a String or AutoArray built on top of the stack grows without copying.
+ *  Freeing any other allocation only marks it as freed. Its bytes are released once every allocation above it has
+ *  been freed, or in bulk by scratch_allocator__pop.
+ *  Chunks are retained after popping, and reused by subsequent allocations. They are only returned to the backing
+ *  allocator by scratch_allocator__trim and scratch_allocator__deinitialize.
+ *  A ScratchAllocator must only be used by one thread at a time. scratch_allocator__thread_default returns one
+ *  which belongs to the calling thread.
+ */
+typedef struct ScratchAllocator{
+    /**
+     *  The initialized allocator, which can be passed to any method requiring an allocator parameter.
+     */
+    Allocator *allocator;
+    /**
+     *  The allocator from which chunks are allocated. This is borrowed rather than owned.
+     */
+    Allocator *backing_allocator;
+    /**
+     *  The default size, in bytes, of each chunk.
+     */
+    unsigned long long chunk_size;
+    /**
+     *  Whether out of order frees are reported. See \ref ScratchAllocator__Options::debug.
+     */
+    bool debug;
+    /**
+     *  The number of allocations which were freed out of order while \ref debug was set.
+     */
+    unsigned long long out_of_order_free_count;
+    /**
+     *  The first chunk in the allocator's list of chunks.
+     */
+    ScratchAllocator__Chunk *first_chunk;
+    /**
+     *  The chunk from which allocations are currently being served.
+     */
+    ScratchAllocator__Chunk *current_chunk;
+    /**
+     *  The most recent live allocation, which may be resized in place. NULL if there is no such allocation.
+     */
+    void *top;
+} ScratchAllocator;
+
+/**
+ *  \brief Initializes a ScratchAllocator structure with the default options.
+ *  \param scratch_allocator A pointer to the ScratchAllocator to be initialized.
+ *  \param backing_allocator The allocator which will be used to allocate chunks.
+ */
+void scratch_allocator__initialize( ScratchAllocator *scratch_allocator, Allocator *backing_allocator );
+
+/**
+ *  \brief Initializes a ScratchAllocator structure.
+ *  \param scratch_allocator A pointer to the ScratchAllocator to be initialized.
+ *  \param backing_allocator The allocator which will be used to allocate chunks.
+ *  \param options The options with which to initialize \p scratch_allocator. If this is NULL, the default options
+ *  are used.
+ */
+void scratch_allocator__initialize__options(
+    ScratchAllocator *scratch_allocator,
+    Allocator *backing_allocator,
+    ScratchAllocator__Options const *options
+);
+
+/**
+ *  \brief De-initializes a ScratchAllocator structure, returning all of its chunks to the backing allocator.
+ *  \param scratch_allocator A pointer to the ScratchAllocator to be de-initialized.
+ *  \note Any memory allocated from \p scratch_allocator is invalid after this call.
+ */
+void scratch_allocator__deinitialize( ScratchAllocator *scratch_allocator );
+
+/**
+ *  \brief Records the current position of a ScratchAllocator.
+ *  \param scratch_allocator A pointer to the ScratchAllocator.
+ *  \returns A marker which can later be passed to scratch_allocator__pop.
+ */
+ScratchAllocator__Marker scratch_allocator__push( ScratchAllocator const *scratch_allocator );
+
+/**
+ *  \brief Releases every allocation made from a ScratchAllocator since \p marker was pushed, whether or not it
+ *  was freed.
+ *  \param scratch_allocator A pointer to the ScratchAllocator.
+ *  \param marker A marker previously returned by scratch_allocator__push for the same ScratchAllocator, which has
+ *  not been invalidated by popping an earlier marker.
+ */
+void scratch_allocator__pop( ScratchAllocator *scratch_allocator, ScratchAllocator__Marker marker );
+
+/**
+ *  \brief Returns the chunks which lie beyond the one allocations are currently served from to the backing
+ *  allocator. This is also called by allocator__trim on \ref ScratchAllocator::allocator.
+ *  \param scratch_allocator A pointer to the ScratchAllocator.
+ *  \returns Returns true if any chunk was released, and false otherwise.
+ *  \note Markers which refer to a released chunk are invalidated. Such markers can only exist if allocations made
+ *  before them have since been freed.
+ */
+bool scratch_allocator__trim( ScratchAllocator *scratch_allocator );
+
+/**
+ *  \brief Retrieves the calling thread's own ScratchAllocator, creating it on first use. Its chunks are allocated
+ *  from a SystemAllocator, and it is de-initialized when the thread exits. It reports out of order frees unless
+ *  libkirke was built with NDEBUG defined.
+ *  \returns A pointer to the calling thread's ScratchAllocator, or NULL if it could not be created.
+ *  \note Code which uses the thread's ScratchAllocator should push a marker on entry and pop it on exit, so that
+ *  callers further up the stack are unaffected.
+ */
+ScratchAllocator *scratch_allocator__thread_default( void );
+
+/**
+ *  @} group scratch_allocator
+ */
+
+END_DECLARATIONS
+
+#endif // KIRKE__SCRATCH_ALLOCATOR__H
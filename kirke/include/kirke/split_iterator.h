@@ -11,6 +11,7 @@
 // Internal Includes
 #include "kirke/macros.h"
 #include "kirke/string.h"
+#include "kirke/string_searcher.h"
 
 BEGIN_DECLARATIONS
 
@@ -38,6 +39,11 @@ typedef struct SplitIterator{
      *  to the element following the last-found delimiter.
      */
     unsigned long long position;
+    /**
+     *  The searcher for the delimiter, which is analyzed once, by split_iterator__initialize, rather than on every
+     *  call to split_iterator__next.
+     */
+    StringSearcher searcher;
 } SplitIterator;
 
 /**
@@ -0,0 +1,150 @@
+/**
+ *  \file kirke/statistics_allocator.h
+ */
+
+#ifndef KIRKE__STATISTICS_ALLOCATOR__H
+#define KIRKE__STATISTICS_ALLOCATOR__H
+
+// Internal Includes
+#include "kirke/macros.h"
+#include "kirke/allocator.h"
+#include "kirke/string.h"
+
+BEGIN_DECLARATIONS
+
+/**
+ *  \defgroup statistics_allocator StatisticsAllocator
+ *  @{
+ */
+
+/**
+ *  \def STATISTICS_ALLOCATOR__HISTOGRAM_SIZE
+ *  \brief The number of buckets in the size histogram of a StatisticsAllocator__Snapshot. Bucket n counts
+ *  requests whose size s satisfies 2^n <= s < 2^( n + 1 ). Requests of size 0 are counted in bucket 0.
+ */
+#define STATISTICS_ALLOCATOR__HISTOGRAM_SIZE 64
+
+/**
+ *  \def STATISTICS_ALLOCATOR__FLUSH_THRESHOLD
+ *  \brief The number of live bytes a thread may allocate, or free, before adding them to the live bytes shared by
+ *  every thread. This bounds the error of StatisticsAllocator__Snapshot.peak_live_bytes.
+ */
+#define STATISTICS_ALLOCATOR__FLUSH_THRESHOLD ( 64ULL * 1024ULL )
+
+/**
+ *  \brief Opaque type holding the counters of a StatisticsAllocator. Defined in kirke/src/statistics_allocator.c.
+ */
+typedef struct StatisticsAllocator__State StatisticsAllocator__State;
+
+/**
+ *  \brief A point-in-time copy of the counters of a StatisticsAllocator, as returned by
+ *  statistics_allocator__snapshot.
+ */
+typedef struct StatisticsAllocator__Snapshot {
+    /**
+     *  The number of calls to alloc.
+     */
+    unsigned long long alloc_count;
+    /**
+     *  The number of calls to realloc.
+     */
+    unsigned long long realloc_count;
+    /**
+     *  The number of calls to free, with a non-NULL pointer.
+     */
+    unsigned long long free_count;
+    /**
+     *  The number of calls to realloc which requested more bytes than were previously allocated.
+     */
+    unsigned long long realloc_growth_count;
+    /**
+     *  The total number of bytes requested by alloc, and by the growth of realloc.
+     */
+    unsigned long long bytes_allocated;
+    /**
+     *  The number of bytes currently allocated.
+     */
+    unsigned long long live_bytes;
+    /**
+     *  The largest value \ref live_bytes has reached. This is exact when only one thread uses the allocator. Otherwise
+     *  each thread adds its live bytes to a shared total once they reach STATISTICS_ALLOCATOR__FLUSH_THRESHOLD, and
+     *  the peak may be off by less than twice STATISTICS_ALLOCATOR__FLUSH_THRESHOLD for each thread using the
+     *  allocator, however memory is handed between threads.
+     */
+    unsigned long long peak_live_bytes;
+    /**
+     *  The number of alloc and realloc requests in each power-of-2 size class.
+     */
+    unsigned long long size_histogram[ STATISTICS_ALLOCATOR__HISTOGRAM_SIZE ];
+} StatisticsAllocator__Snapshot;
+
+/**
+ *  \brief An allocator which wraps another allocator, counting the calls made to it and tracking the number of
+ *  bytes it holds.
+ *  Call counts, the size histogram and live byte counts are kept in per-thread counters, which are cheap to update
+ *  and are only merged when a snapshot is taken. Live bytes are added to a shared total only once a thread has
+ *  allocated or freed STATISTICS_ALLOCATOR__FLUSH_THRESHOLD of them, which keeps the overhead low enough to leave a
+ *  StatisticsAllocator in place in production.
+ *  \note Every allocation is preceded by a small header recording its size.
+ */
+typedef struct StatisticsAllocator{
+    /**
+     *  The initialized allocator, which can be passed to any method requiring an allocator parameter.
+     */
+    Allocator *allocator;
+    /**
+     *  The allocator which serves all requests. This is borrowed rather than owned. If the StatisticsAllocator
+     *  is used by multiple threads, then this must be thread-safe.
+     */
+    Allocator *backing_allocator;
+    /**
+     *  The counters of this allocator.
+     */
+    StatisticsAllocator__State *state;
+} StatisticsAllocator;
+
+/**
+ *  \brief Initializes a StatisticsAllocator structure.
+ *  \param statistics_allocator A pointer to the StatisticsAllocator to be initialized.
+ *  \param backing_allocator The allocator which will serve all requests.
+ */
+void statistics_allocator__initialize( StatisticsAllocator *statistics_allocator, Allocator *backing_allocator );
+
+/**
+ *  \brief De-initializes a StatisticsAllocator structure.
+ *  \param statistics_allocator A pointer to the StatisticsAllocator to be de-initialized.
+ *  \note Memory allocated through \p statistics_allocator is not freed, and must not be freed after this call.
+ */
+void statistics_allocator__deinitialize( StatisticsAllocator *statistics_allocator );
+
+/**
+ *  \brief Merges the counters of every thread into a snapshot.
+ *  \param statistics_allocator A pointer to the StatisticsAllocator.
+ *  \param out__snapshot An out parameter. Upon return, this will store the current counters.
+ *  \note The allocations made by allocator__create for \ref StatisticsAllocator.allocator itself are not counted.
+ */
+void statistics_allocator__snapshot( StatisticsAllocator const *statistics_allocator, StatisticsAllocator__Snapshot *out__snapshot );
+
+/**
+ *  \brief Appends a human-readable description of a snapshot to a String.
+ *  \param snapshot A pointer to the snapshot to be described.
+ *  \param string A pointer to an initialized String, to which the description will be appended.
+ *  \param allocator The allocator used to allocate memory for \p string.
+ */
+void statistics_allocator__snapshot__append_text( StatisticsAllocator__Snapshot const *snapshot, String *string, Allocator *allocator );
+
+/**
+ *  \brief Appends a JSON object describing a snapshot to a String.
+ *  \param snapshot A pointer to the snapshot to be described.
+ *  \param string A pointer to an initialized String, to which the JSON object will be appended.
+ *  \param allocator The allocator used to allocate memory for \p string.
+ */
+void statistics_allocator__snapshot__append_json( StatisticsAllocator__Snapshot const *snapshot, String *string, Allocator *allocator );
+
+/**
+ *  @} group statistics_allocator
+ */
+
+END_DECLARATIONS
+
+#endif // KIRKE__STATISTICS_ALLOCATOR__H
@@ -21,6 +21,14 @@ ARRAY__DECLARE( String, string, char )
 ARRAY__DECLARE( Array__String, array__string, String )
 LIST__DECLARE( List__String, list__string, String )
 
+/**
+ *  \def SMALL_STRING__INLINE_CAPACITY
+ *  \brief The number of characters which a SmallString stores inline, so that a SmallString fills a 64 byte cache line.
+ */
+#define SMALL_STRING__INLINE_CAPACITY 31
+
+ARRAY__DECLARE_SMALL( SmallString, small_string, String, char, SMALL_STRING__INLINE_CAPACITY )
+
 /**
  *  \def string__literal( TEXT )
  *  \brief This macro defines a String object containing the specified text.
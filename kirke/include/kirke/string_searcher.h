@@ -0,0 +1,89 @@
+/**
+ *  \file kirke/string_searcher.h
+ */
+
+#ifndef KIRKE__STRING_SEARCHER__H
+#define KIRKE__STRING_SEARCHER__H
+
+// System Includes
+#include <stdbool.h>
+
+// Internal Includes
+#include "kirke/macros.h"
+#include "kirke/string.h"
+
+BEGIN_DECLARATIONS
+
+/**
+ *  \defgroup string_searcher StringSearcher
+ *  @{
+ */
+
+/**
+ *  \def STRING_SEARCHER__SHORT_SEQUENCE_LENGTH
+ *  \brief The length of the longest sequence which a StringSearcher finds by filtering candidate positions on their
+ *  first and last characters. Longer sequences are found with the Two-Way algorithm.
+ */
+#define STRING_SEARCHER__SHORT_SEQUENCE_LENGTH 32
+
+/**
+ *  \brief A sequence of characters, analyzed once so that it can be searched for repeatedly, for example as the
+ *  delimiter of a SplitIterator.
+ *
+ *  A single character is found with memchr. Other short sequences are found by comparing the first and last
+ *  characters of the sequence against 16 candidate positions at once, with SSE2 where it is available, and only
+ *  comparing the rest at positions where both match. Long sequences are found with the Two-Way algorithm of
+ *  Crochemore and Perrin, which takes time linear in the length of the searched string, and constant space,
+ *  however repetitive either of them is.
+ */
+typedef struct StringSearcher{
+    /**
+     *  The sequence searched for. Its data is borrowed rather than owned, so it must outlive the StringSearcher.
+     */
+    String sequence;
+    /**
+     *  The index of the last character of the left half of the sequence's critical factorization, which may be
+     *  -1. This is only used for long sequences.
+     */
+    long long critical_position;
+    /**
+     *  The period of the sequence, if it is periodic, or otherwise a shift which cannot skip over a match. This is
+     *  only used for long sequences.
+     */
+    unsigned long long period;
+    /**
+     *  Whether the left half of the critical factorization repeats within the sequence, in which case the Two-Way
+     *  algorithm remembers how much of the sequence already matched after each shift by its period.
+     */
+    bool periodic;
+    /**
+     *  A bit for each byte value, set if the byte occurs in the sequence. A searched byte which does not occur in
+     *  the sequence rules out every position whose match would cover it.
+     */
+    unsigned char byte_set[ 32 ];
+} StringSearcher;
+
+/**
+ *  \brief Initializes a StringSearcher, analyzing the sequence to be searched for.
+ *  \param searcher A pointer to the StringSearcher to be initialized.
+ *  \param sequence The sequence to be searched for. Its data is borrowed, rather than copied.
+ */
+void string_searcher__initialize( StringSearcher *searcher, String const *sequence );
+
+/**
+ *  \brief Searches a String for the first occurrence of a StringSearcher's sequence.
+ *  \param searcher A pointer to the initialized StringSearcher.
+ *  \param string The String in which to search.
+ *  \param out__index An out parameter. Upon return, this will store the index at which the sequence was found, or
+ *  the length of \p string if it was not found. An empty sequence is found at index 0.
+ *  \returns Returns true if the sequence was found, and false otherwise.
+ */
+bool string_searcher__index_of( StringSearcher const *searcher, String const *string, unsigned long long *out__index );
+
+/**
+ *  @} group string_searcher
+ */
+
+END_DECLARATIONS
+
+#endif // KIRKE__STRING_SEARCHER__H
@@ -5,6 +5,9 @@
 #ifndef KIRKE__SYSTEM_ALLOCATOR__H
 #define KIRKE__SYSTEM_ALLOCATOR__H
 
+// System Includes
+#include <stdbool.h>
+
 // Internal Includes
 #include "kirke/macros.h"
 #include "kirke/allocator.h"
@@ -16,10 +19,76 @@ BEGIN_DECLARATIONS
  *  @{
  */
 
+/**
+ *  \def SYSTEM_ALLOCATOR__DEFAULT_LARGE_BLOCK_THRESHOLD
+ *  \brief A suggested value for \ref SystemAllocator__Options::large_block_threshold. Large blocks are only
+ *  supported on Linux, and the threshold is ignored elsewhere.
+ */
+#define SYSTEM_ALLOCATOR__DEFAULT_LARGE_BLOCK_THRESHOLD ( 4ULL * 1024ULL * 1024ULL )
+
+/**
+ *  \def SYSTEM_ALLOCATOR__HUGE_PAGE_SIZE
+ *  \brief The size in bytes of a transparent huge page. Huge page blocks are aligned to, and sized in multiples
+ *  of, this many bytes.
+ */
+#define SYSTEM_ALLOCATOR__HUGE_PAGE_SIZE ( 2ULL * 1024ULL * 1024ULL )
+
+/**
+ *  \brief Opaque type tracking the large blocks of a SystemAllocator. Defined in kirke/src/system_allocator.c.
+ */
+typedef struct SystemAllocator__LargeBlocks SystemAllocator__LargeBlocks;
+
+/**
+ *  \brief Options which may be passed to system_allocator__initialize__options.
+ */
+typedef struct SystemAllocator__Options{
+    /**
+     *  The size in bytes from which blocks are mapped directly from the operating system, rather than allocated
+     *  with malloc. Such blocks are grown with mremap, which remaps their pages instead of copying their contents,
+     *  and which is often able to grow them in place. If this is 0, then every block is allocated with malloc.
+     *  Large blocks are tracked in a table guarded by a mutex, which every free of a page aligned pointer locks, so
+     *  they suit allocators which grow a few large arrays better than ones shared by many threads.
+     */
+    unsigned long long large_block_threshold;
+    /**
+     *  The size in bytes from which large blocks are aligned to \ref SYSTEM_ALLOCATOR__HUGE_PAGE_SIZE and
+     *  advised with madvise( MADV_HUGEPAGE ), so that the kernel backs them with transparent huge pages. This
+     *  cuts the number of TLB entries needed to cover a large array by a factor of 512. Blocks this large are
+     *  always large blocks, whatever \ref large_block_threshold is. If this is 0, then huge pages are not used.
+     */
+    unsigned long long huge_page_threshold;
+    /**
+     *  If true, then every page of a large block is faulted in as soon as it is mapped or grown, rather than on
+     *  first access. This moves the cost of the page faults out of latency sensitive code, at the price of
+     *  committing the memory up front.
+     */
+    bool prefault;
+} SystemAllocator__Options;
+
+/**
+ *  \brief Statistics about the huge page blocks of a SystemAllocator, as returned by
+ *  system_allocator__huge_page_statistics.
+ */
+typedef struct SystemAllocator__HugePageStatistics{
+    /**
+     *  The number of bytes in blocks which were advised to use transparent huge pages.
+     */
+    unsigned long long advised_bytes;
+    /**
+     *  The number of those bytes which the kernel currently backs with transparent huge pages. This can be less
+     *  than \ref advised_bytes if huge pages are disabled, memory is too fragmented, or pages have not yet been
+     *  touched.
+     */
+    unsigned long long backed_bytes;
+} SystemAllocator__HugePageStatistics;
+
 /**
  *  \brief An allocator which uses the system's malloc, realloc and free methods.
  *  This allocator checks for out of memory errors (when malloc or realloc returns NULL),
  *  and calls an optional callback if this occurs.
+ *  On Linux, blocks of at least \ref large_block_threshold bytes are instead mapped directly with mmap, so that
+ *  growing them never copies their contents. Blocks of at least \ref huge_page_threshold bytes are also backed by
+ *  transparent huge pages.
  */
 typedef struct SystemAllocator{
     /**
@@ -31,6 +100,23 @@ typedef struct SystemAllocator{
      *  out of memory errors.
      */
     void ( *out_of_memory_callback )( void );
+    /**
+     *  The size in bytes from which blocks are mapped directly from the operating system, or 0 if large blocks
+     *  are disabled.
+     */
+    unsigned long long large_block_threshold;
+    /**
+     *  The size in bytes from which large blocks use transparent huge pages, or 0 if huge pages are disabled.
+     */
+    unsigned long long huge_page_threshold;
+    /**
+     *  Whether large blocks are faulted in as soon as they are mapped. See \ref SystemAllocator__Options::prefault.
+     */
+    bool prefault;
+    /**
+     *  The large blocks currently allocated, or NULL if large blocks are disabled.
+     */
+    SystemAllocator__LargeBlocks *large_blocks;
 } SystemAllocator;
 
 /**
@@ -38,12 +124,28 @@ typedef struct SystemAllocator{
  *  The SystemAllocator structure contains an \ref allocator field which can be passed to any method taking
  *  an Allocator* parameter. This allocator is a vtable which points to the system's malloc, realloc and free
  *  methods.
+ *  Every block is allocated with malloc, so that frees never contend on a lock. Large blocks, huge pages and
+ *  prefaulting can be enabled with system_allocator__initialize__options.
  *  \param system_allocator A pointer to the SystemAllocator to be initialized.
  *  \param out_of_memory_callback An optional method which will be called if alloc or realloc return NULL,
  *  i.e. an out of memory condition occurred.
  */
 void system_allocator__initialize( SystemAllocator* system_allocator, void( *out_of_memory_callback )( void ) );
 
+/**
+ *  Initializes a SystemAllocator structure, as system_allocator__initialize does, with the given options.
+ *  \param system_allocator A pointer to the SystemAllocator to be initialized.
+ *  \param out_of_memory_callback An optional method which will be called if alloc or realloc return NULL,
+ *  i.e. an out of memory condition occurred.
+ *  \param options Optional. A pointer to the options to use. If this is NULL, then every block is allocated with
+ *  malloc.
+ */
+void system_allocator__initialize__options(
+    SystemAllocator* system_allocator,
+    void( *out_of_memory_callback )( void ),
+    SystemAllocator__Options const* options
+);
+
 /**
  *  De-initializes a SystemAllocator structure.
  *  This must be called when finished with a SystemAllocator initialized with system_allocator__initialize.
@@ -52,6 +154,29 @@ void system_allocator__initialize( SystemAllocator* system_allocator, void( *out
  */
 void system_allocator__deinitialize( SystemAllocator* system_allocator );
 
+/**
+ *  Measures how much of the memory allocated from a SystemAllocator uses transparent huge pages.
+ *  \param system_allocator A pointer to the SystemAllocator.
+ *  \param out_statistics A pointer to the structure which receives the statistics.
+ *  \note This reads /proc/self/smaps, so it is far too slow to call on a hot path. On systems other than Linux,
+ *  every statistic is 0.
+ */
+void system_allocator__huge_page_statistics(
+    SystemAllocator* system_allocator,
+    SystemAllocator__HugePageStatistics* out_statistics
+);
+
+/**
+ *  Returns free memory held by the C library's heap to the operating system, for example after a burst of allocations
+ *  has been freed. Large blocks are unmapped as soon as they are freed, so they never need trimming. This is also
+ *  called by allocator__trim on \ref SystemAllocator::allocator.
+ *  \param system_allocator A pointer to the SystemAllocator.
+ *  \returns Returns true if any memory was released, and false otherwise.
+ *  \note This calls malloc_trim on glibc, which walks the whole heap, so it should be called after a peak rather than
+ *  on a hot path. On other C libraries, it does nothing and returns false.
+ */
+bool system_allocator__trim( SystemAllocator* system_allocator );
+
 /**
  *  @} group system_allocator
  */
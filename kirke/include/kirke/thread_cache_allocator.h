@@ -0,0 +1,87 @@
+/**
+ *  \file kirke/thread_cache_allocator.h
+ */
+
+#ifndef KIRKE__THREAD_CACHE_ALLOCATOR__H
+#define KIRKE__THREAD_CACHE_ALLOCATOR__H
+
+// Internal Includes
+#include "kirke/macros.h"
+#include "kirke/allocator.h"
+
+BEGIN_DECLARATIONS
+
+/**
+ *  \defgroup thread_cache_allocator ThreadCacheAllocator
+ *  @{
+ */
+
+/**
+ *  \def THREAD_CACHE_ALLOCATOR__MAXIMUM_CACHED_SIZE
+ *  \brief The largest request, in bytes, which is served from a thread cache. Larger requests are forwarded
+ *  directly to the backing allocator.
+ */
+#define THREAD_CACHE_ALLOCATOR__MAXIMUM_CACHED_SIZE 32768ULL
+
+/**
+ *  \brief Opaque type holding the state shared by all threads using a ThreadCacheAllocator: the central depot
+ *  of free objects for each size class, and the list of per-thread caches. Defined in
+ *  kirke/src/thread_cache_allocator.c.
+ */
+typedef struct ThreadCacheAllocator__Depot ThreadCacheAllocator__Depot;
+
+/**
+ *  \brief A thread-safe allocator which keeps a cache of free objects for each thread, in the style of tcmalloc.
+ *  Requests up to \ref THREAD_CACHE_ALLOCATOR__MAXIMUM_CACHED_SIZE bytes are rounded up to one of a fixed set of
+ *  size classes. Each thread allocates from, and frees to, its own cache without taking any lock. When a
+ *  thread's cache for a size class runs empty, a batch of objects is fetched from a central depot. When it
+ *  grows too large, a batch is returned to the depot. The depot carves new objects from large chunks obtained
+ *  from the backing allocator. Larger requests bypass the caches and are forwarded to the backing allocator.
+ *  A single ThreadCacheAllocator can be shared by any number of threads through its \ref allocator field.
+ *  \note Every allocation is preceded by a small header recording its size class.
+ */
+typedef struct ThreadCacheAllocator{
+    /**
+     *  The initialized allocator, which can be passed to any method requiring an allocator parameter.
+     */
+    Allocator *allocator;
+    /**
+     *  The allocator from which chunks and large requests are allocated. This must be thread-safe, for
+     *  example the allocator of a \ref SystemAllocator. It is borrowed rather than owned.
+     */
+    Allocator *backing_allocator;
+    /**
+     *  The state shared by all threads using this allocator.
+     */
+    ThreadCacheAllocator__Depot *depot;
+} ThreadCacheAllocator;
+
+/**
+ *  \brief Initializes a ThreadCacheAllocator structure.
+ *  \param thread_cache_allocator A pointer to the ThreadCacheAllocator to be initialized.
+ *  \param backing_allocator The thread-safe allocator which will be used to allocate chunks and large requests.
+ */
+void thread_cache_allocator__initialize( ThreadCacheAllocator *thread_cache_allocator, Allocator *backing_allocator );
+
+/**
+ *  \brief De-initializes a ThreadCacheAllocator structure, returning all of its memory to the backing allocator.
+ *  \param thread_cache_allocator A pointer to the ThreadCacheAllocator to be de-initialized.
+ *  \note No other thread may be using \p thread_cache_allocator during this call. Any memory allocated from
+ *  \p thread_cache_allocator is invalid after this call, except for large requests, which are not freed.
+ */
+void thread_cache_allocator__deinitialize( ThreadCacheAllocator *thread_cache_allocator );
+
+/**
+ *  \brief Returns every object cached by the calling thread to the central depot, where other threads can reuse
+ *  them. This happens automatically when a thread exits.
+ *  \param thread_cache_allocator A pointer to the ThreadCacheAllocator.
+ */
+void thread_cache_allocator__flush( ThreadCacheAllocator *thread_cache_allocator );
+
+/**
+ *  @} group thread_cache_allocator
+ */
+
+END_DECLARATIONS
+
+#endif // KIRKE__THREAD_CACHE_ALLOCATOR__H
@@ -0,0 +1,232 @@
+/**
+ *  \file kirke/trace_allocator.h
+ */
+
+#ifndef KIRKE__TRACE_ALLOCATOR__H
+#define KIRKE__TRACE_ALLOCATOR__H
+
+// System Includes
+#include <stdbool.h>
+
+// Internal Includes
+#include "kirke/macros.h"
+#include "kirke/allocator.h"
+#include "kirke/string.h"
+
+BEGIN_DECLARATIONS
+
+/** Forward declaration of Error, defined in \ref kirke/error.h */
+typedef struct Error Error;
+
+/**
+ *  \defgroup trace_allocator TraceAllocator
+ *  @{
+ */
+
+/**
+ *  \def TRACE_ALLOCATOR__CHUNK_EVENT_COUNT
+ *  \brief The number of events held by each chunk of a TraceAllocator's log.
+ */
+#define TRACE_ALLOCATOR__CHUNK_EVENT_COUNT 65536ULL
+
+/**
+ *  \def TRACE_ALLOCATOR__MAXIMUM_CHUNK_COUNT
+ *  \brief The largest number of chunks in a TraceAllocator's log. Events beyond the last chunk are dropped, and
+ *  counted in \ref TraceAllocator__Trace::dropped_event_count.
+ */
+#define TRACE_ALLOCATOR__MAXIMUM_CHUNK_COUNT 4096ULL
+
+/**
+ *  \brief This enumerator defines possible Error types for TraceAllocator functions.
+ */
+typedef enum TraceAllocator__Error {
+    /** \brief Denotes that an error occurred because the trace file could not be opened. */
+    TraceAllocator__Error__UnableToOpenFile = 1,
+    /** \brief Denotes that an error occurred because the trace file is not a valid trace. */
+    TraceAllocator__Error__InvalidFile = 2,
+    /** \brief Denotes that an error occurred because memory for the trace could not be allocated. */
+    TraceAllocator__Error__OutOfMemory = 3
+} TraceAllocator__Error;
+
+/**
+ *  \brief The kinds of event recorded by a TraceAllocator.
+ */
+typedef enum TraceAllocator__Operation {
+    TraceAllocator__Operation__Alloc = 0,
+    TraceAllocator__Operation__Realloc = 1,
+    TraceAllocator__Operation__Free = 2
+} TraceAllocator__Operation;
+
+/**
+ *  \brief A single recorded call, as stored in a trace file.
+ */
+typedef struct TraceAllocator__Event {
+    /**
+     *  The size requested by an alloc or realloc, or the size of the allocation released by a free.
+     */
+    unsigned long long size;
+    /**
+     *  Identifies the allocation which the event refers to. Identifiers are assigned in order by alloc, and by
+     *  realloc of NULL, and an allocation keeps its identifier when it is reallocated.
+     */
+    unsigned int pointer_id;
+    /**
+     *  Identifies the thread which made the call. Threads are numbered from 0, in the order of their first call.
+     */
+    unsigned short thread;
+    /**
+     *  The \ref TraceAllocator__Operation.
+     */
+    unsigned char operation;
+    unsigned char reserved;
+} TraceAllocator__Event;
+
+/**
+ *  \brief A recorded trace, whose events are stored contiguously.
+ */
+typedef struct TraceAllocator__Trace {
+    TraceAllocator__Event *events;
+    unsigned long long event_count;
+    /**
+     *  The number of pointer identifiers assigned, which bounds every \ref TraceAllocator__Event::pointer_id.
+     */
+    unsigned long long pointer_count;
+    /**
+     *  The number of threads which made calls.
+     */
+    unsigned long long thread_count;
+    /**
+     *  The number of events which were not recorded, because the log was full.
+     */
+    unsigned long long dropped_event_count;
+} TraceAllocator__Trace;
+
+/**
+ *  \brief The result of replaying a trace against an allocator.
+ */
+typedef struct TraceAllocator__Replay {
+    /**
+     *  The number of events replayed.
+     */
+    unsigned long long operation_count;
+    /**
+     *  The time taken to replay the trace, in seconds.
+     */
+    double seconds;
+    /**
+     *  The largest number of bytes which the trace held at once.
+     */
+    unsigned long long peak_live_bytes;
+    /**
+     *  The largest growth of the process's resident set during the replay, in bytes, or 0 if it is unavailable.
+     */
+    unsigned long long peak_resident_bytes;
+    /**
+     *  The share of \ref peak_resident_bytes which did not hold live bytes at the peak:
+     *  1 - peak_live_bytes / peak_resident_bytes, or 0 if the resident set is unavailable.
+     */
+    double fragmentation;
+} TraceAllocator__Replay;
+
+/**
+ *  \brief Opaque type holding the log of a TraceAllocator. Defined in kirke/src/trace_allocator.c.
+ */
+typedef struct TraceAllocator__State TraceAllocator__State;
+
+/**
+ *  \brief An allocator which wraps another allocator, recording every alloc, realloc and free made through it,
+ *  so that a production workload can be replayed later against other allocators with trace_allocator__replay.
+ *  Each event takes 16 bytes. Events are appended to a log of fixed-size chunks with a single atomic increment,
+ *  without taking a lock, so a TraceAllocator can be shared by many threads. The log orders all events, so a free
+ *  is always recorded after the alloc of the same allocation, even when they are made by different threads.
+ *  \note Every allocation is preceded by a small header recording its identifier and size.
+ */
+typedef struct TraceAllocator{
+    /**
+     *  The initialized allocator, which can be passed to any method requiring an allocator parameter.
+     */
+    Allocator *allocator;
+    /**
+     *  The allocator which serves all requests, and holds the log. This is borrowed rather than owned. If the
+     *  TraceAllocator is used by multiple threads, then this must be thread-safe.
+     */
+    Allocator *backing_allocator;
+    /**
+     *  The log of this allocator.
+     */
+    TraceAllocator__State *state;
+} TraceAllocator;
+
+/**
+ *  \brief Initializes a TraceAllocator structure.
+ *  \param trace_allocator A pointer to the TraceAllocator to be initialized.
+ *  \param backing_allocator The allocator which will serve all requests.
+ */
+void trace_allocator__initialize( TraceAllocator *trace_allocator, Allocator *backing_allocator );
+
+/**
+ *  \brief De-initializes a TraceAllocator structure, freeing its log.
+ *  \param trace_allocator A pointer to the TraceAllocator to be de-initialized.
+ *  \note Memory allocated through \p trace_allocator is not freed, and must not be freed after this call.
+ */
+void trace_allocator__deinitialize( TraceAllocator *trace_allocator );
+
+/**
+ *  \brief Copies the events recorded so far into a trace.
+ *  \param trace_allocator A pointer to the TraceAllocator.
+ *  \param out__trace An out parameter. Upon return, this will hold the recorded events. It must be cleared with
+ *  trace_allocator__trace__clear.
+ *  \param allocator The allocator used to allocate the events of \p out__trace.
+ *  \returns Returns true if the trace was copied, and false if its events could not be allocated.
+ *  \note No other thread may allocate through \p trace_allocator during this call.
+ */
+bool trace_allocator__trace( TraceAllocator const *trace_allocator, TraceAllocator__Trace *out__trace, Allocator *allocator );
+
+/**
+ *  \brief Frees the events of a trace.
+ *  \param trace A pointer to the trace to be cleared.
+ *  \param allocator The allocator which was used to allocate the trace.
+ */
+void trace_allocator__trace__clear( TraceAllocator__Trace *trace, Allocator *allocator );
+
+/**
+ *  \brief Writes the events recorded so far to a file: a 32 byte header, holding a magic number and the counts
+ *  of events, pointers and threads, followed by the events themselves in the host's byte order.
+ *  \param trace_allocator A pointer to the TraceAllocator.
+ *  \param file_path A String containing the path of the file to be written.
+ *  \param error Optional. A pointer to an Error structure, which will be set if the file cannot be written.
+ *  \returns Returns true if the trace was written, and false otherwise.
+ *  \note No other thread may allocate through \p trace_allocator during this call.
+ */
+bool trace_allocator__write( TraceAllocator const *trace_allocator, String file_path, Error *error );
+
+/**
+ *  \brief Reads a trace written by trace_allocator__write.
+ *  \param file_path A String containing the path of the file to be read.
+ *  \param out__trace An out parameter. Upon return, this will hold the events of the file. It must be cleared
+ *  with trace_allocator__trace__clear.
+ *  \param allocator The allocator used to allocate the events of \p out__trace.
+ *  \param error Optional. A pointer to an Error structure, which will be set if the file cannot be read.
+ *  \returns Returns true if the trace was read, and false otherwise.
+ */
+bool trace_allocator__read( String file_path, TraceAllocator__Trace *out__trace, Allocator *allocator, Error *error );
+
+/**
+ *  \brief Replays a trace against an allocator on the calling thread, in the order in which its events were
+ *  recorded, writing to every page of each allocation as a program would. Allocations which are still live at the
+ *  end of the trace are freed afterwards, outside of the timed replay.
+ *  \param trace A pointer to the trace to be replayed.
+ *  \param allocator The allocator to be measured.
+ *  \param out__replay An out parameter. Upon return, this will hold the measurements.
+ *  \returns Returns true if the trace was replayed, and false if an allocation failed or the trace is invalid.
+ *  \note Events made by different threads are replayed by one thread, so contention is not reproduced.
+ */
+bool trace_allocator__replay( TraceAllocator__Trace const *trace, Allocator *allocator, TraceAllocator__Replay *out__replay );
+
+/**
+ *  @} group trace_allocator
+ */
+
+END_DECLARATIONS
+
+#endif // KIRKE__TRACE_ALLOCATOR__H
@@ -1,5 +1,5 @@
 // System Includes
-#include "string.h" // memset
+#include "string.h" // memset, memcpy, memmove
 
 // Internal Includes
 #include "kirke/allocator.h"
@@ -30,6 +30,34 @@ typedef struct Allocator {
      *  This is a pointer to user-supplied memory, which will be1 passed to all of the above methods
      */
 	void* allocator_data;
+    /**
+     *  Optional. This is a pointer to a function which will allocate new memory with a given alignment.
+     */
+    void* ( *alloc_aligned )( unsigned long long size, unsigned long long alignment, void* allocator_data );
+    /**
+     *  Optional. This is a pointer to a function which will reallocate memory allocated by alloc_aligned.
+     */
+    void* ( *realloc_aligned )( void* pointer, unsigned long long old_size, unsigned long long size, unsigned long long alignment, void* allocator_data );
+    /**
+     *  Optional. This is a pointer to a function which will free memory allocated by alloc_aligned.
+     */
+    void ( *free_aligned )( void* pointer, void* allocator_data );
+    /**
+     *  Optional. This is a pointer to a function which will free a region of memory of a known size.
+     */
+    void ( *free_sized )( void* pointer, unsigned long long size, void* allocator_data );
+    /**
+     *  Optional. This is a pointer to a function which will resize a region of memory without moving it.
+     */
+    bool ( *try_expand )( void* pointer, unsigned long long size, void* allocator_data );
+    /**
+     *  Optional. This is a pointer to a function which will allocate new, zeroed memory.
+     */
+    void* ( *calloc )( unsigned long long count, unsigned long long size, void* allocator_data );
+    /**
+     *  Optional. This is a pointer to a function which will release memory which is held, but not in use.
+     */
+    bool ( *trim )( void* allocator_data );
 } Allocator;
 
 
@@ -53,6 +81,13 @@ Allocator* allocator__create(
 		allocator->free = free_function;
 		allocator->out_of_memory = out_of_memory_function;
 		allocator->allocator_data = allocator_data;
+		allocator->alloc_aligned = NULL;
+		allocator->realloc_aligned = NULL;
+		allocator->free_aligned = NULL;
+		allocator->free_sized = NULL;
+		allocator->try_expand = NULL;
+		allocator->calloc = NULL;
+		allocator->trim = NULL;
 	}
 
     return allocator;
@@ -78,16 +113,25 @@ void* allocator__alloc( Allocator* allocator, unsigned long long size ){
 }
 
 void* allocator__calloc( Allocator* allocator, unsigned long long count, unsigned long long size ){
-	void* new_memory = allocator->alloc( count * size, allocator->allocator_data );
+    void* new_memory = NULL;
+
+    /* A calloc function may know that its memory is already zeroed, for example pages fresh from the kernel. */
+    if( allocator->calloc != NULL ){
+        new_memory = allocator->calloc( count, size, allocator->allocator_data );
+    }
+    else if( size == 0 || count <= ~0ULL / size ){
+        new_memory = allocator->alloc( count * size, allocator->allocator_data );
+
+        if( new_memory != NULL ){
+            memset( new_memory, 0, count * size );
+        }
+    }
 
     if( new_memory == NULL ){
         if( allocator->out_of_memory != NULL ){
             allocator->out_of_memory( allocator->allocator_data );
         }
     }
-    else{
-        memset( new_memory, 0, count * size );
-    }
 
     return new_memory;
 }
@@ -109,3 +153,188 @@ void allocator__free( Allocator* allocator, void* pointer ){
         allocator->free( pointer, allocator->allocator_data );
     }
 }
+
+void allocator__set_aligned_functions(
+    Allocator* allocator,
+    void* ( *alloc_aligned_function )( unsigned long long size, unsigned long long alignment, void* allocator_data ),
+    void* ( *realloc_aligned_function )( void* pointer, unsigned long long old_size, unsigned long long size, unsigned long long alignment, void* allocator_data ),
+    void ( *free_aligned_function )( void* pointer, void* allocator_data )
+){
+    RETURN_IF_FAIL( allocator != NULL );
+
+    allocator->alloc_aligned = alloc_aligned_function;
+    allocator->realloc_aligned = realloc_aligned_function;
+    allocator->free_aligned = free_aligned_function;
+}
+
+void allocator__set_free_sized_function(
+    Allocator* allocator,
+    void ( *free_sized_function )( void* pointer, unsigned long long size, void* allocator_data )
+){
+    RETURN_IF_FAIL( allocator != NULL );
+
+    allocator->free_sized = free_sized_function;
+}
+
+void allocator__set_try_expand_function(
+    Allocator* allocator,
+    bool ( *try_expand_function )( void* pointer, unsigned long long size, void* allocator_data )
+){
+    RETURN_IF_FAIL( allocator != NULL );
+
+    allocator->try_expand = try_expand_function;
+}
+
+void allocator__set_calloc_function(
+    Allocator* allocator,
+    void* ( *calloc_function )( unsigned long long count, unsigned long long size, void* allocator_data )
+){
+    RETURN_IF_FAIL( allocator != NULL );
+
+    allocator->calloc = calloc_function;
+}
+
+void allocator__set_trim_function(
+    Allocator* allocator,
+    bool ( *trim_function )( void* allocator_data )
+){
+    RETURN_IF_FAIL( allocator != NULL );
+
+    allocator->trim = trim_function;
+}
+
+bool allocator__trim( Allocator* allocator ){
+    if( allocator == NULL || allocator->trim == NULL ){
+        return false;
+    }
+
+    return allocator->trim( allocator->allocator_data );
+}
+
+bool allocator__try_expand( Allocator* allocator, void* pointer, unsigned long long size ){
+    if( allocator == NULL || pointer == NULL || allocator->try_expand == NULL ){
+        return false;
+    }
+
+    return allocator->try_expand( pointer, size, allocator->allocator_data );
+}
+
+/**
+ *  \brief The number of bytes by which a block is over-allocated when an allocator does not supply alloc_aligned.
+ *  This leaves room to align the block, and to store the address of the underlying block just before it.
+ */
+static unsigned long long allocator__aligned_padding( unsigned long long alignment ){
+    return alignment - 1 + sizeof( void* );
+}
+
+/**
+ *  \brief Finds the aligned block within an over-allocated underlying block. The address of the underlying block is
+ *  stored just before the aligned block.
+ */
+static char* allocator__aligned_address( char* block, unsigned long long alignment ){
+    return (char*)( ( (unsigned long long) block + sizeof( void* ) + alignment - 1 ) & ~( alignment - 1 ) );
+}
+
+void* allocator__alloc_aligned( Allocator* allocator, unsigned long long size, unsigned long long alignment ){
+    RETURN_VALUE_IF_FAIL( allocator != NULL && alignment != 0 && ( alignment & ( alignment - 1 ) ) == 0, NULL );
+
+    alignment = alignment < sizeof( void* ) ? sizeof( void* ) : alignment;
+
+    void* new_memory = NULL;
+    if( allocator->alloc_aligned != NULL ){
+        new_memory = allocator->alloc_aligned( size, alignment, allocator->allocator_data );
+    }
+    else if( size <= ~0ULL - allocator__aligned_padding( alignment ) ){
+        /* Cast for C++ compatibility */
+        char* block = (char*) allocator->alloc( size + allocator__aligned_padding( alignment ), allocator->allocator_data );
+        if( block != NULL ){
+            new_memory = allocator__aligned_address( block, alignment );
+            ( (void**) new_memory )[ -1 ] = block;
+        }
+    }
+
+    if( new_memory == NULL ){
+        if( allocator->out_of_memory != NULL ){
+            allocator->out_of_memory( allocator->allocator_data );
+        }
+    }
+
+    return new_memory;
+}
+
+void* allocator__realloc_aligned( Allocator* allocator, void* pointer, unsigned long long old_size, unsigned long long size, unsigned long long alignment ){
+    RETURN_VALUE_IF_FAIL( allocator != NULL && alignment != 0 && ( alignment & ( alignment - 1 ) ) == 0, NULL );
+
+    if( pointer == NULL ){
+        return allocator__alloc_aligned( allocator, size, alignment );
+    }
+
+    alignment = alignment < sizeof( void* ) ? sizeof( void* ) : alignment;
+
+    unsigned long long preserved_size = old_size < size ? old_size : size;
+    void* new_memory = NULL;
+
+    if( allocator->alloc_aligned != NULL && allocator->realloc_aligned != NULL ){
+        new_memory = allocator->realloc_aligned( pointer, old_size, size, alignment, allocator->allocator_data );
+    }
+    else if( allocator->alloc_aligned != NULL ){
+        new_memory = allocator->alloc_aligned( size, alignment, allocator->allocator_data );
+        if( new_memory != NULL ){
+            memcpy( new_memory, pointer, preserved_size );
+            allocator__free_aligned( allocator, pointer );
+        }
+    }
+    else if( size <= ~0ULL - allocator__aligned_padding( alignment ) ){
+        /*
+         *  Reallocate the underlying block, which may grow in place. If its new address has a different offset from
+         *  the alignment, then the contents are moved to the new aligned address.
+         */
+        char* block = (char*) ( (void**) pointer )[ -1 ];
+        unsigned long long offset = (unsigned long long)( (char*) pointer - block );
+
+        /* Cast for C++ compatibility */
+        char* new_block = (char*) allocator->realloc( block, size + allocator__aligned_padding( alignment ), allocator->allocator_data );
+        if( new_block != NULL ){
+            new_memory = allocator__aligned_address( new_block, alignment );
+            if( (char*) new_memory != new_block + offset ){
+                memmove( new_memory, new_block + offset, preserved_size );
+            }
+            ( (void**) new_memory )[ -1 ] = new_block;
+        }
+    }
+
+    if( new_memory == NULL ){
+        if( allocator->out_of_memory != NULL ){
+            allocator->out_of_memory( allocator->allocator_data );
+        }
+    }
+
+    return new_memory;
+}
+
+void allocator__free_aligned( Allocator* allocator, void* pointer ){
+    if( allocator == NULL || pointer == NULL ){
+        return;
+    }
+
+    if( allocator->alloc_aligned == NULL ){
+        allocator->free( ( (void**) pointer )[ -1 ], allocator->allocator_data );
+    }
+    else if( allocator->free_aligned != NULL ){
+        allocator->free_aligned( pointer, allocator->allocator_data );
+    }
+    else{
+        allocator->free( pointer, allocator->allocator_data );
+    }
+}
+
+void allocator__free_sized( Allocator* allocator, void* pointer, unsigned long long size ){
+    if( allocator != NULL ){
+        if( allocator->free_sized != NULL ){
+            allocator->free_sized( pointer, size, allocator->allocator_data );
+        }
+        else{
+            allocator->free( pointer, allocator->allocator_data );
+        }
+    }
+}
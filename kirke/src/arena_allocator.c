@@ -0,0 +1,273 @@
+// System Includes
+#include <stddef.h> // max_align_t
+#include <stdint.h> // uintptr_t
+#include <string.h> // memcpy
+
+// Internal Includes
+#include "kirke/arena_allocator.h"
+#include "kirke/math.h"
+
+/**
+ *  \brief The alignment of every allocation served by an ArenaAllocator.
+ */
+#define ARENA_ALLOCATOR__ALIGNMENT _Alignof( max_align_t )
+
+/**
+ *  \brief ArenaAllocator__Chunk is the header of a block of memory allocated from the backing allocator.
+ *  Allocations are served from the bytes which directly follow the header.
+ */
+struct ArenaAllocator__Chunk {
+    /**
+     *  The next chunk in the arena's list of chunks, or NULL if this is the last chunk.
+     */
+    ArenaAllocator__Chunk *next;
+    /**
+     *  The number of bytes available for allocations within this chunk.
+     */
+    unsigned long long capacity;
+    /**
+     *  The number of bytes already in use within this chunk.
+     */
+    unsigned long long position;
+};
+
+/**
+ *  \brief The offset from the start of a chunk to the first byte available for allocations.
+ */
+#define ARENA_ALLOCATOR__CHUNK_HEADER_SIZE \
+    ( ( sizeof( ArenaAllocator__Chunk ) + ARENA_ALLOCATOR__ALIGNMENT - 1 ) & ~( ARENA_ALLOCATOR__ALIGNMENT - 1 ) )
+
+static char *arena_allocator__chunk__data( ArenaAllocator__Chunk *chunk ){
+    return (char*) chunk + ARENA_ALLOCATOR__CHUNK_HEADER_SIZE;
+}
+
+/**
+ *  Each allocation is preceded by its size, so that realloc knows how many bytes to copy.
+ */
+static unsigned long long *arena_allocator__allocation__size( void *pointer ){
+    return (unsigned long long*) pointer - 1;
+}
+
+/**
+ *  \brief Attempts to place an allocation of \p size bytes within \p chunk.
+ *  \returns A pointer to the new allocation, or NULL if \p chunk does not have enough room.
+ */
+static void *arena_allocator__chunk__alloc( ArenaAllocator__Chunk *chunk, unsigned long long size ){
+    uintptr_t data = (uintptr_t) arena_allocator__chunk__data( chunk );
+    uintptr_t start = ( data + chunk->position + sizeof( unsigned long long ) + ARENA_ALLOCATOR__ALIGNMENT - 1 ) & ~( ARENA_ALLOCATOR__ALIGNMENT - 1 );
+
+    if( start - data + size > chunk->capacity ){
+        return NULL;
+    }
+
+    chunk->position = start - data + size;
+    *arena_allocator__allocation__size( (void*) start ) = size;
+
+    return (void*) start;
+}
+
+static void *arena_allocator__alloc( unsigned long long size, void *allocator_data ){
+    ArenaAllocator *arena_allocator = (ArenaAllocator*) allocator_data;
+
+    void *allocation = NULL;
+    if( arena_allocator->current_chunk != NULL ){
+        allocation = arena_allocator__chunk__alloc( arena_allocator->current_chunk, size );
+    }
+
+    /*
+     *  Chunks following the current chunk were left behind by a rewind, and are empty. The first which is large
+     *  enough is moved to directly follow the current chunk, so that the smaller ones it passes over stay available
+     *  for later allocations, rather than being skipped for good.
+     */
+    if( allocation == NULL && arena_allocator->current_chunk != NULL ){
+        for( ArenaAllocator__Chunk **link = &arena_allocator->current_chunk->next; *link != NULL; link = &( *link )->next ){
+            ArenaAllocator__Chunk *chunk = *link;
+            chunk->position = 0;
+            allocation = arena_allocator__chunk__alloc( chunk, size );
+
+            if( allocation != NULL ){
+                *link = chunk->next;
+                chunk->next = arena_allocator->current_chunk->next;
+                arena_allocator->current_chunk->next = chunk;
+                arena_allocator->current_chunk = chunk;
+                break;
+            }
+        }
+    }
+
+    if( allocation == NULL ){
+        unsigned long long capacity = math__max__ullong(
+            arena_allocator->chunk_size,
+            size + sizeof( unsigned long long ) + ARENA_ALLOCATOR__ALIGNMENT
+        );
+
+        ArenaAllocator__Chunk *chunk = (ArenaAllocator__Chunk*) allocator__alloc(
+            arena_allocator->backing_allocator,
+            ARENA_ALLOCATOR__CHUNK_HEADER_SIZE + capacity
+        );
+
+        if( chunk == NULL ){
+            return NULL;
+        }
+
+        /* A new chunk goes in front of any retained chunks, none of which was large enough, so they are kept. */
+        *chunk = (ArenaAllocator__Chunk){
+            .next = arena_allocator->current_chunk != NULL ? arena_allocator->current_chunk->next : NULL,
+            .capacity = capacity,
+            .position = 0
+        };
+
+        if( arena_allocator->current_chunk == NULL ){
+            arena_allocator->first_chunk = chunk;
+        }
+        else{
+            arena_allocator->current_chunk->next = chunk;
+        }
+
+        arena_allocator->current_chunk = chunk;
+        allocation = arena_allocator__chunk__alloc( chunk, size );
+    }
+
+    arena_allocator->last_allocation = allocation;
+
+    return allocation;
+}
+
+static bool arena_allocator__try_expand( void *pointer, unsigned long long size, void *allocator_data ){
+    ArenaAllocator *arena_allocator = (ArenaAllocator*) allocator_data;
+
+    unsigned long long *allocation_size = arena_allocator__allocation__size( pointer );
+
+    /* The most recent allocation can be resized in place, as long as it still fits within the current chunk. */
+    if( pointer == arena_allocator->last_allocation ){
+        ArenaAllocator__Chunk *chunk = arena_allocator->current_chunk;
+        unsigned long long offset = (unsigned long long)( (char*) pointer - arena_allocator__chunk__data( chunk ) );
+
+        if( offset + size <= chunk->capacity ){
+            chunk->position = offset + size;
+            *allocation_size = size;
+            return true;
+        }
+    }
+    else if( size <= *allocation_size ){
+        *allocation_size = size;
+        return true;
+    }
+
+    return false;
+}
+
+static void *arena_allocator__realloc( void *pointer, unsigned long long size, void *allocator_data ){
+    if( pointer == NULL ){
+        return arena_allocator__alloc( size, allocator_data );
+    }
+
+    if( arena_allocator__try_expand( pointer, size, allocator_data ) ){
+        return pointer;
+    }
+
+    void *new_allocation = arena_allocator__alloc( size, allocator_data );
+    if( new_allocation != NULL ){
+        memcpy( new_allocation, pointer, math__min__ullong( *arena_allocator__allocation__size( pointer ), size ) );
+    }
+
+    return new_allocation;
+}
+
+static void arena_allocator__free( void *pointer, void *allocator_data ){
+    (void)( pointer );
+    (void)( allocator_data );
+}
+
+static bool arena_allocator__trim__allocator( void *allocator_data ){
+    return arena_allocator__trim( (ArenaAllocator*) allocator_data );
+}
+
+void arena_allocator__initialize( ArenaAllocator *arena_allocator, Allocator *backing_allocator, unsigned long long chunk_size ){
+    *arena_allocator = (ArenaAllocator){
+        .allocator = NULL,
+        .backing_allocator = backing_allocator,
+        .chunk_size = chunk_size,
+        .first_chunk = NULL,
+        .current_chunk = NULL,
+        .last_allocation = NULL
+    };
+
+    arena_allocator->allocator = allocator__create(
+        arena_allocator__alloc,
+        arena_allocator__realloc,
+        arena_allocator__free,
+        NULL,
+        arena_allocator
+    );
+
+    if( arena_allocator->allocator != NULL ){
+        allocator__set_try_expand_function( arena_allocator->allocator, arena_allocator__try_expand );
+        allocator__set_trim_function( arena_allocator->allocator, arena_allocator__trim__allocator );
+    }
+
+    /* The base mark is taken after allocator__create has carved the Allocator structure out of the first chunk, so
+     * arena_allocator__reset rewinds to just past it. */
+    arena_allocator->base_mark = arena_allocator__mark( arena_allocator );
+    arena_allocator->last_allocation = NULL;
+}
+
+void arena_allocator__deinitialize( ArenaAllocator *arena_allocator ){
+    if( arena_allocator != NULL ){
+        allocator__destroy( arena_allocator->allocator );
+
+        ArenaAllocator__Chunk *chunk = arena_allocator->first_chunk;
+        while( chunk != NULL ){
+            ArenaAllocator__Chunk *next = chunk->next;
+            allocator__free( arena_allocator->backing_allocator, chunk );
+            chunk = next;
+        }
+
+        arena_allocator->allocator = NULL;
+        arena_allocator->first_chunk = NULL;
+        arena_allocator->current_chunk = NULL;
+        arena_allocator->last_allocation = NULL;
+    }
+}
+
+ArenaAllocator__Mark arena_allocator__mark( ArenaAllocator const *arena_allocator ){
+    return (ArenaAllocator__Mark){
+        .chunk = arena_allocator->current_chunk,
+        .position = arena_allocator->current_chunk != NULL ? arena_allocator->current_chunk->position : 0
+    };
+}
+
+void arena_allocator__rewind( ArenaAllocator *arena_allocator, ArenaAllocator__Mark mark ){
+    RETURN_IF_FAIL( arena_allocator != NULL );
+
+    /* A mark taken before any chunk existed rewinds to the very beginning of the arena. */
+    arena_allocator->current_chunk = mark.chunk != NULL ? mark.chunk : arena_allocator->first_chunk;
+    if( arena_allocator->current_chunk != NULL ){
+        arena_allocator->current_chunk->position = mark.position;
+    }
+
+    arena_allocator->last_allocation = NULL;
+}
+
+void arena_allocator__reset( ArenaAllocator *arena_allocator ){
+    arena_allocator__rewind( arena_allocator, arena_allocator->base_mark );
+}
+
+bool arena_allocator__trim( ArenaAllocator *arena_allocator ){
+    if( arena_allocator == NULL || arena_allocator->current_chunk == NULL ){
+        return false;
+    }
+
+    /* Only chunks following the current chunk are unused. Earlier chunks hold allocations which are still live. */
+    ArenaAllocator__Chunk *chunk = arena_allocator->current_chunk->next;
+    arena_allocator->current_chunk->next = NULL;
+
+    bool released = chunk != NULL;
+    while( chunk != NULL ){
+        ArenaAllocator__Chunk *next = chunk->next;
+        allocator__free( arena_allocator->backing_allocator, chunk );
+        chunk = next;
+    }
+
+    return released;
+}
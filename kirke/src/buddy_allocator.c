@@ -0,0 +1,353 @@
+#if defined( __APPLE__ )
+#define _DARWIN_C_SOURCE // MAP_ANONYMOUS
+#else
+#define _DEFAULT_SOURCE // MAP_ANONYMOUS
+#endif
+
+// System Includes
+#include <stdint.h> // uintptr_t
+#include <string.h> // memcpy
+#include <sys/mman.h>
+
+// Internal Includes
+#include "kirke/buddy_allocator.h"
+#include "kirke/math.h"
+
+/**
+ *  \brief The header at the start of every block, whether allocated or free.
+ */
+typedef struct BuddyAllocator__Block {
+    /**
+     *  The number of bytes requested for an allocated block.
+     */
+    unsigned long long size;
+    /**
+     *  The order of the block, whose size is \ref BUDDY_ALLOCATOR__MINIMUM_BLOCK_SIZE << order.
+     */
+    unsigned int order;
+    /**
+     *  Non-zero if the block is on a free list.
+     */
+    unsigned int free;
+} BuddyAllocator__Block;
+
+/**
+ *  \brief A free block, which links itself into the free list for its order through the bytes after its header.
+ */
+struct BuddyAllocator__FreeBlock {
+    BuddyAllocator__Block block;
+    BuddyAllocator__FreeBlock *next;
+    BuddyAllocator__FreeBlock *previous;
+};
+
+/**
+ *  \brief The number of bytes in front of every allocation, which keeps allocations aligned to 16 bytes.
+ */
+#define BUDDY_ALLOCATOR__HEADER_SIZE 16ULL
+
+/**
+ *  \brief The alignment of the start of the managed region.
+ */
+#define BUDDY_ALLOCATOR__ALIGNMENT 16ULL
+
+static unsigned long long buddy_allocator__block_size( unsigned int order ){
+    return BUDDY_ALLOCATOR__MINIMUM_BLOCK_SIZE << order;
+}
+
+static BuddyAllocator__Block *buddy_allocator__block_at( BuddyAllocator *buddy_allocator, unsigned long long offset ){
+    return (BuddyAllocator__Block*)( buddy_allocator->base + offset );
+}
+
+static unsigned long long buddy_allocator__offset_of( BuddyAllocator *buddy_allocator, void *block ){
+    return (unsigned long long)( (char*) block - buddy_allocator->base );
+}
+
+static void buddy_allocator__free_list__push( BuddyAllocator *buddy_allocator, unsigned long long offset, unsigned int order ){
+    BuddyAllocator__FreeBlock *free_block = (BuddyAllocator__FreeBlock*) buddy_allocator__block_at( buddy_allocator, offset );
+
+    *free_block = (BuddyAllocator__FreeBlock){
+        .block = {
+            .size = 0,
+            .order = order,
+            .free = 1
+        },
+        .next = buddy_allocator->free_lists[ order ],
+        .previous = NULL
+    };
+
+    if( free_block->next != NULL ){
+        free_block->next->previous = free_block;
+    }
+
+    buddy_allocator->free_lists[ order ] = free_block;
+    buddy_allocator->free_block_counts[ order ]++;
+}
+
+static void buddy_allocator__free_list__remove( BuddyAllocator *buddy_allocator, BuddyAllocator__FreeBlock *free_block ){
+    unsigned int order = free_block->block.order;
+
+    if( free_block->previous != NULL ){
+        free_block->previous->next = free_block->next;
+    }
+    else{
+        buddy_allocator->free_lists[ order ] = free_block->next;
+    }
+
+    if( free_block->next != NULL ){
+        free_block->next->previous = free_block->previous;
+    }
+
+    free_block->block.free = 0;
+    buddy_allocator->free_block_counts[ order ]--;
+}
+
+/**
+ *  \brief Finds the buddy of the block at \p offset, if it is free and whole.
+ *  \returns The free buddy, or NULL if the buddy lies beyond the region, is allocated, or has been split.
+ */
+static BuddyAllocator__FreeBlock *buddy_allocator__free_buddy( BuddyAllocator *buddy_allocator, unsigned long long offset, unsigned int order ){
+    if( order + 1 >= BUDDY_ALLOCATOR__ORDER_COUNT ){
+        return NULL;
+    }
+
+    unsigned long long buddy_offset = offset ^ buddy_allocator__block_size( order );
+    if( buddy_offset + buddy_allocator__block_size( order ) > buddy_allocator->size ){
+        return NULL;
+    }
+
+    /* A split buddy starts with a block of a lower order, so its header never matches. */
+    BuddyAllocator__Block *buddy = buddy_allocator__block_at( buddy_allocator, buddy_offset );
+    if( !buddy->free || buddy->order != order ){
+        return NULL;
+    }
+
+    return (BuddyAllocator__FreeBlock*) buddy;
+}
+
+/**
+ *  \returns The order of the smallest block which can hold \p size bytes after its header, or
+ *  \ref BUDDY_ALLOCATOR__ORDER_COUNT if no block is large enough.
+ */
+static unsigned int buddy_allocator__order_for( unsigned long long size ){
+    if( size > buddy_allocator__block_size( BUDDY_ALLOCATOR__ORDER_COUNT - 1 ) - BUDDY_ALLOCATOR__HEADER_SIZE ){
+        return BUDDY_ALLOCATOR__ORDER_COUNT;
+    }
+
+    unsigned int order = 0;
+    while( buddy_allocator__block_size( order ) < size + BUDDY_ALLOCATOR__HEADER_SIZE ){
+        order++;
+    }
+
+    return order;
+}
+
+static void *buddy_allocator__alloc( unsigned long long size, void *allocator_data ){
+    BuddyAllocator *buddy_allocator = (BuddyAllocator*) allocator_data;
+
+    unsigned int order = buddy_allocator__order_for( size );
+
+    unsigned int free_order = order;
+    while( free_order < BUDDY_ALLOCATOR__ORDER_COUNT && buddy_allocator->free_lists[ free_order ] == NULL ){
+        free_order++;
+    }
+
+    if( free_order >= BUDDY_ALLOCATOR__ORDER_COUNT ){
+        return NULL;
+    }
+
+    BuddyAllocator__FreeBlock *free_block = buddy_allocator->free_lists[ free_order ];
+    buddy_allocator__free_list__remove( buddy_allocator, free_block );
+    unsigned long long offset = buddy_allocator__offset_of( buddy_allocator, free_block );
+
+    /* Split the block in halves until it is the right size, freeing each upper half. */
+    while( free_order > order ){
+        free_order--;
+        buddy_allocator__free_list__push( buddy_allocator, offset + buddy_allocator__block_size( free_order ), free_order );
+    }
+
+    BuddyAllocator__Block *block = buddy_allocator__block_at( buddy_allocator, offset );
+    *block = (BuddyAllocator__Block){
+        .size = size,
+        .order = order,
+        .free = 0
+    };
+
+    buddy_allocator->allocated_bytes += buddy_allocator__block_size( order );
+    buddy_allocator->requested_bytes += size;
+
+    return (char*) block + BUDDY_ALLOCATOR__HEADER_SIZE;
+}
+
+static void buddy_allocator__free( void *pointer, void *allocator_data ){
+    BuddyAllocator *buddy_allocator = (BuddyAllocator*) allocator_data;
+
+    RETURN_IF_FAIL( pointer != NULL );
+
+    BuddyAllocator__Block *block = (BuddyAllocator__Block*)( (char*) pointer - BUDDY_ALLOCATOR__HEADER_SIZE );
+    unsigned long long offset = buddy_allocator__offset_of( buddy_allocator, block );
+    unsigned int order = block->order;
+
+    buddy_allocator->allocated_bytes -= buddy_allocator__block_size( order );
+    buddy_allocator->requested_bytes -= block->size;
+
+    /* Merge the block with its buddy for as long as the buddy is free. */
+    BuddyAllocator__FreeBlock *buddy = buddy_allocator__free_buddy( buddy_allocator, offset, order );
+    while( buddy != NULL ){
+        buddy_allocator__free_list__remove( buddy_allocator, buddy );
+        offset = math__min__ullong( offset, buddy_allocator__offset_of( buddy_allocator, buddy ) );
+        order++;
+
+        buddy = buddy_allocator__free_buddy( buddy_allocator, offset, order );
+    }
+
+    buddy_allocator__free_list__push( buddy_allocator, offset, order );
+}
+
+static bool buddy_allocator__try_expand( void *pointer, unsigned long long size, void *allocator_data ){
+    BuddyAllocator *buddy_allocator = (BuddyAllocator*) allocator_data;
+
+    BuddyAllocator__Block *block = (BuddyAllocator__Block*)( (char*) pointer - BUDDY_ALLOCATOR__HEADER_SIZE );
+    unsigned long long offset = buddy_allocator__offset_of( buddy_allocator, block );
+    unsigned int order = buddy_allocator__order_for( size );
+
+    if( order >= BUDDY_ALLOCATOR__ORDER_COUNT ){
+        return false;
+    }
+
+    /* The block can only grow in place if it is the lower half of each larger block, and every upper half is free. */
+    for( unsigned int merge_order = block->order; merge_order < order; merge_order++ ){
+        if( ( offset & buddy_allocator__block_size( merge_order ) ) != 0 || buddy_allocator__free_buddy( buddy_allocator, offset, merge_order ) == NULL ){
+            return false;
+        }
+    }
+
+    for( unsigned int merge_order = block->order; merge_order < order; merge_order++ ){
+        buddy_allocator__free_list__remove( buddy_allocator, buddy_allocator__free_buddy( buddy_allocator, offset, merge_order ) );
+    }
+
+    if( order > block->order ){
+        buddy_allocator->allocated_bytes += buddy_allocator__block_size( order ) - buddy_allocator__block_size( block->order );
+        block->order = order;
+    }
+
+    buddy_allocator->requested_bytes += size;
+    buddy_allocator->requested_bytes -= block->size;
+    block->size = size;
+
+    return true;
+}
+
+static void *buddy_allocator__realloc( void *pointer, unsigned long long size, void *allocator_data ){
+    if( pointer == NULL ){
+        return buddy_allocator__alloc( size, allocator_data );
+    }
+
+    if( buddy_allocator__try_expand( pointer, size, allocator_data ) ){
+        return pointer;
+    }
+
+    void *new_pointer = buddy_allocator__alloc( size, allocator_data );
+    if( new_pointer != NULL ){
+        BuddyAllocator__Block *block = (BuddyAllocator__Block*)( (char*) pointer - BUDDY_ALLOCATOR__HEADER_SIZE );
+        memcpy( new_pointer, pointer, math__min__ullong( block->size, size ) );
+        buddy_allocator__free( pointer, allocator_data );
+    }
+
+    return new_pointer;
+}
+
+void buddy_allocator__initialize( BuddyAllocator *buddy_allocator, void *region, unsigned long long size ){
+    *buddy_allocator = (BuddyAllocator){
+        .allocator = NULL,
+        .base = NULL,
+        .size = 0,
+        .mapping = NULL,
+        .mapping_size = 0,
+        .free_lists = { NULL },
+        .free_block_counts = { 0 },
+        .allocated_bytes = 0,
+        .requested_bytes = 0
+    };
+
+    RETURN_IF_FAIL( region != NULL );
+
+    uintptr_t base = ( (uintptr_t) region + BUDDY_ALLOCATOR__ALIGNMENT - 1 ) & ~( (uintptr_t) BUDDY_ALLOCATOR__ALIGNMENT - 1 );
+    unsigned long long padding = (unsigned long long)( base - (uintptr_t) region );
+    RETURN_IF_FAIL( size > padding );
+
+    buddy_allocator->base = (char*) base;
+    buddy_allocator->size = ( size - padding ) & ~( BUDDY_ALLOCATOR__MINIMUM_BLOCK_SIZE - 1 );
+
+    /* Carve the region into the largest blocks which fit, each of which is aligned to its own size. */
+    unsigned long long offset = 0;
+    for( int order = BUDDY_ALLOCATOR__ORDER_COUNT - 1; order >= 0; order-- ){
+        while( buddy_allocator->size - offset >= buddy_allocator__block_size( (unsigned int) order ) ){
+            buddy_allocator__free_list__push( buddy_allocator, offset, (unsigned int) order );
+            offset += buddy_allocator__block_size( (unsigned int) order );
+        }
+    }
+
+    buddy_allocator->allocator = allocator__create(
+        buddy_allocator__alloc,
+        buddy_allocator__realloc,
+        buddy_allocator__free,
+        NULL,
+        buddy_allocator
+    );
+
+    if( buddy_allocator->allocator != NULL ){
+        allocator__set_try_expand_function( buddy_allocator->allocator, buddy_allocator__try_expand );
+    }
+}
+
+void buddy_allocator__initialize__mapped( BuddyAllocator *buddy_allocator, unsigned long long size ){
+    void *mapping = mmap( NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0 );
+    if( mapping == MAP_FAILED ){
+        buddy_allocator__initialize( buddy_allocator, NULL, 0 );
+        return;
+    }
+
+    buddy_allocator__initialize( buddy_allocator, mapping, size );
+    buddy_allocator->mapping = mapping;
+    buddy_allocator->mapping_size = size;
+}
+
+void buddy_allocator__deinitialize( BuddyAllocator *buddy_allocator ){
+    if( buddy_allocator != NULL ){
+        /* The Allocator structure lives within the region, so releasing the region releases it too. */
+        if( buddy_allocator->mapping != NULL ){
+            munmap( buddy_allocator->mapping, buddy_allocator->mapping_size );
+        }
+
+        buddy_allocator->allocator = NULL;
+        buddy_allocator->base = NULL;
+        buddy_allocator->size = 0;
+        buddy_allocator->mapping = NULL;
+        buddy_allocator->mapping_size = 0;
+    }
+}
+
+void buddy_allocator__statistics( BuddyAllocator const *buddy_allocator, BuddyAllocator__Statistics *out_statistics ){
+    *out_statistics = (BuddyAllocator__Statistics){
+        .total_bytes = buddy_allocator->size,
+        .allocated_bytes = buddy_allocator->allocated_bytes,
+        .requested_bytes = buddy_allocator->requested_bytes,
+        .free_bytes = buddy_allocator->size - buddy_allocator->allocated_bytes,
+        .free_block_count = 0,
+        .largest_free_block = 0,
+        .external_fragmentation = 0.0
+    };
+
+    for( unsigned int order = 0; order < BUDDY_ALLOCATOR__ORDER_COUNT; order++ ){
+        out_statistics->free_block_count += buddy_allocator->free_block_counts[ order ];
+
+        if( buddy_allocator->free_lists[ order ] != NULL ){
+            out_statistics->largest_free_block = buddy_allocator__block_size( order );
+        }
+    }
+
+    if( out_statistics->free_bytes > 0 ){
+        out_statistics->external_fragmentation =
+            1.0 - (double) out_statistics->largest_free_block / (double) out_statistics->free_bytes;
+    }
+}
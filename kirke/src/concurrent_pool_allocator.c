@@ -0,0 +1,569 @@
+// System Includes
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h> // uintptr_t
+#include <string.h> // memcpy, memset
+
+// Internal Includes
+#include "kirke/concurrent_pool_allocator.h"
+#include "kirke/math.h"
+
+/**
+ *  \brief The largest number of objects in a slab, chosen so that the index of every object of every slab fits in 32
+ *  bits, leaving the other 32 bits of the depot's head for its tag.
+ */
+#define CONCURRENT_POOL_ALLOCATOR__MAXIMUM_SLAB_OBJECT_COUNT ( 0xFFFFFFFFULL / CONCURRENT_POOL_ALLOCATOR__MAXIMUM_SLAB_COUNT )
+
+/**
+ *  \brief log2 of the number of entries in the hash table which maps slab addresses to slab indices.
+ */
+#define CONCURRENT_POOL_ALLOCATOR__SLAB_TABLE_BITS 13
+
+/**
+ *  \brief The number of entries in the hash table which maps slab addresses to slab indices. This is twice the
+ *  largest number of slabs, so that the table is never more than half full.
+ */
+#define CONCURRENT_POOL_ALLOCATOR__SLAB_TABLE_SIZE ( 1ULL << CONCURRENT_POOL_ALLOCATOR__SLAB_TABLE_BITS )
+
+/**
+ *  \brief The size of a cache line, by which the depot's shared fields are separated to avoid false sharing.
+ */
+#define CONCURRENT_POOL_ALLOCATOR__CACHE_LINE_SIZE 64
+
+/**
+ *  \brief A linked list of free objects owned by a single thread. Objects are linked through their first bytes.
+ *  When a magazine is pushed onto the depot, the second 8 bytes of its first object hold its object count in the
+ *  upper 32 bits, and the index of the next magazine in the depot in the lower 32 bits.
+ */
+typedef struct ConcurrentPoolAllocator__Magazine {
+    void *head;
+    unsigned long long count;
+} ConcurrentPoolAllocator__Magazine;
+
+/**
+ *  \brief The magazines owned by a single thread. Objects are allocated from, and freed to, \ref loaded. The
+ *  \ref previous magazine absorbs alternating allocations and frees at the boundary of \ref loaded, so that such a
+ *  thread does not visit the depot for every object.
+ */
+typedef struct ConcurrentPoolAllocator__ThreadCache ConcurrentPoolAllocator__ThreadCache;
+
+struct ConcurrentPoolAllocator__ThreadCache {
+    /**
+     *  The depot to which the magazines are returned.
+     */
+    ConcurrentPoolAllocator__Depot *depot;
+    /**
+     *  The neighbouring thread caches registered with \ref depot.
+     */
+    ConcurrentPoolAllocator__ThreadCache *next;
+    ConcurrentPoolAllocator__ThreadCache *previous;
+    ConcurrentPoolAllocator__Magazine loaded;
+    ConcurrentPoolAllocator__Magazine previous_magazine;
+};
+
+struct ConcurrentPoolAllocator__Depot {
+    /**
+     *  The head of the lock-free stack of magazines. The lower 32 bits hold the index of the first object of the top
+     *  magazine, or 0 if the stack is empty. The upper 32 bits hold a tag which is incremented by every push and pop.
+     */
+    _Alignas( CONCURRENT_POOL_ALLOCATOR__CACHE_LINE_SIZE ) atomic_ullong magazines;
+    /**
+     *  The keys of the hash table of slabs. Each entry holds the address of a slab, or 0 if it is unused. Entries
+     *  are only ever added, so they may be read without taking \ref mutex.
+     */
+    _Alignas( CONCURRENT_POOL_ALLOCATOR__CACHE_LINE_SIZE ) atomic_uintptr_t slab_table[ CONCURRENT_POOL_ALLOCATOR__SLAB_TABLE_SIZE ];
+    /**
+     *  The index into \ref slabs of the slab in each entry of \ref slab_table.
+     */
+    unsigned int slab_table_indices[ CONCURRENT_POOL_ALLOCATOR__SLAB_TABLE_SIZE ];
+    /**
+     *  Every slab, in the order in which they were allocated.
+     */
+    char *slabs[ CONCURRENT_POOL_ALLOCATOR__MAXIMUM_SLAB_COUNT ];
+    Allocator *backing_allocator;
+    unsigned long long object_size;
+    unsigned long long slab_size;
+    /**
+     *  The number of objects in each slab.
+     */
+    unsigned long long slab_object_count;
+    /**
+     *  The number of bits by which a slab address is shifted before hashing, which is log2( \ref slab_size ).
+     */
+    unsigned int slab_shift;
+    /**
+     *  The key under which each thread stores its ConcurrentPoolAllocator__ThreadCache.
+     */
+    pthread_key_t thread_cache_key;
+    /**
+     *  Guards \ref slabs, \ref slab_count, \ref slab_cursor, \ref thread_caches and additions to \ref slab_table.
+     */
+    pthread_mutex_t mutex;
+    unsigned long long slab_count;
+    /**
+     *  The number of objects of the most recent slab which have never been allocated.
+     */
+    unsigned long long slab_cursor;
+    /**
+     *  Every registered thread cache.
+     */
+    ConcurrentPoolAllocator__ThreadCache *thread_caches;
+};
+
+static unsigned long long concurrent_pool_allocator__slab_table__hash( ConcurrentPoolAllocator__Depot const *depot, uintptr_t slab ){
+    /* Fibonacci hashing of the slab number, keeping the top bits. */
+    unsigned long long hash = ( (unsigned long long) slab >> depot->slab_shift ) * 0x9E3779B97F4A7C15ULL;
+    return hash >> ( 64 - CONCURRENT_POOL_ALLOCATOR__SLAB_TABLE_BITS );
+}
+
+/**
+ *  \brief Finds the index of the slab containing \p pointer.
+ *  \returns The index into \ref ConcurrentPoolAllocator__Depot::slabs, or -1 if no slab contains \p pointer.
+ */
+static long long concurrent_pool_allocator__slab_index( ConcurrentPoolAllocator__Depot const *depot, void const *pointer ){
+    uintptr_t slab = (uintptr_t) pointer & ~(uintptr_t)( depot->slab_size - 1 );
+
+    unsigned long long entry = concurrent_pool_allocator__slab_table__hash( depot, slab );
+    while( true ){
+        /* Cast away const, which C11 atomic loads do not accept. */
+        uintptr_t key = atomic_load_explicit( (atomic_uintptr_t*) &depot->slab_table[ entry ], memory_order_acquire );
+        if( key == slab ){
+            return depot->slab_table_indices[ entry ];
+        }
+        else if( key == 0 ){
+            return -1;
+        }
+
+        entry = ( entry + 1 ) % CONCURRENT_POOL_ALLOCATOR__SLAB_TABLE_SIZE;
+    }
+}
+
+/**
+ *  \brief Converts a pointer to an object in the slab \p slab_index into its index, which is never 0.
+ */
+static unsigned long long concurrent_pool_allocator__object_index( ConcurrentPoolAllocator__Depot const *depot, unsigned long long slab_index, void const *object ){
+    unsigned long long offset = (unsigned long long)( (char const*) object - depot->slabs[ slab_index ] ) / depot->object_size;
+    return 1 + slab_index * depot->slab_object_count + offset;
+}
+
+/**
+ *  \brief Converts an index produced by concurrent_pool_allocator__object_index back into a pointer.
+ */
+static void *concurrent_pool_allocator__object( ConcurrentPoolAllocator__Depot const *depot, unsigned long long object_index ){
+    object_index--;
+    return depot->slabs[ object_index / depot->slab_object_count ] + ( object_index % depot->slab_object_count ) * depot->object_size;
+}
+
+/**
+ *  \brief Pushes a magazine onto the depot's lock-free stack.
+ */
+static void concurrent_pool_allocator__depot__push( ConcurrentPoolAllocator__Depot *depot, ConcurrentPoolAllocator__Magazine magazine ){
+    unsigned long long *link = (unsigned long long*) magazine.head + 1;
+    unsigned long long object_index = concurrent_pool_allocator__object_index(
+        depot,
+        (unsigned long long) concurrent_pool_allocator__slab_index( depot, magazine.head ),
+        magazine.head
+    );
+
+    unsigned long long head = atomic_load_explicit( &depot->magazines, memory_order_relaxed );
+    unsigned long long new_head;
+    do{
+        *link = ( magazine.count << 32 ) | ( head & 0xFFFFFFFFULL );
+        new_head = ( ( ( head >> 32 ) + 1 ) << 32 ) | object_index;
+    } while( atomic_compare_exchange_weak_explicit( &depot->magazines, &head, new_head, memory_order_release, memory_order_relaxed ) == false );
+}
+
+/**
+ *  \brief Pops a magazine from the depot's lock-free stack.
+ *  \returns Returns true if a magazine was popped into \p out__magazine.
+ *  \returns Returns false if the depot is empty.
+ */
+static bool concurrent_pool_allocator__depot__pop( ConcurrentPoolAllocator__Depot *depot, ConcurrentPoolAllocator__Magazine *out__magazine ){
+    unsigned long long head = atomic_load_explicit( &depot->magazines, memory_order_acquire );
+    unsigned long long link;
+    void *object;
+    do{
+        if( ( head & 0xFFFFFFFFULL ) == 0 ){
+            return false;
+        }
+
+        /* If another thread pops this magazine first, the link may be overwritten while it is read. The tag of the
+         * head then differs, so the exchange fails and the link is discarded. Slabs are never freed while the
+         * allocator is in use, so the read itself is always safe. */
+        object = concurrent_pool_allocator__object( depot, head & 0xFFFFFFFFULL );
+        link = *( (unsigned long long volatile*) object + 1 );
+    } while( atomic_compare_exchange_weak_explicit(
+        &depot->magazines,
+        &head,
+        ( ( ( head >> 32 ) + 1 ) << 32 ) | ( link & 0xFFFFFFFFULL ),
+        memory_order_acquire,
+        memory_order_acquire
+    ) == false );
+
+    out__magazine->head = object;
+    out__magazine->count = link >> 32;
+
+    return true;
+}
+
+/**
+ *  \brief Allocates a new slab from the backing allocator, and records it in the hash table of slabs.
+ *  \note The caller must hold the depot's mutex.
+ */
+static bool concurrent_pool_allocator__depot__add_slab( ConcurrentPoolAllocator__Depot *depot ){
+    if( depot->slab_count == CONCURRENT_POOL_ALLOCATOR__MAXIMUM_SLAB_COUNT ){
+        return false;
+    }
+
+    char *slab = (char*) allocator__alloc_aligned( depot->backing_allocator, depot->slab_size, depot->slab_size );
+    if( slab == NULL ){
+        return false;
+    }
+
+    unsigned long long entry = concurrent_pool_allocator__slab_table__hash( depot, (uintptr_t) slab );
+    while( atomic_load_explicit( &depot->slab_table[ entry ], memory_order_relaxed ) != 0 ){
+        entry = ( entry + 1 ) % CONCURRENT_POOL_ALLOCATOR__SLAB_TABLE_SIZE;
+    }
+
+    depot->slabs[ depot->slab_count ] = slab;
+    depot->slab_table_indices[ entry ] = (unsigned int) depot->slab_count;
+    atomic_store_explicit( &depot->slab_table[ entry ], (uintptr_t) slab, memory_order_release );
+
+    depot->slab_count++;
+    depot->slab_cursor = 0;
+
+    return true;
+}
+
+/**
+ *  \brief Carves up to a magazine of objects which have never been allocated from the most recent slab, allocating
+ *  a new slab if it is exhausted.
+ */
+static bool concurrent_pool_allocator__depot__carve( ConcurrentPoolAllocator__Depot *depot, ConcurrentPoolAllocator__Magazine *magazine ){
+    pthread_mutex_lock( &depot->mutex );
+
+    if( ( depot->slab_count == 0 || depot->slab_cursor == depot->slab_object_count ) && concurrent_pool_allocator__depot__add_slab( depot ) == false ){
+        pthread_mutex_unlock( &depot->mutex );
+        return false;
+    }
+
+    char *slab = depot->slabs[ depot->slab_count - 1 ];
+    unsigned long long count = math__min__ullong( CONCURRENT_POOL_ALLOCATOR__MAGAZINE_SIZE, depot->slab_object_count - depot->slab_cursor );
+    unsigned long long first = depot->slab_cursor;
+    depot->slab_cursor += count;
+
+    pthread_mutex_unlock( &depot->mutex );
+
+    /* Link the objects in ascending order, so that they are handed out in address order. */
+    for( unsigned long long object_index = first + count; object_index > first; object_index-- ){
+        void *object = slab + ( object_index - 1 ) * depot->object_size;
+        *(void**) object = magazine->head;
+        magazine->head = object;
+    }
+    magazine->count = count;
+
+    return true;
+}
+
+static void concurrent_pool_allocator__thread_cache__flush( ConcurrentPoolAllocator__ThreadCache *thread_cache ){
+    if( thread_cache->loaded.count > 0 ){
+        concurrent_pool_allocator__depot__push( thread_cache->depot, thread_cache->loaded );
+    }
+    if( thread_cache->previous_magazine.count > 0 ){
+        concurrent_pool_allocator__depot__push( thread_cache->depot, thread_cache->previous_magazine );
+    }
+
+    thread_cache->loaded = (ConcurrentPoolAllocator__Magazine){ .head = NULL, .count = 0 };
+    thread_cache->previous_magazine = (ConcurrentPoolAllocator__Magazine){ .head = NULL, .count = 0 };
+}
+
+/**
+ *  \brief Called by pthreads when a thread which used the allocator exits.
+ */
+static void concurrent_pool_allocator__thread_cache__destroy( void *thread_cache_pointer ){
+    ConcurrentPoolAllocator__ThreadCache *thread_cache = (ConcurrentPoolAllocator__ThreadCache*) thread_cache_pointer;
+    ConcurrentPoolAllocator__Depot *depot = thread_cache->depot;
+
+    concurrent_pool_allocator__thread_cache__flush( thread_cache );
+
+    pthread_mutex_lock( &depot->mutex );
+    if( thread_cache->previous != NULL ){
+        thread_cache->previous->next = thread_cache->next;
+    }
+    else{
+        depot->thread_caches = thread_cache->next;
+    }
+    if( thread_cache->next != NULL ){
+        thread_cache->next->previous = thread_cache->previous;
+    }
+    pthread_mutex_unlock( &depot->mutex );
+
+    allocator__free( depot->backing_allocator, thread_cache );
+}
+
+static ConcurrentPoolAllocator__ThreadCache *concurrent_pool_allocator__thread_cache( ConcurrentPoolAllocator__Depot *depot ){
+    ConcurrentPoolAllocator__ThreadCache *thread_cache = (ConcurrentPoolAllocator__ThreadCache*) pthread_getspecific( depot->thread_cache_key );
+
+    if( thread_cache == NULL ){
+        thread_cache = (ConcurrentPoolAllocator__ThreadCache*) allocator__calloc( depot->backing_allocator, 1, sizeof( ConcurrentPoolAllocator__ThreadCache ) );
+        if( thread_cache == NULL ){
+            return NULL;
+        }
+
+        thread_cache->depot = depot;
+
+        pthread_mutex_lock( &depot->mutex );
+        thread_cache->next = depot->thread_caches;
+        if( depot->thread_caches != NULL ){
+            depot->thread_caches->previous = thread_cache;
+        }
+        depot->thread_caches = thread_cache;
+        pthread_mutex_unlock( &depot->mutex );
+
+        pthread_setspecific( depot->thread_cache_key, thread_cache );
+    }
+
+    return thread_cache;
+}
+
+static void *concurrent_pool_allocator__alloc( unsigned long long size, void *allocator_data ){
+    ConcurrentPoolAllocator__Depot *depot = (ConcurrentPoolAllocator__Depot*) allocator_data;
+
+    if( size > depot->object_size ){
+        return allocator__alloc( depot->backing_allocator, size );
+    }
+
+    ConcurrentPoolAllocator__ThreadCache *thread_cache = concurrent_pool_allocator__thread_cache( depot );
+    if( thread_cache == NULL ){
+        return NULL;
+    }
+
+    ConcurrentPoolAllocator__Magazine *loaded = &thread_cache->loaded;
+    if( loaded->count == 0 ){
+        if( thread_cache->previous_magazine.count > 0 ){
+            *loaded = thread_cache->previous_magazine;
+            thread_cache->previous_magazine = (ConcurrentPoolAllocator__Magazine){ .head = NULL, .count = 0 };
+        }
+        else if( concurrent_pool_allocator__depot__pop( depot, loaded ) == false && concurrent_pool_allocator__depot__carve( depot, loaded ) == false ){
+            return NULL;
+        }
+    }
+
+    void *object = loaded->head;
+    loaded->head = *(void**) object;
+    loaded->count--;
+
+    return object;
+}
+
+/**
+ *  \brief Returns an object, which is known to have been served from a slab, to the calling thread's magazines.
+ */
+static void concurrent_pool_allocator__free__object( ConcurrentPoolAllocator__Depot *depot, void *object ){
+    ConcurrentPoolAllocator__ThreadCache *thread_cache = concurrent_pool_allocator__thread_cache( depot );
+    if( thread_cache == NULL ){
+        /* Without a cache, return the object directly to the depot, as a magazine of its own. */
+        *(void**) object = NULL;
+        concurrent_pool_allocator__depot__push( depot, (ConcurrentPoolAllocator__Magazine){ .head = object, .count = 1 } );
+        return;
+    }
+
+    ConcurrentPoolAllocator__Magazine *loaded = &thread_cache->loaded;
+    if( loaded->count == CONCURRENT_POOL_ALLOCATOR__MAGAZINE_SIZE ){
+        if( thread_cache->previous_magazine.count > 0 ){
+            concurrent_pool_allocator__depot__push( depot, thread_cache->previous_magazine );
+        }
+
+        thread_cache->previous_magazine = *loaded;
+        *loaded = (ConcurrentPoolAllocator__Magazine){ .head = NULL, .count = 0 };
+    }
+
+    *(void**) object = loaded->head;
+    loaded->head = object;
+    loaded->count++;
+}
+
+static void concurrent_pool_allocator__free( void *pointer, void *allocator_data ){
+    ConcurrentPoolAllocator__Depot *depot = (ConcurrentPoolAllocator__Depot*) allocator_data;
+
+    if( pointer == NULL ){
+        return;
+    }
+
+    if( concurrent_pool_allocator__slab_index( depot, pointer ) >= 0 ){
+        concurrent_pool_allocator__free__object( depot, pointer );
+    }
+    else{
+        allocator__free( depot->backing_allocator, pointer );
+    }
+}
+
+/**
+ *  \brief Frees an object whose size is known. Requests no larger than the object size are always served from the
+ *  slabs, so such objects are returned to the magazines without looking up their slab.
+ */
+static void concurrent_pool_allocator__free_sized( void *pointer, unsigned long long size, void *allocator_data ){
+    ConcurrentPoolAllocator__Depot *depot = (ConcurrentPoolAllocator__Depot*) allocator_data;
+
+    if( pointer == NULL ){
+        return;
+    }
+
+    if( size <= depot->object_size ){
+        concurrent_pool_allocator__free__object( depot, pointer );
+    }
+    else{
+        allocator__free( depot->backing_allocator, pointer );
+    }
+}
+
+static void *concurrent_pool_allocator__realloc( void *pointer, unsigned long long size, void *allocator_data ){
+    ConcurrentPoolAllocator__Depot *depot = (ConcurrentPoolAllocator__Depot*) allocator_data;
+
+    if( pointer == NULL ){
+        return concurrent_pool_allocator__alloc( size, allocator_data );
+    }
+
+    if( concurrent_pool_allocator__slab_index( depot, pointer ) < 0 ){
+        if( size > depot->object_size ){
+            return allocator__realloc( depot->backing_allocator, pointer, size );
+        }
+
+        /* Move shrinking requests into the slabs, so that concurrent_pool_allocator__free_sized can rely on their size. */
+        void *object = concurrent_pool_allocator__alloc( size, allocator_data );
+        if( object != NULL ){
+            memcpy( object, pointer, size );
+            allocator__free( depot->backing_allocator, pointer );
+        }
+
+        return object;
+    }
+
+    if( size <= depot->object_size ){
+        return pointer;
+    }
+
+    void *new_memory = allocator__alloc( depot->backing_allocator, size );
+    if( new_memory != NULL ){
+        memcpy( new_memory, pointer, depot->object_size );
+        concurrent_pool_allocator__free__object( depot, pointer );
+    }
+
+    return new_memory;
+}
+
+void concurrent_pool_allocator__initialize(
+    ConcurrentPoolAllocator *concurrent_pool_allocator,
+    Allocator *backing_allocator,
+    unsigned long long object_size,
+    unsigned long long slab_size
+){
+    /* Objects in the depot store the next link of their magazine, and the link to the next magazine, in their
+     * first 16 bytes. */
+    object_size = math__max__ullong( object_size, 16 );
+    object_size = ( object_size + 7 ) & ~7ULL;
+
+    if( slab_size == 0 ){
+        slab_size = CONCURRENT_POOL_ALLOCATOR__DEFAULT_SLAB_SIZE;
+    }
+
+    unsigned int slab_shift = 0;
+    while( ( 1ULL << slab_shift ) < math__max__ullong( slab_size, object_size ) ){
+        slab_shift++;
+    }
+    while( ( 1ULL << slab_shift ) / object_size > CONCURRENT_POOL_ALLOCATOR__MAXIMUM_SLAB_OBJECT_COUNT ){
+        slab_shift--;
+    }
+
+    ConcurrentPoolAllocator__Depot *depot = (ConcurrentPoolAllocator__Depot*) allocator__alloc_aligned(
+        backing_allocator,
+        sizeof( ConcurrentPoolAllocator__Depot ),
+        CONCURRENT_POOL_ALLOCATOR__CACHE_LINE_SIZE
+    );
+
+    *concurrent_pool_allocator = (ConcurrentPoolAllocator){
+        .allocator = NULL,
+        .backing_allocator = backing_allocator,
+        .object_size = object_size,
+        .slab_size = 1ULL << slab_shift,
+        .depot = depot
+    };
+
+    RETURN_IF_FAIL( depot != NULL );
+
+    memset( depot, 0, sizeof( ConcurrentPoolAllocator__Depot ) );
+    atomic_init( &depot->magazines, 0 );
+    for( unsigned long long entry = 0; entry < CONCURRENT_POOL_ALLOCATOR__SLAB_TABLE_SIZE; entry++ ){
+        atomic_init( &depot->slab_table[ entry ], 0 );
+    }
+
+    depot->backing_allocator = backing_allocator;
+    depot->object_size = object_size;
+    depot->slab_size = 1ULL << slab_shift;
+    depot->slab_object_count = depot->slab_size / object_size;
+    depot->slab_shift = slab_shift;
+    pthread_key_create( &depot->thread_cache_key, concurrent_pool_allocator__thread_cache__destroy );
+    pthread_mutex_init( &depot->mutex, NULL );
+
+    concurrent_pool_allocator->allocator = allocator__create(
+        concurrent_pool_allocator__alloc,
+        concurrent_pool_allocator__realloc,
+        concurrent_pool_allocator__free,
+        NULL,
+        depot
+    );
+
+    if( concurrent_pool_allocator->allocator != NULL ){
+        allocator__set_free_sized_function( concurrent_pool_allocator->allocator, concurrent_pool_allocator__free_sized );
+    }
+}
+
+void concurrent_pool_allocator__deinitialize( ConcurrentPoolAllocator *concurrent_pool_allocator ){
+    RETURN_IF_FAIL( concurrent_pool_allocator != NULL && concurrent_pool_allocator->depot != NULL );
+
+    ConcurrentPoolAllocator__Depot *depot = concurrent_pool_allocator->depot;
+
+    allocator__destroy( concurrent_pool_allocator->allocator );
+
+    /* Deleting the key ensures that threads which exit later do not touch the depot. */
+    pthread_key_delete( depot->thread_cache_key );
+
+    ConcurrentPoolAllocator__ThreadCache *thread_cache = depot->thread_caches;
+    while( thread_cache != NULL ){
+        ConcurrentPoolAllocator__ThreadCache *next = thread_cache->next;
+        allocator__free( depot->backing_allocator, thread_cache );
+        thread_cache = next;
+    }
+
+    for( unsigned long long slab_index = 0; slab_index < depot->slab_count; slab_index++ ){
+        allocator__free_aligned( depot->backing_allocator, depot->slabs[ slab_index ] );
+    }
+
+    pthread_mutex_destroy( &depot->mutex );
+
+    allocator__free_aligned( concurrent_pool_allocator->backing_allocator, depot );
+
+    concurrent_pool_allocator->allocator = NULL;
+    concurrent_pool_allocator->depot = NULL;
+}
+
+void concurrent_pool_allocator__flush( ConcurrentPoolAllocator *concurrent_pool_allocator ){
+    RETURN_IF_FAIL( concurrent_pool_allocator != NULL && concurrent_pool_allocator->depot != NULL );
+
+    ConcurrentPoolAllocator__ThreadCache *thread_cache = (ConcurrentPoolAllocator__ThreadCache*) pthread_getspecific(
+        concurrent_pool_allocator->depot->thread_cache_key
+    );
+
+    if( thread_cache != NULL ){
+        concurrent_pool_allocator__thread_cache__flush( thread_cache );
+    }
+}
+
+bool concurrent_pool_allocator__owns( ConcurrentPoolAllocator const *concurrent_pool_allocator, void const *pointer ){
+    if( concurrent_pool_allocator->depot == NULL ){
+        return false;
+    }
+
+    return concurrent_pool_allocator__slab_index( concurrent_pool_allocator->depot, pointer ) >= 0;
+}
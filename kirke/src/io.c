@@ -38,9 +38,11 @@ bool io__read_text_file( Allocator* allocator, String file_path, String *out__st
 void io__read_stdin( Allocator* allocator, String *out__string ){
     string__initialize( out__string, allocator, 0 );
 
+    /* Every byte of new capacity is about to be overwritten, so zeroing it first would be wasted work. */
     AutoString auto_string = {
         .string = out__string,
-        .allocator = allocator
+        .allocator = allocator,
+        .uninitialized_growth = true
     };
 
     char buffer[ 1024 ];
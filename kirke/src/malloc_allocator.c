@@ -0,0 +1,29 @@
+#if defined( __linux__ )
+#define _DEFAULT_SOURCE // posix_memalign
+#endif
+
+// System Includes
+#include <stdlib.h> // posix_memalign
+
+// Internal Includes
+#include "kirke/malloc_allocator.h"
+
+void *malloc_allocator__alloc_aligned( Allocator *allocator, unsigned long long size, unsigned long long alignment ){
+    (void) allocator;
+
+    if( alignment == 0 || ( alignment & ( alignment - 1 ) ) != 0 ){
+        return NULL;
+    }
+
+    /* posix_memalign requires a multiple of the size of a pointer. */
+    if( alignment < sizeof( void* ) ){
+        alignment = sizeof( void* );
+    }
+
+    void *pointer = NULL;
+    if( posix_memalign( &pointer, alignment, size ) != 0 ){
+        return NULL;
+    }
+
+    return pointer;
+}
@@ -0,0 +1,156 @@
+// System Includes
+#include <stdatomic.h>
+#include <stdio.h> // fopen, fgets, sscanf, fclose
+
+// Internal Includes
+#include "kirke/memory_pressure.h"
+
+/**
+ *  \brief The number of times memory pressure has been signalled, by any thread.
+ */
+static atomic_ullong memory_pressure__signal_count = 0;
+
+/**
+ *  \brief The handlers registered by the current thread, and the signal count it last handled. Only the owning
+ *  thread ever walks its list, so no lock is needed.
+ */
+static _Thread_local MemoryPressure__Handler *memory_pressure__handlers = NULL;
+static _Thread_local unsigned long long memory_pressure__handled_signal_count = 0;
+
+static void memory_pressure__link( MemoryPressure__Handler *handler ){
+    /* A thread registering its first handler has nothing to give back for signals which came before it. */
+    if( memory_pressure__handlers == NULL ){
+        memory_pressure__handled_signal_count = atomic_load_explicit( &memory_pressure__signal_count, memory_order_acquire );
+    }
+
+    handler->previous = NULL;
+    handler->next = memory_pressure__handlers;
+    if( memory_pressure__handlers != NULL ){
+        memory_pressure__handlers->previous = handler;
+    }
+    memory_pressure__handlers = handler;
+}
+
+void memory_pressure__register( MemoryPressure__Handler *handler, void ( *callback )( void *data ), void *data ){
+    RETURN_IF_FAIL( handler != NULL && callback != NULL );
+
+    handler->callback = callback;
+    handler->data = data;
+    handler->allocator = NULL;
+    memory_pressure__link( handler );
+}
+
+void memory_pressure__register__allocator( MemoryPressure__Handler *handler, Allocator *allocator ){
+    RETURN_IF_FAIL( handler != NULL && allocator != NULL );
+
+    handler->callback = NULL;
+    handler->data = NULL;
+    handler->allocator = allocator;
+    memory_pressure__link( handler );
+}
+
+void memory_pressure__unregister( MemoryPressure__Handler *handler ){
+    RETURN_IF_FAIL( handler != NULL );
+
+    if( handler->previous != NULL ){
+        handler->previous->next = handler->next;
+    }
+    else if( memory_pressure__handlers == handler ){
+        memory_pressure__handlers = handler->next;
+    }
+
+    if( handler->next != NULL ){
+        handler->next->previous = handler->previous;
+    }
+
+    handler->next = NULL;
+    handler->previous = NULL;
+}
+
+void memory_pressure__signal( void ){
+    atomic_fetch_add_explicit( &memory_pressure__signal_count, 1, memory_order_release );
+    memory_pressure__handle();
+}
+
+bool memory_pressure__handle( void ){
+    unsigned long long signal_count = atomic_load_explicit( &memory_pressure__signal_count, memory_order_acquire );
+    if( signal_count == memory_pressure__handled_signal_count ){
+        return false;
+    }
+    memory_pressure__handled_signal_count = signal_count;
+
+    /* Containers hand their slack back to their allocators first, so that trimming can then release it. */
+    for( MemoryPressure__Handler *handler = memory_pressure__handlers; handler != NULL; handler = handler->next ){
+        if( handler->callback != NULL ){
+            handler->callback( handler->data );
+        }
+    }
+
+    for( MemoryPressure__Handler *handler = memory_pressure__handlers; handler != NULL; handler = handler->next ){
+        if( handler->allocator != NULL ){
+            allocator__trim( handler->allocator );
+        }
+    }
+
+    return true;
+}
+
+bool memory_pressure__read( MemoryPressure__Reading *out_reading ){
+    String file_path = string__literal( MEMORY_PRESSURE__DEFAULT_FILE_PATH );
+    return memory_pressure__read__file( file_path, out_reading );
+}
+
+bool memory_pressure__read__file( String file_path, MemoryPressure__Reading *out_reading ){
+    if( file_path.data == NULL || out_reading == NULL ){
+        return false;
+    }
+
+    FILE* input_file = fopen( file_path.data, "r" );
+    if( input_file == NULL ){
+        return false;
+    }
+
+    *out_reading = (MemoryPressure__Reading){ 0 };
+
+    /* Each line has the form "some avg10=0.00 avg60=0.00 avg300=0.00 total=0". The "full" line may be absent. */
+    bool read_some = false;
+    char line[ 256 ];
+    while( fgets( line, sizeof( line ), input_file ) != NULL ){
+        char kind[ 8 ] = { 0 };
+        MemoryPressure__Averages averages = { 0 };
+        if(
+            sscanf(
+                line,
+                "%7s avg10=%lf avg60=%lf avg300=%lf total=%llu",
+                kind,
+                &averages.avg10,
+                &averages.avg60,
+                &averages.avg300,
+                &averages.total
+            ) != 5
+        ){
+            continue;
+        }
+
+        if( kind[ 0 ] == 's' ){
+            out_reading->some = averages;
+            read_some = true;
+        }
+        else if( kind[ 0 ] == 'f' ){
+            out_reading->full = averages;
+        }
+    }
+
+    fclose( input_file );
+    return read_some;
+}
+
+bool memory_pressure__poll( double some_avg10_threshold ){
+    MemoryPressure__Reading reading;
+    if( !memory_pressure__read( &reading ) || reading.some.avg10 <= some_avg10_threshold ){
+        return false;
+    }
+
+    memory_pressure__signal();
+    return true;
+}
@@ -0,0 +1,308 @@
+// System Includes
+#include <stdint.h> // uintptr_t
+#include <string.h> // memcpy, memmove
+
+// Internal Includes
+#include "kirke/pool_allocator.h"
+#include "kirke/math.h"
+
+/**
+ *  \brief Finds the index of the last slab whose start address is not greater than \p pointer.
+ *  \returns The number of slabs which start at or before \p pointer. If this is 0, then no slab contains
+ *  \p pointer.
+ */
+static unsigned long long pool_allocator__slab_upper_bound( PoolAllocator const *pool_allocator, void const *pointer ){
+    unsigned long long low = 0;
+    unsigned long long high = pool_allocator->slab_count;
+
+    while( low < high ){
+        unsigned long long middle = low + ( high - low ) / 2;
+
+        if( (uintptr_t) pool_allocator->slabs[ middle ] <= (uintptr_t) pointer ){
+            low = middle + 1;
+        }
+        else{
+            high = middle;
+        }
+    }
+
+    return low;
+}
+
+bool pool_allocator__owns( PoolAllocator const *pool_allocator, void const *pointer ){
+    unsigned long long upper_bound = pool_allocator__slab_upper_bound( pool_allocator, pointer );
+
+    if( upper_bound == 0 ){
+        return false;
+    }
+
+    uintptr_t slab = (uintptr_t) pool_allocator->slabs[ upper_bound - 1 ];
+    return (uintptr_t) pointer < slab + pool_allocator->slab_size;
+}
+
+/**
+ *  \brief Allocates a new slab from the backing allocator, and records it in the sorted list of slabs.
+ *  \returns Returns true if a slab was allocated.
+ *  \returns Returns false if the backing allocator is out of memory.
+ */
+static bool pool_allocator__add_slab( PoolAllocator *pool_allocator ){
+    if( pool_allocator->slab_count == pool_allocator->slab_capacity ){
+        unsigned long long slab_capacity = math__max__ullong( 2 * pool_allocator->slab_capacity, 8 );
+
+        /* Cast for C++ compatibility */
+        char **slabs = (char**) allocator__realloc( pool_allocator->backing_allocator, pool_allocator->slabs, slab_capacity * sizeof( char* ) );
+        if( slabs == NULL ){
+            return false;
+        }
+
+        pool_allocator->slabs = slabs;
+        pool_allocator->slab_capacity = slab_capacity;
+    }
+
+    char *slab = (char*) allocator__alloc( pool_allocator->backing_allocator, pool_allocator->slab_size );
+    if( slab == NULL ){
+        return false;
+    }
+
+    unsigned long long index = pool_allocator__slab_upper_bound( pool_allocator, slab );
+    memmove(
+        pool_allocator->slabs + index + 1,
+        pool_allocator->slabs + index,
+        ( pool_allocator->slab_count - index ) * sizeof( char* )
+    );
+    pool_allocator->slabs[ index ] = slab;
+    pool_allocator->slab_count++;
+
+    pool_allocator->slab_cursor = slab;
+    pool_allocator->slab_end = slab + pool_allocator->slab_size - ( pool_allocator->slab_size % pool_allocator->object_size );
+
+    return true;
+}
+
+static void *pool_allocator__alloc( unsigned long long size, void *allocator_data ){
+    PoolAllocator *pool_allocator = (PoolAllocator*) allocator_data;
+
+    if( size > pool_allocator->object_size ){
+        return allocator__alloc( pool_allocator->backing_allocator, size );
+    }
+
+    if( pool_allocator->free_list != NULL ){
+        void *object = pool_allocator->free_list;
+        pool_allocator->free_list = *(void**) object;
+        return object;
+    }
+
+    if( pool_allocator->slab_cursor == pool_allocator->slab_end ){
+        if( pool_allocator__add_slab( pool_allocator ) == false ){
+            return NULL;
+        }
+    }
+
+    void *object = pool_allocator->slab_cursor;
+    pool_allocator->slab_cursor += pool_allocator->object_size;
+
+    return object;
+}
+
+static void pool_allocator__free( void *pointer, void *allocator_data ){
+    PoolAllocator *pool_allocator = (PoolAllocator*) allocator_data;
+
+    if( pointer == NULL ){
+        return;
+    }
+
+    if( pool_allocator__owns( pool_allocator, pointer ) ){
+        *(void**) pointer = pool_allocator->free_list;
+        pool_allocator->free_list = pointer;
+    }
+    else{
+        allocator__free( pool_allocator->backing_allocator, pointer );
+    }
+}
+
+/**
+ *  \brief Frees an object whose size is known. Requests no larger than the object size are always served from the
+ *  slabs, so such objects are returned to the free list without searching the slabs.
+ */
+static void pool_allocator__free_sized( void *pointer, unsigned long long size, void *allocator_data ){
+    PoolAllocator *pool_allocator = (PoolAllocator*) allocator_data;
+
+    if( pointer == NULL ){
+        return;
+    }
+
+    if( size <= pool_allocator->object_size ){
+        *(void**) pointer = pool_allocator->free_list;
+        pool_allocator->free_list = pointer;
+    }
+    else{
+        allocator__free( pool_allocator->backing_allocator, pointer );
+    }
+}
+
+static void *pool_allocator__realloc( void *pointer, unsigned long long size, void *allocator_data ){
+    PoolAllocator *pool_allocator = (PoolAllocator*) allocator_data;
+
+    if( pointer == NULL ){
+        return pool_allocator__alloc( size, allocator_data );
+    }
+
+    if( pool_allocator__owns( pool_allocator, pointer ) == false ){
+        if( size > pool_allocator->object_size ){
+            return allocator__realloc( pool_allocator->backing_allocator, pointer, size );
+        }
+
+        /* Move shrinking requests into the slabs, so that pool_allocator__free_sized can rely on their size. */
+        void *object = pool_allocator__alloc( size, allocator_data );
+        if( object != NULL ){
+            memcpy( object, pointer, size );
+            allocator__free( pool_allocator->backing_allocator, pointer );
+        }
+
+        return object;
+    }
+
+    if( size <= pool_allocator->object_size ){
+        return pointer;
+    }
+
+    void *new_memory = allocator__alloc( pool_allocator->backing_allocator, size );
+    if( new_memory != NULL ){
+        memcpy( new_memory, pointer, pool_allocator->object_size );
+        pool_allocator__free( pointer, allocator_data );
+    }
+
+    return new_memory;
+}
+
+static bool pool_allocator__trim__allocator( void *allocator_data ){
+    return pool_allocator__trim( (PoolAllocator*) allocator_data );
+}
+
+void pool_allocator__initialize(
+    PoolAllocator *pool_allocator,
+    Allocator *backing_allocator,
+    unsigned long long object_size,
+    unsigned long long slab_size
+){
+    /* Freed objects store the next link of the free list in their first bytes. */
+    object_size = math__max__ullong( object_size, sizeof( void* ) );
+    object_size = ( object_size + sizeof( void* ) - 1 ) & ~( sizeof( void* ) - 1 );
+
+    if( slab_size == 0 ){
+        slab_size = POOL_ALLOCATOR__DEFAULT_SLAB_SIZE;
+    }
+
+    *pool_allocator = (PoolAllocator){
+        .allocator = NULL,
+        .backing_allocator = backing_allocator,
+        .object_size = object_size,
+        .slab_size = math__max__ullong( slab_size, object_size ),
+        .free_list = NULL,
+        .slab_cursor = NULL,
+        .slab_end = NULL,
+        .slabs = NULL,
+        .slab_count = 0,
+        .slab_capacity = 0
+    };
+
+    pool_allocator->allocator = allocator__create(
+        pool_allocator__alloc,
+        pool_allocator__realloc,
+        pool_allocator__free,
+        NULL,
+        pool_allocator
+    );
+
+    if( pool_allocator->allocator != NULL ){
+        allocator__set_free_sized_function( pool_allocator->allocator, pool_allocator__free_sized );
+        allocator__set_trim_function( pool_allocator->allocator, pool_allocator__trim__allocator );
+    }
+}
+
+void pool_allocator__deinitialize( PoolAllocator *pool_allocator ){
+    if( pool_allocator != NULL ){
+        allocator__destroy( pool_allocator->allocator );
+
+        for( unsigned long long slab_index = 0; slab_index < pool_allocator->slab_count; slab_index++ ){
+            allocator__free( pool_allocator->backing_allocator, pool_allocator->slabs[ slab_index ] );
+        }
+        allocator__free( pool_allocator->backing_allocator, pool_allocator->slabs );
+
+        pool_allocator->allocator = NULL;
+        pool_allocator->free_list = NULL;
+        pool_allocator->slab_cursor = NULL;
+        pool_allocator->slab_end = NULL;
+        pool_allocator->slabs = NULL;
+        pool_allocator->slab_count = 0;
+        pool_allocator->slab_capacity = 0;
+    }
+}
+
+bool pool_allocator__trim( PoolAllocator *pool_allocator ){
+    if( pool_allocator == NULL || pool_allocator->slab_count == 0 ){
+        return false;
+    }
+
+    /* Cast for C++ compatibility */
+    unsigned long long *free_counts = (unsigned long long*) allocator__calloc(
+        pool_allocator->backing_allocator,
+        pool_allocator->slab_count,
+        sizeof( unsigned long long )
+    );
+    if( free_counts == NULL ){
+        return false;
+    }
+
+    for( void *object = pool_allocator->free_list; object != NULL; object = *(void**) object ){
+        free_counts[ pool_allocator__slab_upper_bound( pool_allocator, object ) - 1 ]++;
+    }
+
+    /* Objects of the current slab which have not been carved yet are free as well. */
+    unsigned long long current_slab_index = pool_allocator->slab_count;
+    if( pool_allocator->slab_end != NULL ){
+        current_slab_index = pool_allocator__slab_upper_bound( pool_allocator, pool_allocator->slab_end - 1 ) - 1;
+        free_counts[ current_slab_index ] += (unsigned long long)( pool_allocator->slab_end - pool_allocator->slab_cursor ) / pool_allocator->object_size;
+    }
+
+    unsigned long long objects_per_slab = pool_allocator->slab_size / pool_allocator->object_size;
+    unsigned long long released_count = 0;
+    for( unsigned long long slab_index = 0; slab_index < pool_allocator->slab_count; slab_index++ ){
+        if( free_counts[ slab_index ] == objects_per_slab ){
+            released_count++;
+        }
+    }
+
+    if( released_count > 0 ){
+        /* Unlink the objects of the released slabs from the free list, preserving the order of the others. */
+        void **link = &pool_allocator->free_list;
+        while( *link != NULL ){
+            void *object = *link;
+            if( free_counts[ pool_allocator__slab_upper_bound( pool_allocator, object ) - 1 ] == objects_per_slab ){
+                *link = *(void**) object;
+            }
+            else{
+                link = (void**) object;
+            }
+        }
+
+        if( current_slab_index < pool_allocator->slab_count && free_counts[ current_slab_index ] == objects_per_slab ){
+            pool_allocator->slab_cursor = NULL;
+            pool_allocator->slab_end = NULL;
+        }
+
+        unsigned long long slab_count = 0;
+        for( unsigned long long slab_index = 0; slab_index < pool_allocator->slab_count; slab_index++ ){
+            if( free_counts[ slab_index ] == objects_per_slab ){
+                allocator__free( pool_allocator->backing_allocator, pool_allocator->slabs[ slab_index ] );
+            }
+            else{
+                pool_allocator->slabs[ slab_count++ ] = pool_allocator->slabs[ slab_index ];
+            }
+        }
+        pool_allocator->slab_count = slab_count;
+    }
+
+    allocator__free( pool_allocator->backing_allocator, free_counts );
+    return released_count > 0;
+}
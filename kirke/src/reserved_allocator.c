@@ -0,0 +1,236 @@
+#if defined( __APPLE__ )
+#define _DARWIN_C_SOURCE // MAP_ANONYMOUS
+#else
+#define _DEFAULT_SOURCE // MAP_ANONYMOUS
+#endif
+
+// System Includes
+#include <stddef.h> // max_align_t
+#include <string.h> // memcpy
+#include <sys/mman.h>
+#include <unistd.h> // sysconf
+
+// Internal Includes
+#include "kirke/reserved_allocator.h"
+#include "kirke/math.h"
+
+/**
+ *  \brief The alignment of every allocation served by a ReservedAllocator.
+ */
+#define RESERVED_ALLOCATOR__ALIGNMENT _Alignof( max_align_t )
+
+/**
+ *  \brief The flags with which pages are mapped. Reserved pages need no swap space until they are committed.
+ */
+#if defined( MAP_NORESERVE )
+#define RESERVED_ALLOCATOR__MAP_FLAGS ( MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE )
+#else
+#define RESERVED_ALLOCATOR__MAP_FLAGS ( MAP_PRIVATE | MAP_ANONYMOUS )
+#endif
+
+static unsigned long long reserved_allocator__round_up( unsigned long long size, unsigned long long granularity ){
+    return ( size + granularity - 1 ) & ~( granularity - 1 );
+}
+
+/**
+ *  Each allocation is preceded by its size, so that realloc knows how many bytes to copy.
+ */
+static unsigned long long *reserved_allocator__allocation__size( void *pointer ){
+    return (unsigned long long*) pointer - 1;
+}
+
+/**
+ *  \brief Makes sure that the first \p size bytes of the range are committed.
+ *  \returns Returns true if they are committed, and false if they lie beyond the reservation, or cannot be committed.
+ */
+static bool reserved_allocator__commit( ReservedAllocator *reserved_allocator, unsigned long long size ){
+    if( size <= reserved_allocator->committed_size ){
+        return true;
+    }
+
+    if( size > reserved_allocator->reserved_size ){
+        return false;
+    }
+
+    unsigned long long committed_size = math__min__ullong(
+        reserved_allocator__round_up( size, RESERVED_ALLOCATOR__COMMIT_GRANULARITY ),
+        reserved_allocator->reserved_size
+    );
+
+    if(
+        mprotect(
+            reserved_allocator->base + reserved_allocator->committed_size,
+            committed_size - reserved_allocator->committed_size,
+            PROT_READ | PROT_WRITE
+        ) != 0
+    ){
+        return false;
+    }
+
+    reserved_allocator->committed_size = committed_size;
+    return true;
+}
+
+static void *reserved_allocator__alloc( unsigned long long size, void *allocator_data ){
+    ReservedAllocator *reserved_allocator = (ReservedAllocator*) allocator_data;
+
+    unsigned long long start = reserved_allocator__round_up(
+        reserved_allocator->position + sizeof( unsigned long long ),
+        RESERVED_ALLOCATOR__ALIGNMENT
+    );
+
+    if( start + size < start || !reserved_allocator__commit( reserved_allocator, start + size ) ){
+        return NULL;
+    }
+
+    void *allocation = reserved_allocator->base + start;
+    *reserved_allocator__allocation__size( allocation ) = size;
+
+    reserved_allocator->position = start + size;
+    reserved_allocator->last_allocation = allocation;
+
+    return allocation;
+}
+
+static bool reserved_allocator__try_expand( void *pointer, unsigned long long size, void *allocator_data ){
+    ReservedAllocator *reserved_allocator = (ReservedAllocator*) allocator_data;
+
+    unsigned long long *allocation_size = reserved_allocator__allocation__size( pointer );
+
+    /* The most recent allocation can grow up to the end of the reservation. */
+    if( pointer == reserved_allocator->last_allocation ){
+        unsigned long long start = (unsigned long long)( (char*) pointer - reserved_allocator->base );
+
+        if( start + size < start || !reserved_allocator__commit( reserved_allocator, start + size ) ){
+            return false;
+        }
+
+        reserved_allocator->position = start + size;
+        *allocation_size = size;
+        return true;
+    }
+    else if( size <= *allocation_size ){
+        *allocation_size = size;
+        return true;
+    }
+
+    return false;
+}
+
+static void *reserved_allocator__realloc( void *pointer, unsigned long long size, void *allocator_data ){
+    if( pointer == NULL ){
+        return reserved_allocator__alloc( size, allocator_data );
+    }
+
+    if( reserved_allocator__try_expand( pointer, size, allocator_data ) ){
+        return pointer;
+    }
+
+    void *new_allocation = reserved_allocator__alloc( size, allocator_data );
+    if( new_allocation != NULL ){
+        memcpy( new_allocation, pointer, math__min__ullong( *reserved_allocator__allocation__size( pointer ), size ) );
+    }
+
+    return new_allocation;
+}
+
+static void reserved_allocator__free( void *pointer, void *allocator_data ){
+    ReservedAllocator *reserved_allocator = (ReservedAllocator*) allocator_data;
+
+    /* The bytes of the most recent allocation can be reused. Earlier allocations are only reclaimed in bulk. */
+    if( pointer != NULL && pointer == reserved_allocator->last_allocation ){
+        reserved_allocator->position = (unsigned long long)( (char*) pointer - reserved_allocator->base ) - sizeof( unsigned long long );
+        reserved_allocator->last_allocation = NULL;
+    }
+}
+
+static bool reserved_allocator__trim( void *allocator_data ){
+    ReservedAllocator *reserved_allocator = (ReservedAllocator*) allocator_data;
+    unsigned long long committed_size = reserved_allocator->committed_size;
+    reserved_allocator__decommit( reserved_allocator );
+    return reserved_allocator->committed_size < committed_size;
+}
+
+void reserved_allocator__initialize( ReservedAllocator *reserved_allocator, unsigned long long reserved_size ){
+    unsigned long long page_size = (unsigned long long) sysconf( _SC_PAGESIZE );
+
+    *reserved_allocator = (ReservedAllocator){
+        .allocator = NULL,
+        .base = NULL,
+        .reserved_size = reserved_allocator__round_up( reserved_size, page_size ),
+        .committed_size = 0,
+        .position = 0,
+        .last_allocation = NULL
+    };
+
+    /* The whole range is mapped inaccessible, so that it is reserved without consuming memory. */
+    void *base = mmap( NULL, reserved_allocator->reserved_size, PROT_NONE, RESERVED_ALLOCATOR__MAP_FLAGS, -1, 0 );
+    if( base == MAP_FAILED ){
+        reserved_allocator->reserved_size = 0;
+        return;
+    }
+
+    reserved_allocator->base = (char*) base;
+
+    reserved_allocator->allocator = allocator__create(
+        reserved_allocator__alloc,
+        reserved_allocator__realloc,
+        reserved_allocator__free,
+        NULL,
+        reserved_allocator
+    );
+
+    if( reserved_allocator->allocator != NULL ){
+        allocator__set_try_expand_function( reserved_allocator->allocator, reserved_allocator__try_expand );
+        allocator__set_trim_function( reserved_allocator->allocator, reserved_allocator__trim );
+    }
+
+    /* allocator__create took the Allocator structure from the start of the range. Forgetting it as the last
+     * allocation stops a later realloc or free from moving the position back over it. */
+    reserved_allocator->last_allocation = NULL;
+}
+
+void reserved_allocator__deinitialize( ReservedAllocator *reserved_allocator ){
+    if( reserved_allocator != NULL ){
+        /* The Allocator structure lives within the range, so unmapping the range releases it too. */
+        if( reserved_allocator->base != NULL ){
+            munmap( reserved_allocator->base, reserved_allocator->reserved_size );
+        }
+
+        *reserved_allocator = (ReservedAllocator){
+            .allocator = NULL,
+            .base = NULL,
+            .reserved_size = 0,
+            .committed_size = 0,
+            .position = 0,
+            .last_allocation = NULL
+        };
+    }
+}
+
+void reserved_allocator__decommit( ReservedAllocator *reserved_allocator ){
+    RETURN_IF_FAIL( reserved_allocator != NULL && reserved_allocator->base != NULL );
+
+    unsigned long long committed_size = math__min__ullong(
+        reserved_allocator__round_up( reserved_allocator->position, RESERVED_ALLOCATOR__COMMIT_GRANULARITY ),
+        reserved_allocator->reserved_size
+    );
+
+    if( committed_size >= reserved_allocator->committed_size ){
+        return;
+    }
+
+    /* Mapping fresh inaccessible pages over the tail discards its contents, and so releases its memory. */
+    void *tail = mmap(
+        reserved_allocator->base + committed_size,
+        reserved_allocator->committed_size - committed_size,
+        PROT_NONE,
+        RESERVED_ALLOCATOR__MAP_FLAGS | MAP_FIXED,
+        -1,
+        0
+    );
+
+    if( tail != MAP_FAILED ){
+        reserved_allocator->committed_size = committed_size;
+    }
+}
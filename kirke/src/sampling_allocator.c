@@ -0,0 +1,515 @@
+#if defined( __linux__ )
+    /* Required for dladdr. */
+    #define _GNU_SOURCE
+#endif
+
+// System Includes
+#include <math.h> // exp, log
+#include <pthread.h>
+#include <stdio.h> // fopen, fwrite, fclose, snprintf
+#include <string.h> // memcpy, strrchr
+
+#if defined( __GLIBC__ ) || defined( __APPLE__ )
+    #include <dlfcn.h> // dladdr
+    #include <execinfo.h> // backtrace
+    #define SAMPLING_ALLOCATOR__HAS_BACKTRACE 1
+#endif
+
+// Internal Includes
+#include "kirke/sampling_allocator.h"
+#include "kirke/error.h"
+
+/**
+ *  \brief The size of the header preceding every allocation. This keeps allocations aligned to 16 bytes.
+ */
+#define SAMPLING_ALLOCATOR__HEADER_SIZE 16ULL
+
+/**
+ *  \brief The number of innermost frames of each backtrace which belong to the allocation path rather than to its
+ *  caller: the function which captures the backtrace, the alloc or realloc function called through the vtable, and
+ *  allocator__alloc or allocator__realloc, which calls through the vtable.
+ */
+#define SAMPLING_ALLOCATOR__SKIPPED_FRAME_COUNT 3
+
+#if defined( __GNUC__ )
+    #define SAMPLING_ALLOCATOR__NOINLINE __attribute__(( noinline ))
+#else
+    #define SAMPLING_ALLOCATOR__NOINLINE
+#endif
+
+/**
+ *  \brief A sampled allocation, which is linked into the list of live samples until it is freed.
+ */
+typedef struct SamplingAllocator__Sample SamplingAllocator__Sample;
+
+struct SamplingAllocator__Sample {
+    SamplingAllocator__Sample *next;
+    SamplingAllocator__Sample *previous;
+    /**
+     *  The estimated number of bytes this sample stands for.
+     */
+    unsigned long long weight;
+    unsigned long long depth;
+    void *frames[ SAMPLING_ALLOCATOR__MAXIMUM_DEPTH ];
+};
+
+/**
+ *  \brief The sampling state of a single thread, which is only accessed by that thread.
+ */
+typedef struct SamplingAllocator__ThreadState SamplingAllocator__ThreadState;
+
+struct SamplingAllocator__ThreadState {
+    /**
+     *  The state with which this thread state is registered.
+     */
+    SamplingAllocator__State *state;
+    /**
+     *  The neighbouring thread states registered with \ref state.
+     */
+    SamplingAllocator__ThreadState *next;
+    SamplingAllocator__ThreadState *previous;
+    /**
+     *  The number of bytes which this thread may allocate before the next sample is taken.
+     */
+    long long bytes_until_sample;
+    /**
+     *  The state of this thread's random number generator.
+     */
+    unsigned long long random;
+};
+
+struct SamplingAllocator__State {
+    Allocator *backing_allocator;
+    unsigned long long sample_interval;
+    /**
+     *  The key under which each thread stores its SamplingAllocator__ThreadState.
+     */
+    pthread_key_t thread_state_key;
+    /**
+     *  Guards \ref samples and \ref thread_states.
+     */
+    pthread_mutex_t mutex;
+    /**
+     *  Every live sample.
+     */
+    SamplingAllocator__Sample *samples;
+    /**
+     *  Every registered thread state.
+     */
+    SamplingAllocator__ThreadState *thread_states;
+};
+
+static SamplingAllocator__Sample **sampling_allocator__header( void *pointer ){
+    return (SamplingAllocator__Sample**)( (char*) pointer - SAMPLING_ALLOCATOR__HEADER_SIZE );
+}
+
+/**
+ *  \brief Draws the number of bytes until the next sample from an exponential distribution, so that samples
+ *  form a Poisson process over the allocated bytes.
+ */
+static long long sampling_allocator__thread_state__next_interval( SamplingAllocator__ThreadState *thread_state ){
+    if( thread_state->state->sample_interval <= 1 ){
+        return 0;
+    }
+
+    /* xorshift64 */
+    thread_state->random ^= thread_state->random << 13;
+    thread_state->random ^= thread_state->random >> 7;
+    thread_state->random ^= thread_state->random << 17;
+
+    /* A uniform value in ( 0, 1 ]. */
+    double uniform = (double)( ( thread_state->random >> 11 ) + 1 ) * ( 1.0 / 9007199254740992.0 );
+
+    return (long long)( -log( uniform ) * (double) thread_state->state->sample_interval ) + 1;
+}
+
+/**
+ *  \brief Called by pthreads when a thread which used the allocator exits.
+ */
+static void sampling_allocator__thread_state__destroy( void *thread_state_pointer ){
+    SamplingAllocator__ThreadState *thread_state = (SamplingAllocator__ThreadState*) thread_state_pointer;
+    SamplingAllocator__State *state = thread_state->state;
+
+    pthread_mutex_lock( &state->mutex );
+    if( thread_state->previous != NULL ){
+        thread_state->previous->next = thread_state->next;
+    }
+    else{
+        state->thread_states = thread_state->next;
+    }
+    if( thread_state->next != NULL ){
+        thread_state->next->previous = thread_state->previous;
+    }
+    pthread_mutex_unlock( &state->mutex );
+
+    allocator__free( state->backing_allocator, thread_state );
+}
+
+static SamplingAllocator__ThreadState *sampling_allocator__thread_state( SamplingAllocator__State *state ){
+    SamplingAllocator__ThreadState *thread_state = (SamplingAllocator__ThreadState*) pthread_getspecific( state->thread_state_key );
+
+    if( thread_state == NULL ){
+        thread_state = (SamplingAllocator__ThreadState*) allocator__calloc( state->backing_allocator, 1, sizeof( SamplingAllocator__ThreadState ) );
+        if( thread_state == NULL ){
+            return NULL;
+        }
+
+        thread_state->state = state;
+        /* Seed each thread differently, from the address of its state. xorshift64 must not be seeded with 0. */
+        thread_state->random = ( (unsigned long long) thread_state * 0x9E3779B97F4A7C15ULL ) | 1;
+        thread_state->bytes_until_sample = sampling_allocator__thread_state__next_interval( thread_state );
+
+        pthread_mutex_lock( &state->mutex );
+        thread_state->next = state->thread_states;
+        if( state->thread_states != NULL ){
+            state->thread_states->previous = thread_state;
+        }
+        state->thread_states = thread_state;
+        pthread_mutex_unlock( &state->mutex );
+
+        pthread_setspecific( state->thread_state_key, thread_state );
+    }
+
+    return thread_state;
+}
+
+/**
+ *  \brief Counts an allocation of \p size bytes towards the next sample.
+ *  \returns true if the allocation should be sampled.
+ */
+static bool sampling_allocator__should_sample( SamplingAllocator__State *state, unsigned long long size ){
+    SamplingAllocator__ThreadState *thread_state = sampling_allocator__thread_state( state );
+    if( thread_state == NULL ){
+        return false;
+    }
+
+    thread_state->bytes_until_sample -= (long long) size;
+    if( thread_state->bytes_until_sample > 0 ){
+        return false;
+    }
+
+    thread_state->bytes_until_sample = sampling_allocator__thread_state__next_interval( thread_state );
+    return true;
+}
+
+/**
+ *  \brief Records the call stack of a sampled allocation of \p size bytes, and links it into the list of live
+ *  samples.
+ *  \returns The new sample, or NULL if it could not be allocated.
+ */
+static SAMPLING_ALLOCATOR__NOINLINE SamplingAllocator__Sample *sampling_allocator__sample( SamplingAllocator__State *state, unsigned long long size ){
+    SamplingAllocator__Sample *sample = (SamplingAllocator__Sample*) allocator__alloc( state->backing_allocator, sizeof( SamplingAllocator__Sample ) );
+    if( sample == NULL ){
+        return NULL;
+    }
+
+    /* Each sample stands for the bytes of all the allocations which were skipped in expectation, as in pprof. */
+    double interval = (double) state->sample_interval;
+    double probability = state->sample_interval <= 1 ? 1.0 : 1.0 - exp( -(double) size / interval );
+    sample->weight = probability > 0.0 ? (unsigned long long)( (double) size / probability + 0.5 ) : size;
+
+    sample->depth = 0;
+#if defined( SAMPLING_ALLOCATOR__HAS_BACKTRACE )
+    void *frames[ SAMPLING_ALLOCATOR__MAXIMUM_DEPTH + SAMPLING_ALLOCATOR__SKIPPED_FRAME_COUNT ];
+    int depth = backtrace( frames, SAMPLING_ALLOCATOR__MAXIMUM_DEPTH + SAMPLING_ALLOCATOR__SKIPPED_FRAME_COUNT );
+    if( depth > SAMPLING_ALLOCATOR__SKIPPED_FRAME_COUNT ){
+        sample->depth = depth - SAMPLING_ALLOCATOR__SKIPPED_FRAME_COUNT;
+        memcpy( sample->frames, frames + SAMPLING_ALLOCATOR__SKIPPED_FRAME_COUNT, sample->depth * sizeof( void* ) );
+    }
+#endif
+
+    pthread_mutex_lock( &state->mutex );
+    sample->previous = NULL;
+    sample->next = state->samples;
+    if( state->samples != NULL ){
+        state->samples->previous = sample;
+    }
+    state->samples = sample;
+    pthread_mutex_unlock( &state->mutex );
+
+    return sample;
+}
+
+static void sampling_allocator__forget( SamplingAllocator__State *state, SamplingAllocator__Sample *sample ){
+    pthread_mutex_lock( &state->mutex );
+    if( sample->previous != NULL ){
+        sample->previous->next = sample->next;
+    }
+    else{
+        state->samples = sample->next;
+    }
+    if( sample->next != NULL ){
+        sample->next->previous = sample->previous;
+    }
+    pthread_mutex_unlock( &state->mutex );
+
+    allocator__free( state->backing_allocator, sample );
+}
+
+static void *sampling_allocator__alloc( unsigned long long size, void *allocator_data ){
+    SamplingAllocator__State *state = (SamplingAllocator__State*) allocator_data;
+
+    char *block = (char*) allocator__alloc( state->backing_allocator, SAMPLING_ALLOCATOR__HEADER_SIZE + size );
+    if( block == NULL ){
+        return NULL;
+    }
+
+    void *memory = block + SAMPLING_ALLOCATOR__HEADER_SIZE;
+    *sampling_allocator__header( memory ) = sampling_allocator__should_sample( state, size ) ? sampling_allocator__sample( state, size ) : NULL;
+
+    return memory;
+}
+
+static void sampling_allocator__free( void *pointer, void *allocator_data ){
+    SamplingAllocator__State *state = (SamplingAllocator__State*) allocator_data;
+
+    if( pointer == NULL ){
+        return;
+    }
+
+    SamplingAllocator__Sample *sample = *sampling_allocator__header( pointer );
+    if( sample != NULL ){
+        sampling_allocator__forget( state, sample );
+    }
+
+    allocator__free( state->backing_allocator, sampling_allocator__header( pointer ) );
+}
+
+static void *sampling_allocator__realloc( void *pointer, unsigned long long size, void *allocator_data ){
+    SamplingAllocator__State *state = (SamplingAllocator__State*) allocator_data;
+
+    if( pointer == NULL ){
+        return sampling_allocator__alloc( size, allocator_data );
+    }
+
+    SamplingAllocator__Sample *old_sample = *sampling_allocator__header( pointer );
+
+    char *block = (char*) allocator__realloc( state->backing_allocator, sampling_allocator__header( pointer ), SAMPLING_ALLOCATOR__HEADER_SIZE + size );
+    if( block == NULL ){
+        return NULL;
+    }
+
+    /* A reallocation is treated as a new allocation of the new size, made from the current call site. */
+    if( old_sample != NULL ){
+        sampling_allocator__forget( state, old_sample );
+    }
+
+    void *memory = block + SAMPLING_ALLOCATOR__HEADER_SIZE;
+    *sampling_allocator__header( memory ) = sampling_allocator__should_sample( state, size ) ? sampling_allocator__sample( state, size ) : NULL;
+
+    return memory;
+}
+
+/**
+ *  \brief Appends the name of a stack frame to a String, as a symbol name where one is known, and as module+offset
+ *  otherwise. Characters which are significant in the collapsed-stack format are replaced.
+ */
+static void sampling_allocator__append_frame( void *frame, String *string, Allocator *allocator ){
+    char name[ 256 ];
+    snprintf( name, sizeof( name ), "0x%llx", (unsigned long long) frame );
+
+#if defined( SAMPLING_ALLOCATOR__HAS_BACKTRACE )
+    Dl_info info;
+    if( dladdr( frame, &info ) != 0 ){
+        if( info.dli_sname != NULL ){
+            snprintf( name, sizeof( name ), "%s", info.dli_sname );
+        }
+        else if( info.dli_fname != NULL ){
+            const char *module = strrchr( info.dli_fname, '/' );
+            snprintf(
+                name,
+                sizeof( name ),
+                "%s+0x%llx",
+                module != NULL ? module + 1 : info.dli_fname,
+                (unsigned long long)( (char*) frame - (char*) info.dli_fbase )
+            );
+        }
+    }
+#endif
+
+    for( char *character = name; *character != '\0'; character++ ){
+        if( *character == ';' || *character == ' ' || *character == '\n' ){
+            *character = '_';
+        }
+    }
+
+    string__append__format( string, allocator, "%s", name );
+}
+
+/**
+ *  \brief Trims the backing allocator. Samples are kept until their allocations are freed, so trimming never
+ *  discards any of the profile.
+ */
+static bool sampling_allocator__trim( void *allocator_data ){
+    SamplingAllocator__State *state = (SamplingAllocator__State*) allocator_data;
+    return allocator__trim( state->backing_allocator );
+}
+
+void sampling_allocator__initialize( SamplingAllocator *sampling_allocator, Allocator *backing_allocator, unsigned long long sample_interval ){
+    SamplingAllocator__State *state = (SamplingAllocator__State*) allocator__calloc( backing_allocator, 1, sizeof( SamplingAllocator__State ) );
+
+    if( sample_interval == 0 ){
+        sample_interval = SAMPLING_ALLOCATOR__DEFAULT_SAMPLE_INTERVAL;
+    }
+
+    *sampling_allocator = (SamplingAllocator){
+        .allocator = NULL,
+        .backing_allocator = backing_allocator,
+        .sample_interval = sample_interval,
+        .state = state
+    };
+
+    RETURN_IF_FAIL( state != NULL );
+
+    state->backing_allocator = backing_allocator;
+    state->sample_interval = sample_interval;
+    pthread_key_create( &state->thread_state_key, sampling_allocator__thread_state__destroy );
+    pthread_mutex_init( &state->mutex, NULL );
+
+    sampling_allocator->allocator = allocator__create(
+        sampling_allocator__alloc,
+        sampling_allocator__realloc,
+        sampling_allocator__free,
+        NULL,
+        state
+    );
+
+    if( sampling_allocator->allocator != NULL ){
+        allocator__set_trim_function( sampling_allocator->allocator, sampling_allocator__trim );
+    }
+
+    /* The allocator itself lives as long as the profiler, so it is not worth reporting. */
+    if( sampling_allocator->allocator != NULL ){
+        SamplingAllocator__Sample *sample = *sampling_allocator__header( sampling_allocator->allocator );
+        if( sample != NULL ){
+            sampling_allocator__forget( state, sample );
+            *sampling_allocator__header( sampling_allocator->allocator ) = NULL;
+        }
+    }
+}
+
+void sampling_allocator__deinitialize( SamplingAllocator *sampling_allocator ){
+    RETURN_IF_FAIL( sampling_allocator != NULL && sampling_allocator->state != NULL );
+
+    SamplingAllocator__State *state = sampling_allocator->state;
+
+    allocator__destroy( sampling_allocator->allocator );
+
+    /* Deleting the key ensures that threads which exit later do not touch the state. */
+    pthread_key_delete( state->thread_state_key );
+
+    SamplingAllocator__ThreadState *thread_state = state->thread_states;
+    while( thread_state != NULL ){
+        SamplingAllocator__ThreadState *next = thread_state->next;
+        allocator__free( state->backing_allocator, thread_state );
+        thread_state = next;
+    }
+
+    SamplingAllocator__Sample *sample = state->samples;
+    while( sample != NULL ){
+        SamplingAllocator__Sample *next = sample->next;
+        allocator__free( state->backing_allocator, sample );
+        sample = next;
+    }
+
+    pthread_mutex_destroy( &state->mutex );
+
+    allocator__free( sampling_allocator->backing_allocator, state );
+
+    sampling_allocator->allocator = NULL;
+    sampling_allocator->state = NULL;
+}
+
+unsigned long long sampling_allocator__live_bytes( SamplingAllocator const *sampling_allocator ){
+    RETURN_VALUE_IF_FAIL( sampling_allocator != NULL && sampling_allocator->state != NULL, 0 );
+
+    SamplingAllocator__State *state = sampling_allocator->state;
+    unsigned long long live_bytes = 0;
+
+    pthread_mutex_lock( &state->mutex );
+    for( SamplingAllocator__Sample *sample = state->samples; sample != NULL; sample = sample->next ){
+        live_bytes += sample->weight;
+    }
+    pthread_mutex_unlock( &state->mutex );
+
+    return live_bytes;
+}
+
+void sampling_allocator__append_profile( SamplingAllocator const *sampling_allocator, String *string, Allocator *allocator ){
+    RETURN_IF_FAIL( sampling_allocator != NULL && sampling_allocator->state != NULL && string != NULL );
+
+    SamplingAllocator__State *state = sampling_allocator->state;
+
+    /*
+     *  The samples are copied out before they are formatted, so that the mutex is not held while allocating from
+     *  \p allocator, which may be this SamplingAllocator.
+     */
+    pthread_mutex_lock( &state->mutex );
+    unsigned long long sample_count = 0;
+    for( SamplingAllocator__Sample *sample = state->samples; sample != NULL; sample = sample->next ){
+        sample_count++;
+    }
+
+    SamplingAllocator__Sample *samples = NULL;
+    if( sample_count > 0 ){
+        samples = (SamplingAllocator__Sample*) allocator__alloc( state->backing_allocator, sample_count * sizeof( SamplingAllocator__Sample ) );
+    }
+
+    if( samples != NULL ){
+        unsigned long long sample_index = 0;
+        for( SamplingAllocator__Sample *sample = state->samples; sample != NULL; sample = sample->next ){
+            samples[ sample_index++ ] = *sample;
+        }
+    }
+    pthread_mutex_unlock( &state->mutex );
+
+    RETURN_IF_FAIL( samples != NULL );
+
+    for( unsigned long long sample_index = 0; sample_index < sample_count; sample_index++ ){
+        SamplingAllocator__Sample *sample = &samples[ sample_index ];
+
+        if( sample->depth == 0 ){
+            string__append__format( string, allocator, "[unknown]" );
+        }
+
+        for( unsigned long long frame_index = sample->depth; frame_index > 0; frame_index-- ){
+            sampling_allocator__append_frame( sample->frames[ frame_index - 1 ], string, allocator );
+            if( frame_index > 1 ){
+                string__append__format( string, allocator, ";" );
+            }
+        }
+
+        string__append__format( string, allocator, " %llu\n", sample->weight );
+    }
+
+    allocator__free( state->backing_allocator, samples );
+}
+
+bool sampling_allocator__write_profile( SamplingAllocator const *sampling_allocator, String file_path, Error *error ){
+    RETURN_VALUE_IF_FAIL( sampling_allocator != NULL && sampling_allocator->state != NULL, false );
+
+    FILE *output_file = fopen( file_path.data, "w" );
+
+    if( output_file == NULL ){
+        error__set(
+            error,
+            "SamplingAllocator",
+            SamplingAllocator__Error__UnableToOpenFile,
+            "Unable to open profile file \"%.*s\".", file_path.length, file_path.data
+        );
+
+        return false;
+    }
+
+    String profile = { 0 };
+    sampling_allocator__append_profile( sampling_allocator, &profile, sampling_allocator->backing_allocator );
+
+    if( profile.length > 0 ){
+        fwrite( profile.data, 1, profile.length, output_file );
+    }
+
+    fclose( output_file );
+    allocator__free( sampling_allocator->backing_allocator, profile.data );
+
+    return true;
+}
@@ -0,0 +1,412 @@
+// System Includes
+#include <pthread.h>
+#include <stddef.h> // max_align_t
+#include <stdint.h> // uintptr_t
+#include <stdlib.h> // malloc, free
+#include <string.h> // memcpy
+
+// Internal Includes
+#include "kirke/scratch_allocator.h"
+#include "kirke/log.h"
+#include "kirke/math.h"
+#include "kirke/system_allocator.h"
+
+/**
+ *  \brief The alignment of every allocation served by a ScratchAllocator.
+ */
+#define SCRATCH_ALLOCATOR__ALIGNMENT _Alignof( max_align_t )
+
+/**
+ *  \brief ScratchAllocator__Chunk is the header of a block of memory allocated from the backing allocator.
+ *  Allocations are served from the bytes which directly follow the header.
+ */
+struct ScratchAllocator__Chunk {
+    /**
+     *  The next chunk in the allocator's list of chunks, or NULL if this is the last chunk.
+     */
+    ScratchAllocator__Chunk *next;
+    /**
+     *  The number of bytes available for allocations within this chunk.
+     */
+    unsigned long long capacity;
+    /**
+     *  The number of bytes already in use within this chunk.
+     */
+    unsigned long long position;
+};
+
+/**
+ *  \brief The header which directly precedes every allocation. The headers link the live allocations into a stack.
+ */
+typedef struct ScratchAllocator__Header {
+    /**
+     *  The allocation which was the top of the stack when this allocation was made.
+     */
+    void *previous;
+    /**
+     *  The chunk containing this allocation.
+     */
+    ScratchAllocator__Chunk *chunk;
+    /**
+     *  The size in bytes of this allocation, so that realloc knows how many bytes to copy.
+     */
+    unsigned long long size;
+    /**
+     *  Whether this allocation was freed while other allocations were above it.
+     */
+    bool freed;
+} ScratchAllocator__Header;
+
+/**
+ *  \brief The offset from the start of a chunk to the first byte available for allocations.
+ */
+#define SCRATCH_ALLOCATOR__CHUNK_HEADER_SIZE \
+    ( ( sizeof( ScratchAllocator__Chunk ) + SCRATCH_ALLOCATOR__ALIGNMENT - 1 ) & ~( SCRATCH_ALLOCATOR__ALIGNMENT - 1 ) )
+
+/**
+ *  \brief The number of bytes reserved in front of every allocation for its header.
+ */
+#define SCRATCH_ALLOCATOR__HEADER_SIZE \
+    ( ( sizeof( ScratchAllocator__Header ) + SCRATCH_ALLOCATOR__ALIGNMENT - 1 ) & ~( SCRATCH_ALLOCATOR__ALIGNMENT - 1 ) )
+
+static char *scratch_allocator__chunk__data( ScratchAllocator__Chunk *chunk ){
+    return (char*) chunk + SCRATCH_ALLOCATOR__CHUNK_HEADER_SIZE;
+}
+
+static ScratchAllocator__Header *scratch_allocator__header( void *pointer ){
+    return (ScratchAllocator__Header*)( (char*) pointer - SCRATCH_ALLOCATOR__HEADER_SIZE );
+}
+
+/**
+ *  \brief Attempts to place an allocation of \p size bytes within \p chunk.
+ *  \returns A pointer to the new allocation, or NULL if \p chunk does not have enough room.
+ */
+static void *scratch_allocator__chunk__alloc( ScratchAllocator__Chunk *chunk, unsigned long long size ){
+    uintptr_t data = (uintptr_t) scratch_allocator__chunk__data( chunk );
+    uintptr_t start = ( data + chunk->position + SCRATCH_ALLOCATOR__HEADER_SIZE + SCRATCH_ALLOCATOR__ALIGNMENT - 1 ) & ~( SCRATCH_ALLOCATOR__ALIGNMENT - 1 );
+
+    if( start - data > chunk->capacity || size > chunk->capacity - ( start - data ) ){
+        return NULL;
+    }
+
+    chunk->position = start - data + size;
+
+    return (void*) start;
+}
+
+/**
+ *  \brief Releases the most recent live allocation, along with every allocation beneath it which was already
+ *  freed out of order.
+ */
+static void scratch_allocator__release_top( ScratchAllocator *scratch_allocator ){
+    do{
+        ScratchAllocator__Header *header = scratch_allocator__header( scratch_allocator->top );
+
+        scratch_allocator->current_chunk = header->chunk;
+        scratch_allocator->current_chunk->position = (unsigned long long)( (char*) header - scratch_allocator__chunk__data( header->chunk ) );
+        scratch_allocator->top = header->previous;
+    } while( scratch_allocator->top != NULL && scratch_allocator__header( scratch_allocator->top )->freed );
+}
+
+/**
+ *  \brief Frees \p pointer, without reporting whether it was freed out of order.
+ */
+static void scratch_allocator__release( ScratchAllocator *scratch_allocator, void *pointer ){
+    if( pointer == scratch_allocator->top ){
+        scratch_allocator__release_top( scratch_allocator );
+    }
+    else{
+        scratch_allocator__header( pointer )->freed = true;
+    }
+}
+
+static void *scratch_allocator__alloc( unsigned long long size, void *allocator_data ){
+    ScratchAllocator *scratch_allocator = (ScratchAllocator*) allocator_data;
+
+    /* A chunk large enough for the allocation, its header and its alignment could not be sized. */
+    RETURN_VALUE_IF_FAIL(
+        size <= ~0ULL - SCRATCH_ALLOCATOR__CHUNK_HEADER_SIZE - SCRATCH_ALLOCATOR__HEADER_SIZE - SCRATCH_ALLOCATOR__ALIGNMENT,
+        NULL
+    );
+
+    void *allocation = NULL;
+    if( scratch_allocator->current_chunk != NULL ){
+        allocation = scratch_allocator__chunk__alloc( scratch_allocator->current_chunk, size );
+    }
+
+    /* Chunks following the current chunk were left behind by a release or a pop, and can be reused. */
+    while( allocation == NULL && scratch_allocator->current_chunk != NULL && scratch_allocator->current_chunk->next != NULL ){
+        scratch_allocator->current_chunk = scratch_allocator->current_chunk->next;
+        scratch_allocator->current_chunk->position = 0;
+        allocation = scratch_allocator__chunk__alloc( scratch_allocator->current_chunk, size );
+    }
+
+    if( allocation == NULL ){
+        unsigned long long capacity = math__max__ullong(
+            scratch_allocator->chunk_size,
+            size + SCRATCH_ALLOCATOR__HEADER_SIZE + SCRATCH_ALLOCATOR__ALIGNMENT
+        );
+
+        ScratchAllocator__Chunk *chunk = (ScratchAllocator__Chunk*) allocator__alloc(
+            scratch_allocator->backing_allocator,
+            SCRATCH_ALLOCATOR__CHUNK_HEADER_SIZE + capacity
+        );
+
+        if( chunk == NULL ){
+            return NULL;
+        }
+
+        *chunk = (ScratchAllocator__Chunk){
+            .next = NULL,
+            .capacity = capacity,
+            .position = 0
+        };
+
+        if( scratch_allocator->current_chunk == NULL ){
+            scratch_allocator->first_chunk = chunk;
+        }
+        else{
+            scratch_allocator->current_chunk->next = chunk;
+        }
+
+        scratch_allocator->current_chunk = chunk;
+        allocation = scratch_allocator__chunk__alloc( chunk, size );
+    }
+
+    *scratch_allocator__header( allocation ) = (ScratchAllocator__Header){
+        .previous = scratch_allocator->top,
+        .chunk = scratch_allocator->current_chunk,
+        .size = size,
+        .freed = false
+    };
+
+    scratch_allocator->top = allocation;
+
+    return allocation;
+}
+
+static bool scratch_allocator__try_expand( void *pointer, unsigned long long size, void *allocator_data ){
+    ScratchAllocator *scratch_allocator = (ScratchAllocator*) allocator_data;
+
+    ScratchAllocator__Header *header = scratch_allocator__header( pointer );
+
+    /* The top of the stack can be resized in place, as long as it still fits within the current chunk. */
+    if( pointer == scratch_allocator->top && header->chunk == scratch_allocator->current_chunk ){
+        unsigned long long offset = (unsigned long long)( (char*) pointer - scratch_allocator__chunk__data( header->chunk ) );
+
+        if( size <= header->chunk->capacity - offset ){
+            header->chunk->position = offset + size;
+            header->size = size;
+            return true;
+        }
+    }
+    else if( size <= header->size ){
+        header->size = size;
+        return true;
+    }
+
+    return false;
+}
+
+static void *scratch_allocator__realloc( void *pointer, unsigned long long size, void *allocator_data ){
+    ScratchAllocator *scratch_allocator = (ScratchAllocator*) allocator_data;
+
+    if( pointer == NULL ){
+        return scratch_allocator__alloc( size, allocator_data );
+    }
+
+    if( scratch_allocator__try_expand( pointer, size, allocator_data ) ){
+        return pointer;
+    }
+
+    void *new_allocation = scratch_allocator__alloc( size, allocator_data );
+    if( new_allocation != NULL ){
+        memcpy( new_allocation, pointer, math__min__ullong( scratch_allocator__header( pointer )->size, size ) );
+
+        /* The old allocation now lies beneath the new one, but moving it was not the caller's doing. */
+        scratch_allocator__release( scratch_allocator, pointer );
+    }
+
+    return new_allocation;
+}
+
+static void scratch_allocator__free( void *pointer, void *allocator_data ){
+    ScratchAllocator *scratch_allocator = (ScratchAllocator*) allocator_data;
+
+    RETURN_IF_FAIL( pointer != NULL );
+
+    if( pointer != scratch_allocator->top && scratch_allocator->debug ){
+        scratch_allocator->out_of_order_free_count++;
+        log__error(
+            "scratch_allocator__free:  %p was freed before the more recent allocation %p.",
+            pointer,
+            scratch_allocator->top
+        );
+    }
+
+    scratch_allocator__release( scratch_allocator, pointer );
+}
+
+static bool scratch_allocator__trim__allocator( void *allocator_data ){
+    return scratch_allocator__trim( (ScratchAllocator*) allocator_data );
+}
+
+void scratch_allocator__initialize( ScratchAllocator *scratch_allocator, Allocator *backing_allocator ){
+    scratch_allocator__initialize__options( scratch_allocator, backing_allocator, NULL );
+}
+
+void scratch_allocator__initialize__options(
+    ScratchAllocator *scratch_allocator,
+    Allocator *backing_allocator,
+    ScratchAllocator__Options const *options
+){
+    unsigned long long chunk_size = options != NULL ? options->chunk_size : 0;
+
+    *scratch_allocator = (ScratchAllocator){
+        .allocator = NULL,
+        .backing_allocator = backing_allocator,
+        .chunk_size = chunk_size != 0 ? chunk_size : SCRATCH_ALLOCATOR__DEFAULT_CHUNK_SIZE,
+        .debug = options != NULL ? options->debug : false,
+        .out_of_order_free_count = 0,
+        .first_chunk = NULL,
+        .current_chunk = NULL,
+        .top = NULL
+    };
+
+    scratch_allocator->allocator = allocator__create(
+        scratch_allocator__alloc,
+        scratch_allocator__realloc,
+        scratch_allocator__free,
+        NULL,
+        scratch_allocator
+    );
+
+    if( scratch_allocator->allocator != NULL ){
+        allocator__set_try_expand_function( scratch_allocator->allocator, scratch_allocator__try_expand );
+        allocator__set_trim_function( scratch_allocator->allocator, scratch_allocator__trim__allocator );
+    }
+
+    /* allocator__create pushed the Allocator structure as the first allocation. Emptying the stack leaves it out of
+     * the chain of previous allocations, so no free or pop can walk back to it. */
+    scratch_allocator->top = NULL;
+}
+
+void scratch_allocator__deinitialize( ScratchAllocator *scratch_allocator ){
+    if( scratch_allocator != NULL ){
+        ScratchAllocator__Chunk *chunk = scratch_allocator->first_chunk;
+        while( chunk != NULL ){
+            ScratchAllocator__Chunk *next = chunk->next;
+            allocator__free( scratch_allocator->backing_allocator, chunk );
+            chunk = next;
+        }
+
+        scratch_allocator->allocator = NULL;
+        scratch_allocator->first_chunk = NULL;
+        scratch_allocator->current_chunk = NULL;
+        scratch_allocator->top = NULL;
+    }
+}
+
+ScratchAllocator__Marker scratch_allocator__push( ScratchAllocator const *scratch_allocator ){
+    return (ScratchAllocator__Marker){
+        .chunk = scratch_allocator->current_chunk,
+        .position = scratch_allocator->current_chunk != NULL ? scratch_allocator->current_chunk->position : 0,
+        .top = scratch_allocator->top
+    };
+}
+
+void scratch_allocator__pop( ScratchAllocator *scratch_allocator, ScratchAllocator__Marker marker ){
+    RETURN_IF_FAIL( scratch_allocator != NULL );
+
+    scratch_allocator->current_chunk = marker.chunk != NULL ? marker.chunk : scratch_allocator->first_chunk;
+    if( scratch_allocator->current_chunk != NULL ){
+        scratch_allocator->current_chunk->position = marker.position;
+    }
+
+    scratch_allocator->top = marker.top;
+
+    /* The allocation at the top of the marker may have been freed out of order since the marker was pushed. */
+    if( scratch_allocator->top != NULL && scratch_allocator__header( scratch_allocator->top )->freed ){
+        scratch_allocator__release_top( scratch_allocator );
+    }
+}
+
+bool scratch_allocator__trim( ScratchAllocator *scratch_allocator ){
+    if( scratch_allocator == NULL || scratch_allocator->current_chunk == NULL ){
+        return false;
+    }
+
+    /* Every live allocation lies at or below the current chunk, so the chunks following it are unused. */
+    ScratchAllocator__Chunk *chunk = scratch_allocator->current_chunk->next;
+    scratch_allocator->current_chunk->next = NULL;
+
+    bool released = chunk != NULL;
+    while( chunk != NULL ){
+        ScratchAllocator__Chunk *next = chunk->next;
+        allocator__free( scratch_allocator->backing_allocator, chunk );
+        chunk = next;
+    }
+
+    return released;
+}
+
+/**
+ *  \brief The ScratchAllocator belonging to a single thread, together with the allocator backing it.
+ */
+typedef struct ScratchAllocator__ThreadDefault {
+    SystemAllocator system_allocator;
+    ScratchAllocator scratch_allocator;
+} ScratchAllocator__ThreadDefault;
+
+static pthread_once_t scratch_allocator__thread_default__once = PTHREAD_ONCE_INIT;
+static pthread_key_t scratch_allocator__thread_default__key;
+
+/**
+ *  \brief Called by pthreads when a thread which used its ScratchAllocator exits.
+ */
+static void scratch_allocator__thread_default__destroy( void *thread_default_pointer ){
+    ScratchAllocator__ThreadDefault *thread_default = (ScratchAllocator__ThreadDefault*) thread_default_pointer;
+
+    scratch_allocator__deinitialize( &thread_default->scratch_allocator );
+    system_allocator__deinitialize( &thread_default->system_allocator );
+    free( thread_default );
+}
+
+static void scratch_allocator__thread_default__create_key( void ){
+    pthread_key_create( &scratch_allocator__thread_default__key, scratch_allocator__thread_default__destroy );
+}
+
+ScratchAllocator *scratch_allocator__thread_default( void ){
+    pthread_once( &scratch_allocator__thread_default__once, scratch_allocator__thread_default__create_key );
+
+    ScratchAllocator__ThreadDefault *thread_default = (ScratchAllocator__ThreadDefault*) pthread_getspecific( scratch_allocator__thread_default__key );
+
+    if( thread_default == NULL ){
+        thread_default = (ScratchAllocator__ThreadDefault*) malloc( sizeof( ScratchAllocator__ThreadDefault ) );
+        if( thread_default == NULL ){
+            return NULL;
+        }
+
+        /* Out of order frees are reported in debug builds. */
+        ScratchAllocator__Options options = {
+            .chunk_size = SCRATCH_ALLOCATOR__DEFAULT_CHUNK_SIZE,
+#if defined( NDEBUG )
+            .debug = false
+#else
+            .debug = true
+#endif
+        };
+
+        system_allocator__initialize( &thread_default->system_allocator, NULL );
+        scratch_allocator__initialize__options( &thread_default->scratch_allocator, thread_default->system_allocator.allocator, &options );
+
+        if( thread_default->scratch_allocator.allocator == NULL ){
+            scratch_allocator__thread_default__destroy( thread_default );
+            return NULL;
+        }
+
+        pthread_setspecific( scratch_allocator__thread_default__key, thread_default );
+    }
+
+    return &thread_default->scratch_allocator;
+}
@@ -5,14 +5,12 @@ void split_iterator__initialize( SplitIterator* iterator, String const *string,
     iterator->string = string;
     iterator->delimiter = delimiter;
     iterator->position = 0;
+    string_searcher__initialize( &iterator->searcher, delimiter );
 }
 
 unsigned long long split_iterator__count( SplitIterator const *iterator ){
-    SplitIterator copy = {
-        .string = iterator->string,
-        .delimiter = iterator->delimiter,
-        .position = 0
-    };
+    SplitIterator copy = *iterator;
+    copy.position = 0;
 
     unsigned long long count = 0;
 
@@ -36,7 +34,8 @@ bool split_iterator__next( SplitIterator* iterator, String* out__token ){
     do{
         split_iterator__rest( iterator, out__token );
 
-        if( string__index_of( out__token, iterator->delimiter, &out__token->length ) ){
+        /* An empty delimiter would be found without advancing, so it is never searched for. */
+        if( iterator->delimiter->length > 0 && string_searcher__index_of( &iterator->searcher, out__token, &out__token->length ) ){
             iterator->position += out__token->length + iterator->delimiter->length;
         }
         else{
@@ -0,0 +1,467 @@
+// System Includes
+#include <pthread.h>
+#include <stdatomic.h>
+#include <string.h> // memset
+
+// Internal Includes
+#include "kirke/statistics_allocator.h"
+#include "kirke/math.h"
+
+/**
+ *  \brief The size of the header preceding every allocation. This keeps allocations aligned to 16 bytes.
+ */
+#define STATISTICS_ALLOCATOR__HEADER_SIZE 16ULL
+
+/**
+ *  \brief The call counters of a single thread. Only the owning thread writes to these counters, so they are
+ *  updated with relaxed loads and stores rather than atomic read-modify-write operations, which keeps them as
+ *  cheap as plain increments. Other threads only read them, when a snapshot is taken.
+ */
+typedef struct StatisticsAllocator__Counters StatisticsAllocator__Counters;
+
+struct StatisticsAllocator__Counters {
+    /**
+     *  The state with which these counters are registered.
+     */
+    StatisticsAllocator__State *state;
+    /**
+     *  The neighbouring counters registered with \ref state.
+     */
+    StatisticsAllocator__Counters *next;
+    StatisticsAllocator__Counters *previous;
+    _Atomic unsigned long long alloc_count;
+    _Atomic unsigned long long realloc_count;
+    _Atomic unsigned long long free_count;
+    _Atomic unsigned long long realloc_growth_count;
+    _Atomic unsigned long long bytes_allocated;
+    _Atomic unsigned long long size_histogram[ STATISTICS_ALLOCATOR__HISTOGRAM_SIZE ];
+    /**
+     *  The bytes allocated by this thread, less the bytes it freed, since it last flushed them into
+     *  StatisticsAllocator__State.live_bytes. This is negative in a thread which frees more than it allocates, for
+     *  example the consumer of a queue.
+     */
+    _Atomic long long unflushed_live_bytes;
+    /**
+     *  The largest value \ref unflushed_live_bytes has reached since the last flush, or 0 if it has not been positive.
+     */
+    _Atomic long long unflushed_peak_live_bytes;
+};
+
+struct StatisticsAllocator__State {
+    Allocator *backing_allocator;
+    /**
+     *  The key under which each thread stores its StatisticsAllocator__Counters.
+     */
+    pthread_key_t counters_key;
+    /**
+     *  Guards \ref counters and \ref retired.
+     */
+    pthread_mutex_t mutex;
+    /**
+     *  The counters of every thread which is using this allocator.
+     */
+    StatisticsAllocator__Counters *counters;
+    /**
+     *  The sum of the counters of every thread which has exited.
+     */
+    StatisticsAllocator__Snapshot retired;
+    /**
+     *  The live bytes flushed by every thread. Threads flush once their unflushed live bytes reach
+     *  STATISTICS_ALLOCATOR__FLUSH_THRESHOLD in either direction, and when they exit.
+     */
+    atomic_llong live_bytes;
+    /**
+     *  The largest value \ref live_bytes has reached, counting the peak each flushing thread reached in between.
+     */
+    atomic_ullong peak_live_bytes;
+};
+
+static void statistics_allocator__counter__increment( _Atomic unsigned long long *counter, unsigned long long amount ){
+    atomic_store_explicit( counter, atomic_load_explicit( counter, memory_order_relaxed ) + amount, memory_order_relaxed );
+}
+
+static unsigned long long statistics_allocator__histogram_index( unsigned long long size ){
+    if( size == 0 ){
+        return 0;
+    }
+
+#if defined( __GNUC__ )
+    return 63 - __builtin_clzll( size );
+#else
+    unsigned long long result = 0;
+    while( size >>= 1 ){
+        result++;
+    }
+    return result;
+#endif
+}
+
+static unsigned long long *statistics_allocator__header( void *pointer ){
+    return (unsigned long long*)( (char*) pointer - STATISTICS_ALLOCATOR__HEADER_SIZE );
+}
+
+/**
+ *  \brief Adds one thread's counters to a snapshot. Its live bytes are not added, since they are kept in
+ *  StatisticsAllocator__State.live_bytes once flushed.
+ */
+static void statistics_allocator__counters__merge( StatisticsAllocator__Counters *counters, StatisticsAllocator__Snapshot *snapshot ){
+    snapshot->alloc_count += atomic_load_explicit( &counters->alloc_count, memory_order_relaxed );
+    snapshot->realloc_count += atomic_load_explicit( &counters->realloc_count, memory_order_relaxed );
+    snapshot->free_count += atomic_load_explicit( &counters->free_count, memory_order_relaxed );
+    snapshot->realloc_growth_count += atomic_load_explicit( &counters->realloc_growth_count, memory_order_relaxed );
+    snapshot->bytes_allocated += atomic_load_explicit( &counters->bytes_allocated, memory_order_relaxed );
+
+    for( unsigned long long index = 0; index < STATISTICS_ALLOCATOR__HISTOGRAM_SIZE; index++ ){
+        snapshot->size_histogram[ index ] += atomic_load_explicit( &counters->size_histogram[ index ], memory_order_relaxed );
+    }
+}
+
+/**
+ *  \brief Raises the peak live bytes of \p state to at least \p live_bytes.
+ */
+static void statistics_allocator__raise_peak( StatisticsAllocator__State *state, long long live_bytes ){
+    if( live_bytes <= 0 ){
+        return;
+    }
+
+    unsigned long long peak_live_bytes = atomic_load_explicit( &state->peak_live_bytes, memory_order_relaxed );
+    while(
+        (unsigned long long) live_bytes > peak_live_bytes &&
+        !atomic_compare_exchange_weak_explicit(
+            &state->peak_live_bytes,
+            &peak_live_bytes,
+            (unsigned long long) live_bytes,
+            memory_order_relaxed,
+            memory_order_relaxed
+        )
+    ){
+    }
+}
+
+/**
+ *  \brief Adds a thread's unflushed live bytes to the live bytes of its state. The peak is raised to the live bytes
+ *  before the flush plus the thread's unflushed peak, which is exact while no other thread flushes in between.
+ *  \param other_unflushed_peak_live_bytes The sum of the unflushed peaks of the other threads, which are added to the
+ *  peak too when they are known.
+ */
+static void statistics_allocator__counters__flush(
+    StatisticsAllocator__Counters *counters,
+    long long other_unflushed_peak_live_bytes
+){
+    StatisticsAllocator__State *state = counters->state;
+
+    long long unflushed_live_bytes = atomic_load_explicit( &counters->unflushed_live_bytes, memory_order_relaxed );
+    long long unflushed_peak_live_bytes = atomic_load_explicit( &counters->unflushed_peak_live_bytes, memory_order_relaxed );
+    atomic_store_explicit( &counters->unflushed_live_bytes, 0, memory_order_relaxed );
+    atomic_store_explicit( &counters->unflushed_peak_live_bytes, 0, memory_order_relaxed );
+
+    long long live_bytes = atomic_fetch_add_explicit( &state->live_bytes, unflushed_live_bytes, memory_order_relaxed );
+    statistics_allocator__raise_peak( state, live_bytes + unflushed_peak_live_bytes + other_unflushed_peak_live_bytes );
+}
+
+/**
+ *  \brief Called by pthreads when a thread which used the allocator exits.
+ */
+static void statistics_allocator__counters__destroy( void *counters_pointer ){
+    StatisticsAllocator__Counters *counters = (StatisticsAllocator__Counters*) counters_pointer;
+    StatisticsAllocator__State *state = counters->state;
+
+    pthread_mutex_lock( &state->mutex );
+    /* The peaks the other threads reached since their last flush are counted before this thread's flush moves the
+     * live bytes they were reached against. */
+    long long other_unflushed_peak_live_bytes = 0;
+    for( StatisticsAllocator__Counters *other = state->counters; other != NULL; other = other->next ){
+        if( other != counters ){
+            other_unflushed_peak_live_bytes += atomic_load_explicit( &other->unflushed_peak_live_bytes, memory_order_relaxed );
+        }
+    }
+    statistics_allocator__counters__flush( counters, other_unflushed_peak_live_bytes );
+    statistics_allocator__counters__merge( counters, &state->retired );
+    if( counters->previous != NULL ){
+        counters->previous->next = counters->next;
+    }
+    else{
+        state->counters = counters->next;
+    }
+    if( counters->next != NULL ){
+        counters->next->previous = counters->previous;
+    }
+    pthread_mutex_unlock( &state->mutex );
+
+    allocator__free( state->backing_allocator, counters );
+}
+
+static StatisticsAllocator__Counters *statistics_allocator__counters( StatisticsAllocator__State *state ){
+    StatisticsAllocator__Counters *counters = (StatisticsAllocator__Counters*) pthread_getspecific( state->counters_key );
+
+    if( counters == NULL ){
+        counters = (StatisticsAllocator__Counters*) allocator__calloc( state->backing_allocator, 1, sizeof( StatisticsAllocator__Counters ) );
+        if( counters == NULL ){
+            return NULL;
+        }
+
+        counters->state = state;
+
+        pthread_mutex_lock( &state->mutex );
+        counters->next = state->counters;
+        if( state->counters != NULL ){
+            state->counters->previous = counters;
+        }
+        state->counters = counters;
+        pthread_mutex_unlock( &state->mutex );
+
+        pthread_setspecific( state->counters_key, counters );
+    }
+
+    return counters;
+}
+
+static void statistics_allocator__add_live_bytes( StatisticsAllocator__Counters *counters, long long bytes ){
+    long long live_bytes = atomic_load_explicit( &counters->unflushed_live_bytes, memory_order_relaxed ) + bytes;
+    atomic_store_explicit( &counters->unflushed_live_bytes, live_bytes, memory_order_relaxed );
+
+    if( live_bytes > atomic_load_explicit( &counters->unflushed_peak_live_bytes, memory_order_relaxed ) ){
+        atomic_store_explicit( &counters->unflushed_peak_live_bytes, live_bytes, memory_order_relaxed );
+    }
+
+    long long flush_threshold = (long long) STATISTICS_ALLOCATOR__FLUSH_THRESHOLD;
+    if( live_bytes >= flush_threshold || live_bytes <= -flush_threshold ){
+        statistics_allocator__counters__flush( counters, 0 );
+    }
+}
+
+/**
+ *  \brief Records a request for \p size bytes, made by alloc or by realloc, in the histogram.
+ */
+static void statistics_allocator__record_size( StatisticsAllocator__Counters *counters, unsigned long long size ){
+    statistics_allocator__counter__increment( &counters->size_histogram[ statistics_allocator__histogram_index( size ) ], 1 );
+}
+
+static void *statistics_allocator__alloc( unsigned long long size, void *allocator_data ){
+    StatisticsAllocator__State *state = (StatisticsAllocator__State*) allocator_data;
+
+    char *block = (char*) allocator__alloc( state->backing_allocator, STATISTICS_ALLOCATOR__HEADER_SIZE + size );
+    if( block == NULL ){
+        return NULL;
+    }
+
+    void *memory = block + STATISTICS_ALLOCATOR__HEADER_SIZE;
+    *statistics_allocator__header( memory ) = size;
+
+    StatisticsAllocator__Counters *counters = statistics_allocator__counters( state );
+    if( counters != NULL ){
+        statistics_allocator__counter__increment( &counters->alloc_count, 1 );
+        statistics_allocator__counter__increment( &counters->bytes_allocated, size );
+        statistics_allocator__record_size( counters, size );
+        statistics_allocator__add_live_bytes( counters, (long long) size );
+    }
+
+    return memory;
+}
+
+static void statistics_allocator__free( void *pointer, void *allocator_data ){
+    StatisticsAllocator__State *state = (StatisticsAllocator__State*) allocator_data;
+
+    if( pointer == NULL ){
+        return;
+    }
+
+    unsigned long long size = *statistics_allocator__header( pointer );
+
+    StatisticsAllocator__Counters *counters = statistics_allocator__counters( state );
+    if( counters != NULL ){
+        statistics_allocator__counter__increment( &counters->free_count, 1 );
+        statistics_allocator__add_live_bytes( counters, -(long long) size );
+    }
+
+    allocator__free( state->backing_allocator, statistics_allocator__header( pointer ) );
+}
+
+static void *statistics_allocator__realloc( void *pointer, unsigned long long size, void *allocator_data ){
+    StatisticsAllocator__State *state = (StatisticsAllocator__State*) allocator_data;
+
+    if( pointer == NULL ){
+        return statistics_allocator__alloc( size, allocator_data );
+    }
+
+    unsigned long long old_size = *statistics_allocator__header( pointer );
+
+    char *block = (char*) allocator__realloc( state->backing_allocator, statistics_allocator__header( pointer ), STATISTICS_ALLOCATOR__HEADER_SIZE + size );
+    if( block == NULL ){
+        return NULL;
+    }
+
+    void *memory = block + STATISTICS_ALLOCATOR__HEADER_SIZE;
+    *statistics_allocator__header( memory ) = size;
+
+    StatisticsAllocator__Counters *counters = statistics_allocator__counters( state );
+    if( counters != NULL ){
+        statistics_allocator__counter__increment( &counters->realloc_count, 1 );
+        if( size > old_size ){
+            statistics_allocator__counter__increment( &counters->realloc_growth_count, 1 );
+            statistics_allocator__counter__increment( &counters->bytes_allocated, size - old_size );
+        }
+        statistics_allocator__record_size( counters, size );
+        statistics_allocator__add_live_bytes( counters, (long long) size - (long long) old_size );
+    }
+
+    return memory;
+}
+
+/**
+ *  \brief Lets the backing allocator return its unused memory. The counters describe the caller's allocations
+ *  rather than the backing allocator's footprint, so trimming leaves them unchanged.
+ */
+static bool statistics_allocator__trim( void *allocator_data ){
+    StatisticsAllocator__State *state = (StatisticsAllocator__State*) allocator_data;
+    return allocator__trim( state->backing_allocator );
+}
+
+void statistics_allocator__initialize( StatisticsAllocator *statistics_allocator, Allocator *backing_allocator ){
+    StatisticsAllocator__State *state = (StatisticsAllocator__State*) allocator__calloc( backing_allocator, 1, sizeof( StatisticsAllocator__State ) );
+
+    *statistics_allocator = (StatisticsAllocator){
+        .allocator = NULL,
+        .backing_allocator = backing_allocator,
+        .state = state
+    };
+
+    RETURN_IF_FAIL( state != NULL );
+
+    state->backing_allocator = backing_allocator;
+    pthread_key_create( &state->counters_key, statistics_allocator__counters__destroy );
+    pthread_mutex_init( &state->mutex, NULL );
+
+    statistics_allocator->allocator = allocator__create(
+        statistics_allocator__alloc,
+        statistics_allocator__realloc,
+        statistics_allocator__free,
+        NULL,
+        state
+    );
+
+    if( statistics_allocator->allocator != NULL ){
+        allocator__set_trim_function( statistics_allocator->allocator, statistics_allocator__trim );
+    }
+
+    /* Forget the allocation of the allocator itself, so that a new StatisticsAllocator reports no activity. */
+    StatisticsAllocator__Counters *counters = (StatisticsAllocator__Counters*) pthread_getspecific( state->counters_key );
+    if( counters != NULL ){
+        StatisticsAllocator__State *counters_state = counters->state;
+        StatisticsAllocator__Counters *next = counters->next;
+        StatisticsAllocator__Counters *previous = counters->previous;
+
+        memset( counters, 0, sizeof( StatisticsAllocator__Counters ) );
+
+        counters->state = counters_state;
+        counters->next = next;
+        counters->previous = previous;
+    }
+}
+
+void statistics_allocator__deinitialize( StatisticsAllocator *statistics_allocator ){
+    RETURN_IF_FAIL( statistics_allocator != NULL && statistics_allocator->state != NULL );
+
+    StatisticsAllocator__State *state = statistics_allocator->state;
+
+    allocator__destroy( statistics_allocator->allocator );
+
+    /* Deleting the key ensures that threads which exit later do not touch the state. */
+    pthread_key_delete( state->counters_key );
+
+    StatisticsAllocator__Counters *counters = state->counters;
+    while( counters != NULL ){
+        StatisticsAllocator__Counters *next = counters->next;
+        allocator__free( state->backing_allocator, counters );
+        counters = next;
+    }
+
+    pthread_mutex_destroy( &state->mutex );
+
+    allocator__free( statistics_allocator->backing_allocator, state );
+
+    statistics_allocator->allocator = NULL;
+    statistics_allocator->state = NULL;
+}
+
+void statistics_allocator__snapshot( StatisticsAllocator const *statistics_allocator, StatisticsAllocator__Snapshot *out__snapshot ){
+    RETURN_IF_FAIL( statistics_allocator != NULL && statistics_allocator->state != NULL && out__snapshot != NULL );
+
+    StatisticsAllocator__State *state = statistics_allocator->state;
+
+    pthread_mutex_lock( &state->mutex );
+    *out__snapshot = state->retired;
+    long long flushed_live_bytes = atomic_load_explicit( &state->live_bytes, memory_order_relaxed );
+    long long live_bytes = flushed_live_bytes;
+    long long peak_live_bytes = flushed_live_bytes;
+    for( StatisticsAllocator__Counters *counters = state->counters; counters != NULL; counters = counters->next ){
+        statistics_allocator__counters__merge( counters, out__snapshot );
+        live_bytes += atomic_load_explicit( &counters->unflushed_live_bytes, memory_order_relaxed );
+        peak_live_bytes += atomic_load_explicit( &counters->unflushed_peak_live_bytes, memory_order_relaxed );
+    }
+    pthread_mutex_unlock( &state->mutex );
+
+    /* The peaks since each thread's last flush have not reached the state yet, so they are counted here. */
+    out__snapshot->live_bytes = live_bytes > 0 ? (unsigned long long) live_bytes : 0;
+    out__snapshot->peak_live_bytes = math__max__ullong(
+        atomic_load_explicit( &state->peak_live_bytes, memory_order_relaxed ),
+        peak_live_bytes > 0 ? (unsigned long long) peak_live_bytes : 0
+    );
+    out__snapshot->peak_live_bytes = math__max__ullong( out__snapshot->peak_live_bytes, out__snapshot->live_bytes );
+}
+
+void statistics_allocator__snapshot__append_text( StatisticsAllocator__Snapshot const *snapshot, String *string, Allocator *allocator ){
+    RETURN_IF_FAIL( snapshot != NULL && string != NULL );
+
+    string__append__format(
+        string,
+        allocator,
+        "alloc: %llu\nrealloc: %llu (growth: %llu)\nfree: %llu\nbytes allocated: %llu\nlive bytes: %llu\npeak live bytes: %llu\n",
+        snapshot->alloc_count,
+        snapshot->realloc_count,
+        snapshot->realloc_growth_count,
+        snapshot->free_count,
+        snapshot->bytes_allocated,
+        snapshot->live_bytes,
+        snapshot->peak_live_bytes
+    );
+
+    for( unsigned long long index = 0; index < STATISTICS_ALLOCATOR__HISTOGRAM_SIZE; index++ ){
+        if( snapshot->size_histogram[ index ] == 0 ){
+            continue;
+        }
+
+        string__append__format(
+            string,
+            allocator,
+            "size [%llu, %llu): %llu\n",
+            index == 0 ? 0ULL : 1ULL << index,
+            index == 63 ? ~0ULL : 1ULL << ( index + 1 ),
+            snapshot->size_histogram[ index ]
+        );
+    }
+}
+
+void statistics_allocator__snapshot__append_json( StatisticsAllocator__Snapshot const *snapshot, String *string, Allocator *allocator ){
+    RETURN_IF_FAIL( snapshot != NULL && string != NULL );
+
+    string__append__format(
+        string,
+        allocator,
+        "{\"alloc_count\":%llu,\"realloc_count\":%llu,\"realloc_growth_count\":%llu,\"free_count\":%llu,"
+        "\"bytes_allocated\":%llu,\"live_bytes\":%llu,\"peak_live_bytes\":%llu,\"size_histogram\":[",
+        snapshot->alloc_count,
+        snapshot->realloc_count,
+        snapshot->realloc_growth_count,
+        snapshot->free_count,
+        snapshot->bytes_allocated,
+        snapshot->live_bytes,
+        snapshot->peak_live_bytes
+    );
+
+    for( unsigned long long index = 0; index < STATISTICS_ALLOCATOR__HISTOGRAM_SIZE; index++ ){
+        string__append__format( string, allocator, index == 0 ? "%llu" : ",%llu", snapshot->size_histogram[ index ] );
+    }
+
+    string__append__format( string, allocator, "]}" );
+}
@@ -3,17 +3,22 @@
 
 // Internal Includes
 #include "kirke/string.h"
+#include "kirke/string_searcher.h"
 
-static bool chars_are_equal( char first, char second ){
-    if( first == second ){
-        return true;
-    }
+/**
+ *  \brief Implements string__index_of with a StringSearcher initialized for the one search, so that the search takes
+ *  time linear in the length of the string, however repetitive the string and the sequence are.
+ */
+static bool string__index_of__searcher( String const *string, String const *sequence, unsigned long long *out_index ){
+    StringSearcher searcher;
+    string_searcher__initialize( &searcher, sequence );
 
-    return false;
+    return string_searcher__index_of( &searcher, string, out_index );
 }
 
-ARRAY__DEFINE( String, string, char, chars_are_equal )
+ARRAY__DEFINE_POD__INDEX_OF( String, string, char, string__index_of__searcher )
 ARRAY__DEFINE( Array__String, array__string, String, string__equals )
+ARRAY__DEFINE_SMALL( SmallString, small_string, String, char, SMALL_STRING__INLINE_CAPACITY )
 LIST__DEFINE( List__String, list__string, String, string__equals )
 
 void string__initialize__va_list( String* string, Allocator* allocator, const char* format, va_list args ){
@@ -0,0 +1,262 @@
+// System Includes
+#include <string.h> // memchr, memcmp, memset
+
+#if defined( __SSE2__ )
+    #include <emmintrin.h>
+#endif
+
+// Internal Includes
+#include "kirke/string_searcher.h"
+
+/**
+ *  \brief Computes the maximal suffix of a sequence, with respect to either the ordinary or the reversed order of
+ *  characters, as the first step of the critical factorization used by the Two-Way algorithm.
+ *  \param sequence The characters of the sequence.
+ *  \param length The length of the sequence.
+ *  \param reversed Whether characters are ordered in reverse.
+ *  \param out__period An out parameter. Upon return, this will store the period of the maximal suffix.
+ *  \returns Returns the index of the character preceding the maximal suffix, which may be -1.
+ */
+static long long string_searcher__maximal_suffix(
+    unsigned char const *sequence,
+    long long length,
+    bool reversed,
+    unsigned long long *out__period
+){
+    long long suffix = -1;
+    long long index = 0;
+    long long offset = 1;
+    long long period = 1;
+
+    while( index + offset < length ){
+        unsigned char next = sequence[ index + offset ];
+        unsigned char previous = sequence[ suffix + offset ];
+
+        if( reversed ? next > previous : next < previous ){
+            index += offset;
+            offset = 1;
+            period = index - suffix;
+        }
+        else if( next == previous ){
+            if( offset != period ){
+                offset++;
+            }
+            else{
+                index += period;
+                offset = 1;
+            }
+        }
+        else{
+            suffix = index;
+            index = suffix + 1;
+            offset = 1;
+            period = 1;
+        }
+    }
+
+    *out__period = (unsigned long long) period;
+    return suffix;
+}
+
+void string_searcher__initialize( StringSearcher *searcher, String const *sequence ){
+    searcher->sequence = *sequence;
+    searcher->critical_position = -1;
+    searcher->period = 1;
+    searcher->periodic = false;
+
+    /* Cast for C++ compatibility */
+    unsigned char const *characters = (unsigned char const*) sequence->data;
+    long long length = (long long) sequence->length;
+
+    memset( searcher->byte_set, 0, sizeof( searcher->byte_set ) );
+    for( long long index = 0; index < length; index++ ){
+        searcher->byte_set[ characters[ index ] / 8 ] |= 1 << ( characters[ index ] % 8 );
+    }
+
+    if( sequence->length <= STRING_SEARCHER__SHORT_SEQUENCE_LENGTH ){
+        return;
+    }
+
+    /* The critical factorization is given by the later of the two maximal suffixes. */
+    unsigned long long period;
+    unsigned long long reversed_period;
+    long long suffix = string_searcher__maximal_suffix( characters, length, false, &period );
+    long long reversed_suffix = string_searcher__maximal_suffix( characters, length, true, &reversed_period );
+    if( reversed_suffix > suffix ){
+        suffix = reversed_suffix;
+        period = reversed_period;
+    }
+    searcher->critical_position = suffix;
+
+    if( memcmp( characters, characters + period, suffix + 1 ) == 0 ){
+        searcher->period = period;
+        searcher->periodic = true;
+    }
+    else{
+        /* Any shift up to the length of the longer half is safe, and skips the most. */
+        long long left_length = suffix + 1;
+        long long right_length = length - suffix - 1;
+        searcher->period = (unsigned long long)( ( left_length > right_length ? left_length : right_length ) + 1 );
+    }
+}
+
+/**
+ *  \brief Finds a long sequence with the Two-Way algorithm.
+ *  \param searcher A pointer to the StringSearcher of the sequence.
+ *  \param string The characters to be searched.
+ *  \param string_length The number of characters to be searched.
+ *  \param out__index An out parameter. Upon a match, this will store the index of the match.
+ *  \returns Returns true if the sequence was found, and false otherwise.
+ */
+static bool string_searcher__index_of__two_way(
+    StringSearcher const *searcher,
+    unsigned char const *string,
+    long long string_length,
+    unsigned long long *out__index
+){
+    /* Cast for C++ compatibility */
+    unsigned char const *sequence = (unsigned char const*) searcher->sequence.data;
+    long long length = (long long) searcher->sequence.length;
+    long long critical_position = searcher->critical_position;
+    long long period = (long long) searcher->period;
+
+    /* The number of leading characters of the sequence known to match after a shift by the period, less 1. */
+    long long memory = -1;
+    long long position = 0;
+    while( position <= string_length - length ){
+        /* No match can cover a byte which does not occur in the sequence. */
+        unsigned char last = string[ position + length - 1 ];
+        if( ( searcher->byte_set[ last / 8 ] & ( 1 << ( last % 8 ) ) ) == 0 ){
+            position += length;
+            memory = -1;
+            continue;
+        }
+
+        /* Match the right half, from left to right. */
+        long long index = ( critical_position > memory ? critical_position : memory ) + 1;
+        while( index < length && sequence[ index ] == string[ position + index ] ){
+            index++;
+        }
+        if( index < length ){
+            position += index - critical_position;
+            memory = -1;
+            continue;
+        }
+
+        /* Match the left half, from right to left. */
+        index = critical_position;
+        while( index > memory && sequence[ index ] == string[ position + index ] ){
+            index--;
+        }
+        if( index <= memory ){
+            *out__index = (unsigned long long) position;
+            return true;
+        }
+
+        position += period;
+        memory = searcher->periodic ? length - period - 1 : -1;
+    }
+
+    return false;
+}
+
+/**
+ *  \brief Finds a short sequence of at least 2 characters, by filtering candidate positions on the first and last
+ *  characters of the sequence.
+ *  \param searcher A pointer to the StringSearcher of the sequence.
+ *  \param string The characters to be searched.
+ *  \param string_length The number of characters to be searched.
+ *  \param out__index An out parameter. Upon a match, this will store the index of the match.
+ *  \returns Returns true if the sequence was found, and false otherwise.
+ */
+static bool string_searcher__index_of__short(
+    StringSearcher const *searcher,
+    char const *string,
+    unsigned long long string_length,
+    unsigned long long *out__index
+){
+    char const *sequence = searcher->sequence.data;
+    unsigned long long length = searcher->sequence.length;
+    unsigned long long last_position = string_length - length;
+    unsigned long long position = 0;
+
+#if defined( __SSE2__ )
+    __m128i first = _mm_set1_epi8( sequence[ 0 ] );
+    __m128i last = _mm_set1_epi8( sequence[ length - 1 ] );
+
+    /* Each block tests the 16 positions starting at position, while every load stays within the string. */
+    for( ; position + 16 <= last_position + 1; position += 16 ){
+        /* Cast for C++ compatibility */
+        __m128i block_first = _mm_loadu_si128( (__m128i const*)( string + position ) );
+        __m128i block_last = _mm_loadu_si128( (__m128i const*)( string + position + length - 1 ) );
+
+        unsigned int mask = (unsigned int) _mm_movemask_epi8(
+            _mm_and_si128( _mm_cmpeq_epi8( first, block_first ), _mm_cmpeq_epi8( last, block_last ) )
+        );
+        while( mask != 0 ){
+            unsigned long long candidate = position + (unsigned long long) __builtin_ctz( mask );
+            if( memcmp( string + candidate + 1, sequence + 1, length - 2 ) == 0 ){
+                *out__index = candidate;
+                return true;
+            }
+            mask &= mask - 1;
+        }
+    }
+#endif
+
+    while( position <= last_position ){
+        /* Cast for C++ compatibility */
+        char const *candidate = (char const*) memchr( string + position, sequence[ 0 ], last_position - position + 1 );
+        if( candidate == NULL ){
+            return false;
+        }
+
+        position = (unsigned long long)( candidate - string );
+        if( candidate[ length - 1 ] == sequence[ length - 1 ] && memcmp( candidate + 1, sequence + 1, length - 2 ) == 0 ){
+            *out__index = position;
+            return true;
+        }
+        position++;
+    }
+
+    return false;
+}
+
+bool string_searcher__index_of( StringSearcher const *searcher, String const *string, unsigned long long *out__index ){
+    unsigned long long length = searcher->sequence.length;
+
+    *out__index = string->length;
+    if( length > string->length ){
+        return false;
+    }
+
+    if( length == 0 ){
+        *out__index = 0;
+        return true;
+    }
+
+    if( length == 1 ){
+        /* Cast for C++ compatibility */
+        char const *match = (char const*) memchr( string->data, searcher->sequence.data[ 0 ], string->length );
+        if( match != NULL ){
+            *out__index = (unsigned long long)( match - string->data );
+        }
+        return match != NULL;
+    }
+
+    unsigned long long index;
+    bool found = false;
+    if( length <= STRING_SEARCHER__SHORT_SEQUENCE_LENGTH ){
+        found = string_searcher__index_of__short( searcher, string->data, string->length, &index );
+    }
+    else{
+        /* Cast for C++ compatibility */
+        found = string_searcher__index_of__two_way( searcher, (unsigned char const*) string->data, (long long) string->length, &index );
+    }
+
+    if( found ){
+        *out__index = index;
+    }
+
+    return found;
+}
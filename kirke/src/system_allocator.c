@@ -1,27 +1,536 @@
-// Internal Includes
-#include "kirke/system_allocator.h"
+#if defined( __linux__ )
+#define _GNU_SOURCE // mremap, malloc_usable_size
+#endif
 
 // System Includes
+#include <stddef.h> // max_align_t
+#include <stdint.h> // uintptr_t
 #include <stdlib.h>
+#include <string.h> // memcpy
+
+#if defined( __linux__ )
+#include <malloc.h> // malloc_trim, malloc_usable_size
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h> // fopen, fgets, sscanf
+#include <sys/mman.h>
+#include <unistd.h> // sysconf
+#elif defined( __APPLE__ )
+#include <malloc/malloc.h> // malloc_size
+#endif
 
 // Internal Includes
 #include "kirke/system_allocator.h"
 
+#if defined( __linux__ )
+
+/**
+ *  \brief A block of memory mapped directly from the operating system.
+ */
+typedef struct SystemAllocator__LargeBlock{
+    void* address;
+    /**
+     *  The size in bytes of the mapping, which is a multiple of the page size.
+     */
+    unsigned long long size;
+    /**
+     *  Whether the mapping is aligned to \ref SYSTEM_ALLOCATOR__HUGE_PAGE_SIZE, and advised to use transparent huge
+     *  pages. If so, its size is a multiple of the huge page size.
+     */
+    bool huge;
+} SystemAllocator__LargeBlock;
+
+/**
+ *  \brief The large blocks of a SystemAllocator, sorted by address.
+ *  Since large blocks are page aligned, only page aligned pointers need to be looked up.
+ */
+struct SystemAllocator__LargeBlocks{
+    pthread_mutex_t mutex;
+    SystemAllocator__LargeBlock* blocks;
+    unsigned long long count;
+    unsigned long long capacity;
+};
+
+static unsigned long long system_allocator__page_size( void ){
+    /* Every thread which finds the cache empty stores the same value, so relaxed ordering is enough. */
+    static atomic_ullong cached_page_size = 0;
+
+    unsigned long long page_size = atomic_load_explicit( &cached_page_size, memory_order_relaxed );
+    if( page_size == 0 ){
+        page_size = (unsigned long long) sysconf( _SC_PAGESIZE );
+        atomic_store_explicit( &cached_page_size, page_size, memory_order_relaxed );
+    }
+
+    return page_size;
+}
+
+static unsigned long long system_allocator__round_to_pages( unsigned long long size ){
+    unsigned long long page_size = system_allocator__page_size();
+    return ( size + page_size - 1 ) & ~( page_size - 1 );
+}
+
+static unsigned long long system_allocator__round_to_huge_pages( unsigned long long size ){
+    return ( size + SYSTEM_ALLOCATOR__HUGE_PAGE_SIZE - 1 ) & ~( SYSTEM_ALLOCATOR__HUGE_PAGE_SIZE - 1 );
+}
+
+/**
+ *  \brief Determines whether a large block of \p size bytes should use transparent huge pages.
+ */
+static bool system_allocator__wants_huge_pages( SystemAllocator* system_allocator, unsigned long long size ){
+#if defined( MADV_HUGEPAGE )
+    return system_allocator->huge_page_threshold > 0 && size >= system_allocator->huge_page_threshold;
+#else
+    (void)( system_allocator );
+    (void)( size );
+    return false;
+#endif
+}
+
+/**
+ *  \brief Maps \p size bytes, a multiple of the huge page size, at an address aligned to the huge page size, and
+ *  advises the kernel to back them with transparent huge pages.
+ *  \returns The address of the mapping, or NULL if it could not be mapped.
+ */
+static void* system_allocator__map_huge_pages( unsigned long long size ){
+    /* mmap only guarantees page alignment, so map an extra huge page and trim the excess from both ends. */
+    char* reservation = (char*) mmap( NULL, size + SYSTEM_ALLOCATOR__HUGE_PAGE_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0 );
+    if( reservation == MAP_FAILED ){
+        return NULL;
+    }
+
+    char* pointer = (char*)( ( (uintptr_t) reservation + SYSTEM_ALLOCATOR__HUGE_PAGE_SIZE - 1 ) & ~( (uintptr_t) SYSTEM_ALLOCATOR__HUGE_PAGE_SIZE - 1 ) );
+    unsigned long long head = (unsigned long long)( pointer - reservation );
+
+    if( head > 0 ){
+        munmap( reservation, head );
+    }
+    if( head < SYSTEM_ALLOCATOR__HUGE_PAGE_SIZE ){
+        munmap( pointer + size, SYSTEM_ALLOCATOR__HUGE_PAGE_SIZE - head );
+    }
+
+#if defined( MADV_HUGEPAGE )
+    madvise( pointer, size, MADV_HUGEPAGE );
+#endif
+
+    return pointer;
+}
+
+/**
+ *  \brief Faults in every page of a freshly mapped range, so that later accesses do not fault.
+ */
+static void system_allocator__prefault( char* pointer, unsigned long long size ){
+#if defined( MADV_POPULATE_WRITE )
+    if( madvise( pointer, size, MADV_POPULATE_WRITE ) == 0 ){
+        return;
+    }
+#endif
+
+    /* Older kernels cannot populate a range on request, so write to each page instead. The pages are still zero. */
+    unsigned long long page_size = system_allocator__page_size();
+    for( unsigned long long offset = 0; offset < size; offset += page_size ){
+        ( (volatile char*) pointer )[ offset ] = 0;
+    }
+}
+
+/**
+ *  \brief Finds the position of \p address within the sorted large blocks. The mutex must be held.
+ *  \returns The index of the block at \p address, or of the position at which it would be inserted.
+ */
+static unsigned long long system_allocator__large_blocks__search( SystemAllocator__LargeBlocks* large_blocks, void* address ){
+    unsigned long long low = 0;
+    unsigned long long high = large_blocks->count;
+
+    while( low < high ){
+        unsigned long long middle = low + ( high - low ) / 2;
+        if( (uintptr_t) large_blocks->blocks[ middle ].address < (uintptr_t) address ){
+            low = middle + 1;
+        }
+        else{
+            high = middle;
+        }
+    }
+
+    return low;
+}
+
+/**
+ *  \brief Looks up the large block at \p address. The mutex must be held.
+ *  \returns A pointer to the block, or NULL if \p address is not a large block.
+ */
+static SystemAllocator__LargeBlock* system_allocator__large_blocks__find( SystemAllocator__LargeBlocks* large_blocks, void* address ){
+    unsigned long long index = system_allocator__large_blocks__search( large_blocks, address );
+
+    if( index < large_blocks->count && large_blocks->blocks[ index ].address == address ){
+        return &large_blocks->blocks[ index ];
+    }
+
+    return NULL;
+}
+
+/**
+ *  \brief Records a large block. The mutex must be held.
+ *  \returns Returns true if the block was recorded, and false if memory could not be allocated to record it.
+ */
+static bool system_allocator__large_blocks__insert( SystemAllocator__LargeBlocks* large_blocks, void* address, unsigned long long size, bool huge ){
+    if( large_blocks->count == large_blocks->capacity ){
+        unsigned long long capacity = large_blocks->capacity == 0 ? 16 : large_blocks->capacity * 2;
+
+        /* Cast for C++ compatibility */
+        SystemAllocator__LargeBlock* blocks = (SystemAllocator__LargeBlock*) realloc(
+            large_blocks->blocks,
+            capacity * sizeof( SystemAllocator__LargeBlock )
+        );
+        if( blocks == NULL ){
+            return false;
+        }
+
+        large_blocks->blocks = blocks;
+        large_blocks->capacity = capacity;
+    }
+
+    unsigned long long index = system_allocator__large_blocks__search( large_blocks, address );
+    memmove(
+        &large_blocks->blocks[ index + 1 ],
+        &large_blocks->blocks[ index ],
+        ( large_blocks->count - index ) * sizeof( SystemAllocator__LargeBlock )
+    );
+
+    large_blocks->blocks[ index ].address = address;
+    large_blocks->blocks[ index ].size = size;
+    large_blocks->blocks[ index ].huge = huge;
+    large_blocks->count++;
+
+    return true;
+}
+
+/**
+ *  \brief Forgets a large block, previously returned by system_allocator__large_blocks__find. The mutex must be held.
+ */
+static void system_allocator__large_blocks__remove( SystemAllocator__LargeBlocks* large_blocks, SystemAllocator__LargeBlock* block ){
+    unsigned long long index = (unsigned long long)( block - large_blocks->blocks );
+
+    memmove(
+        &large_blocks->blocks[ index ],
+        &large_blocks->blocks[ index + 1 ],
+        ( large_blocks->count - index - 1 ) * sizeof( SystemAllocator__LargeBlock )
+    );
+
+    large_blocks->count--;
+}
+
+/**
+ *  \brief Locks the large blocks if \p pointer may be a large block.
+ *  \returns Returns true if the mutex was locked, in which case the caller must unlock it.
+ */
+static bool system_allocator__large_blocks__lock_for( SystemAllocator* system_allocator, void* pointer ){
+    if(
+        system_allocator->large_blocks == NULL ||
+        ( (uintptr_t) pointer & ( system_allocator__page_size() - 1 ) ) != 0
+    ){
+        return false;
+    }
+
+    pthread_mutex_lock( &system_allocator->large_blocks->mutex );
+    return true;
+}
+
+static void* system_allocator__large_block__alloc( SystemAllocator* system_allocator, unsigned long long size ){
+    bool huge = system_allocator__wants_huge_pages( system_allocator, size );
+    unsigned long long mapping_size = huge ? system_allocator__round_to_huge_pages( size ) : system_allocator__round_to_pages( size );
+
+    void* pointer = NULL;
+    if( huge ){
+        pointer = system_allocator__map_huge_pages( mapping_size );
+    }
+    else{
+        pointer = mmap( NULL, mapping_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0 );
+        if( pointer == MAP_FAILED ){
+            pointer = NULL;
+        }
+    }
+
+    if( pointer == NULL ){
+        return NULL;
+    }
+
+    if( system_allocator->prefault ){
+        system_allocator__prefault( (char*) pointer, mapping_size );
+    }
+
+    pthread_mutex_lock( &system_allocator->large_blocks->mutex );
+    bool inserted = system_allocator__large_blocks__insert( system_allocator->large_blocks, pointer, mapping_size, huge );
+    pthread_mutex_unlock( &system_allocator->large_blocks->mutex );
+
+    if( !inserted ){
+        munmap( pointer, mapping_size );
+        return NULL;
+    }
+
+    return pointer;
+}
+
+/**
+ *  \brief Resizes a large block to \p size bytes, which is at least the large block threshold, by remapping its
+ *  pages rather than copying them. The mutex must be held.
+ *  \returns The new address of the block, or NULL if it could not be resized.
+ */
+static void* system_allocator__large_block__remap( SystemAllocator* system_allocator, SystemAllocator__LargeBlock* block, unsigned long long size ){
+    SystemAllocator__LargeBlocks* large_blocks = system_allocator->large_blocks;
+    void* pointer = block->address;
+    unsigned long long old_size = block->size;
+
+    bool huge = block->huge || system_allocator__wants_huge_pages( system_allocator, size );
+    unsigned long long mapping_size = huge ? system_allocator__round_to_huge_pages( size ) : system_allocator__round_to_pages( size );
+
+    /* The pages are remapped rather than copied, in place if the address space after them is free. */
+    void* new_pointer = MAP_FAILED;
+    if( huge == block->huge ){
+        new_pointer = mremap( pointer, old_size, mapping_size, 0 );
+    }
+
+    if( new_pointer == MAP_FAILED ){
+        if( huge ){
+            /* Moving the pages into an aligned mapping keeps the whole block eligible for huge pages. */
+            void* target = system_allocator__map_huge_pages( mapping_size );
+
+            if( target != NULL ){
+                new_pointer = mremap( pointer, old_size, mapping_size, MREMAP_MAYMOVE | MREMAP_FIXED, target );
+
+                if( new_pointer == MAP_FAILED ){
+                    munmap( target, mapping_size );
+                }
+#if defined( MADV_HUGEPAGE )
+                else{
+                    /* The moved pages keep the advice of their old mapping, which may not have asked for huge pages. */
+                    madvise( new_pointer, mapping_size, MADV_HUGEPAGE );
+                }
+#endif
+            }
+        }
+        else{
+            new_pointer = mremap( pointer, old_size, mapping_size, MREMAP_MAYMOVE );
+        }
+    }
+
+    if( new_pointer == MAP_FAILED ){
+        return NULL;
+    }
+
+    if( system_allocator->prefault && mapping_size > old_size ){
+        system_allocator__prefault( (char*) new_pointer + old_size, mapping_size - old_size );
+    }
+
+    if( new_pointer == pointer ){
+        block->size = mapping_size;
+        block->huge = huge;
+    }
+    else{
+        /* The block moved, and has to be re-sorted. Its old entry leaves room for the new one. */
+        system_allocator__large_blocks__remove( large_blocks, block );
+        system_allocator__large_blocks__insert( large_blocks, new_pointer, mapping_size, huge );
+    }
+
+    return new_pointer;
+}
+
+#endif // defined( __linux__ )
+
 static void* system_allocator__alloc( unsigned long long size, void* allocator_data ){
+#if defined( __linux__ )
+    SystemAllocator* system_allocator = (SystemAllocator*) allocator_data;
+
+    if( system_allocator->large_blocks != NULL && size >= system_allocator->large_block_threshold ){
+        return system_allocator__large_block__alloc( system_allocator, size );
+    }
+#else
     (void)( allocator_data );
+#endif
+
     return malloc( size );
 }
 
+static void* system_allocator__calloc( unsigned long long count, unsigned long long size, void* allocator_data ){
+#if defined( __linux__ )
+    SystemAllocator* system_allocator = (SystemAllocator*) allocator_data;
+
+    /* Freshly mapped pages are zeroed by the kernel, so large blocks need no clearing. */
+    if( system_allocator->large_blocks != NULL && ( size == 0 || count <= ~0ULL / size ) && count * size >= system_allocator->large_block_threshold ){
+        return system_allocator__large_block__alloc( system_allocator, count * size );
+    }
+#else
+    (void)( allocator_data );
+#endif
+
+    return calloc( count, size );
+}
+
 static void* system_allocator__realloc( void* pointer, unsigned long long size, void* allocator_data ){
+#if defined( __linux__ )
+    SystemAllocator* system_allocator = (SystemAllocator*) allocator_data;
+
+    if( system_allocator->large_blocks == NULL ){
+        return realloc( pointer, size );
+    }
+
+    if( pointer == NULL ){
+        return system_allocator__alloc( size, allocator_data );
+    }
+
+    if( system_allocator__large_blocks__lock_for( system_allocator, pointer ) ){
+        SystemAllocator__LargeBlocks* large_blocks = system_allocator->large_blocks;
+        SystemAllocator__LargeBlock* block = system_allocator__large_blocks__find( large_blocks, pointer );
+
+        if( block != NULL ){
+            void* new_pointer = NULL;
+
+            if( size >= system_allocator->large_block_threshold ){
+                new_pointer = system_allocator__large_block__remap( system_allocator, block, size );
+            }
+            else{
+                new_pointer = malloc( size );
+
+                if( new_pointer != NULL ){
+                    memcpy( new_pointer, pointer, size );
+                    munmap( pointer, block->size );
+                    system_allocator__large_blocks__remove( large_blocks, block );
+                }
+            }
+
+            pthread_mutex_unlock( &large_blocks->mutex );
+            return new_pointer;
+        }
+
+        pthread_mutex_unlock( &large_blocks->mutex );
+    }
+
+    if( size >= system_allocator->large_block_threshold ){
+        void* new_pointer = system_allocator__large_block__alloc( system_allocator, size );
+
+        if( new_pointer != NULL ){
+            unsigned long long old_size = malloc_usable_size( pointer );
+            memcpy( new_pointer, pointer, old_size < size ? old_size : size );
+            free( pointer );
+        }
+
+        return new_pointer;
+    }
+#else
     (void)( allocator_data );
+#endif
+
     return realloc( pointer, size );
 }
 
 static void system_allocator__free( void* pointer, void* allocator_data ){
+#if defined( __linux__ )
+    SystemAllocator* system_allocator = (SystemAllocator*) allocator_data;
+
+    if( pointer != NULL && system_allocator__large_blocks__lock_for( system_allocator, pointer ) ){
+        SystemAllocator__LargeBlocks* large_blocks = system_allocator->large_blocks;
+        SystemAllocator__LargeBlock* block = system_allocator__large_blocks__find( large_blocks, pointer );
+
+        if( block != NULL ){
+            munmap( pointer, block->size );
+            system_allocator__large_blocks__remove( large_blocks, block );
+            pthread_mutex_unlock( &large_blocks->mutex );
+            return;
+        }
+
+        pthread_mutex_unlock( &large_blocks->mutex );
+    }
+#else
+    (void)( allocator_data );
+#endif
+
+    free( pointer );
+}
+
+static bool system_allocator__try_expand( void* pointer, unsigned long long size, void* allocator_data ){
+#if defined( __linux__ )
+    SystemAllocator* system_allocator = (SystemAllocator*) allocator_data;
+
+    if( system_allocator__large_blocks__lock_for( system_allocator, pointer ) ){
+        SystemAllocator__LargeBlocks* large_blocks = system_allocator->large_blocks;
+        SystemAllocator__LargeBlock* block = system_allocator__large_blocks__find( large_blocks, pointer );
+
+        if( block != NULL ){
+            bool expanded = true;
+            unsigned long long mapping_size = block->huge ? system_allocator__round_to_huge_pages( size ) : system_allocator__round_to_pages( size );
+
+            /* Blocks which are about to use huge pages are moved into an aligned mapping by realloc instead. */
+            if( !block->huge && system_allocator__wants_huge_pages( system_allocator, size ) ){
+                expanded = false;
+            }
+            /* Without MREMAP_MAYMOVE, mremap only succeeds if the mapping can be extended where it is. */
+            else if( mapping_size > block->size ){
+                expanded = mremap( pointer, block->size, mapping_size, 0 ) != MAP_FAILED;
+                if( expanded ){
+                    if( system_allocator->prefault ){
+                        system_allocator__prefault( (char*) pointer + block->size, mapping_size - block->size );
+                    }
+                    block->size = mapping_size;
+                }
+            }
+
+            pthread_mutex_unlock( &large_blocks->mutex );
+            return expanded;
+        }
+
+        pthread_mutex_unlock( &large_blocks->mutex );
+    }
+
+    /* Blocks which are about to become large are moved into their own mapping by realloc instead. */
+    if( system_allocator->large_blocks != NULL && size >= system_allocator->large_block_threshold ){
+        return false;
+    }
+
+    return malloc_usable_size( pointer ) >= size;
+#elif defined( __APPLE__ )
+    (void)( allocator_data );
+    return malloc_size( pointer ) >= size;
+#else
+    (void)( pointer );
+    (void)( size );
+    (void)( allocator_data );
+    return false;
+#endif
+}
+
+static void* system_allocator__alloc_aligned( unsigned long long size, unsigned long long alignment, void* allocator_data ){
+    (void)( allocator_data );
+
+    void* pointer = NULL;
+    if( posix_memalign( &pointer, alignment, size ) != 0 ){
+        return NULL;
+    }
+
+    return pointer;
+}
+
+static void* system_allocator__realloc_aligned( void* pointer, unsigned long long old_size, unsigned long long size, unsigned long long alignment, void* allocator_data ){
+    /* realloc already guarantees the fundamental alignment, and may grow the block in place. */
+    if( alignment <= _Alignof( max_align_t ) ){
+        return realloc( pointer, size );
+    }
+
+    void* new_pointer = system_allocator__alloc_aligned( size, alignment, allocator_data );
+    if( new_pointer != NULL ){
+        memcpy( new_pointer, pointer, old_size < size ? old_size : size );
+        free( pointer );
+    }
+
+    return new_pointer;
+}
+
+static void system_allocator__free_aligned( void* pointer, void* allocator_data ){
     (void)( allocator_data );
     free( pointer );
 }
 
+static bool system_allocator__trim__allocator( void* allocator_data ){
+    return system_allocator__trim( (SystemAllocator*) allocator_data );
+}
+
 static void system_allocator__out_of_memory( void* allocator_data ){
     SystemAllocator* system_allocator = (SystemAllocator*) allocator_data;
 
@@ -31,6 +540,45 @@ static void system_allocator__out_of_memory( void* allocator_data ){
 }
 
 void system_allocator__initialize( SystemAllocator* system_allocator, void( *out_of_memory_callback )( void ) ){
+    system_allocator__initialize__options( system_allocator, out_of_memory_callback, NULL );
+}
+
+void system_allocator__initialize__options(
+    SystemAllocator* system_allocator,
+    void( *out_of_memory_callback )( void ),
+    SystemAllocator__Options const* options
+){
+    /* allocator__create allocates the Allocator itself through system_allocator__alloc, so set up first. */
+    system_allocator->out_of_memory_callback = out_of_memory_callback;
+    system_allocator->large_block_threshold = 0;
+    system_allocator->huge_page_threshold = 0;
+    system_allocator->prefault = false;
+    system_allocator->large_blocks = NULL;
+
+#if defined( __linux__ )
+    if( options != NULL && ( options->large_block_threshold > 0 || options->huge_page_threshold > 0 ) ){
+        /* Cast for C++ compatibility */
+        SystemAllocator__LargeBlocks* large_blocks = (SystemAllocator__LargeBlocks*) calloc( 1, sizeof( SystemAllocator__LargeBlocks ) );
+
+        if( large_blocks != NULL ){
+            pthread_mutex_init( &large_blocks->mutex, NULL );
+
+            /* Huge page blocks are large blocks, so the large block threshold must not exceed the huge page threshold. */
+            unsigned long long large_block_threshold = options->large_block_threshold;
+            if( large_block_threshold == 0 || ( options->huge_page_threshold > 0 && options->huge_page_threshold < large_block_threshold ) ){
+                large_block_threshold = options->huge_page_threshold;
+            }
+
+            system_allocator->large_block_threshold = large_block_threshold;
+            system_allocator->huge_page_threshold = options->huge_page_threshold;
+            system_allocator->prefault = options->prefault;
+            system_allocator->large_blocks = large_blocks;
+        }
+    }
+#else
+    (void)( options );
+#endif
+
     system_allocator->allocator = allocator__create(
         system_allocator__alloc,
         system_allocator__realloc,
@@ -39,12 +587,107 @@ void system_allocator__initialize( SystemAllocator* system_allocator, void( *out
         system_allocator
     );
 
-    system_allocator->out_of_memory_callback = out_of_memory_callback;
+    if( system_allocator->allocator != NULL ){
+        /* Blocks from posix_memalign are never large blocks, so they bypass the lookup in system_allocator__free. */
+        allocator__set_aligned_functions(
+            system_allocator->allocator,
+            system_allocator__alloc_aligned,
+            system_allocator__realloc_aligned,
+            system_allocator__free_aligned
+        );
+        allocator__set_try_expand_function( system_allocator->allocator, system_allocator__try_expand );
+        allocator__set_calloc_function( system_allocator->allocator, system_allocator__calloc );
+        allocator__set_trim_function( system_allocator->allocator, system_allocator__trim__allocator );
+    }
 }
 
 void system_allocator__deinitialize( SystemAllocator* system_allocator ){
     if( system_allocator != NULL ){
         allocator__destroy( system_allocator->allocator );
         system_allocator->out_of_memory_callback = NULL;
+
+#if defined( __linux__ )
+        if( system_allocator->large_blocks != NULL ){
+            pthread_mutex_destroy( &system_allocator->large_blocks->mutex );
+            free( system_allocator->large_blocks->blocks );
+            free( system_allocator->large_blocks );
+        }
+#endif
+
+        system_allocator->large_block_threshold = 0;
+        system_allocator->huge_page_threshold = 0;
+        system_allocator->prefault = false;
+        system_allocator->large_blocks = NULL;
     }
 }
+
+void system_allocator__huge_page_statistics(
+    SystemAllocator* system_allocator,
+    SystemAllocator__HugePageStatistics* out_statistics
+){
+    *out_statistics = (SystemAllocator__HugePageStatistics){
+        .advised_bytes = 0,
+        .backed_bytes = 0
+    };
+
+#if defined( __linux__ )
+    SystemAllocator__LargeBlocks* large_blocks = system_allocator->large_blocks;
+    RETURN_IF_FAIL( large_blocks != NULL );
+
+    pthread_mutex_lock( &large_blocks->mutex );
+
+    for( unsigned long long index = 0; index < large_blocks->count; index++ ){
+        if( large_blocks->blocks[ index ].huge ){
+            out_statistics->advised_bytes += large_blocks->blocks[ index ].size;
+        }
+    }
+
+    /* Each mapping in smaps starts with its address range, followed by its statistics, one per line. */
+    FILE* smaps = out_statistics->advised_bytes > 0 ? fopen( "/proc/self/smaps", "r" ) : NULL;
+    if( smaps != NULL ){
+        char line[ 256 ];
+        bool in_huge_block = false;
+
+        while( fgets( line, sizeof( line ), smaps ) != NULL ){
+            unsigned long long start = 0;
+            unsigned long long end = 0;
+            unsigned long long kilobytes = 0;
+
+            if( sscanf( line, "%llx-%llx ", &start, &end ) == 2 ){
+                /* Neighbouring huge page blocks may share a mapping, so it suffices that the mapping starts in one. */
+                unsigned long long index = system_allocator__large_blocks__search( large_blocks, (void*)(uintptr_t) start );
+                if( index < large_blocks->count && (uintptr_t) large_blocks->blocks[ index ].address == start ){
+                    in_huge_block = large_blocks->blocks[ index ].huge;
+                }
+                else if( index > 0 ){
+                    SystemAllocator__LargeBlock* block = &large_blocks->blocks[ index - 1 ];
+                    in_huge_block = block->huge && start < (uintptr_t) block->address + block->size;
+                }
+                else{
+                    in_huge_block = false;
+                }
+            }
+            else if( in_huge_block && sscanf( line, "AnonHugePages: %llu kB", &kilobytes ) == 1 ){
+                out_statistics->backed_bytes += kilobytes * 1024ULL;
+            }
+        }
+
+        fclose( smaps );
+    }
+
+    pthread_mutex_unlock( &large_blocks->mutex );
+#else
+    (void)( system_allocator );
+#endif
+}
+
+bool system_allocator__trim( SystemAllocator* system_allocator ){
+    (void)( system_allocator );
+
+#if defined( __GLIBC__ )
+    /* Besides shrinking the top of the heap, this releases whole free pages within every arena. */
+    return malloc_trim( 0 ) != 0;
+#else
+    return false;
+#endif
+}
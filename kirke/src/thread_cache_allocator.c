@@ -0,0 +1,471 @@
+// System Includes
+#include <pthread.h>
+#include <stdbool.h>
+#include <string.h> // memcpy, memset
+
+// Internal Includes
+#include "kirke/thread_cache_allocator.h"
+#include "kirke/math.h"
+
+/**
+ *  \brief The size of the header preceding every allocation. This keeps allocations aligned to 16 bytes.
+ */
+#define THREAD_CACHE_ALLOCATOR__HEADER_SIZE 16ULL
+
+/**
+ *  \brief The number of size classes. Sizes up to 128 bytes are spaced 16 bytes apart, and each following power
+ *  of 2, up to \ref THREAD_CACHE_ALLOCATOR__MAXIMUM_CACHED_SIZE, is divided into 4 classes.
+ */
+#define THREAD_CACHE_ALLOCATOR__CLASS_COUNT 40
+
+/**
+ *  \brief The size class recorded in the header of allocations which bypass the caches.
+ */
+#define THREAD_CACHE_ALLOCATOR__LARGE_CLASS THREAD_CACHE_ALLOCATOR__CLASS_COUNT
+
+/**
+ *  \brief The size in bytes of the chunks which the depot carves into objects.
+ */
+#define THREAD_CACHE_ALLOCATOR__CHUNK_SIZE ( 256ULL * 1024ULL )
+
+/**
+ *  \brief A singly-linked list of free objects, linked through their first bytes.
+ */
+typedef struct ThreadCacheAllocator__FreeList {
+    void *head;
+    unsigned long long length;
+} ThreadCacheAllocator__FreeList;
+
+/**
+ *  \brief The objects cached by a single thread, one free list per size class.
+ */
+typedef struct ThreadCacheAllocator__ThreadCache ThreadCacheAllocator__ThreadCache;
+
+struct ThreadCacheAllocator__ThreadCache {
+    /**
+     *  The depot to which cached objects are returned.
+     */
+    ThreadCacheAllocator__Depot *depot;
+    /**
+     *  The neighbouring thread caches registered with \ref depot.
+     */
+    ThreadCacheAllocator__ThreadCache *next;
+    ThreadCacheAllocator__ThreadCache *previous;
+    ThreadCacheAllocator__FreeList free_lists[ THREAD_CACHE_ALLOCATOR__CLASS_COUNT ];
+};
+
+struct ThreadCacheAllocator__Depot {
+    Allocator *backing_allocator;
+    /**
+     *  The key under which each thread stores its ThreadCacheAllocator__ThreadCache.
+     */
+    pthread_key_t thread_cache_key;
+    /**
+     *  Guards \ref chunks and \ref thread_caches.
+     */
+    pthread_mutex_t mutex;
+    /**
+     *  Every chunk allocated from the backing allocator, linked through their first bytes.
+     */
+    void *chunks;
+    /**
+     *  Every registered thread cache.
+     */
+    ThreadCacheAllocator__ThreadCache *thread_caches;
+    /**
+     *  The central free list for each size class, each guarded by its own mutex.
+     */
+    struct {
+        pthread_mutex_t mutex;
+        ThreadCacheAllocator__FreeList free_list;
+    } classes[ THREAD_CACHE_ALLOCATOR__CLASS_COUNT ];
+};
+
+/**
+ *  \brief Computes floor( log2( value ) ) for a non-zero value.
+ */
+static unsigned long long thread_cache_allocator__log2( unsigned long long value ){
+#if defined( __GNUC__ )
+    return 63 - __builtin_clzll( value );
+#else
+    unsigned long long result = 0;
+    while( value >>= 1 ){
+        result++;
+    }
+    return result;
+#endif
+}
+
+static unsigned long long thread_cache_allocator__size_class( unsigned long long size ){
+    if( size <= 128 ){
+        return size == 0 ? 0 : ( size - 1 ) / 16;
+    }
+
+    /* size lies in ( 2^power, 2^( power + 1 ) ], which is divided into 4 classes. */
+    unsigned long long power = thread_cache_allocator__log2( size - 1 );
+    return 8 + ( power - 7 ) * 4 + ( size - 1 - ( 1ULL << power ) ) / ( 1ULL << ( power - 2 ) );
+}
+
+static unsigned long long thread_cache_allocator__size_class__size( unsigned long long size_class ){
+    if( size_class < 8 ){
+        return ( size_class + 1 ) * 16;
+    }
+
+    unsigned long long power = 7 + ( size_class - 8 ) / 4;
+    return ( 1ULL << power ) + ( ( size_class - 8 ) % 4 + 1 ) * ( 1ULL << ( power - 2 ) );
+}
+
+/**
+ *  \brief The number of objects moved between a thread cache and the depot at a time. A thread cache holds at
+ *  most twice this many objects of each size class.
+ */
+static unsigned long long thread_cache_allocator__size_class__batch_size( unsigned long long size_class ){
+    unsigned long long batch_size = ( 32ULL * 1024ULL ) / thread_cache_allocator__size_class__size( size_class );
+    return math__max__ullong( 2, math__min__ullong( batch_size, 64 ) );
+}
+
+static unsigned long long *thread_cache_allocator__header( void *pointer ){
+    return (unsigned long long*)( (char*) pointer - THREAD_CACHE_ALLOCATOR__HEADER_SIZE );
+}
+
+/**
+ *  \brief Carves a new chunk into objects of the given size class, and pushes them onto \p free_list.
+ *  \note The caller must hold the mutex of the size class.
+ */
+static bool thread_cache_allocator__depot__carve( ThreadCacheAllocator__Depot *depot, unsigned long long size_class, ThreadCacheAllocator__FreeList *free_list ){
+    unsigned long long block_size = THREAD_CACHE_ALLOCATOR__HEADER_SIZE + thread_cache_allocator__size_class__size( size_class );
+    unsigned long long chunk_size = math__max__ullong( THREAD_CACHE_ALLOCATOR__CHUNK_SIZE, 4 * block_size );
+
+    /* The first block of each chunk links it into the depot's list of chunks. */
+    char *chunk = (char*) allocator__alloc( depot->backing_allocator, chunk_size );
+    if( chunk == NULL ){
+        return false;
+    }
+
+    pthread_mutex_lock( &depot->mutex );
+    *(void**) chunk = depot->chunks;
+    depot->chunks = chunk;
+    pthread_mutex_unlock( &depot->mutex );
+
+    for( char *block = chunk + block_size; block + block_size <= chunk + chunk_size; block += block_size ){
+        void *object = block + THREAD_CACHE_ALLOCATOR__HEADER_SIZE;
+        *thread_cache_allocator__header( object ) = size_class;
+        *(void**) object = free_list->head;
+        free_list->head = object;
+        free_list->length++;
+    }
+
+    return true;
+}
+
+/**
+ *  \brief Detaches up to \p count objects from the front of \p free_list, as a linked segment.
+ *  \returns The number of objects detached. \p out__first and \p out__last receive the ends of the segment.
+ */
+static unsigned long long thread_cache_allocator__free_list__detach( ThreadCacheAllocator__FreeList *free_list, unsigned long long count, void **out__first, void **out__last ){
+    if( free_list->head == NULL || count == 0 ){
+        return 0;
+    }
+
+    void *last = free_list->head;
+    unsigned long long detached = 1;
+    while( detached < count && *(void**) last != NULL ){
+        last = *(void**) last;
+        detached++;
+    }
+
+    *out__first = free_list->head;
+    *out__last = last;
+
+    free_list->head = *(void**) last;
+    free_list->length -= detached;
+
+    return detached;
+}
+
+/**
+ *  \brief Attaches a segment produced by thread_cache_allocator__free_list__detach to the front of \p free_list.
+ */
+static void thread_cache_allocator__free_list__attach( ThreadCacheAllocator__FreeList *free_list, void *first, void *last, unsigned long long count ){
+    if( count == 0 ){
+        return;
+    }
+
+    *(void**) last = free_list->head;
+    free_list->head = first;
+    free_list->length += count;
+}
+
+/**
+ *  \brief Moves a batch of objects from the depot to a thread's free list, carving a new chunk if necessary.
+ */
+static bool thread_cache_allocator__depot__fetch( ThreadCacheAllocator__Depot *depot, unsigned long long size_class, ThreadCacheAllocator__FreeList *free_list ){
+    ThreadCacheAllocator__FreeList *depot_free_list = &depot->classes[ size_class ].free_list;
+    void *first = NULL;
+    void *last = NULL;
+
+    pthread_mutex_lock( &depot->classes[ size_class ].mutex );
+
+    if( depot_free_list->head == NULL && thread_cache_allocator__depot__carve( depot, size_class, depot_free_list ) == false ){
+        pthread_mutex_unlock( &depot->classes[ size_class ].mutex );
+        return false;
+    }
+
+    unsigned long long count = thread_cache_allocator__free_list__detach(
+        depot_free_list,
+        thread_cache_allocator__size_class__batch_size( size_class ),
+        &first,
+        &last
+    );
+
+    pthread_mutex_unlock( &depot->classes[ size_class ].mutex );
+
+    thread_cache_allocator__free_list__attach( free_list, first, last, count );
+
+    return true;
+}
+
+/**
+ *  \brief Moves up to \p count objects from a thread's free list back to the depot.
+ */
+static void thread_cache_allocator__depot__release( ThreadCacheAllocator__Depot *depot, unsigned long long size_class, ThreadCacheAllocator__FreeList *free_list, unsigned long long count ){
+    void *first = NULL;
+    void *last = NULL;
+
+    /* The segment is detached before taking the lock, to keep the critical section short. */
+    count = thread_cache_allocator__free_list__detach( free_list, count, &first, &last );
+    if( count == 0 ){
+        return;
+    }
+
+    pthread_mutex_lock( &depot->classes[ size_class ].mutex );
+    thread_cache_allocator__free_list__attach( &depot->classes[ size_class ].free_list, first, last, count );
+    pthread_mutex_unlock( &depot->classes[ size_class ].mutex );
+}
+
+static void thread_cache_allocator__thread_cache__flush( ThreadCacheAllocator__ThreadCache *thread_cache ){
+    for( unsigned long long size_class = 0; size_class < THREAD_CACHE_ALLOCATOR__CLASS_COUNT; size_class++ ){
+        ThreadCacheAllocator__FreeList *free_list = &thread_cache->free_lists[ size_class ];
+        thread_cache_allocator__depot__release( thread_cache->depot, size_class, free_list, free_list->length );
+    }
+}
+
+/**
+ *  \brief Called by pthreads when a thread which used the allocator exits.
+ */
+static void thread_cache_allocator__thread_cache__destroy( void *thread_cache_pointer ){
+    ThreadCacheAllocator__ThreadCache *thread_cache = (ThreadCacheAllocator__ThreadCache*) thread_cache_pointer;
+    ThreadCacheAllocator__Depot *depot = thread_cache->depot;
+
+    thread_cache_allocator__thread_cache__flush( thread_cache );
+
+    pthread_mutex_lock( &depot->mutex );
+    if( thread_cache->previous != NULL ){
+        thread_cache->previous->next = thread_cache->next;
+    }
+    else{
+        depot->thread_caches = thread_cache->next;
+    }
+    if( thread_cache->next != NULL ){
+        thread_cache->next->previous = thread_cache->previous;
+    }
+    pthread_mutex_unlock( &depot->mutex );
+
+    allocator__free( depot->backing_allocator, thread_cache );
+}
+
+static ThreadCacheAllocator__ThreadCache *thread_cache_allocator__thread_cache( ThreadCacheAllocator__Depot *depot ){
+    ThreadCacheAllocator__ThreadCache *thread_cache = (ThreadCacheAllocator__ThreadCache*) pthread_getspecific( depot->thread_cache_key );
+
+    if( thread_cache == NULL ){
+        thread_cache = (ThreadCacheAllocator__ThreadCache*) allocator__calloc( depot->backing_allocator, 1, sizeof( ThreadCacheAllocator__ThreadCache ) );
+        if( thread_cache == NULL ){
+            return NULL;
+        }
+
+        thread_cache->depot = depot;
+
+        pthread_mutex_lock( &depot->mutex );
+        thread_cache->next = depot->thread_caches;
+        if( depot->thread_caches != NULL ){
+            depot->thread_caches->previous = thread_cache;
+        }
+        depot->thread_caches = thread_cache;
+        pthread_mutex_unlock( &depot->mutex );
+
+        pthread_setspecific( depot->thread_cache_key, thread_cache );
+    }
+
+    return thread_cache;
+}
+
+static void *thread_cache_allocator__alloc( unsigned long long size, void *allocator_data ){
+    ThreadCacheAllocator__Depot *depot = (ThreadCacheAllocator__Depot*) allocator_data;
+
+    if( size > THREAD_CACHE_ALLOCATOR__MAXIMUM_CACHED_SIZE ){
+        char *block = (char*) allocator__alloc( depot->backing_allocator, THREAD_CACHE_ALLOCATOR__HEADER_SIZE + size );
+        if( block == NULL ){
+            return NULL;
+        }
+
+        void *object = block + THREAD_CACHE_ALLOCATOR__HEADER_SIZE;
+        *thread_cache_allocator__header( object ) = THREAD_CACHE_ALLOCATOR__LARGE_CLASS;
+        return object;
+    }
+
+    ThreadCacheAllocator__ThreadCache *thread_cache = thread_cache_allocator__thread_cache( depot );
+    if( thread_cache == NULL ){
+        return NULL;
+    }
+
+    unsigned long long size_class = thread_cache_allocator__size_class( size );
+    ThreadCacheAllocator__FreeList *free_list = &thread_cache->free_lists[ size_class ];
+
+    if( free_list->head == NULL && thread_cache_allocator__depot__fetch( depot, size_class, free_list ) == false ){
+        return NULL;
+    }
+
+    void *object = free_list->head;
+    free_list->head = *(void**) object;
+    free_list->length--;
+
+    return object;
+}
+
+static void thread_cache_allocator__free( void *pointer, void *allocator_data ){
+    ThreadCacheAllocator__Depot *depot = (ThreadCacheAllocator__Depot*) allocator_data;
+
+    if( pointer == NULL ){
+        return;
+    }
+
+    unsigned long long size_class = *thread_cache_allocator__header( pointer );
+    if( size_class == THREAD_CACHE_ALLOCATOR__LARGE_CLASS ){
+        allocator__free( depot->backing_allocator, thread_cache_allocator__header( pointer ) );
+        return;
+    }
+
+    ThreadCacheAllocator__ThreadCache *thread_cache = thread_cache_allocator__thread_cache( depot );
+    if( thread_cache == NULL ){
+        /* Without a cache, return the object directly to the depot. */
+        ThreadCacheAllocator__FreeList free_list = { .head = pointer, .length = 1 };
+        *(void**) pointer = NULL;
+        thread_cache_allocator__depot__release( depot, size_class, &free_list, 1 );
+        return;
+    }
+
+    ThreadCacheAllocator__FreeList *free_list = &thread_cache->free_lists[ size_class ];
+    *(void**) pointer = free_list->head;
+    free_list->head = pointer;
+    free_list->length++;
+
+    unsigned long long batch_size = thread_cache_allocator__size_class__batch_size( size_class );
+    if( free_list->length > 2 * batch_size ){
+        thread_cache_allocator__depot__release( depot, size_class, free_list, batch_size );
+    }
+}
+
+static void *thread_cache_allocator__realloc( void *pointer, unsigned long long size, void *allocator_data ){
+    ThreadCacheAllocator__Depot *depot = (ThreadCacheAllocator__Depot*) allocator_data;
+
+    if( pointer == NULL ){
+        return thread_cache_allocator__alloc( size, allocator_data );
+    }
+
+    unsigned long long size_class = *thread_cache_allocator__header( pointer );
+
+    if( size_class == THREAD_CACHE_ALLOCATOR__LARGE_CLASS && size > THREAD_CACHE_ALLOCATOR__MAXIMUM_CACHED_SIZE ){
+        char *block = (char*) allocator__realloc( depot->backing_allocator, thread_cache_allocator__header( pointer ), THREAD_CACHE_ALLOCATOR__HEADER_SIZE + size );
+        return block != NULL ? block + THREAD_CACHE_ALLOCATOR__HEADER_SIZE : NULL;
+    }
+
+    unsigned long long old_size = size;
+    if( size_class != THREAD_CACHE_ALLOCATOR__LARGE_CLASS ){
+        old_size = thread_cache_allocator__size_class__size( size_class );
+        if( size <= old_size ){
+            return pointer;
+        }
+    }
+
+    void *new_memory = thread_cache_allocator__alloc( size, allocator_data );
+    if( new_memory != NULL ){
+        memcpy( new_memory, pointer, math__min__ullong( old_size, size ) );
+        thread_cache_allocator__free( pointer, allocator_data );
+    }
+
+    return new_memory;
+}
+
+void thread_cache_allocator__initialize( ThreadCacheAllocator *thread_cache_allocator, Allocator *backing_allocator ){
+    ThreadCacheAllocator__Depot *depot = (ThreadCacheAllocator__Depot*) allocator__calloc( backing_allocator, 1, sizeof( ThreadCacheAllocator__Depot ) );
+
+    *thread_cache_allocator = (ThreadCacheAllocator){
+        .allocator = NULL,
+        .backing_allocator = backing_allocator,
+        .depot = depot
+    };
+
+    RETURN_IF_FAIL( depot != NULL );
+
+    depot->backing_allocator = backing_allocator;
+    pthread_key_create( &depot->thread_cache_key, thread_cache_allocator__thread_cache__destroy );
+    pthread_mutex_init( &depot->mutex, NULL );
+    for( unsigned long long size_class = 0; size_class < THREAD_CACHE_ALLOCATOR__CLASS_COUNT; size_class++ ){
+        pthread_mutex_init( &depot->classes[ size_class ].mutex, NULL );
+    }
+
+    thread_cache_allocator->allocator = allocator__create(
+        thread_cache_allocator__alloc,
+        thread_cache_allocator__realloc,
+        thread_cache_allocator__free,
+        NULL,
+        depot
+    );
+}
+
+void thread_cache_allocator__deinitialize( ThreadCacheAllocator *thread_cache_allocator ){
+    RETURN_IF_FAIL( thread_cache_allocator != NULL && thread_cache_allocator->depot != NULL );
+
+    ThreadCacheAllocator__Depot *depot = thread_cache_allocator->depot;
+
+    allocator__destroy( thread_cache_allocator->allocator );
+
+    /* Deleting the key ensures that threads which exit later do not touch the depot. */
+    pthread_key_delete( depot->thread_cache_key );
+
+    ThreadCacheAllocator__ThreadCache *thread_cache = depot->thread_caches;
+    while( thread_cache != NULL ){
+        ThreadCacheAllocator__ThreadCache *next = thread_cache->next;
+        allocator__free( depot->backing_allocator, thread_cache );
+        thread_cache = next;
+    }
+
+    void *chunk = depot->chunks;
+    while( chunk != NULL ){
+        void *next = *(void**) chunk;
+        allocator__free( depot->backing_allocator, chunk );
+        chunk = next;
+    }
+
+    pthread_mutex_destroy( &depot->mutex );
+    for( unsigned long long size_class = 0; size_class < THREAD_CACHE_ALLOCATOR__CLASS_COUNT; size_class++ ){
+        pthread_mutex_destroy( &depot->classes[ size_class ].mutex );
+    }
+
+    allocator__free( thread_cache_allocator->backing_allocator, depot );
+
+    thread_cache_allocator->allocator = NULL;
+    thread_cache_allocator->depot = NULL;
+}
+
+void thread_cache_allocator__flush( ThreadCacheAllocator *thread_cache_allocator ){
+    RETURN_IF_FAIL( thread_cache_allocator != NULL && thread_cache_allocator->depot != NULL );
+
+    ThreadCacheAllocator__ThreadCache *thread_cache = (ThreadCacheAllocator__ThreadCache*) pthread_getspecific(
+        thread_cache_allocator->depot->thread_cache_key
+    );
+
+    if( thread_cache != NULL ){
+        thread_cache_allocator__thread_cache__flush( thread_cache );
+    }
+}
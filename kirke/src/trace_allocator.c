@@ -0,0 +1,592 @@
+#if defined( __linux__ )
+#define _DEFAULT_SOURCE // clock_gettime, CLOCK_MONOTONIC
+#endif
+
+// System Includes
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdint.h> // uintptr_t
+#include <stdio.h> // fopen, fread, fwrite, fclose, fscanf
+#include <string.h> // memcpy, memcmp
+#include <time.h> // clock_gettime
+#include <unistd.h> // sysconf
+
+// Internal Includes
+#include "kirke/trace_allocator.h"
+#include "kirke/error.h"
+#include "kirke/malloc_allocator.h"
+
+/**
+ *  \brief The magic number at the start of every trace file.
+ */
+static const char TRACE_ALLOCATOR__MAGIC[ 8 ] = { 'K', 'I', 'R', 'K', 'E', 'T', 'R', '1' };
+
+/**
+ *  \brief The number of events replayed between two measurements of the resident set.
+ */
+#define TRACE_ALLOCATOR__RESIDENT_SAMPLE_INTERVAL 4096ULL
+
+/**
+ *  \brief The header preceding every allocation. This keeps allocations aligned to 16 bytes.
+ */
+typedef struct TraceAllocator__Header {
+    unsigned long long size;
+    unsigned int pointer_id;
+    unsigned int reserved;
+} TraceAllocator__Header;
+
+/**
+ *  \brief The header of a trace file.
+ */
+typedef struct TraceAllocator__FileHeader {
+    char magic[ 8 ];
+    unsigned long long event_count;
+    unsigned long long pointer_count;
+    unsigned long long thread_count;
+} TraceAllocator__FileHeader;
+
+struct TraceAllocator__State {
+    Allocator *backing_allocator;
+    /**
+     *  The key under which each thread stores its index, plus one.
+     */
+    pthread_key_t thread_key;
+    /**
+     *  Guards the allocation of \ref chunks.
+     */
+    pthread_mutex_t mutex;
+    /**
+     *  The number of events which have been assigned a slot in the log, including those which were dropped.
+     */
+    _Atomic unsigned long long event_count;
+    _Atomic unsigned int pointer_count;
+    _Atomic unsigned int thread_count;
+    /**
+     *  The chunks of the log, which are allocated as the log reaches them.
+     */
+    TraceAllocator__Event *_Atomic chunks[ TRACE_ALLOCATOR__MAXIMUM_CHUNK_COUNT ];
+};
+
+static TraceAllocator__Header *trace_allocator__header( void *pointer ){
+    return (TraceAllocator__Header*)( (char*) pointer - sizeof( TraceAllocator__Header ) );
+}
+
+static unsigned short trace_allocator__thread( TraceAllocator__State *state ){
+    uintptr_t thread = (uintptr_t) pthread_getspecific( state->thread_key );
+    if( thread == 0 ){
+        thread = (uintptr_t) atomic_fetch_add_explicit( &state->thread_count, 1, memory_order_relaxed ) + 1;
+        pthread_setspecific( state->thread_key, (void*) thread );
+    }
+
+    /* Threads beyond the range of the event's field share its last value. */
+    return thread - 1 < 0xFFFF ? (unsigned short)( thread - 1 ) : 0xFFFF;
+}
+
+/**
+ *  \brief Appends an event to the log. Claiming a slot takes a single atomic increment, and the slot's chunk is
+ *  only allocated, under the mutex, by the first event to reach it.
+ */
+static void trace_allocator__record( TraceAllocator__State *state, TraceAllocator__Operation operation, unsigned int pointer_id, unsigned long long size ){
+    unsigned long long index = atomic_fetch_add_explicit( &state->event_count, 1, memory_order_relaxed );
+    unsigned long long chunk_index = index / TRACE_ALLOCATOR__CHUNK_EVENT_COUNT;
+    if( chunk_index >= TRACE_ALLOCATOR__MAXIMUM_CHUNK_COUNT ){
+        return;
+    }
+
+    TraceAllocator__Event *chunk = atomic_load_explicit( &state->chunks[ chunk_index ], memory_order_acquire );
+    if( chunk == NULL ){
+        pthread_mutex_lock( &state->mutex );
+
+        chunk = atomic_load_explicit( &state->chunks[ chunk_index ], memory_order_relaxed );
+        if( chunk == NULL ){
+            /* Cast for C++ compatibility */
+            chunk = (TraceAllocator__Event*) allocator__calloc( state->backing_allocator, TRACE_ALLOCATOR__CHUNK_EVENT_COUNT, sizeof( TraceAllocator__Event ) );
+            atomic_store_explicit( &state->chunks[ chunk_index ], chunk, memory_order_release );
+        }
+
+        pthread_mutex_unlock( &state->mutex );
+
+        if( chunk == NULL ){
+            return;
+        }
+    }
+
+    chunk[ index % TRACE_ALLOCATOR__CHUNK_EVENT_COUNT ] = (TraceAllocator__Event){
+        .size = size,
+        .pointer_id = pointer_id,
+        .thread = trace_allocator__thread( state ),
+        .operation = (unsigned char) operation,
+        .reserved = 0
+    };
+}
+
+static void *trace_allocator__alloc( unsigned long long size, void *allocator_data ){
+    TraceAllocator__State *state = (TraceAllocator__State*) allocator_data;
+
+    char *block = (char*) allocator__alloc( state->backing_allocator, sizeof( TraceAllocator__Header ) + size );
+    if( block == NULL ){
+        return NULL;
+    }
+
+    void *memory = block + sizeof( TraceAllocator__Header );
+    *trace_allocator__header( memory ) = (TraceAllocator__Header){
+        .size = size,
+        .pointer_id = atomic_fetch_add_explicit( &state->pointer_count, 1, memory_order_relaxed ),
+        .reserved = 0
+    };
+
+    /* The event is recorded once the memory exists, so that it precedes any use of it by another thread. */
+    trace_allocator__record( state, TraceAllocator__Operation__Alloc, trace_allocator__header( memory )->pointer_id, size );
+
+    return memory;
+}
+
+static void trace_allocator__free( void *pointer, void *allocator_data ){
+    TraceAllocator__State *state = (TraceAllocator__State*) allocator_data;
+
+    if( pointer == NULL ){
+        return;
+    }
+
+    /* The event is recorded while the memory still exists, so that it precedes its reuse by another thread. */
+    TraceAllocator__Header *header = trace_allocator__header( pointer );
+    trace_allocator__record( state, TraceAllocator__Operation__Free, header->pointer_id, header->size );
+
+    allocator__free( state->backing_allocator, header );
+}
+
+static void *trace_allocator__realloc( void *pointer, unsigned long long size, void *allocator_data ){
+    TraceAllocator__State *state = (TraceAllocator__State*) allocator_data;
+
+    if( pointer == NULL ){
+        return trace_allocator__alloc( size, allocator_data );
+    }
+
+    unsigned int pointer_id = trace_allocator__header( pointer )->pointer_id;
+
+    char *block = (char*) allocator__realloc( state->backing_allocator, trace_allocator__header( pointer ), sizeof( TraceAllocator__Header ) + size );
+    if( block == NULL ){
+        return NULL;
+    }
+
+    void *memory = block + sizeof( TraceAllocator__Header );
+    trace_allocator__header( memory )->size = size;
+
+    trace_allocator__record( state, TraceAllocator__Operation__Realloc, pointer_id, size );
+
+    return memory;
+}
+
+/**
+ *  \brief Trims the allocator beneath the trace. This is not recorded as an event, so a replay contains only the
+ *  traced program's own allocations.
+ */
+static bool trace_allocator__trim( void *allocator_data ){
+    TraceAllocator__State *state = (TraceAllocator__State*) allocator_data;
+    return allocator__trim( state->backing_allocator );
+}
+
+void trace_allocator__initialize( TraceAllocator *trace_allocator, Allocator *backing_allocator ){
+    TraceAllocator__State *state = (TraceAllocator__State*) allocator__calloc( backing_allocator, 1, sizeof( TraceAllocator__State ) );
+
+    *trace_allocator = (TraceAllocator){
+        .allocator = NULL,
+        .backing_allocator = backing_allocator,
+        .state = state
+    };
+
+    RETURN_IF_FAIL( state != NULL );
+
+    state->backing_allocator = backing_allocator;
+    pthread_key_create( &state->thread_key, NULL );
+    pthread_mutex_init( &state->mutex, NULL );
+    atomic_init( &state->event_count, 0 );
+    atomic_init( &state->pointer_count, 0 );
+    atomic_init( &state->thread_count, 0 );
+    for( unsigned long long chunk_index = 0; chunk_index < TRACE_ALLOCATOR__MAXIMUM_CHUNK_COUNT; chunk_index++ ){
+        atomic_init( &state->chunks[ chunk_index ], NULL );
+    }
+
+    trace_allocator->allocator = allocator__create(
+        trace_allocator__alloc,
+        trace_allocator__realloc,
+        trace_allocator__free,
+        NULL,
+        state
+    );
+
+    if( trace_allocator->allocator != NULL ){
+        allocator__set_trim_function( trace_allocator->allocator, trace_allocator__trim );
+    }
+
+    /* Forget the allocation of the allocator itself. Its identifier stays taken, so that it is never reused. */
+    atomic_store_explicit( &state->event_count, 0, memory_order_relaxed );
+}
+
+void trace_allocator__deinitialize( TraceAllocator *trace_allocator ){
+    RETURN_IF_FAIL( trace_allocator != NULL && trace_allocator->state != NULL );
+
+    TraceAllocator__State *state = trace_allocator->state;
+
+    allocator__destroy( trace_allocator->allocator );
+
+    pthread_key_delete( state->thread_key );
+    pthread_mutex_destroy( &state->mutex );
+
+    for( unsigned long long chunk_index = 0; chunk_index < TRACE_ALLOCATOR__MAXIMUM_CHUNK_COUNT; chunk_index++ ){
+        allocator__free( state->backing_allocator, atomic_load_explicit( &state->chunks[ chunk_index ], memory_order_relaxed ) );
+    }
+
+    allocator__free( trace_allocator->backing_allocator, state );
+
+    trace_allocator->allocator = NULL;
+    trace_allocator->state = NULL;
+}
+
+/**
+ *  \brief Counts the events which have been recorded in the chunks of the log, and the header describing them.
+ */
+static TraceAllocator__FileHeader trace_allocator__file_header( TraceAllocator__State *state, unsigned long long *out__dropped_event_count ){
+    unsigned long long slot_count = atomic_load_explicit( &state->event_count, memory_order_acquire );
+    unsigned long long event_count = 0;
+    for( unsigned long long start = 0; start < slot_count; start += TRACE_ALLOCATOR__CHUNK_EVENT_COUNT ){
+        unsigned long long chunk_index = start / TRACE_ALLOCATOR__CHUNK_EVENT_COUNT;
+        if( chunk_index < TRACE_ALLOCATOR__MAXIMUM_CHUNK_COUNT && atomic_load_explicit( &state->chunks[ chunk_index ], memory_order_acquire ) != NULL ){
+            event_count += slot_count - start < TRACE_ALLOCATOR__CHUNK_EVENT_COUNT ? slot_count - start : TRACE_ALLOCATOR__CHUNK_EVENT_COUNT;
+        }
+    }
+
+    *out__dropped_event_count = slot_count - event_count;
+
+    TraceAllocator__FileHeader file_header = {
+        .magic = { 0 },
+        .event_count = event_count,
+        .pointer_count = atomic_load_explicit( &state->pointer_count, memory_order_relaxed ),
+        .thread_count = atomic_load_explicit( &state->thread_count, memory_order_relaxed )
+    };
+    memcpy( file_header.magic, TRACE_ALLOCATOR__MAGIC, sizeof( TRACE_ALLOCATOR__MAGIC ) );
+
+    return file_header;
+}
+
+/**
+ *  \brief Calls \p visit with the events of each chunk of the log, in order, skipping chunks which were dropped.
+ *  \returns Returns false as soon as \p visit does.
+ */
+static bool trace_allocator__visit_chunks(
+    TraceAllocator__State *state,
+    bool ( *visit )( TraceAllocator__Event const *events, unsigned long long event_count, void *data ),
+    void *data
+){
+    unsigned long long slot_count = atomic_load_explicit( &state->event_count, memory_order_acquire );
+    for( unsigned long long start = 0; start < slot_count; start += TRACE_ALLOCATOR__CHUNK_EVENT_COUNT ){
+        unsigned long long chunk_index = start / TRACE_ALLOCATOR__CHUNK_EVENT_COUNT;
+        if( chunk_index >= TRACE_ALLOCATOR__MAXIMUM_CHUNK_COUNT ){
+            break;
+        }
+
+        TraceAllocator__Event *chunk = atomic_load_explicit( &state->chunks[ chunk_index ], memory_order_acquire );
+        unsigned long long event_count = slot_count - start < TRACE_ALLOCATOR__CHUNK_EVENT_COUNT ? slot_count - start : TRACE_ALLOCATOR__CHUNK_EVENT_COUNT;
+        if( chunk != NULL && !visit( chunk, event_count, data ) ){
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static bool trace_allocator__visit_chunks__copy( TraceAllocator__Event const *events, unsigned long long event_count, void *data ){
+    TraceAllocator__Event **destination = (TraceAllocator__Event**) data;
+    memcpy( *destination, events, event_count * sizeof( TraceAllocator__Event ) );
+    *destination += event_count;
+    return true;
+}
+
+static bool trace_allocator__visit_chunks__write( TraceAllocator__Event const *events, unsigned long long event_count, void *data ){
+    return fwrite( events, sizeof( TraceAllocator__Event ), event_count, (FILE*) data ) == event_count;
+}
+
+bool trace_allocator__trace( TraceAllocator const *trace_allocator, TraceAllocator__Trace *out__trace, Allocator *allocator ){
+    RETURN_VALUE_IF_FAIL( trace_allocator != NULL && trace_allocator->state != NULL && out__trace != NULL, false );
+
+    unsigned long long dropped_event_count = 0;
+    TraceAllocator__FileHeader file_header = trace_allocator__file_header( trace_allocator->state, &dropped_event_count );
+
+    *out__trace = (TraceAllocator__Trace){
+        .events = NULL,
+        .event_count = file_header.event_count,
+        .pointer_count = file_header.pointer_count,
+        .thread_count = file_header.thread_count,
+        .dropped_event_count = dropped_event_count
+    };
+
+    if( file_header.event_count > 0 ){
+        /* Cast for C++ compatibility */
+        out__trace->events = (TraceAllocator__Event*) allocator__alloc( allocator, file_header.event_count * sizeof( TraceAllocator__Event ) );
+        if( out__trace->events == NULL ){
+            out__trace->event_count = 0;
+            return false;
+        }
+
+        TraceAllocator__Event *destination = out__trace->events;
+        trace_allocator__visit_chunks( trace_allocator->state, trace_allocator__visit_chunks__copy, &destination );
+    }
+
+    return true;
+}
+
+void trace_allocator__trace__clear( TraceAllocator__Trace *trace, Allocator *allocator ){
+    if( trace != NULL ){
+        allocator__free( allocator, trace->events );
+        *trace = (TraceAllocator__Trace){ 0 };
+    }
+}
+
+bool trace_allocator__write( TraceAllocator const *trace_allocator, String file_path, Error *error ){
+    RETURN_VALUE_IF_FAIL( trace_allocator != NULL && trace_allocator->state != NULL, false );
+
+    FILE *output_file = fopen( file_path.data, "wb" );
+
+    if( output_file == NULL ){
+        error__set(
+            error,
+            "TraceAllocator",
+            TraceAllocator__Error__UnableToOpenFile,
+            "Unable to open trace file \"%.*s\".", file_path.length, file_path.data
+        );
+
+        return false;
+    }
+
+    unsigned long long dropped_event_count = 0;
+    TraceAllocator__FileHeader file_header = trace_allocator__file_header( trace_allocator->state, &dropped_event_count );
+
+    bool written =
+        fwrite( &file_header, sizeof( file_header ), 1, output_file ) == 1 &&
+        trace_allocator__visit_chunks( trace_allocator->state, trace_allocator__visit_chunks__write, output_file );
+
+    if( fclose( output_file ) != 0 ){
+        written = false;
+    }
+
+    if( !written ){
+        error__set(
+            error,
+            "TraceAllocator",
+            TraceAllocator__Error__UnableToOpenFile,
+            "Unable to write trace file \"%.*s\".", file_path.length, file_path.data
+        );
+    }
+
+    return written;
+}
+
+bool trace_allocator__read( String file_path, TraceAllocator__Trace *out__trace, Allocator *allocator, Error *error ){
+    RETURN_VALUE_IF_FAIL( out__trace != NULL, false );
+
+    *out__trace = (TraceAllocator__Trace){ 0 };
+
+    FILE *input_file = fopen( file_path.data, "rb" );
+
+    if( input_file == NULL ){
+        error__set(
+            error,
+            "TraceAllocator",
+            TraceAllocator__Error__UnableToOpenFile,
+            "Unable to open trace file \"%.*s\".", file_path.length, file_path.data
+        );
+
+        return false;
+    }
+
+    TraceAllocator__FileHeader file_header;
+    if(
+        fread( &file_header, sizeof( file_header ), 1, input_file ) != 1 ||
+        memcmp( file_header.magic, TRACE_ALLOCATOR__MAGIC, sizeof( TRACE_ALLOCATOR__MAGIC ) ) != 0 ||
+        file_header.event_count > TRACE_ALLOCATOR__MAXIMUM_CHUNK_COUNT * TRACE_ALLOCATOR__CHUNK_EVENT_COUNT
+    ){
+        fclose( input_file );
+        error__set(
+            error,
+            "TraceAllocator",
+            TraceAllocator__Error__InvalidFile,
+            "\"%.*s\" is not a trace file.", file_path.length, file_path.data
+        );
+
+        return false;
+    }
+
+    TraceAllocator__Event *events = NULL;
+    if( file_header.event_count > 0 ){
+        /* Cast for C++ compatibility */
+        events = (TraceAllocator__Event*) allocator__alloc( allocator, file_header.event_count * sizeof( TraceAllocator__Event ) );
+        if( events == NULL ){
+            fclose( input_file );
+            error__set( error, "TraceAllocator", TraceAllocator__Error__OutOfMemory, "Unable to allocate %llu events.", file_header.event_count );
+
+            return false;
+        }
+
+        if( fread( events, sizeof( TraceAllocator__Event ), file_header.event_count, input_file ) != file_header.event_count ){
+            fclose( input_file );
+            allocator__free( allocator, events );
+            error__set(
+                error,
+                "TraceAllocator",
+                TraceAllocator__Error__InvalidFile,
+                "Trace file \"%.*s\" is truncated.", file_path.length, file_path.data
+            );
+
+            return false;
+        }
+    }
+
+    fclose( input_file );
+
+    *out__trace = (TraceAllocator__Trace){
+        .events = events,
+        .event_count = file_header.event_count,
+        .pointer_count = file_header.pointer_count,
+        .thread_count = file_header.thread_count,
+        .dropped_event_count = 0
+    };
+
+    return true;
+}
+
+/**
+ *  \brief Measures the resident set of the process.
+ *  \returns The resident set, in bytes, or 0 if it is unavailable.
+ */
+static unsigned long long trace_allocator__resident_bytes( unsigned long long page_size ){
+    unsigned long long resident_pages = 0;
+
+    FILE *statm = fopen( "/proc/self/statm", "r" );
+    if( statm != NULL ){
+        if( fscanf( statm, "%*u %llu", &resident_pages ) != 1 ){
+            resident_pages = 0;
+        }
+        fclose( statm );
+    }
+
+    return resident_pages * page_size;
+}
+
+/**
+ *  \brief Writes to every page of an allocation, so that it becomes resident, as it would be in a program which
+ *  used it.
+ */
+static void trace_allocator__touch( char *memory, unsigned long long size, unsigned long long page_size ){
+    for( unsigned long long offset = 0; offset < size; offset += page_size ){
+        memory[ offset ] = 1;
+    }
+}
+
+/**
+ *  \brief Makes zeroed memory resident without changing its contents.
+ */
+static void trace_allocator__fault_in( void *memory, unsigned long long size, unsigned long long page_size ){
+    for( unsigned long long offset = 0; offset < size; offset += page_size ){
+        ( (volatile char*) memory )[ offset ] = 0;
+    }
+}
+
+bool trace_allocator__replay( TraceAllocator__Trace const *trace, Allocator *allocator, TraceAllocator__Replay *out__replay ){
+    RETURN_VALUE_IF_FAIL( trace != NULL && allocator != NULL && out__replay != NULL, false );
+
+    *out__replay = (TraceAllocator__Replay){ 0 };
+
+    /* The bookkeeping is allocated from the C library, apart from the allocator being measured. */
+    /* Cast for C++ compatibility */
+    void **pointers = (void**) malloc_allocator__calloc( NULL, trace->pointer_count + 1, sizeof( void* ) );
+    unsigned long long *sizes = (unsigned long long*) malloc_allocator__calloc( NULL, trace->pointer_count + 1, sizeof( unsigned long long ) );
+    if( pointers == NULL || sizes == NULL ){
+        malloc_allocator__free( NULL, pointers );
+        malloc_allocator__free( NULL, sizes );
+        return false;
+    }
+
+    unsigned long long page_size = (unsigned long long) sysconf( _SC_PAGESIZE );
+
+    /* Faulting the bookkeeping in up front keeps it out of the growth of the resident set. */
+    trace_allocator__fault_in( pointers, ( trace->pointer_count + 1 ) * sizeof( void* ), page_size );
+    trace_allocator__fault_in( sizes, ( trace->pointer_count + 1 ) * sizeof( unsigned long long ), page_size );
+
+    unsigned long long baseline_resident_bytes = trace_allocator__resident_bytes( page_size );
+    unsigned long long peak_resident_bytes = baseline_resident_bytes;
+    unsigned long long live_bytes = 0;
+    unsigned long long peak_live_bytes = 0;
+    bool replayed = true;
+
+    struct timespec start;
+    clock_gettime( CLOCK_MONOTONIC, &start );
+
+    unsigned long long event_index = 0;
+    for( ; event_index < trace->event_count; event_index++ ){
+        TraceAllocator__Event event = trace->events[ event_index ];
+        if( event.pointer_id >= trace->pointer_count ){
+            replayed = false;
+            break;
+        }
+
+        void **pointer = &pointers[ event.pointer_id ];
+        if( event.operation == TraceAllocator__Operation__Free ){
+            allocator__free( allocator, *pointer );
+            *pointer = NULL;
+            live_bytes -= sizes[ event.pointer_id ];
+            sizes[ event.pointer_id ] = 0;
+        }
+        else{
+            void *memory = event.operation == TraceAllocator__Operation__Alloc && *pointer == NULL
+                ? allocator__alloc( allocator, event.size )
+                : allocator__realloc( allocator, *pointer, event.size );
+            if( memory == NULL && event.size > 0 ){
+                replayed = false;
+                break;
+            }
+
+            trace_allocator__touch( (char*) memory, event.size, page_size );
+            *pointer = memory;
+            live_bytes += event.size - sizes[ event.pointer_id ];
+            sizes[ event.pointer_id ] = event.size;
+            if( live_bytes > peak_live_bytes ){
+                peak_live_bytes = live_bytes;
+            }
+        }
+
+        if( event_index % TRACE_ALLOCATOR__RESIDENT_SAMPLE_INTERVAL == 0 ){
+            unsigned long long resident_bytes = trace_allocator__resident_bytes( page_size );
+            if( resident_bytes > peak_resident_bytes ){
+                peak_resident_bytes = resident_bytes;
+            }
+        }
+    }
+
+    struct timespec end;
+    clock_gettime( CLOCK_MONOTONIC, &end );
+
+    unsigned long long resident_bytes = trace_allocator__resident_bytes( page_size );
+    if( resident_bytes > peak_resident_bytes ){
+        peak_resident_bytes = resident_bytes;
+    }
+
+    for( unsigned long long pointer_id = 0; pointer_id < trace->pointer_count; pointer_id++ ){
+        allocator__free( allocator, pointers[ pointer_id ] );
+    }
+    malloc_allocator__free( NULL, pointers );
+    malloc_allocator__free( NULL, sizes );
+
+    *out__replay = (TraceAllocator__Replay){
+        .operation_count = event_index,
+        .seconds = (double)( end.tv_sec - start.tv_sec ) + (double)( end.tv_nsec - start.tv_nsec ) * 1e-9,
+        .peak_live_bytes = peak_live_bytes,
+        .peak_resident_bytes = peak_resident_bytes - baseline_resident_bytes,
+        .fragmentation = 0.0
+    };
+
+    if( out__replay->peak_resident_bytes > peak_live_bytes ){
+        out__replay->fragmentation = 1.0 - (double) peak_live_bytes / (double) out__replay->peak_resident_bytes;
+    }
+
+    return replayed;
+}
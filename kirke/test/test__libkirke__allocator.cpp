@@ -1,6 +1,9 @@
 // 3rdParty Includes
 #include "catch2/catch.hpp"
 
+// System Includes
+#include <string.h> // memset
+
 // Internal Includes
 #include "kirke/allocator.h"
 
@@ -91,6 +94,146 @@ TEST_CASE_METHOD( Allocator__TestFixture, "allocator__realloc", "[allocator]" ){
     allocator__free( allocator, array );
 }
 
+TEST_CASE_METHOD( Allocator__TestFixture, "allocator__alloc_aligned_and_free_aligned", "[allocator]" ){
+    // This allocator does not supply aligned functions, so the over-allocating fallback is used.
+    for( unsigned long long alignment = 1; alignment <= 4096; alignment *= 2 ){
+        char* memory = (char*) allocator__alloc_aligned( allocator, 100, alignment );
+
+        REQUIRE( memory != NULL );
+        REQUIRE( (unsigned long long) memory % alignment == 0 );
+
+        memset( memory, 'a', 100 );
+        allocator__free_aligned( allocator, memory );
+    }
+
+    REQUIRE( allocator__alloc_aligned( allocator, 100, 48 ) == NULL );
+    allocator__free_aligned( allocator, NULL );
+}
+
+TEST_CASE_METHOD( Allocator__TestFixture, "allocator__alloc_aligned__size_overflow", "[allocator]" ){
+    // The padding added by the fallback must not wrap a huge size around to a small request.
+    REQUIRE( allocator__alloc_aligned( allocator, ~0ULL - 1, 64 ) == NULL );
+}
+
+TEST_CASE_METHOD( Allocator__TestFixture, "allocator__realloc_aligned", "[allocator]" ){
+    const unsigned long long ALIGNMENT = ALLOCATOR__CACHE_LINE_SIZE;
+
+    unsigned char* memory = (unsigned char*) allocator__realloc_aligned( allocator, NULL, 0, 10, ALIGNMENT );
+    REQUIRE( memory != NULL );
+    for( unsigned char value = 0; value < 10; value++ ){
+        memory[ value ] = value;
+    }
+
+    unsigned long long size = 10;
+    for( unsigned long long new_size = 64; new_size <= 1024 * 1024; new_size *= 4 ){
+        memory = (unsigned char*) allocator__realloc_aligned( allocator, memory, size, new_size, ALIGNMENT );
+        size = new_size;
+
+        REQUIRE( memory != NULL );
+        REQUIRE( (unsigned long long) memory % ALIGNMENT == 0 );
+        for( unsigned char value = 0; value < 10; value++ ){
+            REQUIRE( memory[ value ] == value );
+        }
+    }
+
+    memory = (unsigned char*) allocator__realloc_aligned( allocator, memory, size, 5, ALIGNMENT );
+    REQUIRE( (unsigned long long) memory % ALIGNMENT == 0 );
+    REQUIRE( memory[ 4 ] == 4 );
+
+    allocator__free_aligned( allocator, memory );
+}
+
+TEST_CASE_METHOD( Allocator__TestFixture, "allocator__realloc_aligned__size_overflow", "[allocator]" ){
+    const unsigned long long ALIGNMENT = 64;
+
+    char* memory = (char*) allocator__alloc_aligned( allocator, 10, ALIGNMENT );
+    REQUIRE( memory != NULL );
+    memset( memory, 'a', 10 );
+
+    // A failed realloc leaves the memory in place.
+    REQUIRE( allocator__realloc_aligned( allocator, memory, 10, ~0ULL - 1, ALIGNMENT ) == NULL );
+    REQUIRE( memory[ 9 ] == 'a' );
+
+    allocator__free_aligned( allocator, memory );
+}
+
+struct FreeSizedData{
+    unsigned long long size;
+};
+
+static void* free_sized_alloc( unsigned long long size, void* allocator_data ){
+    return malloc( size );
+}
+
+static void free_sized_free( void* pointer, void* allocator_data ){
+    free( pointer );
+}
+
+static void free_sized_free_sized( void* pointer, unsigned long long size, void* allocator_data ){
+    ( (FreeSizedData*) allocator_data )->size = size;
+    free( pointer );
+}
+
+TEST_CASE_METHOD( Allocator__TestFixture, "allocator__free_sized", "[allocator]" ){
+    // Without a free_sized function, allocator__free_sized falls back to free.
+    allocator__free_sized( allocator, allocator__alloc( allocator, 24 ), 24 );
+
+    FreeSizedData data = { 0 };
+    Allocator* sized_allocator = allocator__create( free_sized_alloc, NULL, free_sized_free, NULL, &data );
+    allocator__set_free_sized_function( sized_allocator, free_sized_free_sized );
+
+    allocator__free_sized( sized_allocator, allocator__alloc( sized_allocator, 24 ), 24 );
+    REQUIRE( data.size == 24 );
+
+    allocator__destroy( sized_allocator );
+}
+
+static void* calloc_calloc( unsigned long long count, unsigned long long size, void* allocator_data ){
+    *(bool*) allocator_data = true;
+    return calloc( count, size );
+}
+
+TEST_CASE_METHOD( Allocator__TestFixture, "allocator__calloc__calloc_function", "[allocator]" ){
+    // Without a calloc function, a count and size whose product overflows fail rather than wrapping around.
+    REQUIRE( allocator__calloc( allocator, ~0ULL / 2, 4 ) == NULL );
+
+    bool calloc_called = false;
+    Allocator* calloc_allocator = allocator__create( free_sized_alloc, NULL, free_sized_free, NULL, &calloc_called );
+    allocator__set_calloc_function( calloc_allocator, calloc_calloc );
+
+    long* array = (long*) allocator__calloc( calloc_allocator, 10, sizeof( long ) );
+    REQUIRE( calloc_called );
+    for( size_t element_index = 0; element_index < 10; element_index++ ){
+        REQUIRE( array[ element_index ] == 0 );
+    }
+
+    allocator__free( calloc_allocator, array );
+    allocator__destroy( calloc_allocator );
+}
+
+static bool try_expand_within_limit( void* pointer, unsigned long long size, void* allocator_data ){
+    return size <= *(unsigned long long*) allocator_data;
+}
+
+TEST_CASE_METHOD( Allocator__TestFixture, "allocator__try_expand", "[allocator]" ){
+    // Without a try_expand function, allocator__try_expand always fails.
+    void* memory = allocator__alloc( allocator, 24 );
+    REQUIRE( allocator__try_expand( allocator, memory, 16 ) == false );
+    REQUIRE( allocator__try_expand( allocator, NULL, 16 ) == false );
+    allocator__free( allocator, memory );
+
+    unsigned long long limit = 64;
+    Allocator* expanding_allocator = allocator__create( free_sized_alloc, NULL, free_sized_free, NULL, &limit );
+    allocator__set_try_expand_function( expanding_allocator, try_expand_within_limit );
+
+    memory = allocator__alloc( expanding_allocator, 24 );
+    REQUIRE( allocator__try_expand( expanding_allocator, memory, 64 ) );
+    REQUIRE( allocator__try_expand( expanding_allocator, memory, 65 ) == false );
+    allocator__free( expanding_allocator, memory );
+
+    allocator__destroy( expanding_allocator );
+}
+
 struct AllocatorData{
     bool out_of_memory_called;
 } allocator_data;
@@ -0,0 +1,208 @@
+// 3rdParty Includes
+#include "catch2/catch.hpp"
+
+// Internal Includes
+#include "kirke/arena_allocator.h"
+#include "kirke/string.h"
+#include "kirke/system_allocator.h"
+
+class ArenaAllocator__TestFixture{
+    protected:
+        ArenaAllocator__TestFixture(){
+            system_allocator__initialize( &system_allocator, NULL );
+            arena_allocator__initialize( &arena_allocator, system_allocator.allocator, CHUNK_SIZE );
+        }
+
+        ~ArenaAllocator__TestFixture(){
+            arena_allocator__deinitialize( &arena_allocator );
+            system_allocator__deinitialize( &system_allocator );
+        }
+
+        const unsigned long long CHUNK_SIZE = 1024;
+        SystemAllocator system_allocator;
+        ArenaAllocator arena_allocator;
+};
+
+TEST_CASE_METHOD( ArenaAllocator__TestFixture, "arena_allocator__initialize_and_deinitialize", "[arena_allocator]" ){
+    REQUIRE( arena_allocator.allocator != NULL );
+    REQUIRE( arena_allocator.backing_allocator == system_allocator.allocator );
+    REQUIRE( arena_allocator.chunk_size == CHUNK_SIZE );
+}
+
+TEST_CASE_METHOD( ArenaAllocator__TestFixture, "arena_allocator__alloc", "[arena_allocator]" ){
+    const unsigned long long ELEMENT_COUNT = 10;
+
+    long *first = (long*) allocator__alloc( arena_allocator.allocator, ELEMENT_COUNT * sizeof( long ) );
+    char *second = (char*) allocator__alloc( arena_allocator.allocator, 3 );
+    long *third = (long*) allocator__alloc( arena_allocator.allocator, ELEMENT_COUNT * sizeof( long ) );
+
+    REQUIRE( first != NULL );
+    REQUIRE( second != NULL );
+    REQUIRE( third != NULL );
+
+    // Allocations are aligned for any type, and do not overlap.
+    REQUIRE( (unsigned long long) second % sizeof( long double ) == 0 );
+    REQUIRE( (unsigned long long) third % sizeof( long double ) == 0 );
+    REQUIRE( (char*) second >= (char*)( first + ELEMENT_COUNT ) );
+    REQUIRE( (char*) third >= second + 3 );
+
+    for( unsigned long long element_index = 0; element_index < ELEMENT_COUNT; element_index++ ){
+        first[ element_index ] = 42;
+        third[ element_index ] = 24;
+    }
+
+    for( unsigned long long element_index = 0; element_index < ELEMENT_COUNT; element_index++ ){
+        REQUIRE( first[ element_index ] == 42 );
+        REQUIRE( third[ element_index ] == 24 );
+    }
+
+    allocator__free( arena_allocator.allocator, first );
+    allocator__free( arena_allocator.allocator, second );
+    allocator__free( arena_allocator.allocator, third );
+}
+
+TEST_CASE_METHOD( ArenaAllocator__TestFixture, "arena_allocator__alloc_larger_than_chunk_size", "[arena_allocator]" ){
+    char *small = (char*) allocator__alloc( arena_allocator.allocator, 16 );
+    char *large = (char*) allocator__alloc( arena_allocator.allocator, 4 * CHUNK_SIZE );
+
+    REQUIRE( small != NULL );
+    REQUIRE( large != NULL );
+
+    memset( large, 'a', 4 * CHUNK_SIZE );
+    REQUIRE( large[ 4 * CHUNK_SIZE - 1 ] == 'a' );
+}
+
+TEST_CASE_METHOD( ArenaAllocator__TestFixture, "arena_allocator__realloc_most_recent_allocation_in_place", "[arena_allocator]" ){
+    char *memory = (char*) allocator__alloc( arena_allocator.allocator, 16 );
+    memcpy( memory, "Hello, World!", 14 );
+
+    char *grown = (char*) allocator__realloc( arena_allocator.allocator, memory, 256 );
+    REQUIRE( grown == memory );
+    REQUIRE( strcmp( grown, "Hello, World!" ) == 0 );
+
+    char *shrunk = (char*) allocator__realloc( arena_allocator.allocator, grown, 14 );
+    REQUIRE( shrunk == memory );
+
+    // Having shrunk the most recent allocation, the next allocation reuses the released bytes.
+    char *next = (char*) allocator__alloc( arena_allocator.allocator, 16 );
+    REQUIRE( next < memory + 256 );
+}
+
+TEST_CASE_METHOD( ArenaAllocator__TestFixture, "arena_allocator__realloc_earlier_allocation_copies", "[arena_allocator]" ){
+    char *first = (char*) allocator__alloc( arena_allocator.allocator, 14 );
+    memcpy( first, "Hello, World!", 14 );
+
+    char *second = (char*) allocator__alloc( arena_allocator.allocator, 16 );
+    REQUIRE( second != NULL );
+
+    char *grown = (char*) allocator__realloc( arena_allocator.allocator, first, 2 * CHUNK_SIZE );
+    REQUIRE( grown != first );
+    REQUIRE( strcmp( grown, "Hello, World!" ) == 0 );
+
+    char *shrunk = (char*) allocator__realloc( arena_allocator.allocator, first, 6 );
+    REQUIRE( shrunk == first );
+}
+
+TEST_CASE_METHOD( ArenaAllocator__TestFixture, "arena_allocator__try_expand", "[arena_allocator]" ){
+    char *first = (char*) allocator__alloc( arena_allocator.allocator, 16 );
+    REQUIRE( allocator__try_expand( arena_allocator.allocator, first, 256 ) );
+
+    // The most recent allocation cannot grow beyond its chunk.
+    REQUIRE( allocator__try_expand( arena_allocator.allocator, first, 2 * CHUNK_SIZE ) == false );
+
+    // Earlier allocations can only shrink.
+    char *second = (char*) allocator__alloc( arena_allocator.allocator, 16 );
+    REQUIRE( second != NULL );
+    REQUIRE( allocator__try_expand( arena_allocator.allocator, first, 512 ) == false );
+    REQUIRE( allocator__try_expand( arena_allocator.allocator, first, 128 ) );
+}
+
+TEST_CASE_METHOD( ArenaAllocator__TestFixture, "arena_allocator__mark_and_rewind", "[arena_allocator]" ){
+    allocator__alloc( arena_allocator.allocator, 100 );
+
+    ArenaAllocator__Mark mark = arena_allocator__mark( &arena_allocator );
+
+    char *first = (char*) allocator__alloc( arena_allocator.allocator, 100 );
+    for( int chunk_index = 0; chunk_index < 4; chunk_index++ ){
+        allocator__alloc( arena_allocator.allocator, CHUNK_SIZE / 2 );
+    }
+
+    arena_allocator__rewind( &arena_allocator, mark );
+
+    char *second = (char*) allocator__alloc( arena_allocator.allocator, 100 );
+    REQUIRE( second == first );
+}
+
+TEST_CASE_METHOD( ArenaAllocator__TestFixture, "arena_allocator__rewind_keeps_small_chunks", "[arena_allocator]" ){
+    ArenaAllocator__Mark mark = arena_allocator__mark( &arena_allocator );
+
+    char *allocations[ 4 ];
+    for( int chunk_index = 0; chunk_index < 4; chunk_index++ ){
+        allocations[ chunk_index ] = (char*) allocator__alloc( arena_allocator.allocator, CHUNK_SIZE / 2 );
+    }
+
+    arena_allocator__rewind( &arena_allocator, mark );
+
+    // No retained chunk fits an allocation larger than the chunk size, but a new chunk for it keeps them for later.
+    REQUIRE( allocator__alloc( arena_allocator.allocator, 4 * CHUNK_SIZE ) != NULL );
+    for( int chunk_index = 1; chunk_index < 4; chunk_index++ ){
+        REQUIRE( allocator__alloc( arena_allocator.allocator, CHUNK_SIZE / 2 ) == allocations[ chunk_index ] );
+    }
+}
+
+TEST_CASE_METHOD( ArenaAllocator__TestFixture, "arena_allocator__reset", "[arena_allocator]" ){
+    char *first = (char*) allocator__alloc( arena_allocator.allocator, 100 );
+    for( int chunk_index = 0; chunk_index < 4; chunk_index++ ){
+        allocator__alloc( arena_allocator.allocator, CHUNK_SIZE / 2 );
+    }
+
+    arena_allocator__reset( &arena_allocator );
+
+    char *second = (char*) allocator__alloc( arena_allocator.allocator, 100 );
+    REQUIRE( second == first );
+
+    // The allocator itself must survive a reset.
+    char *third = (char*) allocator__alloc( arena_allocator.allocator, 100 );
+    REQUIRE( third != NULL );
+}
+
+TEST_CASE_METHOD( ArenaAllocator__TestFixture, "arena_allocator__trim", "[arena_allocator]" ){
+    // Nothing has been rewound, so there is no chunk to release.
+    REQUIRE( allocator__trim( arena_allocator.allocator ) == false );
+
+    ArenaAllocator__Mark mark = arena_allocator__mark( &arena_allocator );
+    char *first = (char*) allocator__alloc( arena_allocator.allocator, 100 );
+    for( int chunk_index = 0; chunk_index < 4; chunk_index++ ){
+        allocator__alloc( arena_allocator.allocator, CHUNK_SIZE / 2 );
+    }
+
+    arena_allocator__rewind( &arena_allocator, mark );
+    REQUIRE( allocator__trim( arena_allocator.allocator ) );
+    REQUIRE( arena_allocator__trim( &arena_allocator ) == false );
+
+    // The current chunk is kept, and further chunks are allocated again as needed.
+    REQUIRE( allocator__alloc( arena_allocator.allocator, 100 ) == first );
+    for( int chunk_index = 0; chunk_index < 4; chunk_index++ ){
+        char *memory = (char*) allocator__alloc( arena_allocator.allocator, CHUNK_SIZE / 2 );
+        REQUIRE( memory != NULL );
+        memory[ CHUNK_SIZE / 2 - 1 ] = 1;
+    }
+}
+
+TEST_CASE_METHOD( ArenaAllocator__TestFixture, "arena_allocator__auto_string", "[arena_allocator]" ){
+    String string;
+    string__initialize( &string, arena_allocator.allocator, 0 );
+
+    AutoString auto_string = {
+        .string = &string,
+        .allocator = arena_allocator.allocator
+    };
+
+    String expected = string__literal( "Hello, World! Hello, World! Hello, World! " );
+
+    for( int repetition = 0; repetition < 3; repetition++ ){
+        auto_string__append_elements( &auto_string, 14, "Hello, World! " );
+    }
+
+    REQUIRE( string__equals( string, expected ) );
+}
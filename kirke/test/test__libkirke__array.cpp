@@ -1,7 +1,11 @@
 // 3rdParty Includes
 #include "catch2/catch.hpp"
 
+// System Includes
+#include <stdlib.h> // malloc, realloc, free
+
 // Internal Includes
+#include "kirke/arena_allocator.h"
 #include "kirke/array.h"
 #include "kirke/system_allocator.h"
 
@@ -15,6 +19,11 @@ char chars_are_equal( char first, char second ){
 
 ARRAY__DECLARE( Array__char, array__char, char )
 ARRAY__DEFINE( Array__char, array__char, char, chars_are_equal )
+ARRAY__DECLARE( Array__int, array__int, int )
+ARRAY__DEFINE_POD( Array__int, array__int, int )
+
+ARRAY__DECLARE_SMALL( SmallArray__char, small_array__char, Array__char, char, 4 )
+ARRAY__DEFINE_SMALL( SmallArray__char, small_array__char, Array__char, char, 4 )
 
 TEST_CASE( "array__char__equals", "[array]" ){
     Array__char first = {
@@ -80,6 +89,54 @@ TEST_CASE( "array__char__index_of", "[array]" ){
     REQUIRE( index == 7 );
 }
 
+TEST_CASE( "array__char__index_of__not_found", "[array]" ){
+    Array__char array = {
+        .data = (char*) "Hello, World!",
+        .length = 13,
+        .capacity = 14,
+        .element_size = 1
+    };
+
+    // The sequence is not found where it would run past the end of the array.
+    Array__char sequence = {
+        .data = (char*) "d!!",
+        .length = 3,
+        .capacity = 4,
+        .element_size = 1
+    };
+
+    unsigned long long index = 0;
+    REQUIRE( array__char__index_of( &array, &sequence, &index ) == false );
+    REQUIRE( index == 13 );
+}
+
+TEST_CASE( "array__int__pod", "[array]" ){
+    int first_data[] = { 1, 2, 3, 1, 2, 4, 1, 2, 4 };
+    int second_data[] = { 1, 2, 3, 1, 2, 4, 1, 2, 5 };
+    int sequence_data[] = { 1, 2, 4 };
+
+    Array__int first = { .data = first_data, .length = 9, .capacity = 9, .element_size = sizeof( int ) };
+    Array__int second = { .data = second_data, .length = 9, .capacity = 9, .element_size = sizeof( int ) };
+    Array__int sequence = { .data = sequence_data, .length = 3, .capacity = 3, .element_size = sizeof( int ) };
+
+    REQUIRE( array__int__equals( first, first ) );
+    REQUIRE( array__int__equals( first, second ) == false );
+    second.length = 8;
+    REQUIRE( array__int__equals( first, second ) == false );
+    first.length = 8;
+    REQUIRE( array__int__equals( first, second ) );
+
+    unsigned long long index;
+    REQUIRE( array__int__index_of( &second, &sequence, &index ) );
+    REQUIRE( index == 3 );
+
+    // Only the first element of the sequence matches the last element of the array.
+    sequence_data[ 0 ] = 2;
+    second.length = 9;
+    REQUIRE( array__int__index_of( &second, &sequence, &index ) == false );
+    REQUIRE( index == 9 );
+}
+
 class Array__TestFixture{
     protected:
         Array__TestFixture(){
@@ -155,6 +212,53 @@ TEST_CASE_METHOD( Array__TestFixture, "auto_array__char__initialize_and_clear",
     REQUIRE( auto_array.allocator == NULL );
 }
 
+TEST_CASE_METHOD( Array__TestFixture, "auto_array__char__initialize__aligned", "[array]" ){
+    AutoArray__char auto_array = {0};
+    auto_array__char__initialize__aligned( &auto_array, system_allocator.allocator, 3, ALLOCATOR__CACHE_LINE_SIZE );
+
+    REQUIRE( auto_array.array__char->data != NULL );
+    REQUIRE( auto_array.array__char->capacity == 3 );
+    REQUIRE( auto_array.alignment == ALLOCATOR__CACHE_LINE_SIZE );
+    REQUIRE( (unsigned long long) auto_array.array__char->data % ALLOCATOR__CACHE_LINE_SIZE == 0 );
+
+    // Growth keeps the data aligned, and preserves its contents.
+    for( char value = 0; value < 100; value++ ){
+        auto_array__char__append_element( &auto_array, value );
+        REQUIRE( (unsigned long long) auto_array.array__char->data % ALLOCATOR__CACHE_LINE_SIZE == 0 );
+    }
+
+    for( char value = 0; value < 100; value++ ){
+        REQUIRE( auto_array.array__char->data[ (int) value ] == value );
+    }
+
+    auto_array__char__clear( &auto_array );
+
+    REQUIRE( auto_array.array__char == NULL );
+    REQUIRE( auto_array.alignment == 0 );
+}
+
+TEST_CASE_METHOD( Array__TestFixture, "auto_array__char__grows_in_place", "[array]" ){
+    ArenaAllocator arena_allocator;
+    arena_allocator__initialize( &arena_allocator, system_allocator.allocator, 4096 );
+
+    AutoArray__char auto_array = {0};
+    auto_array__char__initialize( &auto_array, arena_allocator.allocator, 1 );
+    char *data = auto_array.array__char->data;
+
+    // The data is the arena's most recent allocation, so it grows without moving.
+    for( int index = 0; index < 1000; index++ ){
+        auto_array__char__append_element( &auto_array, (char)( index % 100 ) );
+    }
+
+    REQUIRE( auto_array.array__char->data == data );
+    for( int index = 0; index < 1000; index++ ){
+        REQUIRE( auto_array.array__char->data[ index ] == (char)( index % 100 ) );
+    }
+
+    auto_array__char__clear( &auto_array );
+    arena_allocator__deinitialize( &arena_allocator );
+}
+
 TEST_CASE_METHOD( Array__TestFixture, "auto_array__char__append_elements", "[array]" ){
     char chars[] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
 
@@ -368,6 +472,37 @@ TEST_CASE_METHOD( Array__TestFixture, "auto_array__char__insert_elements", "[arr
 }
 
 
+TEST_CASE_METHOD( Array__TestFixture, "auto_array__char__uninitialized_growth", "[array]" ){
+    AutoArray__char auto_array = {0};
+    auto_array__char__initialize( &auto_array, system_allocator.allocator, 1 );
+    REQUIRE( auto_array.uninitialized_growth == false );
+    auto_array.uninitialized_growth = true;
+
+    for( int index = 0; index < 1000; index++ ){
+        auto_array__char__append_element( &auto_array, 'a' + index % 26 );
+
+        // The element after the last is zeroed whenever there is room for it.
+        if( auto_array.array__char->length < auto_array.array__char->capacity ){
+            REQUIRE( auto_array.array__char->data[ auto_array.array__char->length ] == 0 );
+        }
+    }
+
+    for( int index = 0; index < 1000; index++ ){
+        REQUIRE( auto_array.array__char->data[ index ] == 'a' + index % 26 );
+    }
+
+    // Elements skipped over by inserting beyond the end are still zeroed.
+    char value = 'z';
+    auto_array__char__insert_elements( &auto_array, 2000, 1, &value );
+    REQUIRE( auto_array.array__char->length == 2001 );
+    for( int index = 1000; index < 2000; index++ ){
+        REQUIRE( auto_array.array__char->data[ index ] == 0 );
+    }
+    REQUIRE( auto_array.array__char->data[ 2000 ] == 'z' );
+
+    auto_array__char__clear( &auto_array );
+}
+
 TEST_CASE_METHOD( Array__TestFixture, "auto_array__char__insert_element", "[array]" ){
     const unsigned long ELEMENT_COUNT = 10;
 
@@ -498,3 +633,290 @@ TEST_CASE_METHOD( Array__TestFixture, "auto_array__char__remove_range", "[array]
 
     auto_array__char__clear( &auto_array );
 }
+
+TEST_CASE_METHOD( Array__TestFixture, "auto_array__char__shrink_to_fit", "[array]" ){
+    AutoArray__char auto_array;
+    auto_array__char__initialize( &auto_array, system_allocator.allocator, 1 );
+
+    for( int index = 0; index < 1000; index++ ){
+        auto_array__char__append_element( &auto_array, 'a' );
+    }
+    auto_array__char__remove_range( &auto_array, 10, 990 );
+    REQUIRE( auto_array.array__char->capacity > 1000 );
+
+    auto_array__char__shrink_to_fit( &auto_array );
+
+    REQUIRE( auto_array.array__char->length == 10 );
+    REQUIRE( auto_array.array__char->capacity == 10 );
+    REQUIRE( auto_array.array__char->data[ 9 ] == 'a' );
+    REQUIRE( auto_array.array__char->data[ 10 ] == '\0' );
+
+    // The AutoArray grows again from its fitted capacity.
+    auto_array__char__append_element( &auto_array, 'b' );
+    REQUIRE( auto_array.array__char->length == 11 );
+    REQUIRE( auto_array.array__char->data[ 10 ] == 'b' );
+
+    auto_array__char__clear( &auto_array );
+}
+
+TEST_CASE_METHOD( Array__TestFixture, "auto_array__char__shrink_to_fit__aligned", "[array]" ){
+    AutoArray__char auto_array;
+    auto_array__char__initialize__aligned( &auto_array, system_allocator.allocator, 1000, ALLOCATOR__CACHE_LINE_SIZE );
+    auto_array__char__append_elements( &auto_array, 5, "hello" );
+
+    auto_array__char__shrink_to_fit__callback( &auto_array );
+
+    REQUIRE( auto_array.array__char->capacity == 5 );
+    REQUIRE( (unsigned long long) auto_array.array__char->data % ALLOCATOR__CACHE_LINE_SIZE == 0 );
+    REQUIRE( strcmp( auto_array.array__char->data, "hello" ) == 0 );
+
+    auto_array__char__clear( &auto_array );
+}
+
+TEST_CASE_METHOD( Array__TestFixture, "auto_array__char__growth_policy", "[array]" ){
+    AutoArray__char auto_array;
+    auto_array__char__initialize( &auto_array, system_allocator.allocator, 10 );
+    REQUIRE( auto_array.growth_policy == NULL );
+
+    // By default, capacity doubles, without being rounded up to a power of 2.
+    auto_array__char__append_elements( &auto_array, 11, "hello world" );
+    REQUIRE( auto_array.array__char->capacity == 20 );
+    auto_array__char__append_elements( &auto_array, 30, "012345678901234567890123456789" );
+    REQUIRE( auto_array.array__char->capacity == 41 );
+    REQUIRE( auto_array.array__char->data[ 41 ] == '\0' );
+
+    static const Array__GrowthPolicy growth_policy = {
+        .growth_factor = 1.5,
+        .minimum_capacity = 0,
+        .maximum_growth_bytes = 0
+    };
+    auto_array.growth_policy = &growth_policy;
+    auto_array__char__append_element( &auto_array, 'a' );
+    REQUIRE( auto_array.array__char->capacity == 61 );
+    REQUIRE( auto_array.array__char->length == 42 );
+
+    auto_array__char__clear( &auto_array );
+}
+
+TEST_CASE_METHOD( Array__TestFixture, "auto_array__char__growth_policy__limits", "[array]" ){
+    static const Array__GrowthPolicy growth_policy = {
+        .growth_factor = 2.0,
+        .minimum_capacity = 64,
+        .maximum_growth_bytes = 100
+    };
+
+    AutoArray__char auto_array;
+    auto_array__char__initialize( &auto_array, system_allocator.allocator, 0 );
+    auto_array.growth_policy = &growth_policy;
+
+    auto_array__char__append_element( &auto_array, 'a' );
+    REQUIRE( auto_array.array__char->capacity == 64 );
+
+    // Growth is linear once doubling would add more than maximum_growth_bytes.
+    auto_array__char__append_elements( &auto_array, 64, "0123456789012345678901234567890123456789012345678901234567890123" );
+    REQUIRE( auto_array.array__char->capacity == 128 );
+    auto_array__char__append_elements( &auto_array, 64, "0123456789012345678901234567890123456789012345678901234567890123" );
+    REQUIRE( auto_array.array__char->capacity == 228 );
+
+    // Growth always yields the capacity required.
+    char large[ 1000 ] = { 0 };
+    auto_array__char__append_elements( &auto_array, sizeof( large ), large );
+    REQUIRE( auto_array.array__char->capacity == 1129 );
+
+    auto_array__char__clear( &auto_array );
+}
+
+TEST_CASE_METHOD( Array__TestFixture, "auto_array__char__reserve", "[array]" ){
+    AutoArray__char auto_array;
+    auto_array__char__initialize( &auto_array, system_allocator.allocator, 1 );
+
+    auto_array__char__reserve( &auto_array, 1000 );
+    REQUIRE( auto_array.array__char->capacity == 1000 );
+    char *data = auto_array.array__char->data;
+
+    // Filling a reserved AutoArray to its capacity neither moves it, nor loses its terminator.
+    for( int index = 0; index < 1000; index++ ){
+        auto_array__char__append_element( &auto_array, 'a' );
+    }
+    REQUIRE( auto_array.array__char->data == data );
+    REQUIRE( auto_array.array__char->capacity == 1000 );
+    REQUIRE( auto_array.array__char->data[ 1000 ] == '\0' );
+    REQUIRE( strlen( auto_array.array__char->data ) == 1000 );
+
+    // Reserving less than the capacity has no effect.
+    auto_array__char__reserve( &auto_array, 10 );
+    REQUIRE( auto_array.array__char->capacity == 1000 );
+
+    auto_array__char__clear( &auto_array );
+}
+
+static void *array__limited_alloc( unsigned long long size, void *allocator_data ){
+    return size > *(unsigned long long*) allocator_data ? NULL : malloc( size );
+}
+
+static void *array__limited_realloc( void *pointer, unsigned long long size, void *allocator_data ){
+    return size > *(unsigned long long*) allocator_data ? NULL : realloc( pointer, size );
+}
+
+static void array__limited_free( void *pointer, void *allocator_data ){
+    (void)( allocator_data );
+    free( pointer );
+}
+
+TEST_CASE( "auto_array__char__out_of_memory", "[array]" ){
+    unsigned long long limit = 1024;
+    Allocator *allocator = allocator__create( array__limited_alloc, array__limited_realloc, array__limited_free, NULL, &limit );
+    limit = 64;
+    char large[ 100 ] = { 0 };
+
+    AutoArray__char auto_array;
+    auto_array__char__initialize( &auto_array, allocator, 1 );
+    auto_array__char__append_elements( &auto_array, 5, "hello" );
+    char *data = auto_array.array__char->data;
+    unsigned long long capacity = auto_array.array__char->capacity;
+
+    // Growth which the allocator refuses leaves the AutoArray, and its memory, as they were.
+    REQUIRE( auto_array__char__reserve( &auto_array, 100 ) == false );
+    auto_array__char__append_elements( &auto_array, sizeof( large ), large );
+    auto_array__char__insert_element( &auto_array, 100, '!' );
+    auto_array__char__resize( &auto_array, 100 );
+    REQUIRE( auto_array.array__char->data == data );
+    REQUIRE( auto_array.array__char->capacity == capacity );
+    REQUIRE( auto_array.array__char->length == 5 );
+    REQUIRE( strcmp( auto_array.array__char->data, "hello" ) == 0 );
+
+    SmallArray__char small_array;
+    small_array__char__initialize( &small_array, allocator );
+    small_array__char__append_elements( &small_array, 3, "abc" );
+    REQUIRE( small_array__char__reserve( &small_array, 100 ) == false );
+    small_array__char__append_elements( &small_array, sizeof( large ), large );
+    REQUIRE( small_array.spilled_data == NULL );
+    REQUIRE( strcmp( small_array__char__data( &small_array ), "abc" ) == 0 );
+
+    small_array__char__clear( &small_array );
+    auto_array__char__clear( &auto_array );
+    allocator__destroy( allocator );
+}
+
+TEST_CASE_METHOD( Array__TestFixture, "auto_array__char__resize", "[array]" ){
+    AutoArray__char auto_array;
+    auto_array__char__initialize( &auto_array, system_allocator.allocator, 16 );
+    auto_array__char__append_elements( &auto_array, 11, "hello world" );
+
+    // Shortening discards elements, and keeps the AutoArray terminated.
+    auto_array__char__resize( &auto_array, 5 );
+    REQUIRE( auto_array.array__char->length == 5 );
+    REQUIRE( auto_array.array__char->capacity == 16 );
+    REQUIRE( strcmp( auto_array.array__char->data, "hello" ) == 0 );
+
+    // Lengthening zeroes the new elements, including those which held discarded elements.
+    auto_array__char__resize( &auto_array, 100 );
+    REQUIRE( auto_array.array__char->length == 100 );
+    REQUIRE( auto_array.array__char->capacity >= 100 );
+    REQUIRE( auto_array.array__char->data[ 4 ] == 'o' );
+    for( int index = 5; index <= 100; index++ ){
+        REQUIRE( auto_array.array__char->data[ index ] == '\0' );
+    }
+
+    auto_array__char__resize( &auto_array, 3 );
+    auto_array__char__resize__uninitialized( &auto_array, 50 );
+    REQUIRE( auto_array.array__char->length == 50 );
+    memset( auto_array.array__char->data + 3, 'x', 47 );
+    REQUIRE( auto_array.array__char->data[ 50 ] == '\0' );
+
+    auto_array__char__clear( &auto_array );
+}
+
+TEST_CASE_METHOD( Array__TestFixture, "auto_array__char__clear__keep_capacity", "[array]" ){
+    AutoArray__char auto_array;
+    auto_array__char__initialize( &auto_array, system_allocator.allocator, 1 );
+
+    // A buffer reused across iterations only reallocates while it grows to its largest size.
+    char *data = NULL;
+    int reallocation_count = 0;
+    for( int iteration = 0; iteration < 100; iteration++ ){
+        auto_array__char__clear__keep_capacity( &auto_array );
+        REQUIRE( auto_array.array__char->length == 0 );
+        REQUIRE( auto_array.array__char->data[ 0 ] == '\0' );
+
+        for( int index = 0; index < 1000; index++ ){
+            auto_array__char__append_element( &auto_array, 'a' );
+        }
+        if( auto_array.array__char->data != data ){
+            data = auto_array.array__char->data;
+            reallocation_count++;
+        }
+    }
+
+    REQUIRE( reallocation_count == 1 );
+    REQUIRE( auto_array.array__char->length == 1000 );
+
+    auto_array__char__clear( &auto_array );
+}
+
+TEST_CASE_METHOD( Array__TestFixture, "small_array__char__inline_and_spilled", "[array]" ){
+    SmallArray__char small_array;
+    small_array__char__initialize( &small_array, system_allocator.allocator );
+    REQUIRE( small_array.length == 0 );
+    REQUIRE( small_array.capacity == 4 );
+    REQUIRE( small_array__char__data( &small_array ) == small_array.inline_data );
+
+    // Up to the inline capacity, nothing is allocated.
+    small_array__char__append_elements( &small_array, 3, "abc" );
+    small_array__char__prepend_element( &small_array, 'z' );
+    REQUIRE( small_array.spilled_data == NULL );
+    REQUIRE( strcmp( small_array.inline_data, "zabc" ) == 0 );
+
+    // Beyond it, the elements move to allocated memory.
+    small_array__char__insert_elements( &small_array, 2, 3, "123" );
+    REQUIRE( small_array.spilled_data != NULL );
+    REQUIRE( small_array.length == 7 );
+    REQUIRE( small_array.capacity == 8 );
+    REQUIRE( strcmp( small_array__char__data( &small_array ), "za123bc" ) == 0 );
+
+    small_array__char__remove_range( &small_array, 2, 3 );
+    small_array__char__remove_element( &small_array, 0 );
+    small_array__char__remove_element__fast( &small_array, 0 );
+    REQUIRE( strcmp( small_array__char__data( &small_array ), "cb" ) == 0 );
+
+    // Inserting beyond the end zeroes the elements skipped over.
+    small_array__char__insert_element( &small_array, 4, 'x' );
+    REQUIRE( small_array.length == 5 );
+    REQUIRE( small_array__char__data( &small_array )[ 2 ] == '\0' );
+    REQUIRE( small_array__char__data( &small_array )[ 3 ] == '\0' );
+    REQUIRE( small_array__char__data( &small_array )[ 4 ] == 'x' );
+
+    Array__char view = small_array__char__array( &small_array );
+    REQUIRE( view.data == small_array.spilled_data );
+    REQUIRE( view.length == 5 );
+
+    // Clearing frees the allocated memory, and leaves the small array ready to be used again.
+    small_array__char__clear( &small_array );
+    REQUIRE( small_array.spilled_data == NULL );
+    REQUIRE( small_array.capacity == 4 );
+    small_array__char__append_element( &small_array, 'a' );
+    REQUIRE( strcmp( small_array.inline_data, "a" ) == 0 );
+
+    small_array__char__clear( &small_array );
+}
+
+TEST_CASE_METHOD( Array__TestFixture, "small_array__char__reserve_and_clear__keep_capacity", "[array]" ){
+    SmallArray__char small_array;
+    small_array__char__initialize( &small_array, system_allocator.allocator );
+
+    small_array__char__reserve( &small_array, 2 );
+    REQUIRE( small_array.spilled_data == NULL );
+
+    small_array__char__append_elements( &small_array, 3, "abc" );
+    small_array__char__reserve( &small_array, 100 );
+    REQUIRE( small_array.capacity == 100 );
+    REQUIRE( strcmp( small_array__char__data( &small_array ), "abc" ) == 0 );
+
+    char *data = small_array.spilled_data;
+    small_array__char__clear__keep_capacity( &small_array );
+    REQUIRE( small_array.length == 0 );
+    REQUIRE( small_array.spilled_data == data );
+    REQUIRE( small_array__char__data( &small_array )[ 0 ] == '\0' );
+
+    small_array__char__clear( &small_array );
+}
@@ -0,0 +1,207 @@
+// 3rdParty Includes
+#include "catch2/catch.hpp"
+
+// System Includes
+#include <string.h> // memset
+
+// Internal Includes
+#include "kirke/buddy_allocator.h"
+#include "kirke/hash_map.h"
+#include "kirke/string.h"
+
+static bool ints_are_equal( int first, int second ){
+    return first == second;
+}
+
+static unsigned long long hash_int( int key ){
+    return (unsigned long long) key;
+}
+
+HASH_MAP__DECLARE( BuddyAllocator__HashMap, buddy_allocator__hash_map, int, int )
+HASH_MAP__DEFINE( BuddyAllocator__HashMap, buddy_allocator__hash_map, int, int, hash_int, ints_are_equal )
+
+static const unsigned long long REGION_SIZE = 1024 * 1024;
+
+class BuddyAllocator__TestFixture{
+    protected:
+        BuddyAllocator__TestFixture(){
+            buddy_allocator__initialize( &buddy_allocator, region, REGION_SIZE );
+            buddy_allocator__statistics( &buddy_allocator, &initial_statistics );
+        }
+
+        ~BuddyAllocator__TestFixture(){
+            buddy_allocator__deinitialize( &buddy_allocator );
+        }
+
+        alignas( 16 ) char region[ REGION_SIZE ];
+        BuddyAllocator buddy_allocator;
+        BuddyAllocator__Statistics initial_statistics;
+};
+
+TEST_CASE_METHOD( BuddyAllocator__TestFixture, "buddy_allocator__initialize_and_deinitialize", "[buddy_allocator]" ){
+    REQUIRE( buddy_allocator.allocator != NULL );
+    REQUIRE( buddy_allocator.base == region );
+    REQUIRE( buddy_allocator.size == REGION_SIZE );
+
+    // Only the Allocator structure itself is allocated, from the start of the region.
+    REQUIRE( initial_statistics.total_bytes == REGION_SIZE );
+    REQUIRE( initial_statistics.allocated_bytes >= BUDDY_ALLOCATOR__MINIMUM_BLOCK_SIZE );
+    REQUIRE( initial_statistics.allocated_bytes + initial_statistics.free_bytes == REGION_SIZE );
+    REQUIRE( initial_statistics.largest_free_block == REGION_SIZE / 2 );
+}
+
+TEST_CASE_METHOD( BuddyAllocator__TestFixture, "buddy_allocator__alloc_and_free_coalesce", "[buddy_allocator]" ){
+    void* allocations[ 100 ];
+    for( int index = 0; index < 100; index++ ){
+        allocations[ index ] = allocator__alloc( buddy_allocator.allocator, 10 + index * 37 );
+        REQUIRE( allocations[ index ] != NULL );
+        REQUIRE( (unsigned long long) allocations[ index ] % 16 == 0 );
+        memset( allocations[ index ], index, 10 + index * 37 );
+    }
+
+    BuddyAllocator__Statistics statistics;
+    buddy_allocator__statistics( &buddy_allocator, &statistics );
+    REQUIRE( statistics.allocated_bytes > statistics.requested_bytes );
+    REQUIRE( statistics.allocated_bytes + statistics.free_bytes == REGION_SIZE );
+
+    // Freeing every other allocation first leaves holes, which merge again once their neighbours are freed.
+    for( int index = 0; index < 100; index += 2 ){
+        allocator__free( buddy_allocator.allocator, allocations[ index ] );
+    }
+    for( int index = 1; index < 100; index += 2 ){
+        REQUIRE( *(unsigned char*) allocations[ index ] == index );
+        allocator__free( buddy_allocator.allocator, allocations[ index ] );
+    }
+
+    buddy_allocator__statistics( &buddy_allocator, &statistics );
+    REQUIRE( statistics.allocated_bytes == initial_statistics.allocated_bytes );
+    REQUIRE( statistics.requested_bytes == initial_statistics.requested_bytes );
+    REQUIRE( statistics.free_block_count == initial_statistics.free_block_count );
+    REQUIRE( statistics.largest_free_block == REGION_SIZE / 2 );
+}
+
+TEST_CASE_METHOD( BuddyAllocator__TestFixture, "buddy_allocator__exhaustion_and_fragmentation", "[buddy_allocator]" ){
+    // The upper half of the region is one block, which can be allocated exactly once.
+    void* half = allocator__alloc( buddy_allocator.allocator, REGION_SIZE / 2 - 16 );
+    REQUIRE( half != NULL );
+    REQUIRE( allocator__alloc( buddy_allocator.allocator, REGION_SIZE / 2 - 16 ) == NULL );
+    allocator__free( buddy_allocator.allocator, half );
+
+    // Filling the region with blocks of a sixteenth, then freeing every other one, leaves no two free blocks which
+    // are buddies. Large requests then fail despite half of the region being free.
+    const unsigned long long BLOCK_SIZE = REGION_SIZE / 16;
+    void* blocks[ 16 ];
+    int block_count = 0;
+    while( ( blocks[ block_count ] = allocator__alloc( buddy_allocator.allocator, BLOCK_SIZE - 16 ) ) != NULL ){
+        block_count++;
+    }
+    REQUIRE( block_count == 15 );
+
+    for( int index = 1; index < block_count; index += 2 ){
+        allocator__free( buddy_allocator.allocator, blocks[ index ] );
+    }
+
+    BuddyAllocator__Statistics statistics;
+    buddy_allocator__statistics( &buddy_allocator, &statistics );
+    REQUIRE( statistics.free_bytes >= REGION_SIZE / 2 - BLOCK_SIZE );
+    REQUIRE( statistics.largest_free_block == BLOCK_SIZE );
+    REQUIRE( statistics.external_fragmentation > 0.75 );
+    REQUIRE( allocator__alloc( buddy_allocator.allocator, 2 * BLOCK_SIZE - 16 ) == NULL );
+
+    for( int index = 0; index < block_count; index += 2 ){
+        allocator__free( buddy_allocator.allocator, blocks[ index ] );
+    }
+
+    buddy_allocator__statistics( &buddy_allocator, &statistics );
+    REQUIRE( statistics.largest_free_block == REGION_SIZE / 2 );
+}
+
+TEST_CASE_METHOD( BuddyAllocator__TestFixture, "buddy_allocator__try_expand_merges_free_buddies", "[buddy_allocator]" ){
+    // The first allocation takes the free 1 KB block, so the second splits a 2 KB block and takes its lower half.
+    void* first = allocator__alloc( buddy_allocator.allocator, 1000 );
+    char* memory = (char*) allocator__alloc( buddy_allocator.allocator, 1000 );
+    memset( memory, 'a', 1000 );
+
+    // A block allocated in the upper half stops it from growing.
+    void* neighbour = allocator__alloc( buddy_allocator.allocator, 1000 );
+    REQUIRE( neighbour == memory + 1024 );
+    REQUIRE( allocator__try_expand( buddy_allocator.allocator, memory, 2000 ) == false );
+    allocator__free( buddy_allocator.allocator, neighbour );
+
+    // Once the upper half is free, the block grows by merging with it.
+    REQUIRE( allocator__try_expand( buddy_allocator.allocator, memory, 2000 ) );
+    REQUIRE( allocator__realloc( buddy_allocator.allocator, memory, 1500 ) == memory );
+    REQUIRE( memory[ 999 ] == 'a' );
+
+    // The merged block is itself the upper half of a 4 KB block, so it cannot grow any further in place.
+    REQUIRE( allocator__try_expand( buddy_allocator.allocator, memory, 4000 ) == false );
+    memory = (char*) allocator__realloc( buddy_allocator.allocator, memory, 4000 );
+    REQUIRE( memory[ 999 ] == 'a' );
+
+    allocator__free( buddy_allocator.allocator, memory );
+    allocator__free( buddy_allocator.allocator, first );
+
+    BuddyAllocator__Statistics statistics;
+    buddy_allocator__statistics( &buddy_allocator, &statistics );
+    REQUIRE( statistics.allocated_bytes == initial_statistics.allocated_bytes );
+    REQUIRE( statistics.free_block_count == initial_statistics.free_block_count );
+}
+
+TEST_CASE_METHOD( BuddyAllocator__TestFixture, "buddy_allocator__auto_string_and_hash_map", "[buddy_allocator]" ){
+    AutoString auto_string;
+    auto_string__initialize( &auto_string, buddy_allocator.allocator, 1 );
+    for( int repetition = 0; repetition < 1000; repetition++ ){
+        auto_string__append_elements( &auto_string, 14, "Hello, World! " );
+    }
+    REQUIRE( auto_string.string->length == 14000 );
+    REQUIRE( strncmp( auto_string.string->data + 13986, "Hello, World! ", 14 ) == 0 );
+    auto_string__clear( &auto_string );
+
+    BuddyAllocator__HashMap hash_map;
+    buddy_allocator__hash_map__initialize( &hash_map, buddy_allocator.allocator, 64 );
+    for( int key = 0; key < 1000; key++ ){
+        buddy_allocator__hash_map__insert( &hash_map, key, -key );
+    }
+
+    int value = 0;
+    REQUIRE( buddy_allocator__hash_map__retrieve( &hash_map, 500, &value ) );
+    REQUIRE( value == -500 );
+    buddy_allocator__hash_map__clear( &hash_map );
+
+    BuddyAllocator__Statistics statistics;
+    buddy_allocator__statistics( &buddy_allocator, &statistics );
+    REQUIRE( statistics.allocated_bytes == initial_statistics.allocated_bytes );
+}
+
+TEST_CASE( "buddy_allocator__initialize__mapped", "[buddy_allocator]" ){
+    const unsigned long long SIZE = 3 * 1024 * 1024;
+
+    BuddyAllocator buddy_allocator;
+    buddy_allocator__initialize__mapped( &buddy_allocator, SIZE );
+
+    REQUIRE( buddy_allocator.allocator != NULL );
+    REQUIRE( buddy_allocator.size == SIZE );
+
+    // A region which is not a power of 2 is carved into blocks of 2 MB and 1 MB.
+    void* large = allocator__alloc( buddy_allocator.allocator, 2 * 1024 * 1024 - 16 );
+    void* small = allocator__alloc( buddy_allocator.allocator, 512 * 1024 - 16 );
+    REQUIRE( large != NULL );
+    REQUIRE( small != NULL );
+
+    allocator__free( buddy_allocator.allocator, large );
+    allocator__free( buddy_allocator.allocator, small );
+    buddy_allocator__deinitialize( &buddy_allocator );
+
+    REQUIRE( buddy_allocator.allocator == NULL );
+    REQUIRE( buddy_allocator.mapping == NULL );
+}
+
+TEST_CASE( "buddy_allocator__region_too_small", "[buddy_allocator]" ){
+    char region[ 32 ];
+
+    BuddyAllocator buddy_allocator;
+    buddy_allocator__initialize( &buddy_allocator, region, sizeof( region ) );
+
+    REQUIRE( buddy_allocator.allocator == NULL );
+    buddy_allocator__deinitialize( &buddy_allocator );
+}
@@ -0,0 +1,274 @@
+// System Includes
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string.h> // memcpy, strcmp
+#include <thread>
+#include <vector>
+
+// 3rdParty Includes
+#include "catch2/catch.hpp"
+
+// Internal Includes
+#include "kirke/concurrent_pool_allocator.h"
+#include "kirke/list.h"
+#include "kirke/system_allocator.h"
+
+bool concurrent_pool_allocator__ints_are_equal( int first, int second ){
+    return first == second;
+}
+
+LIST__DECLARE( ConcurrentPoolAllocator__List__Int, concurrent_pool_allocator__list__int, int )
+LIST__DEFINE( ConcurrentPoolAllocator__List__Int, concurrent_pool_allocator__list__int, int, concurrent_pool_allocator__ints_are_equal )
+
+/**
+ *  The object handed between threads by the stress tests. Each object records who allocated it, so that an object
+ *  served to two threads at once is detected.
+ */
+struct ConcurrentPoolAllocator__Message{
+    unsigned long long owner;
+    unsigned long long sequence;
+    unsigned long long checksum;
+};
+
+class ConcurrentPoolAllocator__TestFixture{
+    protected:
+        ConcurrentPoolAllocator__TestFixture(){
+            system_allocator__initialize( &system_allocator, NULL );
+            concurrent_pool_allocator__initialize( &concurrent_pool_allocator, system_allocator.allocator, sizeof( ConcurrentPoolAllocator__Message ), SLAB_SIZE );
+        }
+
+        ~ConcurrentPoolAllocator__TestFixture(){
+            concurrent_pool_allocator__deinitialize( &concurrent_pool_allocator );
+            system_allocator__deinitialize( &system_allocator );
+        }
+
+        const unsigned long long SLAB_SIZE = 4096;
+        SystemAllocator system_allocator;
+        ConcurrentPoolAllocator concurrent_pool_allocator;
+};
+
+TEST_CASE_METHOD( ConcurrentPoolAllocator__TestFixture, "concurrent_pool_allocator__initialize_and_deinitialize", "[concurrent_pool_allocator]" ){
+    REQUIRE( concurrent_pool_allocator.allocator != NULL );
+    REQUIRE( concurrent_pool_allocator.backing_allocator == system_allocator.allocator );
+    REQUIRE( concurrent_pool_allocator.object_size == sizeof( ConcurrentPoolAllocator__Message ) );
+    REQUIRE( concurrent_pool_allocator.slab_size == SLAB_SIZE );
+    REQUIRE( concurrent_pool_allocator.depot != NULL );
+}
+
+TEST_CASE( "concurrent_pool_allocator__sizes_are_rounded", "[concurrent_pool_allocator]" ){
+    SystemAllocator system_allocator;
+    system_allocator__initialize( &system_allocator, NULL );
+
+    ConcurrentPoolAllocator concurrent_pool_allocator;
+    concurrent_pool_allocator__initialize( &concurrent_pool_allocator, system_allocator.allocator, 3, 3000 );
+
+    REQUIRE( concurrent_pool_allocator.object_size == 16 );
+    REQUIRE( concurrent_pool_allocator.slab_size == 4096 );
+
+    concurrent_pool_allocator__deinitialize( &concurrent_pool_allocator );
+
+    concurrent_pool_allocator__initialize( &concurrent_pool_allocator, system_allocator.allocator, 20, 0 );
+
+    REQUIRE( concurrent_pool_allocator.object_size == 24 );
+    REQUIRE( concurrent_pool_allocator.slab_size == CONCURRENT_POOL_ALLOCATOR__DEFAULT_SLAB_SIZE );
+
+    concurrent_pool_allocator__deinitialize( &concurrent_pool_allocator );
+    system_allocator__deinitialize( &system_allocator );
+}
+
+TEST_CASE_METHOD( ConcurrentPoolAllocator__TestFixture, "concurrent_pool_allocator__free_recycles_objects", "[concurrent_pool_allocator]" ){
+    char *first = (char*) allocator__alloc( concurrent_pool_allocator.allocator, concurrent_pool_allocator.object_size );
+    char *second = (char*) allocator__alloc( concurrent_pool_allocator.allocator, concurrent_pool_allocator.object_size );
+
+    // Fresh objects are carved from the slab in address order.
+    REQUIRE( concurrent_pool_allocator__owns( &concurrent_pool_allocator, first ) );
+    REQUIRE( second == first + concurrent_pool_allocator.object_size );
+    REQUIRE( (unsigned long long) first % 8 == 0 );
+
+    allocator__free( concurrent_pool_allocator.allocator, first );
+    allocator__free_sized( concurrent_pool_allocator.allocator, second, concurrent_pool_allocator.object_size );
+
+    // Freed objects are reused from the thread's magazine in last-in, first-out order.
+    REQUIRE( allocator__alloc( concurrent_pool_allocator.allocator, 1 ) == second );
+    REQUIRE( allocator__alloc( concurrent_pool_allocator.allocator, 1 ) == first );
+}
+
+TEST_CASE_METHOD( ConcurrentPoolAllocator__TestFixture, "concurrent_pool_allocator__large_requests_are_forwarded", "[concurrent_pool_allocator]" ){
+    char *small = (char*) allocator__alloc( concurrent_pool_allocator.allocator, 10 );
+    memcpy( small, "Hello", 6 );
+
+    // Growing beyond the object size moves the object to the backing allocator.
+    char *large = (char*) allocator__realloc( concurrent_pool_allocator.allocator, small, 1000 );
+    REQUIRE( large != NULL );
+    REQUIRE( concurrent_pool_allocator__owns( &concurrent_pool_allocator, large ) == false );
+    REQUIRE( strcmp( large, "Hello" ) == 0 );
+
+    // Shrinking to the object size moves it back into a slab.
+    small = (char*) allocator__realloc( concurrent_pool_allocator.allocator, large, 10 );
+    REQUIRE( concurrent_pool_allocator__owns( &concurrent_pool_allocator, small ) );
+    REQUIRE( strcmp( small, "Hello" ) == 0 );
+
+    allocator__free( concurrent_pool_allocator.allocator, small );
+    REQUIRE( concurrent_pool_allocator__owns( &concurrent_pool_allocator, &small ) == false );
+}
+
+TEST_CASE_METHOD( ConcurrentPoolAllocator__TestFixture, "concurrent_pool_allocator__flush", "[concurrent_pool_allocator]" ){
+    void *first = allocator__alloc( concurrent_pool_allocator.allocator, 16 );
+    allocator__free( concurrent_pool_allocator.allocator, first );
+
+    concurrent_pool_allocator__flush( &concurrent_pool_allocator );
+
+    // After flushing, another thread pops the magazine from the depot and reuses the object.
+    void *second = NULL;
+    std::thread thread( [ & ](){
+        second = allocator__alloc( concurrent_pool_allocator.allocator, 16 );
+    } );
+    thread.join();
+
+    REQUIRE( second == first );
+}
+
+TEST_CASE_METHOD( ConcurrentPoolAllocator__TestFixture, "concurrent_pool_allocator__list_links", "[concurrent_pool_allocator]" ){
+    ConcurrentPoolAllocator pool;
+    concurrent_pool_allocator__initialize( &pool, system_allocator.allocator, sizeof( ConcurrentPoolAllocator__List__Int ), 0 );
+
+    ConcurrentPoolAllocator__List__Int *list;
+    concurrent_pool_allocator__list__int__initialize( &list, pool.allocator, 0 );
+
+    for( int value = 1; value < 1000; value++ ){
+        list = concurrent_pool_allocator__list__int__prepend( list, pool.allocator, value );
+    }
+
+    REQUIRE( concurrent_pool_allocator__list__int__length( list ) == 1000 );
+    REQUIRE( concurrent_pool_allocator__owns( &pool, list ) );
+
+    concurrent_pool_allocator__list__int__clear( list, pool.allocator );
+    concurrent_pool_allocator__deinitialize( &pool );
+}
+
+TEST_CASE_METHOD( ConcurrentPoolAllocator__TestFixture, "concurrent_pool_allocator__stress_random", "[concurrent_pool_allocator]" ){
+    const int THREAD_COUNT = 8;
+    const int ITERATION_COUNT = 200000;
+    const int LIVE_OBJECT_COUNT = 256;
+
+    std::vector< std::thread > threads;
+    std::vector< int > results( THREAD_COUNT, 0 );
+
+    for( int thread_index = 0; thread_index < THREAD_COUNT; thread_index++ ){
+        threads.push_back( std::thread( [ &, thread_index ](){
+            std::vector< ConcurrentPoolAllocator__Message* > objects( LIVE_OBJECT_COUNT, NULL );
+            unsigned long long state = 0x9E3779B97F4A7C15ULL * ( thread_index + 1 );
+            bool success = true;
+
+            for( int iteration = 0; iteration < ITERATION_COUNT; iteration++ ){
+                state ^= state << 13;
+                state ^= state >> 7;
+                state ^= state << 17;
+
+                ConcurrentPoolAllocator__Message *&object = objects[ state % LIVE_OBJECT_COUNT ];
+                if( object != NULL ){
+                    success = success && object->owner == (unsigned long long) thread_index && object->checksum == ~object->sequence;
+                    allocator__free( concurrent_pool_allocator.allocator, object );
+                }
+
+                object = (ConcurrentPoolAllocator__Message*) allocator__alloc( concurrent_pool_allocator.allocator, sizeof( ConcurrentPoolAllocator__Message ) );
+                object->owner = thread_index;
+                object->sequence = iteration;
+                object->checksum = ~object->sequence;
+            }
+
+            for( int object_index = 0; object_index < LIVE_OBJECT_COUNT; object_index++ ){
+                allocator__free( concurrent_pool_allocator.allocator, objects[ object_index ] );
+            }
+
+            results[ thread_index ] = success ? 1 : 0;
+        } ) );
+    }
+
+    for( int thread_index = 0; thread_index < THREAD_COUNT; thread_index++ ){
+        threads[ thread_index ].join();
+        REQUIRE( results[ thread_index ] == 1 );
+    }
+}
+
+TEST_CASE_METHOD( ConcurrentPoolAllocator__TestFixture, "concurrent_pool_allocator__stress_producers_and_consumers", "[concurrent_pool_allocator]" ){
+    const int PRODUCER_COUNT = 4;
+    const int CONSUMER_COUNT = 4;
+    const unsigned long long MESSAGE_COUNT = 100000;
+
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::deque< ConcurrentPoolAllocator__Message* > queue;
+    int finished_producer_count = 0;
+
+    std::vector< std::thread > threads;
+    std::vector< unsigned long long > received( CONSUMER_COUNT, 0 );
+    std::vector< int > results( CONSUMER_COUNT, 0 );
+
+    // Objects are allocated by one thread and freed by another, so they migrate between the threads' magazines
+    // through the depot.
+    for( int producer = 0; producer < PRODUCER_COUNT; producer++ ){
+        threads.push_back( std::thread( [ &, producer ](){
+            for( unsigned long long sequence = 0; sequence < MESSAGE_COUNT; sequence++ ){
+                ConcurrentPoolAllocator__Message *message = (ConcurrentPoolAllocator__Message*) allocator__alloc(
+                    concurrent_pool_allocator.allocator,
+                    sizeof( ConcurrentPoolAllocator__Message )
+                );
+                message->owner = producer;
+                message->sequence = sequence;
+                message->checksum = ~sequence;
+
+                std::lock_guard< std::mutex > lock( mutex );
+                queue.push_back( message );
+                condition.notify_one();
+            }
+
+            std::lock_guard< std::mutex > lock( mutex );
+            finished_producer_count++;
+            condition.notify_all();
+        } ) );
+    }
+
+    for( int consumer = 0; consumer < CONSUMER_COUNT; consumer++ ){
+        threads.push_back( std::thread( [ &, consumer ](){
+            bool success = true;
+
+            while( true ){
+                std::vector< ConcurrentPoolAllocator__Message* > batch;
+                {
+                    std::unique_lock< std::mutex > lock( mutex );
+                    condition.wait( lock, [ & ](){ return queue.empty() == false || finished_producer_count == PRODUCER_COUNT; } );
+                    if( queue.empty() ){
+                        break;
+                    }
+
+                    while( queue.empty() == false && batch.size() < 64 ){
+                        batch.push_back( queue.front() );
+                        queue.pop_front();
+                    }
+                }
+
+                for( ConcurrentPoolAllocator__Message *message : batch ){
+                    success = success && message->owner < PRODUCER_COUNT && message->checksum == ~message->sequence;
+                    message->owner = ~0ULL;
+                    allocator__free( concurrent_pool_allocator.allocator, message );
+                }
+                received[ consumer ] += batch.size();
+            }
+
+            results[ consumer ] = success ? 1 : 0;
+        } ) );
+    }
+
+    for( std::thread &thread : threads ){
+        thread.join();
+    }
+
+    unsigned long long total_received = 0;
+    for( int consumer = 0; consumer < CONSUMER_COUNT; consumer++ ){
+        REQUIRE( results[ consumer ] == 1 );
+        total_received += received[ consumer ];
+    }
+    REQUIRE( total_received == PRODUCER_COUNT * MESSAGE_COUNT );
+}
@@ -0,0 +1,122 @@
+// 3rdParty Includes
+#include "catch2/catch.hpp"
+
+// System Includes
+#include <map>
+#include <utility>
+#include <vector>
+
+// Internal Includes
+#include "kirke/flat_map.h"
+#include "kirke/system_allocator.h"
+
+static bool ints_are_less( int first, int second ){
+    return first < second;
+}
+
+FLAT_MAP__DECLARE( FlatMap__IntToInt, flat_map__int_to_int, int, int )
+FLAT_MAP__DEFINE( FlatMap__IntToInt, flat_map__int_to_int, int, int, ints_are_less )
+
+static void flat_map__test__collect( int key, int value, void *user_data ){
+    static_cast<std::vector<std::pair<int, int> >*>( user_data )->push_back( std::make_pair( key, value ) );
+}
+
+class FlatMap__TestFixture {
+    protected:
+
+        FlatMap__TestFixture(){
+            system_allocator__initialize( &system_allocator, NULL );
+        }
+
+        ~FlatMap__TestFixture(){
+            system_allocator__deinitialize( &system_allocator );
+        }
+
+        std::vector<std::pair<int, int> > pairs( FlatMap__IntToInt *flat_map ){
+            std::vector<std::pair<int, int> > pairs;
+            flat_map__int_to_int__for_each( flat_map, flat_map__test__collect, &pairs );
+            return pairs;
+        }
+
+        SystemAllocator system_allocator;
+};
+
+TEST_CASE_METHOD( FlatMap__TestFixture, "flat_map__insert_and_retrieve", "[flat_map]" ){
+    FlatMap__IntToInt flat_map;
+    flat_map__int_to_int__initialize( &flat_map, system_allocator.allocator, 4 );
+
+    flat_map__int_to_int__insert( &flat_map, 42, 1 );
+    flat_map__int_to_int__insert( &flat_map, 7, 2 );
+    flat_map__int_to_int__insert( &flat_map, 42, 3 );
+
+    int value;
+    REQUIRE( flat_map__int_to_int__retrieve( &flat_map, 42, &value ) );
+    REQUIRE( value == 3 );
+    REQUIRE( flat_map__int_to_int__retrieve( &flat_map, 7, &value ) );
+    REQUIRE( value == 2 );
+    REQUIRE_FALSE( flat_map__int_to_int__retrieve( &flat_map, 8, &value ) );
+
+    REQUIRE( pairs( &flat_map ) == std::vector<std::pair<int, int> >( { { 7, 2 }, { 42, 3 } } ) );
+
+    flat_map__int_to_int__clear( &flat_map );
+}
+
+TEST_CASE_METHOD( FlatMap__TestFixture, "flat_map__delete", "[flat_map]" ){
+    FlatMap__IntToInt flat_map;
+    flat_map__int_to_int__initialize( &flat_map, system_allocator.allocator, 0 );
+
+    std::map<int, int> expected;
+    unsigned long long state = 88172645463325252ULL;
+    for( int operation = 0; operation < 20000; operation++ ){
+        /* xorshift64 */
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+
+        int key = (int)( state % 1000 );
+        if( ( state >> 32 ) % 3 == 0 ){
+            flat_map__int_to_int__delete( &flat_map, key );
+            expected.erase( key );
+        }
+        else{
+            flat_map__int_to_int__insert( &flat_map, key, operation );
+            expected[ key ] = operation;
+        }
+    }
+
+    REQUIRE( pairs( &flat_map ) == std::vector<std::pair<int, int> >( expected.begin(), expected.end() ) );
+
+    flat_map__int_to_int__clear( &flat_map );
+}
+
+TEST_CASE_METHOD( FlatMap__TestFixture, "flat_map__initialize__pairs", "[flat_map]" ){
+    std::vector<FlatMap__IntToInt__KeyValuePair> inputs;
+    std::map<int, int> expected;
+    unsigned long long state = 88172645463325252ULL;
+    for( int index = 0; index < 10000; index++ ){
+        /* xorshift64 */
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+
+        // Of pairs with equal keys, the last is kept.
+        FlatMap__IntToInt__KeyValuePair pair = { .key = (int)( state % 3000 ), .value = index };
+        inputs.push_back( pair );
+        expected[ pair.key ] = pair.value;
+    }
+
+    FlatMap__IntToInt flat_map;
+    flat_map__int_to_int__initialize__pairs( &flat_map, system_allocator.allocator, inputs.size(), inputs.data() );
+    REQUIRE( pairs( &flat_map ) == std::vector<std::pair<int, int> >( expected.begin(), expected.end() ) );
+
+    for( int key = -10; key < 3010; key++ ){
+        int value;
+        bool found = flat_map__int_to_int__retrieve( &flat_map, key, &value );
+        REQUIRE( found == ( expected.count( key ) == 1 ) );
+        if( found ){
+            REQUIRE( value == expected[ key ] );
+        }
+    }
+
+    flat_map__int_to_int__clear( &flat_map );
+}
@@ -0,0 +1,94 @@
+// 3rdParty Includes
+#include "catch2/catch.hpp"
+
+// System Includes
+#include <set>
+#include <vector>
+
+// Internal Includes
+#include "kirke/flat_set.h"
+#include "kirke/system_allocator.h"
+
+static bool ints_are_less( int first, int second ){
+    return first < second;
+}
+
+FLAT_SET__DECLARE( FlatSet__Int, flat_set__int, int )
+FLAT_SET__DEFINE( FlatSet__Int, flat_set__int, int, ints_are_less )
+
+static void flat_set__test__collect( int element, void *user_data ){
+    static_cast<std::vector<int>*>( user_data )->push_back( element );
+}
+
+class FlatSet__TestFixture {
+    protected:
+
+        FlatSet__TestFixture(){
+            system_allocator__initialize( &system_allocator, NULL );
+        }
+
+        ~FlatSet__TestFixture(){
+            system_allocator__deinitialize( &system_allocator );
+        }
+
+        std::vector<int> elements( FlatSet__Int *flat_set ){
+            std::vector<int> elements;
+            flat_set__int__for_each( flat_set, flat_set__test__collect, &elements );
+            return elements;
+        }
+
+        SystemAllocator system_allocator;
+};
+
+TEST_CASE_METHOD( FlatSet__TestFixture, "flat_set__insert_contains_and_delete", "[flat_set]" ){
+    FlatSet__Int flat_set;
+    flat_set__int__initialize( &flat_set, system_allocator.allocator, 0 );
+
+    int inserted[] = { 5, 3, 9, 3, 1, 7, 5 };
+    for( int element : inserted ){
+        flat_set__int__insert( &flat_set, element );
+    }
+
+    REQUIRE( elements( &flat_set ) == std::vector<int>( { 1, 3, 5, 7, 9 } ) );
+    REQUIRE( flat_set__int__contains( &flat_set, 7 ) );
+    REQUIRE_FALSE( flat_set__int__contains( &flat_set, 4 ) );
+    REQUIRE_FALSE( flat_set__int__contains( &flat_set, 10 ) );
+
+    flat_set__int__delete( &flat_set, 5 );
+    flat_set__int__delete( &flat_set, 4 );
+    REQUIRE( elements( &flat_set ) == std::vector<int>( { 1, 3, 7, 9 } ) );
+    REQUIRE_FALSE( flat_set__int__contains( &flat_set, 5 ) );
+
+    flat_set__int__clear( &flat_set );
+}
+
+TEST_CASE_METHOD( FlatSet__TestFixture, "flat_set__initialize__elements", "[flat_set]" ){
+    std::vector<int> inputs;
+    std::set<int> expected;
+    unsigned long long state = 88172645463325252ULL;
+    for( unsigned int index = 0; index < 10000; index++ ){
+        /* xorshift64 */
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+
+        inputs.push_back( (int)( state % 4000 ) - 2000 );
+        expected.insert( inputs.back() );
+    }
+
+    FlatSet__Int flat_set;
+    flat_set__int__initialize__elements( &flat_set, system_allocator.allocator, inputs.size(), inputs.data() );
+    REQUIRE( elements( &flat_set ) == std::vector<int>( expected.begin(), expected.end() ) );
+
+    for( int element = -2100; element < 2100; element++ ){
+        REQUIRE( flat_set__int__contains( &flat_set, element ) == ( expected.count( element ) == 1 ) );
+    }
+
+    flat_set__int__clear( &flat_set );
+
+    // No elements at all.
+    flat_set__int__initialize__elements( &flat_set, system_allocator.allocator, 0, NULL );
+    REQUIRE( elements( &flat_set ).empty() );
+    REQUIRE_FALSE( flat_set__int__contains( &flat_set, 0 ) );
+    flat_set__int__clear( &flat_set );
+}
@@ -0,0 +1,122 @@
+// 3rdParty Includes
+#include "catch2/catch.hpp"
+
+// System Includes
+#include <string.h> // memset
+
+// Internal Includes
+#include "kirke/array.h"
+#include "kirke/hash_map.h"
+#include "kirke/list.h"
+#include "kirke/malloc_allocator.h"
+
+bool ints_are_equal( int first, int second ){
+    if( first == second ){
+        return true;
+    }
+    return false;
+}
+
+ARRAY__DECLARE( Array__int, array__int, int )
+ARRAY__DEFINE__ALLOCATOR( Array__int, array__int, int, ints_are_equal, malloc_allocator )
+
+LIST__DECLARE( List__int, list__int, int )
+LIST__DEFINE__ALLOCATOR( List__int, list__int, int, ints_are_equal, malloc_allocator )
+
+unsigned long long hash_int( int key ){
+    return (unsigned long long) key;
+}
+
+HASH_MAP__DECLARE( HashMap__IntToInt, hash_map__int_to_int, int, int )
+HASH_MAP__DEFINE__ALLOCATOR(
+    HashMap__IntToInt,
+    hash_map__int_to_int,
+    int,
+    int,
+    hash_int,
+    ints_are_equal,
+    malloc_allocator
+)
+
+TEST_CASE( "malloc_allocator__alloc_aligned_and_realloc_aligned", "[malloc_allocator]" ){
+    for( unsigned long long alignment = 1; alignment <= 4096; alignment *= 2 ){
+        char* memory = (char*) malloc_allocator__alloc_aligned( NULL, 100, alignment );
+
+        REQUIRE( memory != NULL );
+        REQUIRE( (unsigned long long) memory % alignment == 0 );
+
+        memset( memory, 'a', 100 );
+        memory = (char*) malloc_allocator__realloc_aligned( NULL, memory, 100, 100000, alignment );
+
+        REQUIRE( memory != NULL );
+        REQUIRE( (unsigned long long) memory % alignment == 0 );
+        REQUIRE( memory[ 99 ] == 'a' );
+
+        malloc_allocator__free_aligned( NULL, memory );
+    }
+
+    REQUIRE( malloc_allocator__alloc_aligned( NULL, 100, 48 ) == NULL );
+}
+
+TEST_CASE( "malloc_allocator__auto_array", "[malloc_allocator]" ){
+    const int ELEMENT_COUNT = 10000;
+
+    AutoArray__int auto_array;
+    auto_array__int__initialize( &auto_array, NULL, 1 );
+
+    for( int element = 0; element < ELEMENT_COUNT; element++ ){
+        auto_array__int__append_element( &auto_array, element );
+    }
+
+    auto_array__int__prepend_element( &auto_array, -1 );
+    auto_array__int__insert_element( &auto_array, ELEMENT_COUNT / 2, -2 );
+
+    REQUIRE( auto_array.array__int->length == ELEMENT_COUNT + 2 );
+    REQUIRE( auto_array.array__int->data[ 0 ] == -1 );
+    REQUIRE( auto_array.array__int->data[ 1 ] == 0 );
+    REQUIRE( auto_array.array__int->data[ ELEMENT_COUNT / 2 ] == -2 );
+    REQUIRE( auto_array.array__int->data[ ELEMENT_COUNT + 1 ] == ELEMENT_COUNT - 1 );
+
+    auto_array__int__clear( &auto_array );
+}
+
+TEST_CASE( "malloc_allocator__list", "[malloc_allocator]" ){
+    List__int *list = NULL;
+    list__int__initialize( &list, NULL, 0 );
+
+    for( int value = 1; value < 10; value++ ){
+        list__int__append( list, NULL, value );
+    }
+
+    REQUIRE( list__int__length( list ) == 10 );
+    REQUIRE( list__int__tail( list )->value == 9 );
+
+    list = list__int__delete_all( list, 5, NULL );
+    REQUIRE( list__int__length( list ) == 9 );
+
+    list__int__clear( list, NULL );
+}
+
+TEST_CASE( "malloc_allocator__hash_map", "[malloc_allocator]" ){
+    const int ENTRY_COUNT = 1000;
+
+    HashMap__IntToInt hash_map;
+    hash_map__int_to_int__initialize( &hash_map, NULL, 64 );
+
+    for( int key = 0; key < ENTRY_COUNT; key++ ){
+        hash_map__int_to_int__insert( &hash_map, key, key * 2 );
+    }
+
+    for( int key = 0; key < ENTRY_COUNT; key++ ){
+        int value = 0;
+
+        REQUIRE( hash_map__int_to_int__retrieve( &hash_map, key, &value ) );
+        REQUIRE( value == key * 2 );
+    }
+
+    int value = 0;
+    hash_map__int_to_int__delete( &hash_map, 0 );
+    REQUIRE( hash_map__int_to_int__retrieve( &hash_map, 0, &value ) == false );
+
+    hash_map__int_to_int__clear( &hash_map );
+}
@@ -0,0 +1,175 @@
+// 3rdParty Includes
+#include "catch2/catch.hpp"
+
+// System Includes
+#include <stdio.h> // fopen, fputs, fclose, remove
+#include <stdlib.h> // mkstemp
+#include <unistd.h> // close
+#include <atomic>
+#include <thread>
+
+// Internal Includes
+#include "kirke/arena_allocator.h"
+#include "kirke/memory_pressure.h"
+#include "kirke/string.h"
+#include "kirke/system_allocator.h"
+
+static void memory_pressure__count( void *data ){
+    (*(int*) data)++;
+}
+
+class MemoryPressure__TestFixture{
+    protected:
+        MemoryPressure__TestFixture(){
+            system_allocator__initialize( &system_allocator, NULL );
+        }
+
+        ~MemoryPressure__TestFixture(){
+            system_allocator__deinitialize( &system_allocator );
+        }
+
+        SystemAllocator system_allocator;
+};
+
+TEST_CASE_METHOD( MemoryPressure__TestFixture, "memory_pressure__register_and_unregister", "[memory_pressure]" ){
+    int first_count = 0;
+    int second_count = 0;
+
+    MemoryPressure__Handler first;
+    MemoryPressure__Handler second;
+    memory_pressure__register( &first, memory_pressure__count, &first_count );
+    memory_pressure__register( &second, memory_pressure__count, &second_count );
+
+    memory_pressure__signal();
+    REQUIRE( first_count == 1 );
+    REQUIRE( second_count == 1 );
+
+    memory_pressure__unregister( &first );
+    memory_pressure__signal();
+    REQUIRE( first_count == 1 );
+    REQUIRE( second_count == 2 );
+
+    memory_pressure__unregister( &second );
+    memory_pressure__signal();
+    REQUIRE( second_count == 2 );
+}
+
+TEST_CASE( "memory_pressure__handle", "[memory_pressure]" ){
+    int count = 0;
+    int count_before_handling = -1;
+    bool handled_before_signal = true;
+    bool handled_after_signal = false;
+    bool handled_twice = true;
+    std::atomic< int > step( 0 );
+
+    // The worker's handler is only ever called on the worker, when it handles a signal sent by another thread.
+    std::thread thread( [ & ](){
+        MemoryPressure__Handler handler;
+        memory_pressure__register( &handler, memory_pressure__count, &count );
+        handled_before_signal = memory_pressure__handle();
+        step = 1;
+
+        while( step != 2 ){
+            std::this_thread::yield();
+        }
+        count_before_handling = count;
+        handled_after_signal = memory_pressure__handle();
+        handled_twice = memory_pressure__handle();
+
+        memory_pressure__unregister( &handler );
+    } );
+
+    while( step != 1 ){
+        std::this_thread::yield();
+    }
+    memory_pressure__signal();
+    REQUIRE( memory_pressure__handle() == false );
+    step = 2;
+    thread.join();
+
+    REQUIRE( handled_before_signal == false );
+    REQUIRE( count_before_handling == 0 );
+    REQUIRE( handled_after_signal );
+    REQUIRE( handled_twice == false );
+    REQUIRE( count == 1 );
+}
+
+TEST_CASE_METHOD( MemoryPressure__TestFixture, "memory_pressure__signal_shrinks_and_trims", "[memory_pressure]" ){
+    ArenaAllocator arena_allocator;
+    arena_allocator__initialize( &arena_allocator, system_allocator.allocator, 1024 );
+
+    AutoString auto_string;
+    auto_string__initialize( &auto_string, system_allocator.allocator, 1 );
+    for( int repetition = 0; repetition < 1000; repetition++ ){
+        auto_string__append_elements( &auto_string, 14, "Hello, World! " );
+    }
+    auto_string__remove_range( &auto_string, 5, auto_string.string->length - 5 );
+
+    // Chunks left behind by a rewind are unused, so trimming can release them.
+    ArenaAllocator__Mark mark = arena_allocator__mark( &arena_allocator );
+    for( int chunk_index = 0; chunk_index < 4; chunk_index++ ){
+        allocator__alloc( arena_allocator.allocator, 512 );
+    }
+    arena_allocator__rewind( &arena_allocator, mark );
+
+    MemoryPressure__Handler string_handler;
+    MemoryPressure__Handler arena_handler;
+    memory_pressure__register( &string_handler, auto_string__shrink_to_fit__callback, &auto_string );
+    memory_pressure__register__allocator( &arena_handler, arena_allocator.allocator );
+
+    memory_pressure__signal();
+
+    REQUIRE( auto_string.string->capacity == 5 );
+    REQUIRE( strcmp( auto_string.string->data, "Hello" ) == 0 );
+    REQUIRE( arena_allocator__trim( &arena_allocator ) == false );
+
+    memory_pressure__unregister( &arena_handler );
+    memory_pressure__unregister( &string_handler );
+
+    auto_string__clear( &auto_string );
+    arena_allocator__deinitialize( &arena_allocator );
+}
+
+TEST_CASE( "memory_pressure__read__file", "[memory_pressure]" ){
+    char path[] = "/tmp/test__libkirke__memory_pressure__XXXXXX";
+    int file_descriptor = mkstemp( path );
+    REQUIRE( file_descriptor != -1 );
+    close( file_descriptor );
+
+    String file_path = string__literal( path );
+    FILE *output_file = fopen( file_path.data, "w" );
+    fputs( "some avg10=1.50 avg60=0.25 avg300=0.05 total=123456\n", output_file );
+    fputs( "full avg10=0.75 avg60=0.00 avg300=0.00 total=654\n", output_file );
+    fclose( output_file );
+
+    MemoryPressure__Reading reading;
+    REQUIRE( memory_pressure__read__file( file_path, &reading ) );
+    REQUIRE( reading.some.avg10 == Approx( 1.5 ) );
+    REQUIRE( reading.some.avg60 == Approx( 0.25 ) );
+    REQUIRE( reading.some.avg300 == Approx( 0.05 ) );
+    REQUIRE( reading.some.total == 123456 );
+    REQUIRE( reading.full.avg10 == Approx( 0.75 ) );
+    REQUIRE( reading.full.total == 654 );
+
+    remove( file_path.data );
+    REQUIRE( memory_pressure__read__file( file_path, &reading ) == false );
+}
+
+TEST_CASE( "memory_pressure__poll", "[memory_pressure]" ){
+    int count = 0;
+    MemoryPressure__Handler handler;
+    memory_pressure__register( &handler, memory_pressure__count, &count );
+
+    // No system reports a stall of more than 100% of the time, so polling never signals.
+    REQUIRE( memory_pressure__poll( 100.0 ) == false );
+    REQUIRE( count == 0 );
+
+    MemoryPressure__Reading reading;
+    if( memory_pressure__read( &reading ) ){
+        REQUIRE( reading.some.avg10 >= 0.0 );
+        REQUIRE( memory_pressure__poll( -1.0 ) );
+        REQUIRE( count == 1 );
+    }
+
+    memory_pressure__unregister( &handler );
+}
@@ -0,0 +1,346 @@
+// 3rdParty Includes
+#include "catch2/catch.hpp"
+
+// System Includes
+#include <algorithm>
+#include <vector>
+
+// Internal Includes
+#include "kirke/array.h"
+#include "kirke/ordered_array.h"
+#include "kirke/system_allocator.h"
+
+typedef struct OrderedArray__Record{
+    int key;
+    unsigned int position;
+} OrderedArray__Record;
+
+static bool ints_are_less( int first, int second ){
+    return first < second;
+}
+
+static unsigned long long int__key( int value ){
+    return ( (unsigned long long) value ) ^ ( 1ULL << 63 );
+}
+
+static bool records_are_less( OrderedArray__Record first, OrderedArray__Record second ){
+    return first.key < second.key;
+}
+
+static unsigned long long record__key( OrderedArray__Record record ){
+    return int__key( record.key );
+}
+
+ARRAY__DECLARE( Array__int, array__int, int )
+ARRAY__DEFINE_POD( Array__int, array__int, int )
+ORDERED_ARRAY__DECLARE( Array__int, array__int, int )
+ORDERED_ARRAY__DEFINE( Array__int, array__int, int, ints_are_less )
+ORDERED_ARRAY__DECLARE_RADIX_SORT( Array__int, array__int, int )
+ORDERED_ARRAY__DEFINE_RADIX_SORT( Array__int, array__int, int, int__key )
+ORDERED_ARRAY__DECLARE_EYTZINGER( Array__int, array__int, int )
+ORDERED_ARRAY__DEFINE_EYTZINGER( Array__int, array__int, int, ints_are_less )
+
+ARRAY__DECLARE( Array__Record, array__record, OrderedArray__Record )
+ARRAY__DEFINE_POD( Array__Record, array__record, OrderedArray__Record )
+ORDERED_ARRAY__DECLARE( Array__Record, array__record, OrderedArray__Record )
+ORDERED_ARRAY__DEFINE( Array__Record, array__record, OrderedArray__Record, records_are_less )
+ORDERED_ARRAY__DECLARE_RADIX_SORT( Array__Record, array__record, OrderedArray__Record )
+ORDERED_ARRAY__DEFINE_RADIX_SORT( Array__Record, array__record, OrderedArray__Record, record__key )
+ORDERED_ARRAY__DECLARE_PARALLEL_SORT( Array__Record, array__record, OrderedArray__Record )
+ORDERED_ARRAY__DEFINE_PARALLEL_SORT( Array__Record, array__record, OrderedArray__Record, records_are_less )
+
+class OrderedArray__TestFixture {
+public:
+    OrderedArray__TestFixture(){
+        system_allocator__initialize( &system_allocator, NULL );
+    }
+
+    ~OrderedArray__TestFixture(){
+        system_allocator__deinitialize( &system_allocator );
+    }
+
+    /**
+     *  Returns inputs of the given length in the patterns which quicksort implementations handle worst or best:
+     *  random, few distinct values, sorted, reversed, equal, sawtooth, organ pipe, and sorted with a few swaps.
+     */
+    std::vector<std::vector<int> > patterns( unsigned int length ){
+        std::vector<std::vector<int> > patterns( 8, std::vector<int>( length ) );
+        unsigned long long state = 88172645463325252ULL + length;
+        for( unsigned int index = 0; index < length; index++ ){
+            /* xorshift64 */
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+
+            patterns[ 0 ][ index ] = (int) state;
+            patterns[ 1 ][ index ] = (int)( state % 4 ) - 2;
+            patterns[ 2 ][ index ] = (int) index;
+            patterns[ 3 ][ index ] = (int)( length - index );
+            patterns[ 4 ][ index ] = 7;
+            patterns[ 5 ][ index ] = (int)( index % 37 );
+            patterns[ 6 ][ index ] = (int)( index < length / 2 ? index : length - index );
+            patterns[ 7 ][ index ] = (int) index;
+        }
+        for( unsigned int swap = 0; length > 0 && swap < 4; swap++ ){
+            std::swap( patterns[ 7 ][ ( swap * 7919 ) % length ], patterns[ 7 ][ ( swap * 104729 + 1 ) % length ] );
+        }
+
+        return patterns;
+    }
+
+    /**
+     *  Returns an Array__int viewing the elements of a vector.
+     */
+    Array__int array( std::vector<int> &elements ){
+        return (Array__int){
+            .data = elements.data(),
+            .length = elements.size(),
+            .capacity = elements.size(),
+            .element_size = sizeof( int )
+        };
+    }
+
+    /**
+     *  Returns records whose keys repeat, each storing its original position, so that stability can be checked.
+     */
+    std::vector<OrderedArray__Record> records( std::vector<int> const &keys ){
+        std::vector<OrderedArray__Record> records( keys.size() );
+        for( unsigned int index = 0; index < keys.size(); index++ ){
+            records[ index ].key = keys[ index ] % 16;
+            records[ index ].position = index;
+        }
+
+        return records;
+    }
+
+    void require_stable( std::vector<OrderedArray__Record> const &records ){
+        for( unsigned int index = 1; index < records.size(); index++ ){
+            REQUIRE( records[ index - 1 ].key <= records[ index ].key );
+            if( records[ index - 1 ].key == records[ index ].key ){
+                REQUIRE( records[ index - 1 ].position < records[ index ].position );
+            }
+        }
+    }
+
+    SystemAllocator system_allocator;
+};
+
+TEST_CASE_METHOD( OrderedArray__TestFixture, "array__sort", "[ordered_array]" ){
+    unsigned int lengths[] = { 0, 1, 2, 3, 23, 24, 25, 100, 129, 1000, 100000 };
+    for( unsigned int length : lengths ){
+        std::vector<std::vector<int> > inputs = patterns( length );
+        for( unsigned int pattern = 0; pattern < inputs.size(); pattern++ ){
+            INFO( "length: " << length << ", pattern: " << pattern );
+            std::vector<int> expected = inputs[ pattern ];
+            std::sort( expected.begin(), expected.end() );
+
+            Array__int array = this->array( inputs[ pattern ] );
+            array__int__sort( &array );
+            REQUIRE( inputs[ pattern ] == expected );
+        }
+    }
+}
+
+TEST_CASE_METHOD( OrderedArray__TestFixture, "array__sort__adversarial", "[ordered_array]" ){
+    // Interleaved ascending and descending elements, which unbalance many partitions.
+    std::vector<int> elements( 100000 );
+    for( unsigned int index = 0; index < elements.size(); index++ ){
+        elements[ index ] = index % 2 == 0 ? (int) index : (int)( elements.size() - index );
+    }
+    std::vector<int> expected = elements;
+    std::sort( expected.begin(), expected.end() );
+
+    Array__int array = this->array( elements );
+    array__int__sort( &array );
+    REQUIRE( elements == expected );
+}
+
+TEST_CASE_METHOD( OrderedArray__TestFixture, "array__sort__stable", "[ordered_array]" ){
+    unsigned int lengths[] = { 0, 1, 2, 23, 24, 25, 100, 1000, 100000 };
+    for( unsigned int length : lengths ){
+        std::vector<std::vector<int> > inputs = patterns( length );
+        for( unsigned int pattern = 0; pattern < inputs.size(); pattern++ ){
+            INFO( "length: " << length << ", pattern: " << pattern );
+            std::vector<OrderedArray__Record> records = this->records( inputs[ pattern ] );
+            Array__Record array = {
+                .data = records.data(),
+                .length = records.size(),
+                .capacity = records.size(),
+                .element_size = sizeof( OrderedArray__Record )
+            };
+
+            REQUIRE( array__record__sort__stable( &array, system_allocator.allocator ) == true );
+            require_stable( records );
+        }
+    }
+}
+
+TEST_CASE_METHOD( OrderedArray__TestFixture, "array__sort__radix", "[ordered_array]" ){
+    unsigned int lengths[] = { 0, 1, 2, 100, 1000, 100000 };
+    for( unsigned int length : lengths ){
+        std::vector<std::vector<int> > inputs = patterns( length );
+        for( unsigned int pattern = 0; pattern < inputs.size(); pattern++ ){
+            INFO( "length: " << length << ", pattern: " << pattern );
+            std::vector<int> expected = inputs[ pattern ];
+            std::sort( expected.begin(), expected.end() );
+
+            Array__int array = this->array( inputs[ pattern ] );
+            REQUIRE( array__int__sort__radix( &array, system_allocator.allocator ) == true );
+            REQUIRE( inputs[ pattern ] == expected );
+
+            // Records keyed by an integer keep the order of equal keys.
+            std::vector<OrderedArray__Record> records = this->records( inputs[ pattern ] );
+            Array__Record record_array = {
+                .data = records.data(),
+                .length = records.size(),
+                .capacity = records.size(),
+                .element_size = sizeof( OrderedArray__Record )
+            };
+            REQUIRE( array__record__sort__radix( &record_array, system_allocator.allocator ) == true );
+            require_stable( records );
+        }
+    }
+}
+
+TEST_CASE_METHOD( OrderedArray__TestFixture, "array__sort__radix__negative", "[ordered_array]" ){
+    std::vector<int> elements = { 3, -1, 2147483647, 0, -2147483647 - 1, -256, 256, -1 };
+    std::vector<int> expected = elements;
+    std::sort( expected.begin(), expected.end() );
+
+    Array__int array = this->array( elements );
+    REQUIRE( array__int__sort__radix( &array, system_allocator.allocator ) == true );
+    REQUIRE( elements == expected );
+}
+
+TEST_CASE_METHOD( OrderedArray__TestFixture, "array__sort__parallel", "[ordered_array]" ){
+    // Lengths which give every thread its minimum share, or leave too few elements for more than one thread.
+    unsigned int lengths[] = { 0, 1000, ORDERED_ARRAY__PARALLEL_SORT_MINIMUM_LENGTH * 7 + 5 };
+    unsigned int thread_counts[] = { 0, 1, 2, 3, 4, 7, 8, 1000 };
+    for( unsigned int length : lengths ){
+        std::vector<std::vector<int> > inputs = patterns( length );
+        for( unsigned int pattern = 0; pattern < inputs.size(); pattern++ ){
+            std::vector<OrderedArray__Record> expected = this->records( inputs[ pattern ] );
+            Array__Record expected_array = {
+                .data = expected.data(),
+                .length = expected.size(),
+                .capacity = expected.size(),
+                .element_size = sizeof( OrderedArray__Record )
+            };
+            REQUIRE( array__record__sort__stable( &expected_array, system_allocator.allocator ) == true );
+
+            for( unsigned int thread_count : thread_counts ){
+                INFO( "length: " << length << ", pattern: " << pattern << ", threads: " << thread_count );
+                std::vector<OrderedArray__Record> records = this->records( inputs[ pattern ] );
+                Array__Record array = {
+                    .data = records.data(),
+                    .length = records.size(),
+                    .capacity = records.size(),
+                    .element_size = sizeof( OrderedArray__Record )
+                };
+
+                REQUIRE( array__record__sort__parallel( &array, system_allocator.allocator, thread_count ) == true );
+                for( unsigned int index = 0; index < records.size(); index++ ){
+                    REQUIRE( records[ index ].key == expected[ index ].key );
+                    REQUIRE( records[ index ].position == expected[ index ].position );
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE_METHOD( OrderedArray__TestFixture, "array__lower_bound_and_upper_bound", "[ordered_array]" ){
+    unsigned int lengths[] = { 0, 1, 2, 3, 24, 100, 1000 };
+    for( unsigned int length : lengths ){
+        std::vector<std::vector<int> > inputs = patterns( length );
+        for( unsigned int pattern = 1; pattern < inputs.size(); pattern++ ){
+            std::vector<int> &elements = inputs[ pattern ];
+            std::sort( elements.begin(), elements.end() );
+            Array__int array = this->array( elements );
+
+            // Every element, and values between and beyond them.
+            std::vector<int> searched = { -2147483647 - 1, 2147483647 };
+            for( int element : elements ){
+                searched.push_back( element - 1 );
+                searched.push_back( element );
+                searched.push_back( element + 1 );
+            }
+
+            for( int element : searched ){
+                INFO( "length: " << length << ", pattern: " << pattern << ", element: " << element );
+                unsigned long long lower_bound = std::lower_bound( elements.begin(), elements.end(), element ) - elements.begin();
+                unsigned long long upper_bound = std::upper_bound( elements.begin(), elements.end(), element ) - elements.begin();
+                REQUIRE( array__int__lower_bound( &array, element ) == lower_bound );
+                REQUIRE( array__int__upper_bound( &array, element ) == upper_bound );
+
+                unsigned long long index;
+                REQUIRE( array__int__binary_search( &array, element, &index ) == ( lower_bound != upper_bound ) );
+                REQUIRE( index == lower_bound );
+            }
+        }
+    }
+}
+
+TEST_CASE_METHOD( OrderedArray__TestFixture, "auto_array__sorted_insert", "[ordered_array]" ){
+    AutoArray__int auto_array;
+    auto_array__int__initialize( &auto_array, system_allocator.allocator, 0 );
+
+    std::vector<int> expected;
+    std::vector<int> inputs = patterns( 500 )[ 1 ];
+    for( int element : inputs ){
+        unsigned long long index = auto_array__int__sorted_insert( &auto_array, element );
+        std::vector<int>::iterator position = std::upper_bound( expected.begin(), expected.end(), element );
+        REQUIRE( index == (unsigned long long)( position - expected.begin() ) );
+        expected.insert( position, element );
+    }
+
+    REQUIRE( std::vector<int>( auto_array.array__int->data, auto_array.array__int->data + auto_array.array__int->length ) == expected );
+
+    auto_array__int__clear( &auto_array );
+}
+
+TEST_CASE_METHOD( OrderedArray__TestFixture, "array__eytzinger", "[ordered_array]" ){
+    // Every length up to a few levels, to cover every shape of the last level of the tree.
+    std::vector<unsigned int> lengths;
+    for( unsigned int length = 0; length <= 70; length++ ){
+        lengths.push_back( length );
+    }
+    lengths.push_back( 100000 );
+
+    for( unsigned int length : lengths ){
+        std::vector<std::vector<int> > inputs = patterns( length );
+        for( unsigned int pattern = 0; pattern < inputs.size(); pattern++ ){
+            std::vector<int> &elements = inputs[ pattern ];
+            std::sort( elements.begin(), elements.end() );
+            Array__int array = this->array( elements );
+
+            Array__int__Eytzinger eytzinger;
+            REQUIRE( array__int__eytzinger__initialize( &eytzinger, &array, system_allocator.allocator ) == true );
+            REQUIRE( eytzinger.length == length );
+            REQUIRE( (unsigned long long) eytzinger.data % ORDERED_ARRAY__CACHE_LINE_SIZE == 0 );
+
+            std::vector<int> searched = { -2147483647 - 1, 2147483647 };
+            for( unsigned int index = 0; index < elements.size(); index += 1 + elements.size() / 1000 ){
+                searched.push_back( elements[ index ] - 1 );
+                searched.push_back( elements[ index ] );
+                searched.push_back( elements[ index ] + 1 );
+            }
+
+            for( int element : searched ){
+                INFO( "length: " << length << ", pattern: " << pattern << ", element: " << element );
+                unsigned long long rank = std::lower_bound( elements.begin(), elements.end(), element ) - elements.begin();
+                REQUIRE( array__int__eytzinger__rank( &eytzinger, element ) == rank );
+
+                unsigned long long index;
+                REQUIRE( array__int__eytzinger__lower_bound( &eytzinger, element, &index ) == ( rank < length ) );
+                if( rank < length ){
+                    REQUIRE( eytzinger.data[ index ] == elements[ rank ] );
+                }
+                else{
+                    REQUIRE( index == 0 );
+                }
+            }
+
+            array__int__eytzinger__clear( &eytzinger, system_allocator.allocator );
+        }
+    }
+}
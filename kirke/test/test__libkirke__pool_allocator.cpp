@@ -0,0 +1,240 @@
+// 3rdParty Includes
+#include "catch2/catch.hpp"
+
+// Internal Includes
+#include "kirke/hash_map.h"
+#include "kirke/list.h"
+#include "kirke/pool_allocator.h"
+#include "kirke/system_allocator.h"
+
+bool pool_allocator__ints_are_equal( int first, int second ){
+    return first == second;
+}
+
+LIST__DECLARE( PoolAllocator__List__Int, pool_allocator__list__int, int )
+LIST__DEFINE( PoolAllocator__List__Int, pool_allocator__list__int, int, pool_allocator__ints_are_equal )
+
+class PoolAllocator__TestFixture{
+    protected:
+        PoolAllocator__TestFixture(){
+            system_allocator__initialize( &system_allocator, NULL );
+            pool_allocator__initialize( &pool_allocator, system_allocator.allocator, sizeof( PoolAllocator__List__Int ), SLAB_SIZE );
+        }
+
+        ~PoolAllocator__TestFixture(){
+            pool_allocator__deinitialize( &pool_allocator );
+            system_allocator__deinitialize( &system_allocator );
+        }
+
+        const unsigned long long SLAB_SIZE = 1024;
+        SystemAllocator system_allocator;
+        PoolAllocator pool_allocator;
+};
+
+TEST_CASE_METHOD( PoolAllocator__TestFixture, "pool_allocator__initialize_and_deinitialize", "[pool_allocator]" ){
+    REQUIRE( pool_allocator.allocator != NULL );
+    REQUIRE( pool_allocator.backing_allocator == system_allocator.allocator );
+    REQUIRE( pool_allocator.object_size >= sizeof( PoolAllocator__List__Int ) );
+    REQUIRE( pool_allocator.object_size % sizeof( void* ) == 0 );
+    REQUIRE( pool_allocator.slab_size == SLAB_SIZE );
+}
+
+TEST_CASE_METHOD( PoolAllocator__TestFixture, "pool_allocator__objects_are_packed_contiguously", "[pool_allocator]" ){
+    char *first = (char*) allocator__alloc( pool_allocator.allocator, pool_allocator.object_size );
+    char *second = (char*) allocator__alloc( pool_allocator.allocator, pool_allocator.object_size );
+
+    REQUIRE( pool_allocator__owns( &pool_allocator, first ) );
+    REQUIRE( pool_allocator__owns( &pool_allocator, second ) );
+    REQUIRE( second == first + pool_allocator.object_size );
+}
+
+TEST_CASE_METHOD( PoolAllocator__TestFixture, "pool_allocator__free_recycles_objects", "[pool_allocator]" ){
+    void *first = allocator__alloc( pool_allocator.allocator, pool_allocator.object_size );
+    void *second = allocator__alloc( pool_allocator.allocator, pool_allocator.object_size );
+
+    allocator__free( pool_allocator.allocator, first );
+    allocator__free( pool_allocator.allocator, second );
+
+    // Freed objects are reused in last-in, first-out order.
+    REQUIRE( allocator__alloc( pool_allocator.allocator, pool_allocator.object_size ) == second );
+    REQUIRE( allocator__alloc( pool_allocator.allocator, pool_allocator.object_size ) == first );
+}
+
+TEST_CASE_METHOD( PoolAllocator__TestFixture, "pool_allocator__many_slabs", "[pool_allocator]" ){
+    const unsigned long long OBJECT_COUNT = 10 * SLAB_SIZE / sizeof( PoolAllocator__List__Int );
+
+    void **objects = (void**) allocator__alloc( system_allocator.allocator, OBJECT_COUNT * sizeof( void* ) );
+    for( unsigned long long object_index = 0; object_index < OBJECT_COUNT; object_index++ ){
+        objects[ object_index ] = allocator__alloc( pool_allocator.allocator, sizeof( PoolAllocator__List__Int ) );
+        REQUIRE( objects[ object_index ] != NULL );
+        memset( objects[ object_index ], (int) object_index, sizeof( PoolAllocator__List__Int ) );
+    }
+
+    REQUIRE( pool_allocator.slab_count >= 10 );
+
+    for( unsigned long long slab_index = 1; slab_index < pool_allocator.slab_count; slab_index++ ){
+        REQUIRE( pool_allocator.slabs[ slab_index - 1 ] < pool_allocator.slabs[ slab_index ] );
+    }
+
+    for( unsigned long long object_index = 0; object_index < OBJECT_COUNT; object_index++ ){
+        REQUIRE( pool_allocator__owns( &pool_allocator, objects[ object_index ] ) );
+        REQUIRE( *(unsigned char*) objects[ object_index ] == (unsigned char) object_index );
+        allocator__free( pool_allocator.allocator, objects[ object_index ] );
+    }
+
+    allocator__free( system_allocator.allocator, objects );
+}
+
+TEST_CASE_METHOD( PoolAllocator__TestFixture, "pool_allocator__trim", "[pool_allocator]" ){
+    const unsigned long long OBJECT_COUNT = 10 * SLAB_SIZE / sizeof( PoolAllocator__List__Int );
+
+    void **objects = (void**) allocator__alloc( system_allocator.allocator, OBJECT_COUNT * sizeof( void* ) );
+    for( unsigned long long object_index = 0; object_index < OBJECT_COUNT; object_index++ ){
+        objects[ object_index ] = allocator__alloc( pool_allocator.allocator, sizeof( PoolAllocator__List__Int ) );
+        memset( objects[ object_index ], 1, sizeof( PoolAllocator__List__Int ) );
+    }
+
+    unsigned long long slab_count = pool_allocator.slab_count;
+    REQUIRE( allocator__trim( pool_allocator.allocator ) == false );
+
+    // Every object but the first and the last is freed, so every slab but theirs can be released.
+    for( unsigned long long object_index = 1; object_index < OBJECT_COUNT - 1; object_index++ ){
+        allocator__free( pool_allocator.allocator, objects[ object_index ] );
+    }
+
+    REQUIRE( allocator__trim( pool_allocator.allocator ) );
+    REQUIRE( pool_allocator.slab_count == 2 );
+    REQUIRE( pool_allocator__owns( &pool_allocator, objects[ 0 ] ) );
+    REQUIRE( pool_allocator__owns( &pool_allocator, objects[ OBJECT_COUNT - 1 ] ) );
+    REQUIRE( pool_allocator__trim( &pool_allocator ) == false );
+
+    // Objects freed into the remaining slabs are recycled, and new slabs are allocated once they run out.
+    for( unsigned long long object_index = 1; object_index < OBJECT_COUNT - 1; object_index++ ){
+        objects[ object_index ] = allocator__alloc( pool_allocator.allocator, sizeof( PoolAllocator__List__Int ) );
+        REQUIRE( pool_allocator__owns( &pool_allocator, objects[ object_index ] ) );
+    }
+    REQUIRE( pool_allocator.slab_count <= slab_count );
+
+    for( unsigned long long object_index = 0; object_index < OBJECT_COUNT; object_index++ ){
+        allocator__free( pool_allocator.allocator, objects[ object_index ] );
+    }
+
+    // Once every object is freed, every slab is released, and the pool starts over.
+    REQUIRE( pool_allocator__trim( &pool_allocator ) );
+    REQUIRE( pool_allocator.slab_count == 0 );
+    REQUIRE( allocator__alloc( pool_allocator.allocator, sizeof( PoolAllocator__List__Int ) ) != NULL );
+
+    allocator__free( system_allocator.allocator, objects );
+}
+
+TEST_CASE_METHOD( PoolAllocator__TestFixture, "pool_allocator__large_requests_use_backing_allocator", "[pool_allocator]" ){
+    char *large = (char*) allocator__alloc( pool_allocator.allocator, 4 * SLAB_SIZE );
+
+    REQUIRE( large != NULL );
+    REQUIRE( pool_allocator__owns( &pool_allocator, large ) == false );
+
+    memset( large, 'a', 4 * SLAB_SIZE );
+    allocator__free( pool_allocator.allocator, large );
+}
+
+TEST_CASE_METHOD( PoolAllocator__TestFixture, "pool_allocator__realloc", "[pool_allocator]" ){
+    char *object = (char*) allocator__alloc( pool_allocator.allocator, 4 );
+    memcpy( object, "abc", 4 );
+
+    // Growing within the object size keeps the object in place.
+    REQUIRE( allocator__realloc( pool_allocator.allocator, object, pool_allocator.object_size ) == object );
+
+    // Growing beyond the object size moves the object to the backing allocator.
+    char *grown = (char*) allocator__realloc( pool_allocator.allocator, object, 2 * SLAB_SIZE );
+    REQUIRE( pool_allocator__owns( &pool_allocator, grown ) == false );
+    REQUIRE( strcmp( grown, "abc" ) == 0 );
+
+    // Shrinking back within the object size moves the object into the slabs.
+    char *shrunk = (char*) allocator__realloc( pool_allocator.allocator, grown, 4 );
+    REQUIRE( pool_allocator__owns( &pool_allocator, shrunk ) == true );
+    REQUIRE( strcmp( shrunk, "abc" ) == 0 );
+
+    allocator__free( pool_allocator.allocator, shrunk );
+}
+
+TEST_CASE_METHOD( PoolAllocator__TestFixture, "pool_allocator__free_sized", "[pool_allocator]" ){
+    void *object = allocator__alloc( pool_allocator.allocator, pool_allocator.object_size );
+    allocator__free_sized( pool_allocator.allocator, object, pool_allocator.object_size );
+
+    REQUIRE( allocator__alloc( pool_allocator.allocator, pool_allocator.object_size ) == object );
+
+    char *large = (char*) allocator__alloc( pool_allocator.allocator, 4 * SLAB_SIZE );
+    REQUIRE( large != NULL );
+    allocator__free_sized( pool_allocator.allocator, large, 4 * SLAB_SIZE );
+
+    allocator__free_sized( pool_allocator.allocator, object, pool_allocator.object_size );
+}
+
+TEST_CASE_METHOD( PoolAllocator__TestFixture, "pool_allocator__list", "[pool_allocator]" ){
+    PoolAllocator__List__Int *list;
+    pool_allocator__list__int__initialize( &list, pool_allocator.allocator, 0 );
+
+    for( int value = 1; value < 100; value++ ){
+        list = pool_allocator__list__int__prepend( list, pool_allocator.allocator, value );
+    }
+
+    REQUIRE( pool_allocator__list__int__length( list ) == 100 );
+
+    PoolAllocator__List__Int *link;
+    REQUIRE( pool_allocator__list__int__where( list, 42, &link ) );
+    REQUIRE( pool_allocator__owns( &pool_allocator, link ) );
+
+    pool_allocator__list__int__clear( list, pool_allocator.allocator );
+}
+
+typedef unsigned long long PoolAllocator__Key;
+
+bool pool_allocator__keys_are_equal( PoolAllocator__Key first, PoolAllocator__Key second ){
+    return first == second;
+}
+
+HASH_MAP__DECLARE( PoolAllocator__HashMap, pool_allocator__hash_map, PoolAllocator__Key, int )
+HASH_MAP__DEFINE_DEFAULT_HASH_FUNCTION( pool_allocator__hash_map, PoolAllocator__Key )
+HASH_MAP__DEFINE(
+    PoolAllocator__HashMap,
+    pool_allocator__hash_map,
+    PoolAllocator__Key,
+    int,
+    HASH_MAP__DEFAULT_HASH_FUNCTION( pool_allocator__hash_map, PoolAllocator__Key ),
+    pool_allocator__keys_are_equal
+)
+
+TEST_CASE( "pool_allocator__hash_map", "[pool_allocator]" ){
+    SystemAllocator system_allocator;
+    system_allocator__initialize( &system_allocator, NULL );
+
+    PoolAllocator pool_allocator;
+    pool_allocator__initialize( &pool_allocator, system_allocator.allocator, sizeof( PoolAllocator__HashMap__List__KeyValuePair ), 0 );
+
+    // The bucket array is larger than a list link, and is served by the backing allocator.
+    PoolAllocator__HashMap hash_map;
+    pool_allocator__hash_map__initialize( &hash_map, pool_allocator.allocator, 16 );
+
+    for( int round = 0; round < 3; round++ ){
+        for( PoolAllocator__Key key = 0; key < 1000; key++ ){
+            pool_allocator__hash_map__insert( &hash_map, key, (int) key );
+        }
+
+        int value;
+        REQUIRE( pool_allocator__hash_map__retrieve( &hash_map, 500, &value ) );
+        REQUIRE( value == 500 );
+
+        for( PoolAllocator__Key key = 0; key < 1000; key++ ){
+            pool_allocator__hash_map__delete( &hash_map, key );
+        }
+
+        REQUIRE( pool_allocator__hash_map__retrieve( &hash_map, 500, &value ) == false );
+    }
+
+    // Every round reuses the links freed by the previous round.
+    REQUIRE( pool_allocator.slab_count == 1 );
+
+    pool_allocator__hash_map__clear( &hash_map );
+    pool_allocator__deinitialize( &pool_allocator );
+    system_allocator__deinitialize( &system_allocator );
+}
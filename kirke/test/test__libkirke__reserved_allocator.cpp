@@ -0,0 +1,127 @@
+// 3rdParty Includes
+#include "catch2/catch.hpp"
+
+// Internal Includes
+#include "kirke/array.h"
+#include "kirke/reserved_allocator.h"
+
+char longs_are_equal( long first, long second ){
+    if( first == second ){
+        return 1;
+    }
+
+    return 0;
+}
+
+ARRAY__DECLARE( Array__long, array__long, long )
+ARRAY__DEFINE( Array__long, array__long, long, longs_are_equal )
+
+class ReservedAllocator__TestFixture{
+    protected:
+        ReservedAllocator__TestFixture(){
+            reserved_allocator__initialize( &reserved_allocator, RESERVED_SIZE );
+        }
+
+        ~ReservedAllocator__TestFixture(){
+            reserved_allocator__deinitialize( &reserved_allocator );
+        }
+
+        const unsigned long long RESERVED_SIZE = 1024ULL * 1024ULL * 1024ULL;
+        ReservedAllocator reserved_allocator;
+};
+
+TEST_CASE_METHOD( ReservedAllocator__TestFixture, "reserved_allocator__initialize_and_deinitialize", "[reserved_allocator]" ){
+    REQUIRE( reserved_allocator.allocator != NULL );
+    REQUIRE( reserved_allocator.base != NULL );
+    REQUIRE( reserved_allocator.reserved_size == RESERVED_SIZE );
+    REQUIRE( reserved_allocator.committed_size <= RESERVED_ALLOCATOR__COMMIT_GRANULARITY );
+
+    reserved_allocator__deinitialize( &reserved_allocator );
+
+    REQUIRE( reserved_allocator.allocator == NULL );
+    REQUIRE( reserved_allocator.base == NULL );
+}
+
+TEST_CASE_METHOD( ReservedAllocator__TestFixture, "reserved_allocator__alloc_and_realloc", "[reserved_allocator]" ){
+    char *first = (char*) allocator__alloc( reserved_allocator.allocator, 14 );
+    REQUIRE( (unsigned long long) first % 16 == 0 );
+    memcpy( first, "Hello, World!", 14 );
+
+    // The most recent allocation grows in place, committing pages as it goes.
+    char *grown = (char*) allocator__realloc( reserved_allocator.allocator, first, 10 * RESERVED_ALLOCATOR__COMMIT_GRANULARITY );
+    REQUIRE( grown == first );
+    REQUIRE( strcmp( grown, "Hello, World!" ) == 0 );
+    REQUIRE( reserved_allocator.committed_size > 10 * RESERVED_ALLOCATOR__COMMIT_GRANULARITY );
+    grown[ 10 * RESERVED_ALLOCATOR__COMMIT_GRANULARITY - 1 ] = 'x';
+
+    // Earlier allocations are copied.
+    char *second = (char*) allocator__alloc( reserved_allocator.allocator, 16 );
+    REQUIRE( second > grown );
+    char *moved = (char*) allocator__realloc( reserved_allocator.allocator, grown, 11 * RESERVED_ALLOCATOR__COMMIT_GRANULARITY );
+    REQUIRE( moved != grown );
+    REQUIRE( strcmp( moved, "Hello, World!" ) == 0 );
+
+    // Allocations beyond the reservation fail.
+    REQUIRE( allocator__try_expand( reserved_allocator.allocator, moved, RESERVED_SIZE ) == false );
+}
+
+TEST_CASE_METHOD( ReservedAllocator__TestFixture, "reserved_allocator__free_most_recent_allocation", "[reserved_allocator]" ){
+    void *first = allocator__alloc( reserved_allocator.allocator, 100 );
+    allocator__free( reserved_allocator.allocator, first );
+
+    void *second = allocator__alloc( reserved_allocator.allocator, 100 );
+    REQUIRE( second == first );
+
+    // Freeing any other allocation is a no-op.
+    void *third = allocator__alloc( reserved_allocator.allocator, 100 );
+    allocator__free( reserved_allocator.allocator, second );
+    REQUIRE( allocator__alloc( reserved_allocator.allocator, 100 ) > third );
+}
+
+TEST_CASE_METHOD( ReservedAllocator__TestFixture, "reserved_allocator__auto_array_elements_never_move", "[reserved_allocator]" ){
+    const long ELEMENT_COUNT = 1000000;
+
+    AutoArray__long auto_array = {0};
+    auto_array__long__initialize( &auto_array, reserved_allocator.allocator, 1 );
+
+    auto_array__long__append_element( &auto_array, 0 );
+    long *first = &auto_array.array__long->data[ 0 ];
+
+    for( long value = 1; value < ELEMENT_COUNT; value++ ){
+        auto_array__long__append_element( &auto_array, value );
+    }
+
+    REQUIRE( &auto_array.array__long->data[ 0 ] == first );
+    for( long value = 0; value < ELEMENT_COUNT; value++ ){
+        REQUIRE( first[ value ] == value );
+    }
+
+    auto_array__long__clear( &auto_array );
+}
+
+TEST_CASE_METHOD( ReservedAllocator__TestFixture, "reserved_allocator__decommit", "[reserved_allocator]" ){
+    char *memory = (char*) allocator__alloc( reserved_allocator.allocator, 100 * RESERVED_ALLOCATOR__COMMIT_GRANULARITY );
+    memset( memory, 1, 100 * RESERVED_ALLOCATOR__COMMIT_GRANULARITY );
+    unsigned long long committed_size = reserved_allocator.committed_size;
+
+    memory = (char*) allocator__realloc( reserved_allocator.allocator, memory, 10 );
+    REQUIRE( reserved_allocator.committed_size == committed_size );
+
+    reserved_allocator__decommit( &reserved_allocator );
+    REQUIRE( reserved_allocator.committed_size == RESERVED_ALLOCATOR__COMMIT_GRANULARITY );
+    REQUIRE( memory[ 9 ] == 1 );
+
+    // Decommitted pages are committed again, and read as zero.
+    memory = (char*) allocator__realloc( reserved_allocator.allocator, memory, 100 * RESERVED_ALLOCATOR__COMMIT_GRANULARITY );
+    REQUIRE( memory[ 9 ] == 1 );
+    REQUIRE( memory[ 50 * RESERVED_ALLOCATOR__COMMIT_GRANULARITY ] == 0 );
+}
+
+TEST_CASE_METHOD( ReservedAllocator__TestFixture, "reserved_allocator__trim", "[reserved_allocator]" ){
+    char *memory = (char*) allocator__alloc( reserved_allocator.allocator, 100 * RESERVED_ALLOCATOR__COMMIT_GRANULARITY );
+    allocator__free( reserved_allocator.allocator, memory );
+
+    REQUIRE( allocator__trim( reserved_allocator.allocator ) );
+    REQUIRE( reserved_allocator.committed_size == RESERVED_ALLOCATOR__COMMIT_GRANULARITY );
+    REQUIRE( allocator__trim( reserved_allocator.allocator ) == false );
+}
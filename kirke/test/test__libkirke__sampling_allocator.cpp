@@ -0,0 +1,174 @@
+// System Includes
+#include <thread>
+#include <vector>
+
+// 3rdParty Includes
+#include "catch2/catch.hpp"
+
+// Internal Includes
+#include "kirke/error.h"
+#include "kirke/io.h"
+#include "kirke/sampling_allocator.h"
+#include "kirke/string.h"
+#include "kirke/system_allocator.h"
+
+class SamplingAllocator__TestFixture{
+    protected:
+        SamplingAllocator__TestFixture(){
+            system_allocator__initialize( &system_allocator, NULL );
+        }
+
+        ~SamplingAllocator__TestFixture(){
+            system_allocator__deinitialize( &system_allocator );
+        }
+
+        SystemAllocator system_allocator;
+};
+
+TEST_CASE_METHOD( SamplingAllocator__TestFixture, "sampling_allocator__initialize_and_deinitialize", "[sampling_allocator]" ){
+    SamplingAllocator sampling_allocator;
+    sampling_allocator__initialize( &sampling_allocator, system_allocator.allocator, 0 );
+
+    REQUIRE( sampling_allocator.allocator != NULL );
+    REQUIRE( sampling_allocator.backing_allocator == system_allocator.allocator );
+    REQUIRE( sampling_allocator.sample_interval == SAMPLING_ALLOCATOR__DEFAULT_SAMPLE_INTERVAL );
+    REQUIRE( sampling_allocator.state != NULL );
+    REQUIRE( sampling_allocator__live_bytes( &sampling_allocator ) == 0 );
+
+    sampling_allocator__deinitialize( &sampling_allocator );
+
+    REQUIRE( sampling_allocator.allocator == NULL );
+    REQUIRE( sampling_allocator.state == NULL );
+}
+
+TEST_CASE_METHOD( SamplingAllocator__TestFixture, "sampling_allocator__samples_are_forgotten_on_free", "[sampling_allocator]" ){
+    SamplingAllocator sampling_allocator;
+    sampling_allocator__initialize( &sampling_allocator, system_allocator.allocator, 1 );
+
+    // With an interval of 1 byte, every allocation is sampled.
+    char *first = (char*) allocator__alloc( sampling_allocator.allocator, 100 );
+    char *second = (char*) allocator__alloc( sampling_allocator.allocator, 200 );
+    REQUIRE( (unsigned long long) first % 16 == 0 );
+    REQUIRE( sampling_allocator__live_bytes( &sampling_allocator ) == 300 );
+
+    memcpy( first, "Hello", 6 );
+    first = (char*) allocator__realloc( sampling_allocator.allocator, first, 1000 );
+    REQUIRE( strcmp( first, "Hello" ) == 0 );
+    REQUIRE( sampling_allocator__live_bytes( &sampling_allocator ) == 1200 );
+
+    allocator__free( sampling_allocator.allocator, second );
+    REQUIRE( sampling_allocator__live_bytes( &sampling_allocator ) == 1000 );
+
+    allocator__free( sampling_allocator.allocator, first );
+    REQUIRE( sampling_allocator__live_bytes( &sampling_allocator ) == 0 );
+
+    sampling_allocator__deinitialize( &sampling_allocator );
+}
+
+TEST_CASE_METHOD( SamplingAllocator__TestFixture, "sampling_allocator__estimates_live_bytes", "[sampling_allocator]" ){
+    const unsigned long long ALLOCATION_COUNT = 20000;
+    const unsigned long long ALLOCATION_SIZE = 256;
+
+    SamplingAllocator sampling_allocator;
+    sampling_allocator__initialize( &sampling_allocator, system_allocator.allocator, 16 * 1024 );
+
+    std::vector< void* > allocations;
+    for( unsigned long long index = 0; index < ALLOCATION_COUNT; index++ ){
+        allocations.push_back( allocator__alloc( sampling_allocator.allocator, ALLOCATION_SIZE ) );
+    }
+
+    // About 300 samples are taken, so the estimate should be well within 30% of the true value.
+    double expected = (double)( ALLOCATION_COUNT * ALLOCATION_SIZE );
+    double estimate = (double) sampling_allocator__live_bytes( &sampling_allocator );
+    REQUIRE( estimate > 0.7 * expected );
+    REQUIRE( estimate < 1.3 * expected );
+
+    for( void *allocation : allocations ){
+        allocator__free( sampling_allocator.allocator, allocation );
+    }
+
+    REQUIRE( sampling_allocator__live_bytes( &sampling_allocator ) == 0 );
+
+    sampling_allocator__deinitialize( &sampling_allocator );
+}
+
+TEST_CASE_METHOD( SamplingAllocator__TestFixture, "sampling_allocator__many_threads", "[sampling_allocator]" ){
+    const int THREAD_COUNT = 8;
+    const int ITERATION_COUNT = 10000;
+
+    SamplingAllocator sampling_allocator;
+    sampling_allocator__initialize( &sampling_allocator, system_allocator.allocator, 1024 );
+
+    std::vector< std::thread > threads;
+    for( int thread_index = 0; thread_index < THREAD_COUNT; thread_index++ ){
+        threads.push_back( std::thread( [ & ](){
+            void *memory = NULL;
+            for( int iteration = 0; iteration < ITERATION_COUNT; iteration++ ){
+                allocator__free( sampling_allocator.allocator, memory );
+                memory = allocator__alloc( sampling_allocator.allocator, 64 + iteration % 64 );
+            }
+            allocator__free( sampling_allocator.allocator, memory );
+        } ) );
+    }
+
+    for( int thread_index = 0; thread_index < THREAD_COUNT; thread_index++ ){
+        threads[ thread_index ].join();
+    }
+
+    REQUIRE( sampling_allocator__live_bytes( &sampling_allocator ) == 0 );
+
+    sampling_allocator__deinitialize( &sampling_allocator );
+}
+
+TEST_CASE_METHOD( SamplingAllocator__TestFixture, "sampling_allocator__append_profile", "[sampling_allocator]" ){
+    SamplingAllocator sampling_allocator;
+    sampling_allocator__initialize( &sampling_allocator, system_allocator.allocator, 1 );
+
+    void *memory = allocator__alloc( sampling_allocator.allocator, 123 );
+
+    // The profile may be built with the profiled allocator itself.
+    String profile = {};
+    sampling_allocator__append_profile( &sampling_allocator, &profile, sampling_allocator.allocator );
+
+    REQUIRE( profile.length > 0 );
+    REQUIRE( profile.data[ profile.length - 1 ] == '\n' );
+    REQUIRE( strstr( profile.data, " 123\n" ) != NULL );
+    REQUIRE( strchr( profile.data, '\n' ) == profile.data + profile.length - 1 );
+#if defined( __GLIBC__ ) || defined( __APPLE__ )
+    // Frames without an exported symbol are named by module and offset.
+    REQUIRE( strchr( profile.data, ';' ) != NULL );
+    REQUIRE( strstr( profile.data, "+0x" ) != NULL );
+#endif
+
+    string__clear( &profile, sampling_allocator.allocator );
+    allocator__free( sampling_allocator.allocator, memory );
+
+    sampling_allocator__deinitialize( &sampling_allocator );
+}
+
+TEST_CASE_METHOD( SamplingAllocator__TestFixture, "sampling_allocator__write_profile", "[sampling_allocator]" ){
+    SamplingAllocator sampling_allocator;
+    sampling_allocator__initialize( &sampling_allocator, system_allocator.allocator, 1 );
+
+    void *memory = allocator__alloc( sampling_allocator.allocator, 42 );
+
+    Error error = {};
+    String file_path = string__literal( "test__libkirke__sampling_allocator.collapsed" );
+    REQUIRE( sampling_allocator__write_profile( &sampling_allocator, file_path, &error ) );
+    REQUIRE( error.code == Error__None );
+
+    String contents;
+    REQUIRE( io__read_text_file( system_allocator.allocator, file_path, &contents, NULL ) );
+    REQUIRE( contents.length > 0 );
+    REQUIRE( strncmp( contents.data + contents.length - 4, " 42\n", 4 ) == 0 );
+    string__clear( &contents, system_allocator.allocator );
+    remove( file_path.data );
+
+    String invalid_path = string__literal( "/nonexistent/directory/profile.collapsed" );
+    REQUIRE( sampling_allocator__write_profile( &sampling_allocator, invalid_path, &error ) == false );
+    REQUIRE( error.code == SamplingAllocator__Error__UnableToOpenFile );
+
+    allocator__free( sampling_allocator.allocator, memory );
+
+    sampling_allocator__deinitialize( &sampling_allocator );
+}
@@ -0,0 +1,181 @@
+// 3rdParty Includes
+#include "catch2/catch.hpp"
+
+// System Includes
+#include <string.h> // strcmp
+#include <thread>
+
+// Internal Includes
+#include "kirke/scratch_allocator.h"
+#include "kirke/string.h"
+#include "kirke/system_allocator.h"
+
+class ScratchAllocator__TestFixture{
+    protected:
+        ScratchAllocator__TestFixture(){
+            system_allocator__initialize( &system_allocator, NULL );
+            scratch_allocator__initialize__options( &scratch_allocator, system_allocator.allocator, &options );
+        }
+
+        ~ScratchAllocator__TestFixture(){
+            scratch_allocator__deinitialize( &scratch_allocator );
+            system_allocator__deinitialize( &system_allocator );
+        }
+
+        const unsigned long long CHUNK_SIZE = 1024;
+        ScratchAllocator__Options options = { CHUNK_SIZE, true };
+        SystemAllocator system_allocator;
+        ScratchAllocator scratch_allocator;
+};
+
+TEST_CASE_METHOD( ScratchAllocator__TestFixture, "scratch_allocator__initialize_and_deinitialize", "[scratch_allocator]" ){
+    REQUIRE( scratch_allocator.allocator != NULL );
+    REQUIRE( scratch_allocator.backing_allocator == system_allocator.allocator );
+    REQUIRE( scratch_allocator.chunk_size == CHUNK_SIZE );
+    REQUIRE( scratch_allocator.debug );
+    REQUIRE( scratch_allocator.top == NULL );
+}
+
+TEST_CASE_METHOD( ScratchAllocator__TestFixture, "scratch_allocator__free_in_order_reuses_memory", "[scratch_allocator]" ){
+    char *first = (char*) allocator__alloc( scratch_allocator.allocator, 10 );
+    char *second = (char*) allocator__alloc( scratch_allocator.allocator, 10 );
+
+    REQUIRE( first != NULL );
+    REQUIRE( second > first );
+    REQUIRE( scratch_allocator.top == second );
+
+    allocator__free( scratch_allocator.allocator, second );
+    REQUIRE( scratch_allocator.top == first );
+    REQUIRE( allocator__alloc( scratch_allocator.allocator, 10 ) == second );
+
+    REQUIRE( scratch_allocator.out_of_order_free_count == 0 );
+}
+
+TEST_CASE_METHOD( ScratchAllocator__TestFixture, "scratch_allocator__free_out_of_order", "[scratch_allocator]" ){
+    char *first = (char*) allocator__alloc( scratch_allocator.allocator, 10 );
+    char *second = (char*) allocator__alloc( scratch_allocator.allocator, 10 );
+
+    allocator__free( scratch_allocator.allocator, first );
+    REQUIRE( scratch_allocator.out_of_order_free_count == 1 );
+    REQUIRE( scratch_allocator.top == second );
+
+    /* Freeing the top also releases the allocation beneath it, which was already freed. */
+    allocator__free( scratch_allocator.allocator, second );
+    REQUIRE( scratch_allocator.out_of_order_free_count == 1 );
+    REQUIRE( scratch_allocator.top == NULL );
+    REQUIRE( allocator__alloc( scratch_allocator.allocator, 10 ) == first );
+}
+
+TEST_CASE_METHOD( ScratchAllocator__TestFixture, "scratch_allocator__alloc_larger_than_chunk_size", "[scratch_allocator]" ){
+    char *small = (char*) allocator__alloc( scratch_allocator.allocator, 10 );
+    char *large = (char*) allocator__alloc( scratch_allocator.allocator, 4 * CHUNK_SIZE );
+
+    REQUIRE( large != NULL );
+    memset( large, 'a', 4 * CHUNK_SIZE );
+
+    allocator__free( scratch_allocator.allocator, large );
+    allocator__free( scratch_allocator.allocator, small );
+    REQUIRE( scratch_allocator.out_of_order_free_count == 0 );
+    REQUIRE( allocator__alloc( scratch_allocator.allocator, 10 ) == small );
+}
+
+TEST_CASE_METHOD( ScratchAllocator__TestFixture, "scratch_allocator__alloc_size_overflow", "[scratch_allocator]" ){
+    char *first = (char*) allocator__alloc( scratch_allocator.allocator, 10 );
+
+    /* Sizes which would wrap the size of a new chunk, or the fit within the current one, are refused. */
+    REQUIRE( allocator__alloc( scratch_allocator.allocator, ~0ULL - 1 ) == NULL );
+    REQUIRE( allocator__alloc( scratch_allocator.allocator, ~0ULL - 2 * CHUNK_SIZE ) == NULL );
+    REQUIRE( allocator__realloc( scratch_allocator.allocator, first, ~0ULL - 1 ) == NULL );
+
+    REQUIRE( scratch_allocator.top == first );
+    REQUIRE( scratch_allocator.current_chunk == scratch_allocator.first_chunk );
+    REQUIRE( allocator__alloc( scratch_allocator.allocator, 10 ) > first );
+}
+
+TEST_CASE_METHOD( ScratchAllocator__TestFixture, "scratch_allocator__realloc_top_in_place", "[scratch_allocator]" ){
+    char *first = (char*) allocator__alloc( scratch_allocator.allocator, 10 );
+    strcpy( first, "scratch" );
+
+    REQUIRE( allocator__realloc( scratch_allocator.allocator, first, 100 ) == first );
+    REQUIRE( allocator__try_expand( scratch_allocator.allocator, first, 200 ) );
+
+    /* Growing beyond the chunk moves the allocation, without reporting the move as an out of order free. */
+    char *moved = (char*) allocator__realloc( scratch_allocator.allocator, first, 2 * CHUNK_SIZE );
+    REQUIRE( moved != first );
+    REQUIRE( strcmp( moved, "scratch" ) == 0 );
+    REQUIRE( scratch_allocator.top == moved );
+
+    allocator__free( scratch_allocator.allocator, moved );
+    REQUIRE( scratch_allocator.out_of_order_free_count == 0 );
+    REQUIRE( scratch_allocator.top == NULL );
+}
+
+TEST_CASE_METHOD( ScratchAllocator__TestFixture, "scratch_allocator__push_and_pop", "[scratch_allocator]" ){
+    char *before = (char*) allocator__alloc( scratch_allocator.allocator, 10 );
+
+    ScratchAllocator__Marker marker = scratch_allocator__push( &scratch_allocator );
+    char *first = (char*) allocator__alloc( scratch_allocator.allocator, 10 );
+    for( int allocation = 0; allocation < 100; allocation++ ){
+        allocator__alloc( scratch_allocator.allocator, 100 );
+    }
+    scratch_allocator__pop( &scratch_allocator, marker );
+
+    REQUIRE( scratch_allocator.top == before );
+    REQUIRE( allocator__alloc( scratch_allocator.allocator, 10 ) == first );
+}
+
+TEST_CASE_METHOD( ScratchAllocator__TestFixture, "scratch_allocator__trim", "[scratch_allocator]" ){
+    char *before = (char*) allocator__alloc( scratch_allocator.allocator, 10 );
+
+    ScratchAllocator__Marker marker = scratch_allocator__push( &scratch_allocator );
+    for( int allocation = 0; allocation < 100; allocation++ ){
+        allocator__alloc( scratch_allocator.allocator, 100 );
+    }
+    REQUIRE( scratch_allocator__trim( &scratch_allocator ) == false );
+    scratch_allocator__pop( &scratch_allocator, marker );
+
+    REQUIRE( allocator__trim( scratch_allocator.allocator ) );
+    REQUIRE( scratch_allocator.current_chunk == scratch_allocator.first_chunk );
+    REQUIRE( scratch_allocator.top == before );
+
+    for( int allocation = 0; allocation < 100; allocation++ ){
+        REQUIRE( allocator__alloc( scratch_allocator.allocator, 100 ) != NULL );
+    }
+}
+
+TEST_CASE_METHOD( ScratchAllocator__TestFixture, "scratch_allocator__format_strings", "[scratch_allocator]" ){
+    ScratchAllocator__Marker marker = scratch_allocator__push( &scratch_allocator );
+
+    String string;
+    string__initialize__format( &string, scratch_allocator.allocator, "%s, %d", "Hello", 1 );
+    for( int repetition = 2; repetition <= 100; repetition++ ){
+        string__append__format( &string, scratch_allocator.allocator, ", %d", repetition );
+    }
+
+    REQUIRE( strncmp( string.data, "Hello, 1, 2, 3", 14 ) == 0 );
+    REQUIRE( strcmp( string.data + string.length - 5, ", 100" ) == 0 );
+
+    scratch_allocator__pop( &scratch_allocator, marker );
+    REQUIRE( scratch_allocator.out_of_order_free_count == 0 );
+}
+
+TEST_CASE( "scratch_allocator__thread_default", "[scratch_allocator]" ){
+    ScratchAllocator *scratch_allocator = scratch_allocator__thread_default();
+
+    REQUIRE( scratch_allocator != NULL );
+    REQUIRE( scratch_allocator__thread_default() == scratch_allocator );
+
+    ScratchAllocator *other_scratch_allocator = NULL;
+    std::thread thread( [ & ](){
+        other_scratch_allocator = scratch_allocator__thread_default();
+
+        ScratchAllocator__Marker marker = scratch_allocator__push( other_scratch_allocator );
+        String string;
+        string__initialize__format( &string, other_scratch_allocator->allocator, "%d", 42 );
+        scratch_allocator__pop( other_scratch_allocator, marker );
+    } );
+    thread.join();
+
+    REQUIRE( other_scratch_allocator != NULL );
+    REQUIRE( other_scratch_allocator != scratch_allocator );
+}
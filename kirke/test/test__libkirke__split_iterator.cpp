@@ -95,3 +95,21 @@ TEST_CASE( "split_iterator__next", "[split_iterator]" ){
         REQUIRE( string__equals( token, test_words[ split_index++ ] ) );
     }
 }
+
+TEST_CASE( "split_iterator__long_delimiter", "[split_iterator]" ){
+    String string = string__literal( "first<-- a delimiter longer than thirty two characters -->second<-- a delimiter longer than thirty two characters -->" );
+    String delimiter = string__literal( "<-- a delimiter longer than thirty two characters -->" );
+
+    SplitIterator split_iterator;
+    split_iterator__initialize( &split_iterator, &string, &delimiter );
+    REQUIRE( split_iterator__count( &split_iterator ) == 2 );
+
+    String token;
+    String expected_first = string__literal( "first" );
+    String expected_second = string__literal( "second" );
+    REQUIRE( split_iterator__next( &split_iterator, &token ) );
+    REQUIRE( string__equals( token, expected_first ) );
+    REQUIRE( split_iterator__next( &split_iterator, &token ) );
+    REQUIRE( string__equals( token, expected_second ) );
+    REQUIRE( split_iterator__next( &split_iterator, &token ) == false );
+}
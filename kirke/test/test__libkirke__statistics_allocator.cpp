@@ -0,0 +1,222 @@
+// System Includes
+#include <atomic>
+#include <thread>
+#include <vector>
+
+// 3rdParty Includes
+#include "catch2/catch.hpp"
+
+// Internal Includes
+#include "kirke/statistics_allocator.h"
+#include "kirke/string.h"
+#include "kirke/system_allocator.h"
+
+class StatisticsAllocator__TestFixture{
+    protected:
+        StatisticsAllocator__TestFixture(){
+            system_allocator__initialize( &system_allocator, NULL );
+            statistics_allocator__initialize( &statistics_allocator, system_allocator.allocator );
+        }
+
+        ~StatisticsAllocator__TestFixture(){
+            statistics_allocator__deinitialize( &statistics_allocator );
+            system_allocator__deinitialize( &system_allocator );
+        }
+
+        SystemAllocator system_allocator;
+        StatisticsAllocator statistics_allocator;
+};
+
+TEST_CASE_METHOD( StatisticsAllocator__TestFixture, "statistics_allocator__initialize_and_deinitialize", "[statistics_allocator]" ){
+    REQUIRE( statistics_allocator.allocator != NULL );
+    REQUIRE( statistics_allocator.backing_allocator == system_allocator.allocator );
+    REQUIRE( statistics_allocator.state != NULL );
+
+    StatisticsAllocator__Snapshot snapshot;
+    statistics_allocator__snapshot( &statistics_allocator, &snapshot );
+
+    REQUIRE( snapshot.alloc_count == 0 );
+    REQUIRE( snapshot.free_count == 0 );
+    REQUIRE( snapshot.live_bytes == 0 );
+    REQUIRE( snapshot.peak_live_bytes == 0 );
+}
+
+TEST_CASE_METHOD( StatisticsAllocator__TestFixture, "statistics_allocator__alloc_realloc_and_free", "[statistics_allocator]" ){
+    char *first = (char*) allocator__alloc( statistics_allocator.allocator, 100 );
+    char *second = (char*) allocator__alloc( statistics_allocator.allocator, 1000 );
+    REQUIRE( (unsigned long long) first % 16 == 0 );
+    memcpy( first, "Hello", 6 );
+
+    first = (char*) allocator__realloc( statistics_allocator.allocator, first, 300 );
+    REQUIRE( strcmp( first, "Hello" ) == 0 );
+    first = (char*) allocator__realloc( statistics_allocator.allocator, first, 50 );
+    REQUIRE( strcmp( first, "Hello" ) == 0 );
+
+    StatisticsAllocator__Snapshot snapshot;
+    statistics_allocator__snapshot( &statistics_allocator, &snapshot );
+
+    REQUIRE( snapshot.alloc_count == 2 );
+    REQUIRE( snapshot.realloc_count == 2 );
+    REQUIRE( snapshot.realloc_growth_count == 1 );
+    REQUIRE( snapshot.free_count == 0 );
+    REQUIRE( snapshot.bytes_allocated == 100 + 1000 + 200 );
+    REQUIRE( snapshot.live_bytes == 50 + 1000 );
+    REQUIRE( snapshot.peak_live_bytes == 300 + 1000 );
+
+    // 100 and 50 lie in [64, 128) and [32, 64), 300 in [256, 512), 1000 in [512, 1024).
+    REQUIRE( snapshot.size_histogram[ 5 ] == 1 );
+    REQUIRE( snapshot.size_histogram[ 6 ] == 1 );
+    REQUIRE( snapshot.size_histogram[ 8 ] == 1 );
+    REQUIRE( snapshot.size_histogram[ 9 ] == 1 );
+
+    allocator__free( statistics_allocator.allocator, first );
+    allocator__free( statistics_allocator.allocator, second );
+    allocator__free( statistics_allocator.allocator, NULL );
+
+    statistics_allocator__snapshot( &statistics_allocator, &snapshot );
+    REQUIRE( snapshot.free_count == 2 );
+    REQUIRE( snapshot.live_bytes == 0 );
+    REQUIRE( snapshot.peak_live_bytes == 300 + 1000 );
+}
+
+TEST_CASE_METHOD( StatisticsAllocator__TestFixture, "statistics_allocator__counts_array_growth", "[statistics_allocator]" ){
+    AutoString auto_string = {0};
+    auto_string__initialize( &auto_string, statistics_allocator.allocator, 1 );
+
+    for( int index = 0; index < 1000; index++ ){
+        auto_string__append_elements( &auto_string, 4, "abcd" );
+    }
+
+    StatisticsAllocator__Snapshot snapshot;
+    statistics_allocator__snapshot( &statistics_allocator, &snapshot );
+
+    REQUIRE( snapshot.realloc_growth_count > 0 );
+    REQUIRE( snapshot.realloc_growth_count < 20 );
+    REQUIRE( snapshot.live_bytes >= 4000 );
+
+    auto_string__clear( &auto_string );
+}
+
+TEST_CASE_METHOD( StatisticsAllocator__TestFixture, "statistics_allocator__free_on_another_thread", "[statistics_allocator]" ){
+    char *memory = (char*) allocator__alloc( statistics_allocator.allocator, 100 );
+
+    // The freeing thread's live bytes go negative, and cancel out the allocating thread's when they are merged.
+    std::thread thread( [ & ](){
+        allocator__free( statistics_allocator.allocator, memory );
+    } );
+    thread.join();
+
+    StatisticsAllocator__Snapshot snapshot;
+    statistics_allocator__snapshot( &statistics_allocator, &snapshot );
+
+    REQUIRE( snapshot.free_count == 1 );
+    REQUIRE( snapshot.live_bytes == 0 );
+    REQUIRE( snapshot.peak_live_bytes == 100 );
+}
+
+TEST_CASE_METHOD( StatisticsAllocator__TestFixture, "statistics_allocator__peaks_at_different_times", "[statistics_allocator]" ){
+    const unsigned long long SIZE = 2 * STATISTICS_ALLOCATOR__FLUSH_THRESHOLD;
+
+    // Each thread peaks while the other holds nothing, so the peaks must not be summed.
+    for( int thread_index = 0; thread_index < 2; thread_index++ ){
+        std::thread thread( [ & ](){
+            allocator__free( statistics_allocator.allocator, allocator__alloc( statistics_allocator.allocator, SIZE ) );
+        } );
+        thread.join();
+    }
+
+    StatisticsAllocator__Snapshot snapshot;
+    statistics_allocator__snapshot( &statistics_allocator, &snapshot );
+
+    REQUIRE( snapshot.live_bytes == 0 );
+    REQUIRE( snapshot.peak_live_bytes == SIZE );
+}
+
+TEST_CASE_METHOD( StatisticsAllocator__TestFixture, "statistics_allocator__producer_and_consumer", "[statistics_allocator]" ){
+    const int ITERATION_COUNT = 10000;
+    const unsigned long long SIZE = 1000;
+
+    // The producer only allocates and the consumer only frees, while at most one allocation is live at a time.
+    std::atomic< void* > handed_over( nullptr );
+    std::thread consumer( [ & ](){
+        for( int iteration = 0; iteration < ITERATION_COUNT; iteration++ ){
+            void *memory;
+            while( ( memory = handed_over.exchange( nullptr ) ) == nullptr ){
+                std::this_thread::yield();
+            }
+            allocator__free( statistics_allocator.allocator, memory );
+        }
+    } );
+
+    for( int iteration = 0; iteration < ITERATION_COUNT; iteration++ ){
+        void *memory = allocator__alloc( statistics_allocator.allocator, SIZE );
+        void *expected = nullptr;
+        while( !handed_over.compare_exchange_weak( expected, memory ) ){
+            expected = nullptr;
+            std::this_thread::yield();
+        }
+    }
+    consumer.join();
+
+    StatisticsAllocator__Snapshot snapshot;
+    statistics_allocator__snapshot( &statistics_allocator, &snapshot );
+
+    REQUIRE( snapshot.live_bytes == 0 );
+    REQUIRE( snapshot.peak_live_bytes >= SIZE );
+    REQUIRE( snapshot.peak_live_bytes < 2 * SIZE + 2 * 2 * STATISTICS_ALLOCATOR__FLUSH_THRESHOLD );
+}
+
+TEST_CASE_METHOD( StatisticsAllocator__TestFixture, "statistics_allocator__many_threads", "[statistics_allocator]" ){
+    const int THREAD_COUNT = 8;
+    const int ITERATION_COUNT = 10000;
+
+    std::vector< std::thread > threads;
+    for( int thread_index = 0; thread_index < THREAD_COUNT; thread_index++ ){
+        threads.push_back( std::thread( [ & ](){
+            for( int iteration = 0; iteration < ITERATION_COUNT; iteration++ ){
+                void *memory = allocator__alloc( statistics_allocator.allocator, 64 );
+                allocator__free( statistics_allocator.allocator, memory );
+            }
+        } ) );
+    }
+
+    // Counters of threads which are still running are merged too.
+    StatisticsAllocator__Snapshot snapshot;
+    statistics_allocator__snapshot( &statistics_allocator, &snapshot );
+    REQUIRE( snapshot.alloc_count <= (unsigned long long) THREAD_COUNT * ITERATION_COUNT );
+
+    for( int thread_index = 0; thread_index < THREAD_COUNT; thread_index++ ){
+        threads[ thread_index ].join();
+    }
+
+    statistics_allocator__snapshot( &statistics_allocator, &snapshot );
+    REQUIRE( snapshot.alloc_count == (unsigned long long) THREAD_COUNT * ITERATION_COUNT );
+    REQUIRE( snapshot.free_count == (unsigned long long) THREAD_COUNT * ITERATION_COUNT );
+    REQUIRE( snapshot.size_histogram[ 6 ] == (unsigned long long) THREAD_COUNT * ITERATION_COUNT );
+    REQUIRE( snapshot.live_bytes == 0 );
+    REQUIRE( snapshot.peak_live_bytes >= 64 );
+    REQUIRE( snapshot.peak_live_bytes <= 64ULL * THREAD_COUNT );
+}
+
+TEST_CASE_METHOD( StatisticsAllocator__TestFixture, "statistics_allocator__snapshot__append_text_and_json", "[statistics_allocator]" ){
+    void *memory = allocator__alloc( statistics_allocator.allocator, 3 );
+
+    StatisticsAllocator__Snapshot snapshot;
+    statistics_allocator__snapshot( &statistics_allocator, &snapshot );
+
+    String text = {};
+    statistics_allocator__snapshot__append_text( &snapshot, &text, system_allocator.allocator );
+    REQUIRE( strstr( text.data, "alloc: 1\n" ) != NULL );
+    REQUIRE( strstr( text.data, "live bytes: 3\n" ) != NULL );
+    REQUIRE( strstr( text.data, "size [2, 4): 1\n" ) != NULL );
+
+    String json = {};
+    statistics_allocator__snapshot__append_json( &snapshot, &json, system_allocator.allocator );
+    REQUIRE( strncmp( json.data, "{\"alloc_count\":1,\"realloc_count\":0,", 35 ) == 0 );
+    REQUIRE( strstr( json.data, "\"size_histogram\":[0,1,0," ) != NULL );
+    REQUIRE( json.data[ json.length - 1 ] == '}' );
+
+    string__clear( &text, system_allocator.allocator );
+    string__clear( &json, system_allocator.allocator );
+    allocator__free( statistics_allocator.allocator, memory );
+}
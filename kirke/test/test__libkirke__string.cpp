@@ -60,6 +60,34 @@ TEST_CASE( "string__index_of", "[string]" ){
     REQUIRE( index == 7 );
 }
 
+TEST_CASE( "string__index_of__repeated_first_character", "[string]" ){
+    String string = string__literal( "aaaaaaab, aaab" );
+    String sequence = string__literal( "aab" );
+    String single = string__literal( "," );
+    String missing = string__literal( "aaac" );
+
+    unsigned long long index;
+    REQUIRE( string__index_of( &string, &sequence, &index ) );
+    REQUIRE( index == 5 );
+    REQUIRE( string__index_of( &string, &single, &index ) );
+    REQUIRE( index == 8 );
+    REQUIRE( string__index_of( &string, &missing, &index ) == false );
+    REQUIRE( index == string.length );
+}
+
+TEST_CASE( "string__index_of__long_sequence", "[string]" ){
+    // A long, repetitive sequence which almost matches at every position is found in time linear in the string.
+    String string = string__literal( "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaab" );
+    String sequence = string__literal( "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaab" );
+    String missing = string__literal( "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaac" );
+
+    unsigned long long index;
+    REQUIRE( string__index_of( &string, &sequence, &index ) );
+    REQUIRE( index == string.length - sequence.length );
+    REQUIRE( string__index_of( &string, &missing, &index ) == false );
+    REQUIRE( index == string.length );
+}
+
 class String__TestFixture{
     protected:
         String__TestFixture(){
@@ -435,3 +463,26 @@ TEST_CASE_METHOD( String__TestFixture, "string__append__format", "[string]" ){
 
     REQUIRE( string__equals( string, expected_string ) );
 }
+
+TEST_CASE_METHOD( String__TestFixture, "small_string", "[string]" ){
+    REQUIRE( sizeof( SmallString ) == 64 );
+
+    SmallString small_string;
+    small_string__initialize( &small_string, system_allocator.allocator );
+
+    // A short string, such as a token, fits inline.
+    small_string__append_elements( &small_string, 5, "token" );
+    REQUIRE( small_string.spilled_data == NULL );
+
+    String expected_string = string__literal( "token" );
+    REQUIRE( string__equals( small_string__array( &small_string ), expected_string ) );
+
+    // A longer one is allocated, and stays null-terminated.
+    char long_string[] = "This string is longer than the inline capacity of a SmallString.";
+    small_string__clear__keep_capacity( &small_string );
+    small_string__append_elements( &small_string, sizeof( long_string ) - 1, long_string );
+    REQUIRE( small_string.spilled_data != NULL );
+    REQUIRE( strcmp( small_string__data( &small_string ), long_string ) == 0 );
+
+    small_string__clear( &small_string );
+}
@@ -0,0 +1,112 @@
+// 3rdParty Includes
+#include "catch2/catch.hpp"
+
+// System Includes
+#include <string>
+
+// Internal Includes
+#include "kirke/string.h"
+#include "kirke/string_searcher.h"
+
+static String string_searcher__test__string( std::string const &text ){
+    return (String){
+        .data = (char*) text.data(),
+        .length = text.size(),
+        .capacity = text.size(),
+        .element_size = sizeof( char )
+    };
+}
+
+/**
+ *  Checks that a StringSearcher finds the same index as std::string::find.
+ */
+static void string_searcher__test__find( std::string const &text, std::string const &sequence ){
+    String string = string_searcher__test__string( text );
+    String sequence_string = string_searcher__test__string( sequence );
+
+    StringSearcher searcher;
+    string_searcher__initialize( &searcher, &sequence_string );
+
+    unsigned long long index;
+    bool found = string_searcher__index_of( &searcher, &string, &index );
+
+    std::string::size_type expected_index = text.find( sequence );
+    INFO( "text: " << text << ", sequence: " << sequence );
+    REQUIRE( found == ( expected_index != std::string::npos ) );
+    REQUIRE( index == ( found ? expected_index : text.size() ) );
+}
+
+TEST_CASE( "string_searcher__short", "[string_searcher]" ){
+    string_searcher__test__find( "Hello, World!", "o" );
+    string_searcher__test__find( "Hello, World!", "Wo" );
+    string_searcher__test__find( "Hello, World!", "d!" );
+    string_searcher__test__find( "Hello, World!", "Hello, World!" );
+    string_searcher__test__find( "Hello, World!", "Hello, World!!" );
+    string_searcher__test__find( "Hello, World!", "x" );
+    string_searcher__test__find( "Hello, World!", "" );
+    string_searcher__test__find( "", "a" );
+
+    // Candidates in the vectorized blocks and the remainder, with matching first and last characters.
+    std::string text( 100, 'a' );
+    text += "abba" + std::string( 37, 'b' ) + "abca";
+    string_searcher__test__find( text, "abca" );
+    string_searcher__test__find( text, "abba" );
+    string_searcher__test__find( text, "acba" );
+    string_searcher__test__find( text, std::string( 37, 'b' ) + "abca" );
+}
+
+TEST_CASE( "string_searcher__two_way", "[string_searcher]" ){
+    // A periodic sequence, which the memory of the Two-Way algorithm handles.
+    std::string periodic;
+    for( int repetition = 0; repetition < 20; repetition++ ){
+        periodic += "abcab";
+    }
+    string_searcher__test__find( periodic + periodic + "x", periodic + "x" );
+    string_searcher__test__find( periodic + periodic, periodic + "x" );
+
+    // A sequence which differs from the searched string only at its end, the worst case for a brute force search.
+    std::string text( 100000, 'a' );
+    std::string sequence = std::string( 999, 'a' ) + "b";
+    string_searcher__test__find( text, sequence );
+    text += "b";
+    string_searcher__test__find( text, sequence );
+    string_searcher__test__find( text, "b" + std::string( 999, 'a' ) );
+    string_searcher__test__find( text, std::string( 40, 'a' ) + "c" + std::string( 40, 'a' ) );
+}
+
+TEST_CASE( "string_searcher__random", "[string_searcher]" ){
+    // Small alphabets make partial matches, and so every branch of both algorithms, frequent.
+    unsigned long long state = 88172645463325252ULL;
+    for( int iteration = 0; iteration < 2000; iteration++ ){
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+
+        unsigned long long alphabet_size = 2 + state % 3;
+        unsigned long long text_length = ( state >> 8 ) % 400;
+        unsigned long long sequence_length = 1 + ( state >> 20 ) % 60;
+
+        std::string text;
+        for( unsigned long long index = 0; index < text_length; index++ ){
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            text += (char)( 'a' + state % alphabet_size );
+        }
+
+        std::string sequence;
+        if( text_length > sequence_length && iteration % 2 == 0 ){
+            sequence = text.substr( ( state >> 32 ) % ( text_length - sequence_length ), sequence_length );
+        }
+        else{
+            for( unsigned long long index = 0; index < sequence_length; index++ ){
+                state ^= state << 13;
+                state ^= state >> 7;
+                state ^= state << 17;
+                sequence += (char)( 'a' + state % alphabet_size );
+            }
+        }
+
+        string_searcher__test__find( text, sequence );
+    }
+}
@@ -1,3 +1,6 @@
+// System Includes
+#include <string.h> // memcpy, strcmp
+
 // 3rdParty Includes
 #include "catch2/catch.hpp"
 
@@ -8,6 +11,10 @@ TEST_CASE( "system_allocator__initialize_and_deinitialize", "[system_allocator]"
     SystemAllocator system_allocator;
     system_allocator__initialize( &system_allocator, NULL );
 
+    // Large blocks are opt-in, so that frees never take their lock by default.
+    REQUIRE( system_allocator.large_block_threshold == 0 );
+    REQUIRE( system_allocator.large_blocks == NULL );
+
     const unsigned long long ELEMENT_COUNT = 25;
     long* memory = (long*) allocator__alloc( system_allocator.allocator, ELEMENT_COUNT * sizeof( long ) );
 
@@ -19,3 +26,173 @@ TEST_CASE( "system_allocator__initialize_and_deinitialize", "[system_allocator]"
 
     system_allocator__deinitialize( &system_allocator );
 }
+
+TEST_CASE( "system_allocator__aligned", "[system_allocator]" ){
+    SystemAllocator system_allocator;
+    system_allocator__initialize( &system_allocator, NULL );
+
+    for( unsigned long long alignment = 1; alignment <= 4096; alignment *= 2 ){
+        char* memory = (char*) allocator__alloc_aligned( system_allocator.allocator, 100, alignment );
+        REQUIRE( memory != NULL );
+        REQUIRE( (unsigned long long) memory % alignment == 0 );
+        memcpy( memory, "Hello", 6 );
+
+        memory = (char*) allocator__realloc_aligned( system_allocator.allocator, memory, 100, 100000, alignment );
+        REQUIRE( memory != NULL );
+        REQUIRE( (unsigned long long) memory % alignment == 0 );
+        REQUIRE( strcmp( memory, "Hello" ) == 0 );
+
+        allocator__free_aligned( system_allocator.allocator, memory );
+    }
+
+    system_allocator__deinitialize( &system_allocator );
+}
+
+TEST_CASE( "system_allocator__large_blocks", "[system_allocator]" ){
+    const unsigned long long THRESHOLD = 64 * 1024;
+
+    SystemAllocator__Options options = {};
+    options.large_block_threshold = THRESHOLD;
+
+    SystemAllocator system_allocator;
+    system_allocator__initialize__options( &system_allocator, NULL, &options );
+
+#if defined( __linux__ )
+    REQUIRE( system_allocator.large_block_threshold == THRESHOLD );
+    REQUIRE( system_allocator.large_blocks != NULL );
+#endif
+
+    // A small block crosses the threshold, grows as a large block, then shrinks back below the threshold.
+    char* memory = (char*) allocator__alloc( system_allocator.allocator, 100 );
+    memcpy( memory, "Hello", 6 );
+
+    for( unsigned long long size = 2 * THRESHOLD; size <= 64 * THRESHOLD; size *= 2 ){
+        memory = (char*) allocator__realloc( system_allocator.allocator, memory, size );
+        REQUIRE( memory != NULL );
+        REQUIRE( strcmp( memory, "Hello" ) == 0 );
+        memory[ size - 1 ] = 'x';
+    }
+
+    memory = (char*) allocator__realloc( system_allocator.allocator, memory, 100 );
+    REQUIRE( strcmp( memory, "Hello" ) == 0 );
+    allocator__free( system_allocator.allocator, memory );
+
+    // Large blocks are page aligned, and can always be resized in place within their last page.
+    memory = (char*) allocator__alloc( system_allocator.allocator, THRESHOLD + 1 );
+#if defined( __linux__ )
+    REQUIRE( (unsigned long long) memory % 4096 == 0 );
+    REQUIRE( allocator__try_expand( system_allocator.allocator, memory, THRESHOLD + 4096 ) );
+#endif
+    allocator__free( system_allocator.allocator, memory );
+
+    system_allocator__deinitialize( &system_allocator );
+
+    REQUIRE( system_allocator.large_blocks == NULL );
+}
+
+TEST_CASE( "system_allocator__huge_pages", "[system_allocator]" ){
+    const unsigned long long THRESHOLD = SYSTEM_ALLOCATOR__HUGE_PAGE_SIZE;
+
+    SystemAllocator__Options options = {};
+    options.huge_page_threshold = THRESHOLD;
+    options.prefault = true;
+
+    SystemAllocator system_allocator;
+    system_allocator__initialize__options( &system_allocator, NULL, &options );
+
+    SystemAllocator__HugePageStatistics statistics;
+
+#if defined( __linux__ )
+    // Without a large block threshold, blocks become large blocks at the huge page threshold.
+    REQUIRE( system_allocator.large_block_threshold == THRESHOLD );
+    REQUIRE( system_allocator.huge_page_threshold == THRESHOLD );
+    REQUIRE( system_allocator.prefault );
+#endif
+
+    char* memory = (char*) allocator__alloc( system_allocator.allocator, 100 );
+    memcpy( memory, "Hello", 6 );
+
+    // The block moves into a huge page block, then keeps its alignment however it grows.
+    for( unsigned long long size = THRESHOLD; size <= 16 * THRESHOLD; size *= 2 ){
+        memory = (char*) allocator__realloc( system_allocator.allocator, memory, size + 1 );
+        REQUIRE( memory != NULL );
+        REQUIRE( strcmp( memory, "Hello" ) == 0 );
+        memory[ size ] = 'x';
+
+#if defined( __linux__ )
+        REQUIRE( (unsigned long long) memory % SYSTEM_ALLOCATOR__HUGE_PAGE_SIZE == 0 );
+
+        system_allocator__huge_page_statistics( &system_allocator, &statistics );
+        REQUIRE( statistics.advised_bytes == ( ( size + 1 + THRESHOLD - 1 ) / THRESHOLD ) * THRESHOLD );
+        REQUIRE( statistics.backed_bytes <= statistics.advised_bytes );
+#endif
+    }
+
+    allocator__free( system_allocator.allocator, memory );
+
+    system_allocator__huge_page_statistics( &system_allocator, &statistics );
+    REQUIRE( statistics.advised_bytes == 0 );
+    REQUIRE( statistics.backed_bytes == 0 );
+
+    system_allocator__deinitialize( &system_allocator );
+}
+
+TEST_CASE( "system_allocator__calloc", "[system_allocator]" ){
+    const unsigned long long THRESHOLD = 64 * 1024;
+
+    SystemAllocator__Options options = {};
+    options.large_block_threshold = THRESHOLD;
+
+    SystemAllocator system_allocator;
+    system_allocator__initialize__options( &system_allocator, NULL, &options );
+
+    // Both small blocks from calloc and large blocks fresh from the kernel are zeroed.
+    for( unsigned long long size = 16; size <= 4 * THRESHOLD; size *= 4 ){
+        unsigned char* memory = (unsigned char*) allocator__calloc( system_allocator.allocator, size, 1 );
+        REQUIRE( memory != NULL );
+        for( unsigned long long index = 0; index < size; index++ ){
+            REQUIRE( memory[ index ] == 0 );
+        }
+        allocator__free( system_allocator.allocator, memory );
+    }
+
+    system_allocator__deinitialize( &system_allocator );
+}
+
+TEST_CASE( "system_allocator__large_blocks_disabled", "[system_allocator]" ){
+    SystemAllocator system_allocator;
+    system_allocator__initialize__options( &system_allocator, NULL, NULL );
+
+    REQUIRE( system_allocator.large_block_threshold == 0 );
+    REQUIRE( system_allocator.large_blocks == NULL );
+
+    char* memory = (char*) allocator__alloc( system_allocator.allocator, 8 * 1024 * 1024 );
+    memory = (char*) allocator__realloc( system_allocator.allocator, memory, 16 * 1024 * 1024 );
+    REQUIRE( memory != NULL );
+    allocator__free( system_allocator.allocator, memory );
+
+    system_allocator__deinitialize( &system_allocator );
+}
+
+TEST_CASE( "system_allocator__trim", "[system_allocator]" ){
+    SystemAllocator system_allocator;
+    system_allocator__initialize( &system_allocator, NULL );
+
+    void* memory[ 1000 ];
+    for( int index = 0; index < 1000; index++ ){
+        memory[ index ] = allocator__alloc( system_allocator.allocator, 1000 );
+    }
+    for( int index = 0; index < 1000; index++ ){
+        allocator__free( system_allocator.allocator, memory[ index ] );
+    }
+
+    // Whether any memory is released depends on the C library, but trimming must leave the allocator usable.
+    allocator__trim( system_allocator.allocator );
+    system_allocator__trim( &system_allocator );
+
+    memory[ 0 ] = allocator__alloc( system_allocator.allocator, 1000 );
+    REQUIRE( memory[ 0 ] != NULL );
+    allocator__free( system_allocator.allocator, memory[ 0 ] );
+
+    system_allocator__deinitialize( &system_allocator );
+}
@@ -0,0 +1,149 @@
+// System Includes
+#include <thread>
+#include <vector>
+
+// 3rdParty Includes
+#include "catch2/catch.hpp"
+
+// Internal Includes
+#include "kirke/string.h"
+#include "kirke/system_allocator.h"
+#include "kirke/thread_cache_allocator.h"
+
+class ThreadCacheAllocator__TestFixture{
+    protected:
+        ThreadCacheAllocator__TestFixture(){
+            system_allocator__initialize( &system_allocator, NULL );
+            thread_cache_allocator__initialize( &thread_cache_allocator, system_allocator.allocator );
+        }
+
+        ~ThreadCacheAllocator__TestFixture(){
+            thread_cache_allocator__deinitialize( &thread_cache_allocator );
+            system_allocator__deinitialize( &system_allocator );
+        }
+
+        SystemAllocator system_allocator;
+        ThreadCacheAllocator thread_cache_allocator;
+};
+
+TEST_CASE_METHOD( ThreadCacheAllocator__TestFixture, "thread_cache_allocator__initialize_and_deinitialize", "[thread_cache_allocator]" ){
+    REQUIRE( thread_cache_allocator.allocator != NULL );
+    REQUIRE( thread_cache_allocator.backing_allocator == system_allocator.allocator );
+    REQUIRE( thread_cache_allocator.depot != NULL );
+}
+
+TEST_CASE_METHOD( ThreadCacheAllocator__TestFixture, "thread_cache_allocator__alloc_and_free_every_size_class", "[thread_cache_allocator]" ){
+    std::vector< unsigned char* > allocations;
+
+    for( unsigned long long size = 1; size <= THREAD_CACHE_ALLOCATOR__MAXIMUM_CACHED_SIZE; size += 1 + size / 8 ){
+        unsigned char *memory = (unsigned char*) allocator__alloc( thread_cache_allocator.allocator, size );
+        REQUIRE( memory != NULL );
+        REQUIRE( (unsigned long long) memory % 16 == 0 );
+
+        memset( memory, (int)( size & 0xFF ), size );
+        allocations.push_back( memory );
+    }
+
+    unsigned long long allocation_index = 0;
+    for( unsigned long long size = 1; size <= THREAD_CACHE_ALLOCATOR__MAXIMUM_CACHED_SIZE; size += 1 + size / 8 ){
+        unsigned char *memory = allocations[ allocation_index++ ];
+        REQUIRE( memory[ 0 ] == (unsigned char)( size & 0xFF ) );
+        REQUIRE( memory[ size - 1 ] == (unsigned char)( size & 0xFF ) );
+        allocator__free( thread_cache_allocator.allocator, memory );
+    }
+}
+
+TEST_CASE_METHOD( ThreadCacheAllocator__TestFixture, "thread_cache_allocator__free_recycles_objects", "[thread_cache_allocator]" ){
+    void *first = allocator__alloc( thread_cache_allocator.allocator, 24 );
+    allocator__free( thread_cache_allocator.allocator, first );
+
+    // Objects of the same size class are reused from the thread cache.
+    REQUIRE( allocator__alloc( thread_cache_allocator.allocator, 32 ) == first );
+}
+
+TEST_CASE_METHOD( ThreadCacheAllocator__TestFixture, "thread_cache_allocator__large_allocations", "[thread_cache_allocator]" ){
+    const unsigned long long SIZE = 4 * THREAD_CACHE_ALLOCATOR__MAXIMUM_CACHED_SIZE;
+
+    char *memory = (char*) allocator__alloc( thread_cache_allocator.allocator, SIZE );
+    REQUIRE( memory != NULL );
+
+    memset( memory, 'a', SIZE );
+    REQUIRE( memory[ SIZE - 1 ] == 'a' );
+
+    allocator__free( thread_cache_allocator.allocator, memory );
+}
+
+TEST_CASE_METHOD( ThreadCacheAllocator__TestFixture, "thread_cache_allocator__realloc", "[thread_cache_allocator]" ){
+    char *memory = (char*) allocator__alloc( thread_cache_allocator.allocator, 10 );
+    memcpy( memory, "Hello", 6 );
+
+    // Growing within the size class keeps the allocation in place.
+    REQUIRE( allocator__realloc( thread_cache_allocator.allocator, memory, 16 ) == memory );
+
+    // Growing across size classes, and beyond the cached sizes, preserves the contents.
+    memory = (char*) allocator__realloc( thread_cache_allocator.allocator, memory, 1000 );
+    REQUIRE( strcmp( memory, "Hello" ) == 0 );
+
+    memory = (char*) allocator__realloc( thread_cache_allocator.allocator, memory, 2 * THREAD_CACHE_ALLOCATOR__MAXIMUM_CACHED_SIZE );
+    REQUIRE( strcmp( memory, "Hello" ) == 0 );
+
+    memory = (char*) allocator__realloc( thread_cache_allocator.allocator, memory, 4 * THREAD_CACHE_ALLOCATOR__MAXIMUM_CACHED_SIZE );
+    REQUIRE( strcmp( memory, "Hello" ) == 0 );
+
+    memory = (char*) allocator__realloc( thread_cache_allocator.allocator, memory, 100 );
+    REQUIRE( strcmp( memory, "Hello" ) == 0 );
+
+    allocator__free( thread_cache_allocator.allocator, memory );
+}
+
+TEST_CASE_METHOD( ThreadCacheAllocator__TestFixture, "thread_cache_allocator__flush", "[thread_cache_allocator]" ){
+    void *first = allocator__alloc( thread_cache_allocator.allocator, 64 );
+    allocator__free( thread_cache_allocator.allocator, first );
+
+    thread_cache_allocator__flush( &thread_cache_allocator );
+
+    // After flushing, another thread can reuse the object from the depot.
+    void *second = NULL;
+    std::thread thread( [ & ](){
+        second = allocator__alloc( thread_cache_allocator.allocator, 64 );
+    } );
+    thread.join();
+
+    REQUIRE( second == first );
+}
+
+TEST_CASE_METHOD( ThreadCacheAllocator__TestFixture, "thread_cache_allocator__many_threads", "[thread_cache_allocator]" ){
+    const int THREAD_COUNT = 8;
+    const int ITERATION_COUNT = 20000;
+
+    std::vector< std::thread > threads;
+    std::vector< int > results( THREAD_COUNT, 0 );
+
+    for( int thread_index = 0; thread_index < THREAD_COUNT; thread_index++ ){
+        threads.push_back( std::thread( [ &, thread_index ](){
+            String strings[ 16 ] = {};
+            bool success = true;
+
+            for( int iteration = 0; iteration < ITERATION_COUNT; iteration++ ){
+                String *string = &strings[ iteration % 16 ];
+                string__clear( string, thread_cache_allocator.allocator );
+                string__initialize__format( string, thread_cache_allocator.allocator, "%d:%d", thread_index, iteration );
+
+                char expected[ 32 ];
+                snprintf( expected, sizeof( expected ), "%d:%d", thread_index, iteration );
+                success = success && strcmp( string->data, expected ) == 0;
+            }
+
+            for( int string_index = 0; string_index < 16; string_index++ ){
+                string__clear( &strings[ string_index ], thread_cache_allocator.allocator );
+            }
+
+            results[ thread_index ] = success ? 1 : 0;
+        } ) );
+    }
+
+    for( int thread_index = 0; thread_index < THREAD_COUNT; thread_index++ ){
+        threads[ thread_index ].join();
+        REQUIRE( results[ thread_index ] == 1 );
+    }
+}
@@ -0,0 +1,214 @@
+// System Includes
+#include <stdio.h> // fopen, fputs, fclose, remove
+#include <thread>
+#include <vector>
+
+// 3rdParty Includes
+#include "catch2/catch.hpp"
+
+// Internal Includes
+#include "kirke/error.h"
+#include "kirke/hash_map.h"
+#include "kirke/string.h"
+#include "kirke/system_allocator.h"
+#include "kirke/thread_cache_allocator.h"
+#include "kirke/trace_allocator.h"
+
+static bool ints_are_equal( int first, int second ){
+    return first == second;
+}
+
+static unsigned long long hash_int( int key ){
+    return (unsigned long long) key;
+}
+
+HASH_MAP__DECLARE( TraceAllocator__HashMap, trace_allocator__hash_map, int, int )
+HASH_MAP__DEFINE( TraceAllocator__HashMap, trace_allocator__hash_map, int, int, hash_int, ints_are_equal )
+
+class TraceAllocator__TestFixture{
+    protected:
+        TraceAllocator__TestFixture(){
+            system_allocator__initialize( &system_allocator, NULL );
+            trace_allocator__initialize( &trace_allocator, system_allocator.allocator );
+        }
+
+        ~TraceAllocator__TestFixture(){
+            trace_allocator__deinitialize( &trace_allocator );
+            system_allocator__deinitialize( &system_allocator );
+        }
+
+        SystemAllocator system_allocator;
+        TraceAllocator trace_allocator;
+};
+
+TEST_CASE_METHOD( TraceAllocator__TestFixture, "trace_allocator__initialize_and_deinitialize", "[trace_allocator]" ){
+    REQUIRE( trace_allocator.allocator != NULL );
+    REQUIRE( trace_allocator.backing_allocator == system_allocator.allocator );
+    REQUIRE( trace_allocator.state != NULL );
+    REQUIRE( sizeof( TraceAllocator__Event ) == 16 );
+
+    // The allocation of the allocator itself is not part of the trace.
+    TraceAllocator__Trace trace;
+    REQUIRE( trace_allocator__trace( &trace_allocator, &trace, system_allocator.allocator ) );
+    REQUIRE( trace.event_count == 0 );
+    trace_allocator__trace__clear( &trace, system_allocator.allocator );
+
+    trace_allocator__deinitialize( &trace_allocator );
+    REQUIRE( trace_allocator.allocator == NULL );
+}
+
+TEST_CASE_METHOD( TraceAllocator__TestFixture, "trace_allocator__records_events", "[trace_allocator]" ){
+    char *first = (char*) allocator__alloc( trace_allocator.allocator, 100 );
+    void *second = allocator__alloc( trace_allocator.allocator, 24 );
+    first[ 99 ] = 'a';
+    first = (char*) allocator__realloc( trace_allocator.allocator, first, 1000 );
+    REQUIRE( first[ 99 ] == 'a' );
+    allocator__free( trace_allocator.allocator, first );
+    allocator__free( trace_allocator.allocator, second );
+    allocator__free( trace_allocator.allocator, NULL );
+
+    TraceAllocator__Trace trace;
+    REQUIRE( trace_allocator__trace( &trace_allocator, &trace, system_allocator.allocator ) );
+    REQUIRE( trace.event_count == 5 );
+    REQUIRE( trace.thread_count == 1 );
+    REQUIRE( trace.dropped_event_count == 0 );
+
+    TraceAllocator__Event *events = trace.events;
+    REQUIRE( events[ 0 ].operation == TraceAllocator__Operation__Alloc );
+    REQUIRE( events[ 0 ].size == 100 );
+    REQUIRE( events[ 1 ].operation == TraceAllocator__Operation__Alloc );
+    REQUIRE( events[ 1 ].pointer_id != events[ 0 ].pointer_id );
+    REQUIRE( events[ 2 ].operation == TraceAllocator__Operation__Realloc );
+    REQUIRE( events[ 2 ].pointer_id == events[ 0 ].pointer_id );
+    REQUIRE( events[ 2 ].size == 1000 );
+    REQUIRE( events[ 3 ].operation == TraceAllocator__Operation__Free );
+    REQUIRE( events[ 3 ].pointer_id == events[ 0 ].pointer_id );
+    REQUIRE( events[ 3 ].size == 1000 );
+    REQUIRE( events[ 4 ].pointer_id == events[ 1 ].pointer_id );
+    REQUIRE( events[ 4 ].size == 24 );
+
+    for( unsigned long long event_index = 0; event_index < trace.event_count; event_index++ ){
+        REQUIRE( events[ event_index ].pointer_id < trace.pointer_count );
+        REQUIRE( events[ event_index ].thread == 0 );
+    }
+
+    trace_allocator__trace__clear( &trace, system_allocator.allocator );
+    REQUIRE( trace.events == NULL );
+}
+
+TEST_CASE_METHOD( TraceAllocator__TestFixture, "trace_allocator__threads", "[trace_allocator]" ){
+    const int THREAD_COUNT = 4;
+    const int ALLOCATION_COUNT = 100000;
+
+    std::vector<std::thread> threads;
+    for( int thread_index = 0; thread_index < THREAD_COUNT; thread_index++ ){
+        threads.emplace_back( [ this ](){
+            for( int allocation = 0; allocation < ALLOCATION_COUNT; allocation++ ){
+                void *memory = allocator__alloc( trace_allocator.allocator, 16 + allocation % 100 );
+                allocator__free( trace_allocator.allocator, memory );
+            }
+        } );
+    }
+    for( std::thread &thread : threads ){
+        thread.join();
+    }
+
+    // The log spans several chunks, and orders every free after the alloc of the same allocation.
+    TraceAllocator__Trace trace;
+    REQUIRE( trace_allocator__trace( &trace_allocator, &trace, system_allocator.allocator ) );
+    REQUIRE( trace.event_count == 2ULL * THREAD_COUNT * ALLOCATION_COUNT );
+    REQUIRE( trace.event_count > TRACE_ALLOCATOR__CHUNK_EVENT_COUNT );
+    REQUIRE( trace.thread_count == THREAD_COUNT + 1 );
+
+    std::vector<bool> live( trace.pointer_count, false );
+    bool ordered = true;
+    for( unsigned long long event_index = 0; event_index < trace.event_count; event_index++ ){
+        TraceAllocator__Event event = trace.events[ event_index ];
+        if( event.operation == TraceAllocator__Operation__Alloc ){
+            ordered = ordered && !live[ event.pointer_id ];
+            live[ event.pointer_id ] = true;
+        }
+        else{
+            ordered = ordered && live[ event.pointer_id ];
+            live[ event.pointer_id ] = false;
+        }
+    }
+    REQUIRE( ordered );
+
+    TraceAllocator__Replay replay;
+    REQUIRE( trace_allocator__replay( &trace, system_allocator.allocator, &replay ) );
+    REQUIRE( replay.operation_count == trace.event_count );
+
+    trace_allocator__trace__clear( &trace, system_allocator.allocator );
+}
+
+TEST_CASE_METHOD( TraceAllocator__TestFixture, "trace_allocator__write_read_and_replay", "[trace_allocator]" ){
+    // A hash map and a string generate the same pattern of growth which they would in a service.
+    TraceAllocator__HashMap hash_map;
+    trace_allocator__hash_map__initialize( &hash_map, trace_allocator.allocator, 16 );
+    for( int key = 0; key < 10000; key++ ){
+        trace_allocator__hash_map__insert( &hash_map, key, key );
+    }
+
+    AutoString auto_string;
+    auto_string__initialize( &auto_string, trace_allocator.allocator, 1 );
+    for( int repetition = 0; repetition < 10000; repetition++ ){
+        auto_string__append_elements( &auto_string, 14, "Hello, World! " );
+    }
+
+    Error error = {};
+    String file_path = string__literal( "test__libkirke__trace_allocator.trace" );
+    REQUIRE( trace_allocator__write( &trace_allocator, file_path, &error ) );
+    REQUIRE( error.code == Error__None );
+
+    TraceAllocator__Trace recorded;
+    REQUIRE( trace_allocator__trace( &trace_allocator, &recorded, system_allocator.allocator ) );
+
+    TraceAllocator__Trace trace;
+    REQUIRE( trace_allocator__read( file_path, &trace, system_allocator.allocator, &error ) );
+    REQUIRE( trace.event_count == recorded.event_count );
+    REQUIRE( trace.pointer_count == recorded.pointer_count );
+    REQUIRE( trace.thread_count == recorded.thread_count );
+    REQUIRE( memcmp( trace.events, recorded.events, trace.event_count * sizeof( TraceAllocator__Event ) ) == 0 );
+    remove( file_path.data );
+
+    TraceAllocator__Replay replay;
+    REQUIRE( trace_allocator__replay( &trace, system_allocator.allocator, &replay ) );
+    REQUIRE( replay.operation_count == trace.event_count );
+    REQUIRE( replay.peak_live_bytes >= 140000 );
+    REQUIRE( replay.fragmentation >= 0.0 );
+    REQUIRE( replay.fragmentation < 1.0 );
+
+    ThreadCacheAllocator thread_cache_allocator;
+    thread_cache_allocator__initialize( &thread_cache_allocator, system_allocator.allocator );
+    TraceAllocator__Replay other_replay;
+    REQUIRE( trace_allocator__replay( &trace, thread_cache_allocator.allocator, &other_replay ) );
+    REQUIRE( other_replay.peak_live_bytes == replay.peak_live_bytes );
+    thread_cache_allocator__deinitialize( &thread_cache_allocator );
+
+    trace_allocator__trace__clear( &trace, system_allocator.allocator );
+    trace_allocator__trace__clear( &recorded, system_allocator.allocator );
+    auto_string__clear( &auto_string );
+    trace_allocator__hash_map__clear( &hash_map );
+}
+
+TEST_CASE_METHOD( TraceAllocator__TestFixture, "trace_allocator__read_invalid_file", "[trace_allocator]" ){
+    Error error = {};
+    TraceAllocator__Trace trace;
+
+    String missing_path = string__literal( "/nonexistent/directory/allocations.trace" );
+    REQUIRE( trace_allocator__read( missing_path, &trace, system_allocator.allocator, &error ) == false );
+    REQUIRE( error.code == TraceAllocator__Error__UnableToOpenFile );
+    REQUIRE( trace_allocator__write( &trace_allocator, missing_path, NULL ) == false );
+
+    String file_path = string__literal( "test__libkirke__trace_allocator.invalid" );
+    FILE *output_file = fopen( file_path.data, "w" );
+    fputs( "This is not a trace, although it is longer than the header of one.", output_file );
+    fclose( output_file );
+
+    Error invalid_error = {};
+    REQUIRE( trace_allocator__read( file_path, &trace, system_allocator.allocator, &invalid_error ) == false );
+    REQUIRE( invalid_error.code == TraceAllocator__Error__InvalidFile );
+    REQUIRE( trace.events == NULL );
+    remove( file_path.data );
+}